@@ -138,3 +138,19 @@ void branch_predictor_t::print_configuration() {
 
     sinuca_engine.write_statistics_value(get_type_component_label(), get_label(), "branch_predictor_type", get_enum_branch_predictor_policy_char(branch_predictor_type));
 };
+
+// ============================================================================
+void branch_predictor_t::checkpoint(checkpoint_t *checkpoint) {
+    checkpoint->section(this->get_type_component_label());
+
+    /// Statistics, not kept by the warm images
+    if (!checkpoint->get_is_warm()) {
+        checkpoint->value(this->stat_branch_predictor_operation);
+        checkpoint->value(this->stat_branch_predictor_hit);
+        checkpoint->value(this->stat_branch_predictor_miss);
+        checkpoint->value(this->stat_branch_predictor_taken);
+        checkpoint->value(this->stat_branch_predictor_not_taken);
+        checkpoint->value(this->stat_branch_predictor_conditional);
+        checkpoint->value(this->stat_branch_predictor_unconditional);
+    }
+};
@@ -72,6 +72,9 @@ class branch_predictor_t : public interconnection_interface_t {
         void reset_statistics();
         void print_statistics();
         void print_configuration();
+
+        /// Checkpoint Methods
+        void checkpoint(checkpoint_t *checkpoint);
         // ====================================================================
 
         virtual processor_stage_t predict_branch(const opcode_package_t& actual_opcode, const opcode_package_t& next_opcode)=0;
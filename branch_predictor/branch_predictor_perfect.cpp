@@ -233,3 +233,20 @@ void branch_predictor_perfect_t::print_configuration() {
     sinuca_engine.write_statistics_value(get_type_component_label(), get_label(), "btb_index_bits_mask", utils_t::address_to_binary(btb_index_bits_mask).c_str());
 
 };
+
+// ============================================================================
+void branch_predictor_perfect_t::checkpoint(checkpoint_t *checkpoint) {
+    branch_predictor_t::checkpoint(checkpoint);
+
+    checkpoint->check_size(this->get_btb_total_sets());
+    for (uint32_t i = 0; i < this->get_btb_total_sets(); i++) {
+        checkpoint->array(this->btb[i].ways, this->get_btb_associativity());
+    }
+
+    /// Statistics, not kept by the warm images
+    if (!checkpoint->get_is_warm()) {
+        checkpoint->value(this->stat_btb_accesses);
+        checkpoint->value(this->stat_btb_hit);
+        checkpoint->value(this->stat_btb_miss);
+    }
+};
@@ -373,3 +373,23 @@ void branch_predictor_two_level_gas_t::print_configuration() {
     sinuca_engine.write_statistics_value(get_type_component_label(), get_label(), "fsm_max_counter", fsm_max_counter);
     sinuca_engine.write_statistics_value(get_type_component_label(), get_label(), "fsm_taken_threshold", fsm_taken_threshold);
 };
+
+// ============================================================================
+void branch_predictor_two_level_gas_t::checkpoint(checkpoint_t *checkpoint) {
+    branch_predictor_t::checkpoint(checkpoint);
+
+    checkpoint->check_size(this->get_btb_total_sets());
+    for (uint32_t i = 0; i < this->get_btb_total_sets(); i++) {
+        checkpoint->array(this->btb[i].ways, this->get_btb_associativity());
+    }
+    checkpoint->value(this->gbhr);
+    /// The matrix is allocated contiguously
+    checkpoint->array(this->spht[0], this->get_spht_line_number() * this->get_spht_set_number());
+
+    /// Statistics, not kept by the warm images
+    if (!checkpoint->get_is_warm()) {
+        checkpoint->value(this->stat_btb_accesses);
+        checkpoint->value(this->stat_btb_hit);
+        checkpoint->value(this->stat_btb_miss);
+    }
+};
@@ -95,6 +95,9 @@ class branch_predictor_two_level_pag_t : public branch_predictor_t {
         void reset_statistics();
         void print_statistics();
         void print_configuration();
+
+        /// Checkpoint Methods
+        void checkpoint(checkpoint_t *checkpoint);
         // ====================================================================
         uint32_t btb_evict_address(uint64_t opcode_address);
         bool btb_find_update_address(uint64_t opcode_address);
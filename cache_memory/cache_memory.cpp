@@ -71,6 +71,7 @@ cache_memory_t::cache_memory_t() {
 
     this->send_ans_ready_cycle = 0;
     this->send_rqst_ready_cycle = 0;
+    this->skip_token_package = NULL;
 
     this->recv_ans_ready_cycle = 0;
     this->recv_rqst_read_ready_cycle = 0;
@@ -112,18 +113,7 @@ void cache_memory_t::allocate() {
         }
     }
 
-    ERROR_ASSERT_PRINTF(mshr_request_buffer_size > 0, "mshr_request_buffer_size should be bigger than zero.\n");
-    ERROR_ASSERT_PRINTF(mshr_prefetch_buffer_size > 0, "mshr_prefetch_buffer_size should be bigger than zero.\n");
-    ERROR_ASSERT_PRINTF(mshr_write_buffer_size > 0, "mshr_write_buffer_size should be bigger than zero.\n");
-    ERROR_ASSERT_PRINTF(mshr_eviction_buffer_size > 0, "mshr_eviction_buffer_size should be bigger than zero.\n");
-
-    /// MSHR = [    REQUEST    | PREFETCH | WRITE | EVICT ]
-    this->mshr_buffer_size = this->mshr_request_buffer_size +
-                                this->mshr_prefetch_buffer_size +
-                                this->mshr_write_buffer_size +
-                                this->mshr_eviction_buffer_size;
-    this->mshr_buffer = utils_t::template_allocate_array<memory_package_t>(this->get_mshr_buffer_size());
-    this->mshr_born_ordered.reserve(this->mshr_buffer_size);
+    this->allocate_mshr();
 
     this->mshr_tokens_request = utils_t::template_allocate_initialize_array<int32_t>(sinuca_engine.get_interconnection_interface_array_size(), -1);
     this->mshr_tokens_prefetch = utils_t::template_allocate_initialize_array<int32_t>(sinuca_engine.get_interconnection_interface_array_size(), -1);
@@ -152,6 +142,26 @@ void cache_memory_t::allocate() {
     #endif
 };
 
+// ============================================================================
+/// Also called to resize the MSHR of a drained cache (variants after the warm-up)
+void cache_memory_t::allocate_mshr() {
+    ERROR_ASSERT_PRINTF(mshr_request_buffer_size > 0, "mshr_request_buffer_size should be bigger than zero.\n");
+    ERROR_ASSERT_PRINTF(mshr_prefetch_buffer_size > 0, "mshr_prefetch_buffer_size should be bigger than zero.\n");
+    ERROR_ASSERT_PRINTF(mshr_write_buffer_size > 0, "mshr_write_buffer_size should be bigger than zero.\n");
+    ERROR_ASSERT_PRINTF(mshr_eviction_buffer_size > 0, "mshr_eviction_buffer_size should be bigger than zero.\n");
+    ERROR_ASSERT_PRINTF(this->mshr_born_ordered.empty(), "Allocating the MSHR with packages inside.\n");
+
+    utils_t::template_delete_array<memory_package_t>(this->mshr_buffer);
+
+    /// MSHR = [    REQUEST    | PREFETCH | WRITE | EVICT ]
+    this->mshr_buffer_size = this->mshr_request_buffer_size +
+                                this->mshr_prefetch_buffer_size +
+                                this->mshr_write_buffer_size +
+                                this->mshr_eviction_buffer_size;
+    this->mshr_buffer = utils_t::template_allocate_array<memory_package_t>(this->get_mshr_buffer_size());
+    this->mshr_born_ordered.reserve(this->mshr_buffer_size);
+};
+
 // ============================================================================
 void cache_memory_t::set_tokens() {
 
@@ -475,6 +485,8 @@ void cache_memory_t::clock(uint32_t subcycle) {
 
 // ============================================================================
 void cache_memory_t::insert_mshr_born_ordered(memory_package_t* package){
+    sinuca_engine.wake_component(this->get_id());
+
     /// this->mshr_born_ordered            = [OLDER --------> NEWER]
     /// this->mshr_born_ordered.born_cycle = [SMALLER -----> BIGGER]
 
@@ -700,6 +712,7 @@ int32_t cache_memory_t::send_package(memory_package_t *package) {
 
 // ============================================================================
 bool cache_memory_t::receive_package(memory_package_t *package, uint32_t input_port, uint32_t transmission_latency) {
+    profile_scope_t profile(&this->profile_receive);
     CACHE_DEBUG_PRINTF("receive_package() port:%u, package:%s\n", input_port, package->content_to_string().c_str());
 
     // ~ ERROR_ASSERT_PRINTF(package->memory_address != 0, "Wrong memory address.\n%s\n", package->content_to_string().c_str());
@@ -1008,29 +1021,29 @@ void cache_memory_t::cache_wait(memory_package_t *package) {
 
     switch (package->memory_operation) {
         case MEMORY_OPERATION_READ:
-            this->add_stat_read_wait(package->born_cycle);
+            this->add_stat_read_wait_time(package->born_cycle);
         break;
 
         case MEMORY_OPERATION_INST:
-            this->add_stat_instruction_wait(package->born_cycle);
+            this->add_stat_instruction_wait_time(package->born_cycle);
         break;
 
         case MEMORY_OPERATION_WRITE:
-            this->add_stat_write_wait(package->born_cycle);
+            this->add_stat_write_wait_time(package->born_cycle);
         break;
 
         case MEMORY_OPERATION_PREFETCH:
-            this->add_stat_prefetch_wait(package->born_cycle);
+            this->add_stat_prefetch_wait_time(package->born_cycle);
         break;
 
         case MEMORY_OPERATION_WRITEBACK:
-            this->add_stat_writeback_wait(package->born_cycle);
+            this->add_stat_writeback_wait_time(package->born_cycle);
         break;
 
         // HMC
         case MEMORY_OPERATION_HMC_ALU:
         case MEMORY_OPERATION_HMC_ALUR:
-            this->add_stat_hmc_wait(package->born_cycle);
+            this->add_stat_hmc_wait_time(package->born_cycle);
         break;
 
     }
@@ -1199,6 +1212,143 @@ void cache_memory_t::update_last_access(cache_line_t *line) {
 
 
 
+// ============================================================================
+/// The prefetches are installed at once, without MSHR
+void cache_memory_t::functional_prefetch() {
+    while (!this->prefetcher->request_buffer.is_empty()) {
+        memory_package_t *package = this->prefetcher->request_buffer.front();
+        package->id_owner = this->get_id();
+        sinuca_engine.directory_controller->functional_request(this, package);
+        this->prefetcher->request_buffer.pop_front();
+    }
+};
+
+// ============================================================================
+/// Nothing inside the MSHR neither waiting for room on it
+bool cache_memory_t::is_drained() {
+    return this->mshr_born_ordered.empty() && this->prefetcher->request_buffer.is_empty();
+};
+
+// ============================================================================
+/// The MSHR entries waiting for answers only wake up when receiving them.
+/// A prefetch waiting for room on the MSHR is retried every cycle.
+/// The oldest request to be sent may wait for a token of the lower level,
+/// retried (and counted as full MSHR there) every cycle until one is given back.
+uint64_t cache_memory_t::get_next_event_cycle() {
+    uint64_t cycle = sinuca_engine.get_global_cycle();
+    this->skip_token_package = NULL;
+
+    if (!this->prefetcher->request_buffer.is_empty()) {
+        return cycle;
+    }
+
+    uint64_t next_cycle = std::numeric_limits<uint64_t>::max();
+    bool request_to_send = false;
+    for (uint32_t i = 0; i < this->mshr_born_ordered.size(); i++){
+        memory_package_t *package = this->mshr_born_ordered[i];
+        if (package->state == PACKAGE_STATE_WAIT) {
+            continue;
+        }
+        if (package->ready_cycle > cycle) {
+            next_cycle = std::min(next_cycle, package->ready_cycle);
+            continue;
+        }
+        if (package->state != PACKAGE_STATE_TRANSMIT || package->is_answer) {
+            return cycle;
+        }
+
+        /// Only the oldest request is tried on each cycle
+        if (request_to_send) {
+            continue;
+        }
+        request_to_send = true;
+        if (this->send_rqst_ready_cycle > cycle) {
+            next_cycle = std::min(next_cycle, this->send_rqst_ready_cycle);
+            continue;
+        }
+
+        bool got_token = true;
+        switch (package->memory_operation) {
+            // HMC -> READ buffer
+            case MEMORY_OPERATION_HMC_ALU:
+            case MEMORY_OPERATION_HMC_ALUR:
+
+            case MEMORY_OPERATION_READ:
+            case MEMORY_OPERATION_INST:
+                got_token = this->got_request_token;
+            break;
+
+            case MEMORY_OPERATION_PREFETCH:
+                got_token = this->got_prefetch_token;
+            break;
+
+            case MEMORY_OPERATION_WRITEBACK:
+            case MEMORY_OPERATION_WRITE:
+                got_token = this->got_write_token;
+            break;
+        }
+        if (got_token ||
+        sinuca_engine.interconnection_interface_array[package->id_dst]->check_token_credit(this->get_id(), package->memory_operation)) {
+            return cycle;
+        }
+        this->skip_token_package = package;
+    }
+    return next_cycle;
+};
+
+// ============================================================================
+void cache_memory_t::skip_cycles(uint64_t cycles) {
+    if (this->skip_token_package != NULL) {
+        sinuca_engine.interconnection_interface_array[this->skip_token_package->id_dst]->skip_token_credit(this->get_id(),
+                                                                                    this->skip_token_package->memory_operation, cycles);
+    }
+};
+
+// ============================================================================
+bool cache_memory_t::check_token_credit(uint32_t src_id, memory_operation_t memory_operation) {
+    switch (memory_operation) {
+        case MEMORY_OPERATION_READ:
+        case MEMORY_OPERATION_INST:
+        // HMC -> READ buffer
+        case MEMORY_OPERATION_HMC_ALU:
+        case MEMORY_OPERATION_HMC_ALUR:
+            return this->mshr_tokens_request[src_id] > 0;
+
+        case MEMORY_OPERATION_PREFETCH:
+            return this->mshr_tokens_prefetch[src_id] > 0;
+
+        case MEMORY_OPERATION_WRITE:
+        case MEMORY_OPERATION_WRITEBACK:
+            return this->mshr_tokens_write[src_id] > 0;
+    }
+    return OK;
+};
+
+// ============================================================================
+/// While nothing moves the tokens are not given back, so each skipped cycle is one failed pop.
+void cache_memory_t::skip_token_credit(uint32_t src_id, memory_operation_t memory_operation, uint64_t cycles) {
+    ERROR_ASSERT_PRINTF(!this->check_token_credit(src_id, memory_operation), "Skipping cycles with available tokens.\n")
+
+    switch (memory_operation) {
+        case MEMORY_OPERATION_READ:
+        case MEMORY_OPERATION_INST:
+        // HMC -> READ buffer
+        case MEMORY_OPERATION_HMC_ALU:
+        case MEMORY_OPERATION_HMC_ALUR:
+            this->statistics.stat_full_mshr_request_buffer += cycles;
+        break;
+
+        case MEMORY_OPERATION_PREFETCH:
+            this->statistics.stat_full_mshr_prefetch_buffer += cycles;
+        break;
+
+        case MEMORY_OPERATION_WRITE:
+        case MEMORY_OPERATION_WRITEBACK:
+            this->statistics.stat_full_mshr_write_buffer += cycles;
+        break;
+    }
+};
+
 // ============================================================================
 void cache_memory_t::print_structures() {
     SINUCA_PRINTF("%s MSHR_BUFFER:\n%s", this->get_label(), memory_package_t::print_all(this->mshr_buffer, this->mshr_buffer_size).c_str())
@@ -1251,50 +1401,7 @@ void cache_memory_t::periodic_check(){
 /// STATISTICS
 // ============================================================================
 void cache_memory_t::reset_statistics() {
-    this->set_stat_accesses(0);
-    this->set_stat_invalidation(0);
-    this->set_stat_eviction(0);
-    this->set_stat_writeback(0);
-
-    this->set_stat_final_eviction(0);
-    this->set_stat_final_writeback(0);
-
-    this->set_stat_instruction_hit(0);
-    this->set_stat_read_hit(0);
-    this->set_stat_prefetch_hit(0);
-    this->set_stat_write_hit(0);
-    this->set_stat_writeback_recv(0);
-
-    this->set_stat_instruction_miss(0);
-    this->set_stat_read_miss(0);
-    this->set_stat_prefetch_miss(0);
-    this->set_stat_write_miss(0);
-    this->set_stat_writeback_send(0);
-
-    this->stat_min_instruction_wait_time = 0;
-    this->stat_max_instruction_wait_time = 0;
-    this->stat_accumulated_instruction_wait_time = 0;
-
-    this->stat_min_read_wait_time = 0;
-    this->stat_max_read_wait_time = 0;
-    this->stat_accumulated_read_wait_time = 0;
-
-    this->stat_min_prefetch_wait_time = 0;
-    this->stat_max_prefetch_wait_time = 0;
-    this->stat_accumulated_prefetch_wait_time = 0;
-
-    this->stat_min_write_wait_time = 0;
-    this->stat_max_write_wait_time = 0;
-    this->stat_accumulated_write_wait_time = 0;
-
-    this->stat_min_writeback_wait_time = 0;
-    this->stat_max_writeback_wait_time = 0;
-    this->stat_accumulated_writeback_wait_time = 0;
-
-    this->stat_full_mshr_request_buffer = 0;
-    this->stat_full_mshr_prefetch_buffer = 0;
-    this->stat_full_mshr_write_buffer = 0;
-    this->stat_full_mshr_eviction_buffer = 0;
+    memset(&this->statistics, 0, sizeof(this->statistics));
 
     this->prefetcher->reset_statistics();
     this->line_usage_predictor->reset_statistics();
@@ -1308,70 +1415,32 @@ void cache_memory_t::print_statistics() {
     sinuca_engine.write_statistics_comments(title);
     sinuca_engine.write_statistics_big_separator();
 
-    sinuca_engine.write_statistics_value(get_type_component_label(), get_label(), "stat_accesses", stat_accesses);
-    sinuca_engine.write_statistics_value(get_type_component_label(), get_label(), "stat_invalidation", stat_invalidation);
-    sinuca_engine.write_statistics_value(get_type_component_label(), get_label(), "stat_eviction", stat_eviction);
-    sinuca_engine.write_statistics_value(get_type_component_label(), get_label(), "stat_writeback", stat_writeback);
-
-    sinuca_engine.write_statistics_small_separator();
-    sinuca_engine.write_statistics_value(get_type_component_label(), get_label(), "stat_final_eviction", stat_final_eviction);
-    sinuca_engine.write_statistics_value(get_type_component_label(), get_label(), "stat_final_writeback", stat_final_writeback);
-
-    sinuca_engine.write_statistics_small_separator();
-    sinuca_engine.write_statistics_value(get_type_component_label(), get_label(), "stat_sum_read", stat_instruction_hit + stat_read_hit + stat_prefetch_hit +
-                                                                                                    stat_instruction_miss + stat_read_miss + stat_prefetch_miss);
-    sinuca_engine.write_statistics_value(get_type_component_label(), get_label(), "stat_sum_read_hit", stat_instruction_hit + stat_read_hit + stat_prefetch_hit);
-    sinuca_engine.write_statistics_value(get_type_component_label(), get_label(), "stat_sum_read_miss", stat_instruction_miss + stat_read_miss + stat_prefetch_miss);
-
-    sinuca_engine.write_statistics_value(get_type_component_label(), get_label(), "stat_sum_write", stat_write_hit + stat_writeback_recv + stat_write_miss + stat_writeback_send);
-    sinuca_engine.write_statistics_value(get_type_component_label(), get_label(), "stat_sum_write_hit", stat_write_hit + stat_writeback_recv);
-    sinuca_engine.write_statistics_value(get_type_component_label(), get_label(), "stat_sum_write_miss", stat_write_miss + stat_writeback_send);
-
-    sinuca_engine.write_statistics_small_separator();
-    sinuca_engine.write_statistics_value(get_type_component_label(), get_label(), "stat_instruction_hit", stat_instruction_hit);
-    sinuca_engine.write_statistics_value(get_type_component_label(), get_label(), "stat_read_hit", stat_read_hit);
-    sinuca_engine.write_statistics_value(get_type_component_label(), get_label(), "stat_prefetch_hit", stat_prefetch_hit);
-    sinuca_engine.write_statistics_value(get_type_component_label(), get_label(), "stat_write_hit", stat_write_hit);
-    sinuca_engine.write_statistics_value(get_type_component_label(), get_label(), "stat_writeback_recv", stat_writeback_recv);
-
-    sinuca_engine.write_statistics_small_separator();
-    sinuca_engine.write_statistics_value(get_type_component_label(), get_label(), "stat_instruction_miss", stat_instruction_miss);
-    sinuca_engine.write_statistics_value(get_type_component_label(), get_label(), "stat_read_miss", stat_read_miss);
-    sinuca_engine.write_statistics_value(get_type_component_label(), get_label(), "stat_prefetch_miss", stat_prefetch_miss);
-    sinuca_engine.write_statistics_value(get_type_component_label(), get_label(), "stat_write_miss", stat_write_miss);
-    sinuca_engine.write_statistics_value(get_type_component_label(), get_label(), "stat_writeback_send", stat_writeback_send);
-
-    sinuca_engine.write_statistics_small_separator();
-    sinuca_engine.write_statistics_value_percentage(get_type_component_label(), get_label(), "stat_instruction_miss_percentage", stat_instruction_miss, stat_instruction_miss + stat_instruction_hit);
-    sinuca_engine.write_statistics_value_percentage(get_type_component_label(), get_label(), "stat_read_miss_percentage", stat_read_miss, stat_read_miss + stat_read_hit);
-    sinuca_engine.write_statistics_value_percentage(get_type_component_label(), get_label(), "stat_prefetch_miss_percentage", stat_prefetch_miss, stat_prefetch_miss + stat_prefetch_hit);
-    sinuca_engine.write_statistics_value_percentage(get_type_component_label(), get_label(), "stat_write_miss_percentage", stat_write_miss, stat_write_miss + stat_write_hit);
+    CACHE_MEMORY_STATISTICS(STATISTICS_PRINT_COUNTER, STATISTICS_PRINT_LATENCY)
 
+    /// Derived from the statistics above
+    const statistics_t *stat = &this->statistics;
     sinuca_engine.write_statistics_small_separator();
-    sinuca_engine.write_statistics_value(get_type_component_label(), get_label(), "stat_min_instruction_wait_time", stat_min_instruction_wait_time);
-    sinuca_engine.write_statistics_value(get_type_component_label(), get_label(), "stat_min_read_wait_time", stat_min_read_wait_time);
-    sinuca_engine.write_statistics_value(get_type_component_label(), get_label(), "stat_min_prefetch_wait_time", stat_min_prefetch_wait_time);
-    sinuca_engine.write_statistics_value(get_type_component_label(), get_label(), "stat_min_write_wait_time", stat_min_write_wait_time);
-    sinuca_engine.write_statistics_value(get_type_component_label(), get_label(), "stat_min_writeback_wait_time", stat_min_writeback_wait_time);
+    sinuca_engine.write_statistics_value(get_type_component_label(), get_label(), "stat_sum_read", stat->stat_instruction_hit + stat->stat_read_hit + stat->stat_prefetch_hit +
+                                                                                                    stat->stat_instruction_miss + stat->stat_read_miss + stat->stat_prefetch_miss);
+    sinuca_engine.write_statistics_value(get_type_component_label(), get_label(), "stat_sum_read_hit", stat->stat_instruction_hit + stat->stat_read_hit + stat->stat_prefetch_hit);
+    sinuca_engine.write_statistics_value(get_type_component_label(), get_label(), "stat_sum_read_miss", stat->stat_instruction_miss + stat->stat_read_miss + stat->stat_prefetch_miss);
 
-    sinuca_engine.write_statistics_small_separator();
-    sinuca_engine.write_statistics_value(get_type_component_label(), get_label(), "stat_max_instruction_wait_time", stat_max_instruction_wait_time);
-    sinuca_engine.write_statistics_value(get_type_component_label(), get_label(), "stat_max_read_wait_time", stat_max_read_wait_time);
-    sinuca_engine.write_statistics_value(get_type_component_label(), get_label(), "stat_max_prefetch_wait_time", stat_max_prefetch_wait_time);
-    sinuca_engine.write_statistics_value(get_type_component_label(), get_label(), "stat_max_write_wait_time", stat_max_write_wait_time);
-    sinuca_engine.write_statistics_value(get_type_component_label(), get_label(), "stat_max_writeback_wait_time", stat_max_writeback_wait_time);
+    sinuca_engine.write_statistics_value(get_type_component_label(), get_label(), "stat_sum_write", stat->stat_write_hit + stat->stat_writeback_recv + stat->stat_write_miss + stat->stat_writeback_send);
+    sinuca_engine.write_statistics_value(get_type_component_label(), get_label(), "stat_sum_write_hit", stat->stat_write_hit + stat->stat_writeback_recv);
+    sinuca_engine.write_statistics_value(get_type_component_label(), get_label(), "stat_sum_write_miss", stat->stat_write_miss + stat->stat_writeback_send);
 
     sinuca_engine.write_statistics_small_separator();
-    sinuca_engine.write_statistics_value_ratio(get_type_component_label(), get_label(), "stat_accumulated_instruction_wait_time_ratio", stat_accumulated_instruction_wait_time, stat_accesses);
-    sinuca_engine.write_statistics_value_ratio(get_type_component_label(), get_label(), "stat_accumulated_read_wait_time_ratio", stat_accumulated_read_wait_time, stat_read_miss);
-    sinuca_engine.write_statistics_value_ratio(get_type_component_label(), get_label(), "stat_accumulated_prefetch_wait_time_ratio", stat_accumulated_prefetch_wait_time, stat_prefetch_miss);
-    sinuca_engine.write_statistics_value_ratio(get_type_component_label(), get_label(), "stat_accumulated_write_wait_time_ratio", stat_accumulated_write_wait_time, stat_write_miss);
-    sinuca_engine.write_statistics_value_ratio(get_type_component_label(), get_label(), "stat_accumulated_writeback_wait_time_ratio", stat_accumulated_writeback_wait_time, stat_writeback_send);
+    sinuca_engine.write_statistics_value_percentage(get_type_component_label(), get_label(), "stat_instruction_miss_percentage", stat->stat_instruction_miss, stat->stat_instruction_miss + stat->stat_instruction_hit);
+    sinuca_engine.write_statistics_value_percentage(get_type_component_label(), get_label(), "stat_read_miss_percentage", stat->stat_read_miss, stat->stat_read_miss + stat->stat_read_hit);
+    sinuca_engine.write_statistics_value_percentage(get_type_component_label(), get_label(), "stat_prefetch_miss_percentage", stat->stat_prefetch_miss, stat->stat_prefetch_miss + stat->stat_prefetch_hit);
+    sinuca_engine.write_statistics_value_percentage(get_type_component_label(), get_label(), "stat_write_miss_percentage", stat->stat_write_miss, stat->stat_write_miss + stat->stat_write_hit);
 
     sinuca_engine.write_statistics_small_separator();
-    sinuca_engine.write_statistics_value(get_type_component_label(), get_label(), "stat_full_mshr_request_buffer", stat_full_mshr_request_buffer);
-    sinuca_engine.write_statistics_value(get_type_component_label(), get_label(), "stat_full_mshr_write_buffer", stat_full_mshr_write_buffer);
-    sinuca_engine.write_statistics_value(get_type_component_label(), get_label(), "stat_full_mshr_prefetch_buffer", stat_full_mshr_prefetch_buffer);
+    sinuca_engine.write_statistics_value_ratio(get_type_component_label(), get_label(), "stat_accumulated_instruction_wait_time_ratio", stat->stat_instruction_wait_time.accumulated, stat->stat_accesses);
+    sinuca_engine.write_statistics_value_ratio(get_type_component_label(), get_label(), "stat_accumulated_read_wait_time_ratio", stat->stat_read_wait_time.accumulated, stat->stat_read_miss);
+    sinuca_engine.write_statistics_value_ratio(get_type_component_label(), get_label(), "stat_accumulated_prefetch_wait_time_ratio", stat->stat_prefetch_wait_time.accumulated, stat->stat_prefetch_miss);
+    sinuca_engine.write_statistics_value_ratio(get_type_component_label(), get_label(), "stat_accumulated_write_wait_time_ratio", stat->stat_write_wait_time.accumulated, stat->stat_write_miss);
+    sinuca_engine.write_statistics_value_ratio(get_type_component_label(), get_label(), "stat_accumulated_writeback_wait_time_ratio", stat->stat_writeback_wait_time.accumulated, stat->stat_writeback_send);
 
 
     this->prefetcher->print_statistics();
@@ -1427,3 +1496,35 @@ void cache_memory_t::print_configuration() {
     this->prefetcher->print_configuration();
     this->line_usage_predictor->print_configuration();
 };
+
+// ============================================================================
+/// The MSHR is drained before saving, the tokens are all back at their owners.
+void cache_memory_t::checkpoint(checkpoint_t *checkpoint) {
+    ERROR_ASSERT_PRINTF(checkpoint->get_is_restore() || this->is_drained(), "Checkpoint with requests inside the MSHR.\n")
+    checkpoint->section(this->get_label());
+
+    checkpoint->check_size(this->get_total_sets());
+    for (uint32_t i = 0; i < this->get_total_sets(); i++) {
+        checkpoint->array(this->sets[i].ways, this->get_associativity());
+    }
+
+    /// Timing, not kept by the warm images
+    if (!checkpoint->get_is_warm()) {
+        checkpoint->value(this->got_request_token);
+        checkpoint->value(this->got_prefetch_token);
+        checkpoint->value(this->got_write_token);
+        checkpoint->value(this->send_ans_ready_cycle);
+        checkpoint->value(this->send_rqst_ready_cycle);
+        checkpoint->value(this->recv_ans_ready_cycle);
+        checkpoint->value(this->recv_rqst_read_ready_cycle);
+        checkpoint->value(this->recv_rqst_write_ready_cycle);
+    }
+
+    /// Statistics, not kept by the warm images
+    if (!checkpoint->get_is_warm()) {
+        checkpoint->value(this->statistics);
+    }
+
+    this->prefetcher->checkpoint(checkpoint);
+    this->line_usage_predictor->checkpoint(checkpoint);
+};
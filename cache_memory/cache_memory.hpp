@@ -19,6 +19,35 @@
  */
 
 
+/// Statistics of the cache memory, see statistics_registry.hpp
+#define CACHE_MEMORY_STATISTICS(COUNTER, LATENCY) \
+    COUNTER(stat_accesses) \
+    COUNTER(stat_invalidation) \
+    COUNTER(stat_eviction) \
+    COUNTER(stat_writeback) \
+    COUNTER(stat_final_eviction) \
+    COUNTER(stat_final_writeback) \
+    COUNTER(stat_instruction_hit) \
+    COUNTER(stat_read_hit) \
+    COUNTER(stat_prefetch_hit) \
+    COUNTER(stat_write_hit) \
+    COUNTER(stat_writeback_recv) \
+    COUNTER(stat_instruction_miss) \
+    COUNTER(stat_read_miss) \
+    COUNTER(stat_prefetch_miss) \
+    COUNTER(stat_write_miss) \
+    COUNTER(stat_writeback_send) \
+    COUNTER(stat_full_mshr_request_buffer) \
+    COUNTER(stat_full_mshr_prefetch_buffer) \
+    COUNTER(stat_full_mshr_write_buffer) \
+    COUNTER(stat_full_mshr_eviction_buffer) \
+    LATENCY(instruction_wait_time) \
+    LATENCY(read_wait_time) \
+    LATENCY(prefetch_wait_time) \
+    LATENCY(write_wait_time) \
+    LATENCY(writeback_wait_time) \
+    LATENCY(hmc_wait_time)
+
 /// Cache Memory.
 class cache_memory_t : public interconnection_interface_t {
     public:
@@ -87,6 +116,8 @@ class cache_memory_t : public interconnection_interface_t {
         uint64_t send_ans_ready_cycle;
         uint64_t send_rqst_ready_cycle;
 
+        memory_package_t *skip_token_package;           /// Request waiting for a token while the cycles are skipped
+
         uint64_t recv_ans_ready_cycle;                  /// Ready to receive new READ ANS
         uint64_t recv_rqst_read_ready_cycle;            /// Ready to receive new READ RQST
         uint64_t recv_rqst_write_ready_cycle;           /// Ready to receive new WRITE RQST
@@ -97,55 +128,9 @@ class cache_memory_t : public interconnection_interface_t {
         // ====================================================================
         /// Statistics related
         // ====================================================================
-        uint64_t stat_accesses;
-        uint64_t stat_invalidation;
-        uint64_t stat_eviction;
-        uint64_t stat_writeback;
-
-        uint64_t stat_final_eviction;
-        uint64_t stat_final_writeback;
-
-        uint64_t stat_instruction_hit;
-        uint64_t stat_read_hit;
-        uint64_t stat_prefetch_hit;
-        uint64_t stat_write_hit;
-        uint64_t stat_writeback_recv;
-
-        uint64_t stat_instruction_miss;
-        uint64_t stat_read_miss;
-        uint64_t stat_prefetch_miss;
-        uint64_t stat_write_miss;
-        uint64_t stat_writeback_send;
-
-        uint64_t stat_min_instruction_wait_time;
-        uint64_t stat_max_instruction_wait_time;
-        uint64_t stat_accumulated_instruction_wait_time;
-
-        uint64_t stat_min_read_wait_time;
-        uint64_t stat_max_read_wait_time;
-        uint64_t stat_accumulated_read_wait_time;
-
-        uint64_t stat_min_prefetch_wait_time;
-        uint64_t stat_max_prefetch_wait_time;
-        uint64_t stat_accumulated_prefetch_wait_time;
-
-        uint64_t stat_min_write_wait_time;
-        uint64_t stat_max_write_wait_time;
-        uint64_t stat_accumulated_write_wait_time;
-
-        uint64_t stat_min_writeback_wait_time;
-        uint64_t stat_max_writeback_wait_time;
-        uint64_t stat_accumulated_writeback_wait_time;
-
-        // HMC
-        uint64_t stat_min_hmc_wait_time;
-        uint64_t stat_max_hmc_wait_time;
-        uint64_t stat_accumulated_hmc_wait_time;
-
-        uint64_t stat_full_mshr_request_buffer;
-        uint64_t stat_full_mshr_prefetch_buffer;
-        uint64_t stat_full_mshr_write_buffer;
-        uint64_t stat_full_mshr_eviction_buffer;
+        struct statistics_t {
+            CACHE_MEMORY_STATISTICS(STATISTICS_DECLARE_COUNTER, STATISTICS_DECLARE_LATENCY)
+        } statistics;
 
     public:
         // ====================================================================
@@ -159,6 +144,7 @@ class cache_memory_t : public interconnection_interface_t {
         // ====================================================================
         /// Basic Methods
         void allocate();
+        void allocate_mshr();
         void clock(uint32_t sub_cycle);
         int32_t send_package(memory_package_t *package);
         bool receive_package(memory_package_t *package, uint32_t input_port, uint32_t transmission_latency);
@@ -173,6 +159,15 @@ class cache_memory_t : public interconnection_interface_t {
         void reset_statistics();
         void print_statistics();
         void print_configuration();
+
+        /// Checkpoint Methods
+        void checkpoint(checkpoint_t *checkpoint);
+
+        /// Idle-Cycle Skipping Methods
+        uint64_t get_next_event_cycle();
+        void skip_cycles(uint64_t cycles);
+        bool check_token_credit(uint32_t src_id, memory_operation_t memory_operation);
+        void skip_token_credit(uint32_t src_id, memory_operation_t memory_operation, uint64_t cycles);
         // ====================================================================
 
         /// MASKS
@@ -227,6 +222,10 @@ class cache_memory_t : public interconnection_interface_t {
         void change_status(cache_line_t *line, protocol_status_t status);
         void update_last_access(cache_line_t *line);
 
+        /// Functional warm-up of the prefetches created by the prefetcher
+        void functional_prefetch();
+        bool is_drained();
+
         /// Methods called by the directory to add statistics and others
         void cache_stats(memory_operation_t memory_operation, bool is_hit);
         void cache_wait(memory_package_t *package);
@@ -260,75 +259,5 @@ class cache_memory_t : public interconnection_interface_t {
         // ====================================================================
         /// Statistics related
         // ====================================================================
-        INSTANTIATE_GET_SET_ADD(uint64_t, stat_accesses)
-        INSTANTIATE_GET_SET_ADD(uint64_t, stat_invalidation)
-        INSTANTIATE_GET_SET_ADD(uint64_t, stat_eviction)
-        INSTANTIATE_GET_SET_ADD(uint64_t, stat_writeback)
-
-        INSTANTIATE_GET_SET_ADD(uint64_t, stat_final_eviction)
-        INSTANTIATE_GET_SET_ADD(uint64_t, stat_final_writeback)
-
-        INSTANTIATE_GET_SET_ADD(uint64_t, stat_instruction_hit)
-        INSTANTIATE_GET_SET_ADD(uint64_t, stat_read_hit)
-        INSTANTIATE_GET_SET_ADD(uint64_t, stat_prefetch_hit)
-        INSTANTIATE_GET_SET_ADD(uint64_t, stat_write_hit)
-        INSTANTIATE_GET_SET_ADD(uint64_t, stat_writeback_recv)
-
-        INSTANTIATE_GET_SET_ADD(uint64_t, stat_instruction_miss)
-        INSTANTIATE_GET_SET_ADD(uint64_t, stat_read_miss)
-        INSTANTIATE_GET_SET_ADD(uint64_t, stat_prefetch_miss)
-        INSTANTIATE_GET_SET_ADD(uint64_t, stat_write_miss)
-        INSTANTIATE_GET_SET_ADD(uint64_t, stat_writeback_send)
-
-        INSTANTIATE_GET_SET_ADD(uint64_t, stat_full_mshr_request_buffer);
-        INSTANTIATE_GET_SET_ADD(uint64_t, stat_full_mshr_prefetch_buffer);
-        INSTANTIATE_GET_SET_ADD(uint64_t, stat_full_mshr_write_buffer);
-        INSTANTIATE_GET_SET_ADD(uint64_t, stat_full_mshr_eviction_buffer);
-
-
-
-        inline void add_stat_instruction_wait(uint64_t born_cycle) {
-            uint64_t new_time = (sinuca_engine.get_global_cycle() - born_cycle);
-            this->stat_accumulated_instruction_wait_time += new_time;
-            if (this->stat_min_instruction_wait_time > new_time) this->stat_min_instruction_wait_time = new_time;
-            if (this->stat_max_instruction_wait_time < new_time) this->stat_max_instruction_wait_time = new_time;
-        };
-
-        inline void add_stat_read_wait(uint64_t born_cycle) {
-            uint64_t new_time = (sinuca_engine.get_global_cycle() - born_cycle);
-            this->stat_accumulated_read_wait_time += new_time;
-            if (this->stat_min_read_wait_time > new_time) this->stat_min_read_wait_time = new_time;
-            if (this->stat_max_read_wait_time < new_time) this->stat_max_read_wait_time = new_time;
-        };
-
-        inline void add_stat_prefetch_wait(uint64_t born_cycle) {
-            uint64_t new_time = (sinuca_engine.get_global_cycle() - born_cycle);
-            this->stat_accumulated_prefetch_wait_time += new_time;
-            if (this->stat_min_prefetch_wait_time > new_time) this->stat_min_prefetch_wait_time = new_time;
-            if (this->stat_max_prefetch_wait_time < new_time) this->stat_max_prefetch_wait_time = new_time;
-        };
-
-        inline void add_stat_write_wait(uint64_t born_cycle) {
-            uint64_t new_time = (sinuca_engine.get_global_cycle() - born_cycle);
-            this->stat_accumulated_write_wait_time += new_time;
-            if (this->stat_min_write_wait_time > new_time) this->stat_min_write_wait_time = new_time;
-            if (this->stat_max_write_wait_time < new_time) this->stat_max_write_wait_time = new_time;
-        };
-
-        inline void add_stat_writeback_wait(uint64_t born_cycle) {
-            uint64_t new_time = (sinuca_engine.get_global_cycle() - born_cycle);
-            this->stat_accumulated_writeback_wait_time += new_time;
-            if (this->stat_min_writeback_wait_time > new_time) this->stat_min_writeback_wait_time = new_time;
-            if (this->stat_max_writeback_wait_time < new_time) this->stat_max_writeback_wait_time = new_time;
-        };
-
-        // HMC
-        inline void add_stat_hmc_wait(uint64_t born_cycle) {
-            uint64_t new_time = (sinuca_engine.get_global_cycle() - born_cycle);
-            this->stat_accumulated_hmc_wait_time += new_time;
-            if (this->stat_min_hmc_wait_time > new_time) this->stat_min_hmc_wait_time = new_time;
-            if (this->stat_max_hmc_wait_time < new_time) this->stat_max_hmc_wait_time = new_time;
-        };
-
-
+        CACHE_MEMORY_STATISTICS(STATISTICS_COUNTER_METHODS, STATISTICS_LATENCY_METHODS)
 };
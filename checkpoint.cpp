@@ -0,0 +1,95 @@
+/*
+ * Copyright (C) 2010~2014  Marco Antonio Zanata Alves
+ *                          (mazalves at inf.ufrgs.br)
+ *                          GPPD - Parallel and Distributed Processing Group
+ *                          Universidade Federal do Rio Grande do Sul
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "./sinuca.hpp"
+
+// =============================================================================
+checkpoint_t::checkpoint_t() {
+    this->file_name[0] = '\0';
+    this->section_label[0] = '\0';
+    this->file = NULL;
+    this->is_restore = false;
+    this->is_warm = false;
+};
+
+// =============================================================================
+checkpoint_t::~checkpoint_t() {
+    this->close();
+};
+
+// =============================================================================
+void checkpoint_t::open(const char *in_file_name, bool restore, bool warm) {
+    snprintf(this->file_name, sizeof(this->file_name), "%s", in_file_name);
+    this->is_restore = restore;
+    this->is_warm = warm;
+
+    this->file = gzopen(this->file_name, restore ? "rb" : "wb");
+    ERROR_ASSERT_PRINTF(this->file != NULL, "Could not open the checkpoint.\n%s\n", this->file_name);
+
+    uint32_t version = CHECKPOINT_VERSION;
+    this->section(warm ? CHECKPOINT_WARM_MAGIC : CHECKPOINT_MAGIC);
+    this->value(version);
+    ERROR_ASSERT_PRINTF(version == CHECKPOINT_VERSION, "Checkpoint version %u, expected %u.\n%s\n", version, CHECKPOINT_VERSION, this->file_name);
+};
+
+// =============================================================================
+void checkpoint_t::close() {
+    if (this->file != NULL) {
+        ERROR_ASSERT_PRINTF(gzclose(this->file) == Z_OK, "Could not close the checkpoint.\n%s\n", this->file_name);
+        this->file = NULL;
+    }
+};
+
+// =============================================================================
+void checkpoint_t::raw(void *data, uint64_t size) {
+    char *bytes = static_cast<char*>(data);
+
+    while (size > 0) {
+        uint32_t block = size > CHECKPOINT_BLOCK_SIZE ? CHECKPOINT_BLOCK_SIZE : size;
+        int done = this->is_restore ? gzread(this->file, bytes, block) : gzwrite(this->file, bytes, block);
+        ERROR_ASSERT_PRINTF(done == (int)block, "Checkpoint %s could not be %s at %s.\n",
+                            this->file_name, this->is_restore ? "read" : "written", this->section_label);
+        bytes += block;
+        size -= block;
+    }
+};
+
+// =============================================================================
+/// Each component starts with its label, a different component order fails here
+void checkpoint_t::section(const char *label) {
+    char buffer[CHECKPOINT_LABEL_SIZE];
+
+    memset(buffer, 0, sizeof(buffer));
+    snprintf(buffer, sizeof(buffer), "%s", label);
+    this->raw(buffer, sizeof(buffer));
+    buffer[sizeof(buffer) - 1] = '\0';
+
+    ERROR_ASSERT_PRINTF(strcmp(buffer, label) == 0, "Checkpoint %s has %s where %s was expected.\n", this->file_name, buffer, label);
+    snprintf(this->section_label, sizeof(this->section_label), "%s", label);
+};
+
+// =============================================================================
+void checkpoint_t::check_size(uint64_t size) {
+    uint64_t saved_size = size;
+
+    this->value(saved_size);
+    ERROR_ASSERT_PRINTF(saved_size == size, "Checkpoint %s has %" PRIu64 " entries at %s, the configuration has %" PRIu64 ".\n",
+                        this->file_name, saved_size, this->section_label, size);
+};
@@ -0,0 +1,82 @@
+/*
+ * Copyright (C) 2010~2014  Marco Antonio Zanata Alves
+ *                          (mazalves at inf.ufrgs.br)
+ *                          GPPD - Parallel and Distributed Processing Group
+ *                          Universidade Federal do Rio Grande do Sul
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/// Checkpoint
+// ============================================================================
+ /*! Saves or restores the simulator state with one gzip file.
+  * Each component has one checkpoint() method listing its state with
+  * value() and array(), the same method saves and restores it.
+  * The array sizes are stored and checked on restore, so a checkpoint
+  * is only restored with the same structures (sets, ways, tables),
+  * latencies and policies may change.
+  * The warm images (is_warm) keep only the learning state: cache contents,
+  * predictor and prefetcher tables and the trace position, without timing
+  * or statistics, so they can be loaded by runs with different latencies.
+  */
+#ifndef _SINUCA_CHECKPOINT_HPP_
+#define _SINUCA_CHECKPOINT_HPP_
+
+#define CHECKPOINT_MAGIC "SiNUCA Checkpoint"
+#define CHECKPOINT_WARM_MAGIC "SiNUCA Warm Image"
+#define CHECKPOINT_VERSION 4
+#define CHECKPOINT_LABEL_SIZE 500       /// Same as interconnection_interface_t labels
+#define CHECKPOINT_BLOCK_SIZE 1048576   /// Bytes given to zlib at once
+
+class checkpoint_t {
+    private:
+        char file_name[TRACE_FILE_NAME_SIZE];
+        char section_label[CHECKPOINT_LABEL_SIZE];     /// Last section, used by the error messages
+        gzFile file;
+        bool is_restore;
+        bool is_warm;
+
+    public:
+        // ====================================================================
+        /// Methods
+        // ====================================================================
+        checkpoint_t();
+        ~checkpoint_t();
+        inline const char* get_label() {
+            return "CHECKPOINT";
+        };
+
+        void open(const char *in_file_name, bool restore, bool warm);
+        void close();
+
+        void raw(void *data, uint64_t size);
+        void section(const char *label);
+        void check_size(uint64_t size);
+
+        template <class TYPE>
+        inline void value(TYPE &variable) {
+            this->raw(&variable, sizeof(TYPE));
+        };
+
+        template <class TYPE>
+        inline void array(TYPE *variable, uint64_t size) {
+            this->check_size(size);
+            this->raw(variable, sizeof(TYPE) * size);
+        };
+
+        INSTANTIATE_GET_SET(bool, is_restore);
+        INSTANTIATE_GET_SET(bool, is_warm);
+};
+
+#endif  // _SINUCA_CHECKPOINT_HPP_
@@ -177,6 +177,7 @@ bool directory_controller_t::pop_token_credit(uint32_t src_id, memory_operation_
  *  the cache operations.
  */
 package_state_t directory_controller_t::treat_cache_request(uint32_t cache_id, memory_package_t *package) {
+    profile_scope_t profile(&this->profile_treat_request);
     DIRECTORY_CTRL_DEBUG_PRINTF("new_cache_request() cache_id:%u, package:%s\n", cache_id, package->content_to_string().c_str())
     ERROR_ASSERT_PRINTF(cache_id < sinuca_engine.get_cache_memory_array_size(), "Wrong cache_id.\n")
 
@@ -690,6 +691,7 @@ package_state_t directory_controller_t::treat_cache_request(uint32_t cache_id, m
 
 // ============================================================================
 package_state_t directory_controller_t::treat_cache_answer(uint32_t cache_id, memory_package_t *package) {
+    profile_scope_t profile(&this->profile_treat_answer);
     DIRECTORY_CTRL_DEBUG_PRINTF("new_cache_request() cache_id:%u, package:%s\n", cache_id, package->content_to_string().c_str())
     ERROR_ASSERT_PRINTF(cache_id < sinuca_engine.get_cache_memory_array_size(), "Wrong cache_id.\n")
 
@@ -879,6 +881,7 @@ package_state_t directory_controller_t::treat_cache_answer(uint32_t cache_id, me
 
 // ============================================================================
 package_state_t directory_controller_t::treat_cache_request_sent(uint32_t cache_id, memory_package_t *package) {
+    profile_scope_t profile(&this->profile_treat_request_sent);
     DIRECTORY_CTRL_DEBUG_PRINTF("new_cache_request() cache_id:%u, package:%s\n", cache_id, package->content_to_string().c_str())
     ERROR_ASSERT_PRINTF(cache_id < sinuca_engine.get_cache_memory_array_size(), "Wrong cache_id.\n")
 
@@ -1565,6 +1568,125 @@ bool directory_controller_t::is_locked(uint64_t memory_address) {
 };
 
 
+// ============================================================================
+/// Functional warm-up: one request from the processor side (or from the higher
+/// level) updates the tags, replacement and coherence status of the hierarchy
+/// at once, with the same transitions of treat_cache_request/answer.
+/// The prefetcher is trained as in cache_memory_t::receive_package.
+void directory_controller_t::functional_access(cache_memory_t *cache, uint64_t opcode_address, uint64_t memory_address, memory_operation_t memory_operation) {
+    memory_package_t package;
+    package.packager(
+                    cache->get_id(),                        /// Request Owner
+                    0,                                      /// Opcode. Number
+                    opcode_address,                         /// Opcode. Address
+                    0,                                      /// Uop. Number
+
+                    memory_address,                         /// Mem. Address
+                    sinuca_engine.get_global_line_size(),   /// Block Size
+
+                    PACKAGE_STATE_UNTREATED,                /// Pack. State
+                    0,                                      /// Ready Cycle
+
+                    memory_operation,                       /// Mem. Operation
+                    false,                                  /// Is Answer
+
+                    cache->get_id(),                        /// Src ID
+                    cache->get_id(),                        /// Dst ID
+                    NULL,                                   /// *Hops
+                    0);                                     /// Hop Counter
+
+    cache->prefetcher->treat_prefetch(&package);
+    this->functional_request(cache, &package);
+    cache->functional_prefetch();
+};
+
+// ============================================================================
+void directory_controller_t::functional_request(cache_memory_t *cache, memory_package_t *package) {
+    uint32_t index, way;
+    cache_line_t *cache_line = cache->find_line(package->memory_address, index, way);
+
+    /// Miss => Make room and fill from the higher levels or the next level
+    if (cache_line == NULL || !this->coherence_is_hit(cache_line->status)) {
+        if (cache_line == NULL) {
+            cache_line = cache->evict_address(package->memory_address, index, way);
+            ERROR_ASSERT_PRINTF(cache_line != NULL, "Functional warm-up could not evict a line.\n")
+            this->functional_eviction(cache, cache_line);
+        }
+        cache->change_address(cache_line, package->memory_address);
+        cache->change_status(cache_line, PROTOCOL_STATUS_I);
+
+        /// Check if some HIGHER LEVEL has the cache line
+        uint32_t sum_latency = 0;
+        cache->change_status(cache_line, this->find_cache_line_higher_levels(&sum_latency, cache, package->memory_address, true));
+
+        if (!this->coherence_is_hit(cache_line->status)) {
+            container_ptr_cache_memory_t *lower_level_cache = cache->get_lower_level_cache();
+            for (uint32_t i = 0; i < lower_level_cache->size(); i++) {
+                cache_memory_t *lower_cache = lower_level_cache[0][i];
+                if (lower_cache->get_bank(package->memory_address) == lower_cache->get_bank_number()) {
+                    /// Send Request to fill the cache line
+                    this->functional_access(lower_cache, package->opcode_address, package->memory_address,
+                                            package->memory_operation == MEMORY_OPERATION_WRITE ? MEMORY_OPERATION_READ : package->memory_operation);
+                    break;
+                }
+            }
+        }
+    }
+
+    /// Update Coherence Status and Last Access Time
+    this->coherence_new_operation(cache, cache_line, package, true);
+};
+
+// ============================================================================
+/// Same decisions of inclusiveness_new_eviction, the write-back is installed
+/// directly on the next level
+void directory_controller_t::functional_eviction(cache_memory_t *cache, cache_line_t *cache_line) {
+    container_ptr_cache_memory_t *lower_level_cache = cache->get_lower_level_cache();
+    bool is_inclusive = (this->inclusiveness_type == INCLUSIVENESS_INCLUSIVE_ALL ||
+                        (this->inclusiveness_type == INCLUSIVENESS_INCLUSIVE_LLC && lower_level_cache->empty()));
+
+    /// Check if some HIGHER LEVEL has the cache line Modified
+    if (!coherence_need_writeback(cache, cache_line) && is_inclusive) {
+        uint32_t sum_latency = 0;
+        cache->change_status(cache_line, this->find_cache_line_higher_levels(&sum_latency, cache, cache_line->tag, false));
+    }
+
+    if (coherence_need_writeback(cache, cache_line)) {
+        this->functional_writeback(cache, cache_line->tag);
+    }
+
+    /// Invalidate higher levels to maintain INCLUSIVINESS
+    if (is_inclusive) {
+        this->coherence_evict_higher_levels(cache, cache_line->tag);
+    }
+};
+
+// ============================================================================
+void directory_controller_t::functional_writeback(cache_memory_t *cache, uint64_t memory_address) {
+    container_ptr_cache_memory_t *lower_level_cache = cache->get_lower_level_cache();
+
+    /// LLC => Main memory, nothing to keep
+    for (uint32_t i = 0; i < lower_level_cache->size(); i++) {
+        cache_memory_t *lower_cache = lower_level_cache[0][i];
+        if (lower_cache->get_bank(memory_address) != lower_cache->get_bank_number()) {
+            continue;
+        }
+
+        uint32_t index, way;
+        cache_line_t *cache_line = lower_cache->find_line(memory_address, index, way);
+        if (cache_line == NULL) {
+            cache_line = lower_cache->evict_address(memory_address, index, way);
+            ERROR_ASSERT_PRINTF(cache_line != NULL, "Functional warm-up could not evict a line.\n")
+            this->functional_eviction(lower_cache, cache_line);
+        }
+        /// Received a Copy-back
+        lower_cache->change_address(cache_line, memory_address);
+        lower_cache->change_status(cache_line, PROTOCOL_STATUS_O);
+        lower_cache->update_last_access(cache_line);
+        break;
+    }
+};
+
 // ============================================================================
 void directory_controller_t::new_statistics(cache_memory_t *cache, memory_operation_t memory_operation, bool is_hit) {
 
@@ -1726,3 +1848,52 @@ void directory_controller_t::print_configuration() {
     sinuca_engine.write_statistics_value(get_type_component_label(), get_label(), "generate_llc_writeback", generate_llc_writeback);
     sinuca_engine.write_statistics_value(get_type_component_label(), get_label(), "not_offset_bits_mask", utils_t::address_to_binary(this->not_offset_bits_mask).c_str());
 };
+
+// ============================================================================
+void directory_controller_t::checkpoint(checkpoint_t *checkpoint) {
+    ERROR_ASSERT_PRINTF(checkpoint->get_is_restore() || this->directory_lines.empty(), "Checkpoint with lines inside the directory.\n")
+    checkpoint->section(this->get_label());
+
+    /// The warm images do not keep the memory mapping
+    if (checkpoint->get_is_warm()) {
+        return;
+    }
+
+    /// Pages already mapped to one memory controller
+    uint64_t mapped_size = this->mapped_controller.size();
+    checkpoint->value(mapped_size);
+    if (checkpoint->get_is_restore()) {
+        this->mapped_controller.clear();
+        for (uint64_t i = 0; i < mapped_size; i++) {
+            uint64_t page;
+            uint32_t controller;
+            checkpoint->value(page);
+            checkpoint->value(controller);
+            this->mapped_controller[page] = controller;
+        }
+    }
+    else {
+        for (std::unordered_map<uint64_t, uint32_t>::iterator it = this->mapped_controller.begin(); it != this->mapped_controller.end(); it++) {
+            uint64_t page = it->first;
+            uint32_t controller = it->second;
+            checkpoint->value(page);
+            checkpoint->value(controller);
+        }
+    }
+
+    /// Statistics, not kept by the warm images
+    if (!checkpoint->get_is_warm()) {
+        checkpoint->value(this->stat_instruction_hit);
+        checkpoint->value(this->stat_read_hit);
+        checkpoint->value(this->stat_prefetch_hit);
+        checkpoint->value(this->stat_write_hit);
+        checkpoint->value(this->stat_writeback_recv);
+        checkpoint->value(this->stat_instruction_miss);
+        checkpoint->value(this->stat_read_miss);
+        checkpoint->value(this->stat_prefetch_miss);
+        checkpoint->value(this->stat_write_miss);
+        checkpoint->value(this->stat_writeback_send);
+        checkpoint->value(this->stat_cache_to_cache);
+        checkpoint->value(this->stat_final_writeback_all_cycles);
+    }
+};
@@ -62,6 +62,11 @@ class directory_controller_t : public interconnection_interface_t {
         uint64_t stat_final_writeback_all_cycles;
 
     public:
+        /// Host time profiling (-profile)
+        profile_counter_t profile_treat_request;
+        profile_counter_t profile_treat_answer;
+        profile_counter_t profile_treat_request_sent;
+
         // ====================================================================
         /// Methods
         // ====================================================================
@@ -93,6 +98,9 @@ class directory_controller_t : public interconnection_interface_t {
         void reset_statistics();
         void print_statistics();
         void print_configuration();
+
+        /// Checkpoint Methods
+        void checkpoint(checkpoint_t *checkpoint);
         // ====================================================================
 
         int32_t find_directory_line(memory_package_t *package);
@@ -124,6 +132,12 @@ class directory_controller_t : public interconnection_interface_t {
         void coherence_new_operation(cache_memory_t *cache_memory, cache_line_t *cache_line,  memory_package_t *package, bool is_hit);
         bool inclusiveness_new_eviction(cache_memory_t *cache, cache_line_t *cache_line, uint32_t index, uint32_t way, memory_package_t *package);
 
+        /// Functional warm-up (no timing, MSHR or directory lines)
+        void functional_access(cache_memory_t *cache, uint64_t opcode_address, uint64_t memory_address, memory_operation_t memory_operation);
+        void functional_request(cache_memory_t *cache, memory_package_t *package);
+        void functional_eviction(cache_memory_t *cache, cache_line_t *cache_line);
+        void functional_writeback(cache_memory_t *cache, uint64_t memory_address);
+
         inline bool cmp_index_tag(uint64_t memory_addressA, uint64_t memory_addressB) {
             return (memory_addressA & not_offset_bits_mask) == (memory_addressB & not_offset_bits_mask);
         };
@@ -185,6 +185,24 @@ const char *get_enum_processor_stage_char(processor_stage_t type) {
     return "FAIL";
 };
 
+// ============================================================================
+/// Enumerates the functional unit classes, each one with its own units and dispatch queue
+const char *get_enum_functional_unit_char(functional_unit_t type) {
+    switch (type) {
+        case FUNCTIONAL_UNIT_INT_ALU:   return "INT_ALU"; break;
+        case FUNCTIONAL_UNIT_INT_MUL:   return "INT_MUL"; break;
+        case FUNCTIONAL_UNIT_INT_DIV:   return "INT_DIV"; break;
+        case FUNCTIONAL_UNIT_FP_ALU:    return "FP_ALU"; break;
+        case FUNCTIONAL_UNIT_FP_MUL:    return "FP_MUL"; break;
+        case FUNCTIONAL_UNIT_FP_DIV:    return "FP_DIV"; break;
+        case FUNCTIONAL_UNIT_MEM_LOAD:  return "MEM_LOAD"; break;
+        case FUNCTIONAL_UNIT_MEM_STORE: return "MEM_STORE"; break;
+        case FUNCTIONAL_UNIT_NUMBER:    break;
+    };
+    ERROR_PRINTF("Wrong FUNCTIONAL_UNIT\n");
+    return "FAIL";
+};
+
 // ============================================================================
 /// Enumerates the synchronization type required by the dynamic trace.
 const char *get_enum_sync_char(sync_t type) {
@@ -433,3 +451,26 @@ const char *get_enum_line_prediction_t_char(line_prediction_t type) {
     ERROR_PRINTF("Wrong LINE_PREDICTION\n");
     return "FAIL";
 };
+
+// ============================================================================
+/// Enumerates the trace file formats
+const char *get_enum_trace_format_char(trace_format_t type) {
+    switch (type) {
+        case TRACE_FORMAT_TEXT:         return "TEXT";      break;
+        case TRACE_FORMAT_BINARY:       return "BINARY";    break;
+    };
+    ERROR_PRINTF("Wrong TRACE_FORMAT\n");
+    return "FAIL";
+};
+
+// ============================================================================
+/// Enumerates the result file formats
+const char *get_enum_statistics_format_char(statistics_format_t type) {
+    switch (type) {
+        case STATISTICS_FORMAT_TEXT:    return "TEXT";      break;
+        case STATISTICS_FORMAT_JSON:    return "JSON";      break;
+        case STATISTICS_FORMAT_BINARY:  return "BINARY";    break;
+    };
+    ERROR_PRINTF("Wrong STATISTICS_FORMAT\n");
+    return "FAIL";
+};
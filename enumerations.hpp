@@ -153,6 +153,21 @@ enum processor_stage_t {
 };
 const char *get_enum_processor_stage_char(processor_stage_t type);
 
+// ============================================================================
+/// Enumerates the functional unit classes, each one with its own units and dispatch queue
+enum functional_unit_t {
+    FUNCTIONAL_UNIT_INT_ALU,
+    FUNCTIONAL_UNIT_INT_MUL,
+    FUNCTIONAL_UNIT_INT_DIV,
+    FUNCTIONAL_UNIT_FP_ALU,
+    FUNCTIONAL_UNIT_FP_MUL,
+    FUNCTIONAL_UNIT_FP_DIV,
+    FUNCTIONAL_UNIT_MEM_LOAD,
+    FUNCTIONAL_UNIT_MEM_STORE,
+    FUNCTIONAL_UNIT_NUMBER
+};
+const char *get_enum_functional_unit_char(functional_unit_t type);
+
 // ============================================================================
 /// Enumerates the synchronization type required by the dynamic trace.
 enum sync_t {
@@ -342,5 +357,22 @@ enum line_prediction_t {
 };
 const char *get_enum_line_prediction_t_char(line_prediction_t type);
 
+// ============================================================================
+/// Enumerates the trace file formats
+enum trace_format_t {
+    TRACE_FORMAT_TEXT,
+    TRACE_FORMAT_BINARY
+};
+const char *get_enum_trace_format_char(trace_format_t type);
+
+// ============================================================================
+/// Enumerates the result file formats
+enum statistics_format_t {
+    STATISTICS_FORMAT_TEXT,
+    STATISTICS_FORMAT_JSON,
+    STATISTICS_FORMAT_BINARY
+};
+const char *get_enum_statistics_format_char(statistics_format_t type);
+
 
 #endif  // _SINUCA_ENUMERATOR_HPP_
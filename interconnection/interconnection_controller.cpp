@@ -490,6 +490,12 @@ void interconnection_controller_t::print_configuration() {
     sinuca_engine.write_statistics_big_separator();
 };
 
+// ============================================================================
+/// The routing tables are rebuilt from the configuration at start-up.
+void interconnection_controller_t::checkpoint(checkpoint_t *checkpoint) {
+    checkpoint->section(this->get_label());
+};
+
 // ============================================================================
 void interconnection_controller_t::print_graph() {
     char graph_line[100] = "";
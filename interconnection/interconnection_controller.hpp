@@ -70,6 +70,9 @@ class interconnection_controller_t : public interconnection_interface_t {
         void reset_statistics();
         void print_statistics();
         void print_configuration();
+
+        /// Checkpoint Methods
+        void checkpoint(checkpoint_t *checkpoint);
         // ====================================================================
         void print_graph();
 
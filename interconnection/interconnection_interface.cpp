@@ -90,3 +90,35 @@ int32_t interconnection_interface_t::find_port_from_obj(interconnection_interfac
     }
     return POSITION_FAIL;
 };
+
+// =============================================================================
+/// Components which do not hold packages (directory and interconnection controllers).
+bool interconnection_interface_t::is_drained() {
+    return true;
+};
+
+// =============================================================================
+/// Components which do not know their next event are clocked every cycle.
+uint64_t interconnection_interface_t::get_next_event_cycle() {
+    return sinuca_engine.get_global_cycle();
+};
+
+// =============================================================================
+void interconnection_interface_t::skip_cycles(uint64_t cycles) {
+    (void) cycles;
+};
+
+// =============================================================================
+/// Components which do not report their tokens make the sender retry every cycle.
+bool interconnection_interface_t::check_token_credit(uint32_t src_id, memory_operation_t memory_operation) {
+    (void) src_id;
+    (void) memory_operation;
+    return OK;
+};
+
+// =============================================================================
+void interconnection_interface_t::skip_token_credit(uint32_t src_id, memory_operation_t memory_operation, uint64_t cycles) {
+    (void) src_id;
+    (void) memory_operation;
+    (void) cycles;
+};
@@ -46,6 +46,12 @@ class interconnection_interface_t {
         uint32_t *ports_output_components;
 
     public:
+        // ====================================================================
+        /// Host time profiling (-profile)
+        // ====================================================================
+        profile_counter_t profile_clock;
+        profile_counter_t profile_receive;
+
         // ====================================================================
         /// Methods
         // ====================================================================
@@ -92,6 +98,7 @@ class interconnection_interface_t {
         virtual void clock(uint32_t sub_cycle) = 0;   /// Called every cycle
         virtual int32_t send_package(memory_package_t *package) = 0;    /// Find the route between Sender and Receiver and return -1 (fail) or lantency (sent)
         virtual bool receive_package(memory_package_t *package, uint32_t input_port, uint32_t transmission_latency) = 0; /// Only Sender calculate the latency and pass to the receiver.
+        virtual bool is_drained();    /// No package inside, the clock would do nothing
 
         /// Token Controller Methods
         virtual bool pop_token_credit(uint32_t src_id, memory_operation_t memory_operation) = 0;       /// Check for available position to receive a package and allocate a token
@@ -105,4 +112,13 @@ class interconnection_interface_t {
         virtual void reset_statistics()=0;      /// Reset all internal statistics variables
         virtual void print_statistics()=0;      /// Print out the internal statistics variables
         virtual void print_configuration()=0;   /// Print out the internal configuration variables
+
+        /// Checkpoint Methods
+        virtual void checkpoint(checkpoint_t *checkpoint)=0;   /// Save or restore the internal state
+
+        /// Idle-Cycle Skipping Methods
+        virtual uint64_t get_next_event_cycle();    /// First cycle the component may change its state (without receiving packages)
+        virtual void skip_cycles(uint64_t cycles);  /// Account the per-cycle statistics of the cycles jumped over
+        virtual bool check_token_credit(uint32_t src_id, memory_operation_t memory_operation);    /// Check for an available token without allocating it
+        virtual void skip_token_credit(uint32_t src_id, memory_operation_t memory_operation, uint64_t cycles);    /// Account the failed token pops of the cycles jumped over
 };
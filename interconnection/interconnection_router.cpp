@@ -155,6 +155,7 @@ int32_t interconnection_router_t::send_package(memory_package_t *package) {
 
 // ============================================================================
 bool interconnection_router_t::receive_package(memory_package_t *package, uint32_t input_port, uint32_t transmission_latency) {
+    profile_scope_t profile(&this->profile_receive);
 
     if (this->recv_ready_cycle[input_port] <= sinuca_engine.get_global_cycle()) {
         ERROR_ASSERT_PRINTF(input_port < this->get_max_ports(), "Input Port does not exist on this Router !\n");
@@ -167,6 +168,7 @@ bool interconnection_router_t::receive_package(memory_package_t *package, uint32
             ROUTER_DEBUG_PRINTF("\tRECV DATA OK\n");
             this->input_buffer[input_port].back()->package_untreated(1);
             this->packages_inside_router++;
+            sinuca_engine.wake_component(this->get_id());
 
             this->recv_ready_cycle[input_port] = sinuca_engine.get_global_cycle() + transmission_latency;
 
@@ -232,6 +234,15 @@ uint32_t interconnection_router_t::selection_buffer_level(){
     return this->last_selected;
 };
 
+// ============================================================================
+/// After the send latency the port selection changes every cycle.
+uint64_t interconnection_router_t::get_next_event_cycle() {
+    if (this->packages_inside_router == 0) {
+        return std::numeric_limits<uint64_t>::max();
+    }
+    return std::max(this->send_ready_cycle, sinuca_engine.get_global_cycle());
+};
+
 // ============================================================================
 void interconnection_router_t::print_structures() {
     for (uint32_t i = 0; i < this->get_max_ports(); i++) {
@@ -328,3 +339,28 @@ void interconnection_router_t::print_configuration() {
     sinuca_engine.write_statistics_value(get_type_component_label(), get_label(), "input_buffer_size", input_buffer_size);
     sinuca_engine.write_statistics_value(get_type_component_label(), get_label(), "selection_policy", get_enum_selection_char(selection_policy));
 };
+
+// ============================================================================
+void interconnection_router_t::checkpoint(checkpoint_t *checkpoint) {
+    ERROR_ASSERT_PRINTF(checkpoint->get_is_restore() || this->is_drained(), "Checkpoint with packages inside the router.\n")
+    checkpoint->section(this->get_label());
+
+    /// The warm images keep only the learning state
+    if (checkpoint->get_is_warm()) {
+        return;
+    }
+
+    checkpoint->value(this->send_ready_cycle);
+    checkpoint->array(this->recv_ready_cycle, this->get_max_ports());
+    checkpoint->value(this->last_selected);
+
+    /// Statistics, not kept by the warm images
+    if (!checkpoint->get_is_warm()) {
+        checkpoint->value(this->stat_transmissions);
+        checkpoint->value(this->stat_total_send_size);
+        checkpoint->value(this->stat_total_recv_size);
+        checkpoint->value(this->stat_total_send_flits);
+        checkpoint->value(this->stat_total_recv_flits);
+        checkpoint->array(this->stat_transmitted_package_size, sinuca_engine.get_global_line_size() + 1);
+    }
+};
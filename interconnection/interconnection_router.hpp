@@ -79,6 +79,12 @@ class interconnection_router_t : public interconnection_interface_t {
         void reset_statistics();
         void print_statistics();
         void print_configuration();
+
+        /// Checkpoint Methods
+        void checkpoint(checkpoint_t *checkpoint);
+
+        /// Idle-Cycle Skipping Methods
+        uint64_t get_next_event_cycle();
         // ====================================================================
 
         /// Selection strategies
@@ -86,6 +92,10 @@ class interconnection_router_t : public interconnection_interface_t {
         uint32_t selection_round_robin();
         uint32_t selection_buffer_level();
 
+        inline bool is_drained() {
+            return this->packages_inside_router == 0;
+        };
+
 
         INSTANTIATE_GET_SET(selection_t, selection_policy)
         INSTANTIATE_GET_SET(uint32_t, send_ready_cycle)
@@ -108,3 +108,8 @@ void line_usage_predictor_t::print_configuration() {
 
     sinuca_engine.write_statistics_value(get_type_component_label(), get_label(), "line_usage_predictor_type", get_enum_line_usage_predictor_policy_char(line_usage_predictor_type));
 };
+
+// ============================================================================
+void line_usage_predictor_t::checkpoint(checkpoint_t *checkpoint) {
+    checkpoint->section(this->get_label());
+};
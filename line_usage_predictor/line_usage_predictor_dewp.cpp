@@ -1027,3 +1027,87 @@ void line_usage_predictor_dewp_t::print_configuration() {
     sinuca_engine.write_statistics_value(get_type_component_label(), get_label(), "aht_total_sets", aht_total_sets);
     sinuca_engine.write_statistics_value(get_type_component_label(), get_label(), "aht_replacement_policy", get_enum_replacement_char(aht_replacement_policy));
 };
+
+// ============================================================================
+void line_usage_predictor_dewp_t::checkpoint(checkpoint_t *checkpoint) {
+    line_usage_predictor_t::checkpoint(checkpoint);
+
+    checkpoint->check_size(this->get_metadata_total_sets());
+    for (uint32_t i = 0; i < this->get_metadata_total_sets(); i++) {
+        checkpoint->array(this->metadata_sets[i].ways, this->get_metadata_associativity());
+    }
+
+    checkpoint->check_size(this->get_aht_total_sets());
+    for (uint32_t i = 0; i < this->get_aht_total_sets(); i++) {
+        checkpoint->array(this->aht_sets[i].ways, this->get_aht_associativity());
+    }
+
+    /// The aht_pointer is saved as the AHT line index (set * associativity + way)
+    for (uint32_t i = 0; i < this->get_metadata_total_sets(); i++) {
+        for (uint32_t j = 0; j < this->get_metadata_associativity(); j++) {
+            int64_t aht_index = POSITION_FAIL;
+            if (!checkpoint->get_is_restore() && this->metadata_sets[i].ways[j].aht_pointer != NULL) {
+                for (uint32_t set = 0; set < this->get_aht_total_sets(); set++) {
+                    aht_line_t *ways = this->aht_sets[set].ways;
+                    if (this->metadata_sets[i].ways[j].aht_pointer >= ways &&
+                    this->metadata_sets[i].ways[j].aht_pointer < ways + this->get_aht_associativity()) {
+                        aht_index = (int64_t)set * this->get_aht_associativity() + (this->metadata_sets[i].ways[j].aht_pointer - ways);
+                        break;
+                    }
+                }
+                ERROR_ASSERT_PRINTF(aht_index != POSITION_FAIL, "Metadata line pointing outside the AHT.\n")
+            }
+            checkpoint->value(aht_index);
+
+            if (checkpoint->get_is_restore()) {
+                if (aht_index == POSITION_FAIL) {
+                    this->metadata_sets[i].ways[j].aht_pointer = NULL;
+                }
+                else {
+                    this->metadata_sets[i].ways[j].aht_pointer = &this->aht_sets[aht_index / this->get_aht_associativity()].ways[aht_index % this->get_aht_associativity()];
+                }
+            }
+        }
+    }
+
+    /// Statistics, not kept by the warm images
+    if (!checkpoint->get_is_warm()) {
+        checkpoint->value(this->stat_line_hit);
+        checkpoint->value(this->stat_line_miss);
+        checkpoint->value(this->stat_sub_block_miss);
+        checkpoint->value(this->stat_send_writeback);
+        checkpoint->value(this->stat_recv_writeback);
+        checkpoint->value(this->stat_eviction);
+        checkpoint->value(this->stat_invalidation);
+        checkpoint->value(this->stat_aht_access);
+        checkpoint->value(this->stat_aht_hit);
+        checkpoint->value(this->stat_aht_miss);
+        checkpoint->value(this->stat_dead_read_learn);
+        checkpoint->value(this->stat_dead_read_normal_over);
+        checkpoint->value(this->stat_dead_read_normal_correct);
+        checkpoint->value(this->stat_dead_read_disable_correct);
+        checkpoint->value(this->stat_dead_read_disable_under);
+        checkpoint->value(this->stat_dead_writeback_learn);
+        checkpoint->value(this->stat_dead_writeback_notsent_over);
+        checkpoint->value(this->stat_dead_writeback_notsent_correct);
+        checkpoint->value(this->stat_dead_writeback_sent_correct);
+        checkpoint->value(this->stat_dead_writeback_sent_under);
+        checkpoint->value(this->stat_line_read_0);
+        checkpoint->value(this->stat_line_read_1);
+        checkpoint->value(this->stat_line_read_2_3);
+        checkpoint->value(this->stat_line_read_4_7);
+        checkpoint->value(this->stat_line_read_8_15);
+        checkpoint->value(this->stat_line_read_16_127);
+        checkpoint->value(this->stat_line_read_128_bigger);
+        checkpoint->value(this->stat_line_writeback_0);
+        checkpoint->value(this->stat_line_writeback_1);
+        checkpoint->value(this->stat_line_writeback_2_3);
+        checkpoint->value(this->stat_line_writeback_4_7);
+        checkpoint->value(this->stat_line_writeback_8_15);
+        checkpoint->value(this->stat_line_writeback_16_127);
+        checkpoint->value(this->stat_line_writeback_128_bigger);
+        checkpoint->value(this->stat_cycles_turned_on_whole_line);
+        checkpoint->value(this->stat_cycles_turned_off_whole_line);
+        checkpoint->value(this->stat_cycles_turned_off_whole_line_since_begin);
+    }
+};
@@ -458,3 +458,41 @@ void line_usage_predictor_dewp_oracle_t::print_configuration() {
     sinuca_engine.write_statistics_value(get_type_component_label(), get_label(), "metadata_total_sets", metadata_total_sets);
 };
 
+// ============================================================================
+void line_usage_predictor_dewp_oracle_t::checkpoint(checkpoint_t *checkpoint) {
+    line_usage_predictor_t::checkpoint(checkpoint);
+
+    checkpoint->check_size(this->get_metadata_total_sets());
+    for (uint32_t i = 0; i < this->get_metadata_total_sets(); i++) {
+        checkpoint->array(this->metadata_sets[i].ways, this->get_metadata_associativity());
+    }
+
+    /// Statistics, not kept by the warm images
+    if (!checkpoint->get_is_warm()) {
+        checkpoint->value(this->stat_line_hit);
+        checkpoint->value(this->stat_line_miss);
+        checkpoint->value(this->stat_sub_block_miss);
+        checkpoint->value(this->stat_send_writeback);
+        checkpoint->value(this->stat_recv_writeback);
+        checkpoint->value(this->stat_eviction);
+        checkpoint->value(this->stat_invalidation);
+        checkpoint->value(this->stat_line_read_0);
+        checkpoint->value(this->stat_line_read_1);
+        checkpoint->value(this->stat_line_read_2_3);
+        checkpoint->value(this->stat_line_read_4_7);
+        checkpoint->value(this->stat_line_read_8_15);
+        checkpoint->value(this->stat_line_read_16_127);
+        checkpoint->value(this->stat_line_read_128_bigger);
+        checkpoint->value(this->stat_line_writeback_0);
+        checkpoint->value(this->stat_line_writeback_1);
+        checkpoint->value(this->stat_line_writeback_2_3);
+        checkpoint->value(this->stat_line_writeback_4_7);
+        checkpoint->value(this->stat_line_writeback_8_15);
+        checkpoint->value(this->stat_line_writeback_16_127);
+        checkpoint->value(this->stat_line_writeback_128_bigger);
+        checkpoint->value(this->stat_cycles_turned_on_whole_line);
+        checkpoint->value(this->stat_cycles_turned_off_whole_line);
+        checkpoint->value(this->stat_cycles_turned_off_whole_line_since_begin);
+    }
+};
+
@@ -93,6 +93,9 @@ class line_usage_predictor_dewp_oracle_t : public line_usage_predictor_t {
         void reset_statistics();
         void print_statistics();
         void print_configuration();
+
+        /// Checkpoint Methods
+        void checkpoint(checkpoint_t *checkpoint);
         // ====================================================================
 
 
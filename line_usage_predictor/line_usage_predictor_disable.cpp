@@ -235,3 +235,19 @@ void line_usage_predictor_disable_t::print_configuration() {
     line_usage_predictor_t::print_configuration();
 };
 
+// ============================================================================
+void line_usage_predictor_disable_t::checkpoint(checkpoint_t *checkpoint) {
+    line_usage_predictor_t::checkpoint(checkpoint);
+
+    /// Statistics, not kept by the warm images
+    if (!checkpoint->get_is_warm()) {
+        checkpoint->value(this->stat_line_hit);
+        checkpoint->value(this->stat_line_miss);
+        checkpoint->value(this->stat_sub_block_miss);
+        checkpoint->value(this->stat_send_writeback);
+        checkpoint->value(this->stat_recv_writeback);
+        checkpoint->value(this->stat_eviction);
+        checkpoint->value(this->stat_invalidation);
+    }
+};
+
@@ -64,6 +64,9 @@ class line_usage_predictor_disable_t : public line_usage_predictor_t {
         void reset_statistics();
         void print_statistics();
         void print_configuration();
+
+        /// Checkpoint Methods
+        void checkpoint(checkpoint_t *checkpoint);
         // ====================================================================
 
 
@@ -127,6 +127,9 @@ class line_usage_predictor_skewed_t : public line_usage_predictor_t {
         void reset_statistics();
         void print_statistics();
         void print_configuration();
+
+        /// Checkpoint Methods
+        void checkpoint(checkpoint_t *checkpoint);
         // ====================================================================
 
 
@@ -677,6 +677,111 @@ bool memory_channel_t::pop_token_credit(uint32_t src_id, memory_operation_t memo
     return FAIL;
 };
 
+// ============================================================================
+/// First cycle in which the bank executes its next command, when selected.
+uint64_t memory_channel_t::get_bank_ready_cycle(uint32_t bank) {
+    /// The next package is selected (and the drain write updated) when the bank is selected
+    if (this->bank_buffer_actual_position[bank] == POSITION_FAIL) {
+        /// Only writes waiting for the buffer to fill up
+        if (!(this->bank_is_drain_write[bank] && this->bank_number_drain_write[bank] > 0) &&
+        this->write_priority_policy == WRITE_PRIORITY_DRAIN_WHEN_FULL &&
+        this->bank_buffer[bank].size() < this->bank_buffer_size &&
+        this->find_next_read_operation(bank) == POSITION_FAIL) {
+            return std::numeric_limits<uint64_t>::max();
+        }
+        return sinuca_engine.get_global_cycle();
+    }
+
+    memory_package_t *package = this->bank_buffer[bank][this->bank_buffer_actual_position[bank]];
+    switch(this->bank_last_command[bank]) {
+        case MEMORY_CONTROLLER_COMMAND_PRECHARGE:
+            return get_minimum_latency(bank, MEMORY_CONTROLLER_COMMAND_ROW_ACCESS);
+
+        case MEMORY_CONTROLLER_COMMAND_ROW_ACCESS:
+        case MEMORY_CONTROLLER_COMMAND_COLUMN_READ:
+        case MEMORY_CONTROLLER_COMMAND_COLUMN_WRITE:
+            if (this->bank_last_command[bank] != MEMORY_CONTROLLER_COMMAND_ROW_ACCESS &&
+            !cmp_row_bank_channel(this->bank_open_row_address[bank], package->memory_address)) {
+                return get_minimum_latency(bank, MEMORY_CONTROLLER_COMMAND_PRECHARGE);
+            }
+            switch (package->memory_operation) {
+                case MEMORY_OPERATION_HMC_ALU:
+                case MEMORY_OPERATION_HMC_ALUR:
+                    return std::max(get_minimum_latency(bank, MEMORY_CONTROLLER_COMMAND_COLUMN_READ),
+                                    get_minimum_latency(bank, MEMORY_CONTROLLER_COMMAND_COLUMN_WRITE));
+
+                case MEMORY_OPERATION_READ:
+                case MEMORY_OPERATION_INST:
+                case MEMORY_OPERATION_PREFETCH:
+                    return get_minimum_latency(bank, MEMORY_CONTROLLER_COMMAND_COLUMN_READ);
+
+                case MEMORY_OPERATION_WRITEBACK:
+                case MEMORY_OPERATION_WRITE:
+                    return get_minimum_latency(bank, MEMORY_CONTROLLER_COMMAND_COLUMN_WRITE);
+            }
+        break;
+
+        case MEMORY_CONTROLLER_COMMAND_NUMBER:
+        break;
+    }
+    return sinuca_engine.get_global_cycle();
+};
+
+// ============================================================================
+/// The round robin selects one non-empty bank per cycle, even when the
+/// bank cannot issue its command. So each bank acts on the first cycle,
+/// after its ready cycle, in which its turn comes.
+uint64_t memory_channel_t::get_next_event_cycle() {
+    if (this->packages_inside_channel == 0) {
+        return std::numeric_limits<uint64_t>::max();
+    }
+    if (this->get_bank_selection_policy() != SELECTION_ROUND_ROBIN) {
+        return sinuca_engine.get_global_cycle();
+    }
+
+    uint64_t cycle = sinuca_engine.get_global_cycle();
+    uint64_t next_cycle = std::numeric_limits<uint64_t>::max();
+
+    uint32_t banks_used = 0;
+    for (uint32_t i = 0; i < this->get_bank_per_channel(); i++) {
+        banks_used += !this->bank_buffer[i].empty();
+    }
+
+    uint32_t turn = 0;
+    for (uint32_t i = 1; i <= this->get_bank_per_channel(); i++) {
+        uint32_t bank = (this->last_bank_selected + i) % this->get_bank_per_channel();
+        if (this->bank_buffer[bank].empty()) {
+            continue;
+        }
+        uint64_t ready_cycle = this->get_bank_ready_cycle(bank);
+        if (ready_cycle != std::numeric_limits<uint64_t>::max()) {
+            uint64_t bank_cycle = cycle + turn;
+            if (bank_cycle < ready_cycle) {
+                bank_cycle += ((ready_cycle - bank_cycle + banks_used - 1) / banks_used) * banks_used;
+            }
+            next_cycle = std::min(next_cycle, bank_cycle);
+        }
+        turn++;
+    }
+    return next_cycle;
+};
+
+// ============================================================================
+void memory_channel_t::skip_cycles(uint64_t cycles) {
+    if (this->packages_inside_channel == 0) {
+        return;
+    }
+    ERROR_ASSERT_PRINTF(this->get_bank_selection_policy() == SELECTION_ROUND_ROBIN, "Skipping cycles with the random bank selection.\n")
+
+    uint32_t banks_used = 0;
+    for (uint32_t i = 0; i < this->get_bank_per_channel(); i++) {
+        banks_used += !this->bank_buffer[i].empty();
+    }
+    for (uint64_t i = 0; i < cycles % banks_used; i++) {
+        this->selection_bank_round_robin();
+    }
+};
+
 // ============================================================================
 void memory_channel_t::print_structures() {
     for (uint32_t i = 0; i < this->get_bank_per_channel(); i++) {
@@ -763,3 +868,27 @@ void memory_channel_t::print_configuration() {
 
 
 };
+
+// ============================================================================
+void memory_channel_t::checkpoint(checkpoint_t *checkpoint) {
+    ERROR_ASSERT_PRINTF(checkpoint->get_is_restore() || this->packages_inside_channel == 0, "Checkpoint with requests inside the banks.\n")
+    checkpoint->section(this->get_label());
+
+    checkpoint->array(this->bank_buffer_actual_position, this->get_bank_per_channel());
+    checkpoint->array(this->bank_is_drain_write, this->get_bank_per_channel());
+    checkpoint->array(this->bank_number_drain_write, this->get_bank_per_channel());
+    checkpoint->array(this->bank_open_row_address, this->get_bank_per_channel());
+    checkpoint->array(this->bank_last_command, this->get_bank_per_channel());
+    /// The matrix is allocated contiguously
+    checkpoint->array(this->bank_last_command_cycle[0], this->get_bank_per_channel() * MEMORY_CONTROLLER_COMMAND_NUMBER);
+    checkpoint->array(this->channel_last_command_cycle, MEMORY_CONTROLLER_COMMAND_NUMBER);
+    checkpoint->value(this->last_bank_selected);
+
+    /// Statistics, not kept by the warm images
+    if (!checkpoint->get_is_warm()) {
+        checkpoint->value(this->stat_row_buffer_hit);
+        checkpoint->value(this->stat_row_buffer_miss);
+        checkpoint->value(this->stat_read_forward);
+        checkpoint->value(this->stat_write_forward);
+    }
+};
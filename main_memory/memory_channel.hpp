@@ -110,6 +110,14 @@ class memory_channel_t : public interconnection_interface_t {
         void reset_statistics();
         void print_statistics();
         void print_configuration();
+
+        /// Checkpoint Methods
+        void checkpoint(checkpoint_t *checkpoint);
+
+        /// Idle-Cycle Skipping Methods
+        uint64_t get_next_event_cycle();
+        void skip_cycles(uint64_t cycles);
+        uint64_t get_bank_ready_cycle(uint32_t bank);
         // ====================================================================
         inline uint64_t get_bank(uint64_t addr) {
             return (addr & this->bank_bits_mask) >> this->bank_bits_shift;
@@ -128,30 +128,7 @@ void memory_controller_t::allocate() {
         this->channels[i].bank_selection_policy = this->bank_selection_policy;
         this->channels[i].bank_buffer_size = this->bank_buffer_size;
 
-        this->channels[i].page_policy = this->page_policy;
-
-        this->channels[i].request_priority_policy = this->request_priority_policy;
-        this->channels[i].write_priority_policy = this->write_priority_policy;
-
-        /// Consider the latency in terms of processor cycles
-        this->channels[i].timing_burst  = ceil(this->timing_burst   * this->core_to_bus_clock_ratio);
-        this->channels[i].timing_al     = ceil(this->timing_al      * this->core_to_bus_clock_ratio);
-        this->channels[i].timing_cas    = ceil(this->timing_cas     * this->core_to_bus_clock_ratio);
-        this->channels[i].timing_ccd    = ceil(this->timing_ccd     * this->core_to_bus_clock_ratio);
-        this->channels[i].timing_cwd    = ceil(this->timing_cwd     * this->core_to_bus_clock_ratio);
-        this->channels[i].timing_faw    = ceil(this->timing_faw     * this->core_to_bus_clock_ratio);
-        this->channels[i].timing_ras    = ceil(this->timing_ras     * this->core_to_bus_clock_ratio);
-        this->channels[i].timing_rc     = ceil(this->timing_rc      * this->core_to_bus_clock_ratio);
-        this->channels[i].timing_rcd    = ceil(this->timing_rcd     * this->core_to_bus_clock_ratio);
-        this->channels[i].timing_rp     = ceil(this->timing_rp      * this->core_to_bus_clock_ratio);
-        this->channels[i].timing_rrd    = ceil(this->timing_rrd     * this->core_to_bus_clock_ratio);
-        this->channels[i].timing_rtp    = ceil(this->timing_rtp     * this->core_to_bus_clock_ratio);
-        this->channels[i].timing_wr     = ceil(this->timing_wr      * this->core_to_bus_clock_ratio);
-        this->channels[i].timing_wtr    = ceil(this->timing_wtr     * this->core_to_bus_clock_ratio);
-
-        // HMC
-        this->channels[i].hmc_latency_alu  = this->hmc_latency_alu ; // ceil(this->hmc_latency_alu  * this->core_to_bus_clock_ratio);
-        this->channels[i].hmc_latency_alur = this->hmc_latency_alur; // ceil(this->hmc_latency_alur * this->core_to_bus_clock_ratio);
+        this->set_channel_timing(i);
 
         /// Copy the masks
         this->channels[i].not_column_bits_mask = this->not_column_bits_mask;
@@ -168,6 +145,35 @@ void memory_controller_t::allocate() {
     #endif
 };
 
+// ============================================================================
+/// Also called to change the timings and policies of a drained controller (variants after the warm-up)
+void memory_controller_t::set_channel_timing(uint32_t channel) {
+    this->channels[channel].page_policy = this->page_policy;
+
+    this->channels[channel].request_priority_policy = this->request_priority_policy;
+    this->channels[channel].write_priority_policy = this->write_priority_policy;
+
+    /// Consider the latency in terms of processor cycles
+    this->channels[channel].timing_burst  = ceil(this->timing_burst   * this->core_to_bus_clock_ratio);
+    this->channels[channel].timing_al     = ceil(this->timing_al      * this->core_to_bus_clock_ratio);
+    this->channels[channel].timing_cas    = ceil(this->timing_cas     * this->core_to_bus_clock_ratio);
+    this->channels[channel].timing_ccd    = ceil(this->timing_ccd     * this->core_to_bus_clock_ratio);
+    this->channels[channel].timing_cwd    = ceil(this->timing_cwd     * this->core_to_bus_clock_ratio);
+    this->channels[channel].timing_faw    = ceil(this->timing_faw     * this->core_to_bus_clock_ratio);
+    this->channels[channel].timing_ras    = ceil(this->timing_ras     * this->core_to_bus_clock_ratio);
+    this->channels[channel].timing_rc     = ceil(this->timing_rc      * this->core_to_bus_clock_ratio);
+    this->channels[channel].timing_rcd    = ceil(this->timing_rcd     * this->core_to_bus_clock_ratio);
+    this->channels[channel].timing_rp     = ceil(this->timing_rp      * this->core_to_bus_clock_ratio);
+    this->channels[channel].timing_rrd    = ceil(this->timing_rrd     * this->core_to_bus_clock_ratio);
+    this->channels[channel].timing_rtp    = ceil(this->timing_rtp     * this->core_to_bus_clock_ratio);
+    this->channels[channel].timing_wr     = ceil(this->timing_wr      * this->core_to_bus_clock_ratio);
+    this->channels[channel].timing_wtr    = ceil(this->timing_wtr     * this->core_to_bus_clock_ratio);
+
+    // HMC
+    this->channels[channel].hmc_latency_alu  = this->hmc_latency_alu ; // ceil(this->hmc_latency_alu  * this->core_to_bus_clock_ratio);
+    this->channels[channel].hmc_latency_alur = this->hmc_latency_alur; // ceil(this->hmc_latency_alur * this->core_to_bus_clock_ratio);
+};
+
 // ============================================================================
 void memory_controller_t::set_tokens() {
 
@@ -612,6 +618,8 @@ void memory_controller_t::clock(uint32_t subcycle) {
 
 // ============================================================================
 void memory_controller_t::insert_mshr_born_ordered(memory_package_t* package){
+    sinuca_engine.wake_component(this->get_id());
+
     /// this->mshr_born_ordered            = [OLDER --------> NEWER]
     /// this->mshr_born_ordered.born_cycle = [SMALLER -----> BIGGER]
 
@@ -716,6 +724,7 @@ int32_t memory_controller_t::send_package(memory_package_t *package) {
 
 // ============================================================================
 bool memory_controller_t::receive_package(memory_package_t *package, uint32_t input_port, uint32_t transmission_latency) {
+    profile_scope_t profile(&this->profile_receive);
     MEMORY_CONTROLLER_DEBUG_PRINTF("receive_package() port:%u, package:%s\n", input_port, package->content_to_string().c_str());
 
     // ~ ERROR_ASSERT_PRINTF(package->memory_address != 0, "Wrong memory address.\n%s\n", package->content_to_string().c_str());
@@ -901,6 +910,73 @@ void memory_controller_t::memory_stats(memory_package_t *package) {
 };
 
 
+// ============================================================================
+/// The packages inside the channels are followed by the channels.
+uint64_t memory_controller_t::get_next_event_cycle() {
+    uint64_t next_cycle = std::numeric_limits<uint64_t>::max();
+    for (uint32_t i = 0; i < this->mshr_born_ordered.size(); i++){
+        if (this->mshr_born_ordered[i]->state != PACKAGE_STATE_WAIT) {
+            next_cycle = std::min(next_cycle, this->mshr_born_ordered[i]->ready_cycle);
+        }
+    }
+    for (uint32_t i = 0; i < this->channels_per_controller; i++) {
+        next_cycle = std::min(next_cycle, this->channels[i].get_next_event_cycle());
+    }
+    return next_cycle;
+};
+
+// ============================================================================
+void memory_controller_t::skip_cycles(uint64_t cycles) {
+    for (uint32_t i = 0; i < this->channels_per_controller; i++) {
+        this->channels[i].skip_cycles(cycles);
+    }
+};
+
+// ============================================================================
+bool memory_controller_t::check_token_credit(uint32_t src_id, memory_operation_t memory_operation) {
+    switch (memory_operation) {
+        case MEMORY_OPERATION_READ:
+        case MEMORY_OPERATION_INST:
+        // HMC -> READ buffer
+        case MEMORY_OPERATION_HMC_ALU:
+        case MEMORY_OPERATION_HMC_ALUR:
+            return this->mshr_tokens_request[src_id] > 0;
+
+        case MEMORY_OPERATION_PREFETCH:
+            return this->mshr_tokens_prefetch[src_id] > 0;
+
+        case MEMORY_OPERATION_WRITE:
+        case MEMORY_OPERATION_WRITEBACK:
+            return this->mshr_tokens_write[src_id] > 0;
+    }
+    return OK;
+};
+
+// ============================================================================
+/// While nothing moves the tokens are not given back, so each skipped cycle is one failed pop.
+void memory_controller_t::skip_token_credit(uint32_t src_id, memory_operation_t memory_operation, uint64_t cycles) {
+    ERROR_ASSERT_PRINTF(!this->check_token_credit(src_id, memory_operation), "Skipping cycles with available tokens.\n")
+
+    switch (memory_operation) {
+        case MEMORY_OPERATION_READ:
+        case MEMORY_OPERATION_INST:
+        // HMC -> READ buffer
+        case MEMORY_OPERATION_HMC_ALU:
+        case MEMORY_OPERATION_HMC_ALUR:
+            this->statistics.stat_full_mshr_request_buffer += cycles;
+        break;
+
+        case MEMORY_OPERATION_PREFETCH:
+            this->statistics.stat_full_mshr_prefetch_buffer += cycles;
+        break;
+
+        case MEMORY_OPERATION_WRITE:
+        case MEMORY_OPERATION_WRITEBACK:
+            this->statistics.stat_full_mshr_write_buffer += cycles;
+        break;
+    }
+};
+
 // ============================================================================
 void memory_controller_t::print_structures() {
     SINUCA_PRINTF("%s MSHR_BUFFER:\n%s", this->get_label(), memory_package_t::print_all(this->mshr_buffer, this->mshr_buffer_size).c_str())
@@ -952,49 +1028,7 @@ void memory_controller_t::periodic_check(){
 /// STATISTICS
 // ============================================================================
 void memory_controller_t::reset_statistics() {
-    this->stat_accesses = 0;
-
-    this->set_stat_instruction_completed(0);
-    this->set_stat_read_completed(0);
-    this->set_stat_prefetch_completed(0);
-    this->set_stat_write_completed(0);
-    this->set_stat_writeback_completed(0);
-
-    this->stat_min_instruction_wait_time = MAX_ALIVE_TIME;
-    this->stat_max_instruction_wait_time = 0;
-    this->stat_accumulated_instruction_wait_time = 0;
-
-    this->stat_min_read_wait_time = MAX_ALIVE_TIME;
-    this->stat_max_read_wait_time = 0;
-    this->stat_accumulated_read_wait_time = 0;
-
-    this->stat_min_prefetch_wait_time = MAX_ALIVE_TIME;
-    this->stat_max_prefetch_wait_time = 0;
-    this->stat_accumulated_prefetch_wait_time = 0;
-
-    this->stat_min_write_wait_time = MAX_ALIVE_TIME;
-    this->stat_max_write_wait_time = 0;
-    this->stat_accumulated_write_wait_time = 0;
-
-    this->stat_min_writeback_wait_time = MAX_ALIVE_TIME;
-    this->stat_max_writeback_wait_time = 0;
-    this->stat_accumulated_writeback_wait_time = 0;
-
-    // HMC
-    this->set_stat_hmc_alu_completed(0);
-    this->set_stat_hmc_alur_completed(0);
-
-    this->stat_min_hmc_alu_wait_time = MAX_ALIVE_TIME;
-    this->stat_max_hmc_alu_wait_time = 0;
-    this->stat_accumulated_hmc_alu_wait_time = 0;
-
-    this->stat_min_hmc_alur_wait_time = MAX_ALIVE_TIME;
-    this->stat_max_hmc_alur_wait_time = 0;
-    this->stat_accumulated_hmc_alur_wait_time = 0;
-
-    this->stat_full_mshr_request_buffer = 0;
-    this->stat_full_mshr_write_buffer = 0;
-    this->stat_full_mshr_prefetch_buffer = 0;
+    memset(&this->statistics, 0, sizeof(this->statistics));
 
     for (uint32_t i = 0; i < this->channels_per_controller; i++) {
         this->channels[i].reset_statistics();
@@ -1009,67 +1043,29 @@ void memory_controller_t::print_statistics() {
     sinuca_engine.write_statistics_comments(title);
     sinuca_engine.write_statistics_big_separator();
 
-    sinuca_engine.write_statistics_value(get_type_component_label(), get_label(), "stat_accesses", stat_accesses);
-
-    sinuca_engine.write_statistics_small_separator();
-    sinuca_engine.write_statistics_value(get_type_component_label(), get_label(), "stat_instruction_completed", stat_instruction_completed);
-    sinuca_engine.write_statistics_value(get_type_component_label(), get_label(), "stat_read_completed", stat_read_completed);
-    sinuca_engine.write_statistics_value(get_type_component_label(), get_label(), "stat_prefetch_completed", stat_prefetch_completed);
-    sinuca_engine.write_statistics_value(get_type_component_label(), get_label(), "stat_write_completed", stat_write_completed);
-    sinuca_engine.write_statistics_value(get_type_component_label(), get_label(), "stat_writeback_completed", stat_writeback_completed);
+    MEMORY_CONTROLLER_STATISTICS(STATISTICS_PRINT_COUNTER, STATISTICS_PRINT_LATENCY)
 
+    /// Derived from the statistics above
+    const statistics_t *stat = &this->statistics;
     sinuca_engine.write_statistics_small_separator();
     sinuca_engine.write_statistics_value(get_type_component_label(), get_label(), "stat_sum_read",
-                                                                                    stat_instruction_completed +
-                                                                                    stat_read_completed +
-                                                                                    stat_prefetch_completed);
+                                                                                    stat->stat_instruction_completed +
+                                                                                    stat->stat_read_completed +
+                                                                                    stat->stat_prefetch_completed);
     sinuca_engine.write_statistics_value(get_type_component_label(), get_label(), "stat_sum_write",
-                                                                                    stat_write_completed +
-                                                                                    stat_writeback_completed);
-
+                                                                                    stat->stat_write_completed +
+                                                                                    stat->stat_writeback_completed);
 
     sinuca_engine.write_statistics_small_separator();
-    sinuca_engine.write_statistics_value(get_type_component_label(), get_label(), "stat_min_instruction_wait_time", stat_min_instruction_wait_time);
-    sinuca_engine.write_statistics_value(get_type_component_label(), get_label(), "stat_min_read_wait_time", stat_min_read_wait_time);
-    sinuca_engine.write_statistics_value(get_type_component_label(), get_label(), "stat_min_prefetch_wait_time", stat_min_prefetch_wait_time);
-    sinuca_engine.write_statistics_value(get_type_component_label(), get_label(), "stat_min_write_wait_time", stat_min_write_wait_time);
-    sinuca_engine.write_statistics_value(get_type_component_label(), get_label(), "stat_min_writeback_wait_time", stat_min_writeback_wait_time);
-
-    sinuca_engine.write_statistics_small_separator();
-    sinuca_engine.write_statistics_value(get_type_component_label(), get_label(), "stat_max_instruction_wait_time", stat_max_instruction_wait_time);
-    sinuca_engine.write_statistics_value(get_type_component_label(), get_label(), "stat_max_read_wait_time", stat_max_read_wait_time);
-    sinuca_engine.write_statistics_value(get_type_component_label(), get_label(), "stat_max_prefetch_wait_time", stat_max_prefetch_wait_time);
-    sinuca_engine.write_statistics_value(get_type_component_label(), get_label(), "stat_max_write_wait_time", stat_max_write_wait_time);
-    sinuca_engine.write_statistics_value(get_type_component_label(), get_label(), "stat_max_writeback_wait_time", stat_max_writeback_wait_time);
-
-    sinuca_engine.write_statistics_small_separator();
-    sinuca_engine.write_statistics_value_ratio(get_type_component_label(), get_label(), "stat_accumulated_instruction_wait_time", stat_accumulated_instruction_wait_time, stat_instruction_completed);
-    sinuca_engine.write_statistics_value_ratio(get_type_component_label(), get_label(), "stat_accumulated_read_wait_time", stat_accumulated_read_wait_time, stat_read_completed);
-    sinuca_engine.write_statistics_value_ratio(get_type_component_label(), get_label(), "stat_accumulated_prefetch_wait_time", stat_accumulated_prefetch_wait_time, stat_prefetch_completed);
-    sinuca_engine.write_statistics_value_ratio(get_type_component_label(), get_label(), "stat_accumulated_write_wait_time", stat_accumulated_write_wait_time, stat_write_completed);
-    sinuca_engine.write_statistics_value_ratio(get_type_component_label(), get_label(), "stat_accumulated_writeback_wait_time", stat_accumulated_writeback_wait_time, stat_writeback_completed);
+    sinuca_engine.write_statistics_value_ratio(get_type_component_label(), get_label(), "stat_accumulated_instruction_wait_time", stat->stat_instruction_wait_time.accumulated, stat->stat_instruction_completed);
+    sinuca_engine.write_statistics_value_ratio(get_type_component_label(), get_label(), "stat_accumulated_read_wait_time", stat->stat_read_wait_time.accumulated, stat->stat_read_completed);
+    sinuca_engine.write_statistics_value_ratio(get_type_component_label(), get_label(), "stat_accumulated_prefetch_wait_time", stat->stat_prefetch_wait_time.accumulated, stat->stat_prefetch_completed);
+    sinuca_engine.write_statistics_value_ratio(get_type_component_label(), get_label(), "stat_accumulated_write_wait_time", stat->stat_write_wait_time.accumulated, stat->stat_write_completed);
+    sinuca_engine.write_statistics_value_ratio(get_type_component_label(), get_label(), "stat_accumulated_writeback_wait_time", stat->stat_writeback_wait_time.accumulated, stat->stat_writeback_completed);
 
     // HMC
-    sinuca_engine.write_statistics_small_separator();
-    sinuca_engine.write_statistics_value(get_type_component_label(), get_label(), "stat_hmc_alu_completed", stat_hmc_alu_completed);
-    sinuca_engine.write_statistics_value(get_type_component_label(), get_label(), "stat_hmc_alur_completed", stat_hmc_alur_completed);
-
-    sinuca_engine.write_statistics_small_separator();
-    sinuca_engine.write_statistics_value(get_type_component_label(), get_label(), "stat_min_hmc_alu_wait_time", stat_min_hmc_alu_wait_time);
-    sinuca_engine.write_statistics_value(get_type_component_label(), get_label(), "stat_max_hmc_alu_wait_time", stat_max_hmc_alu_wait_time);
-
-    sinuca_engine.write_statistics_value(get_type_component_label(), get_label(), "stat_min_hmc_alur_wait_time", stat_min_hmc_alur_wait_time);
-    sinuca_engine.write_statistics_value(get_type_component_label(), get_label(), "stat_max_hmc_alur_wait_time", stat_max_hmc_alur_wait_time);
-
-    sinuca_engine.write_statistics_small_separator();
-    sinuca_engine.write_statistics_value_ratio(get_type_component_label(), get_label(), "stat_accumulated_hmc_alu_wait_time", stat_accumulated_hmc_alu_wait_time, stat_hmc_alu_completed);
-    sinuca_engine.write_statistics_value_ratio(get_type_component_label(), get_label(), "stat_accumulated_hmc_alur_wait_time", stat_accumulated_hmc_alur_wait_time, stat_hmc_alur_completed);
-
-
-    sinuca_engine.write_statistics_small_separator();
-    sinuca_engine.write_statistics_value(get_type_component_label(), get_label(), "stat_full_mshr_request_buffer", stat_full_mshr_request_buffer);
-    sinuca_engine.write_statistics_value(get_type_component_label(), get_label(), "stat_full_mshr_write_buffer", stat_full_mshr_write_buffer);
-    sinuca_engine.write_statistics_value(get_type_component_label(), get_label(), "stat_full_mshr_prefetch_buffer", stat_full_mshr_prefetch_buffer);
+    sinuca_engine.write_statistics_value_ratio(get_type_component_label(), get_label(), "stat_accumulated_hmc_alu_wait_time", stat->stat_hmc_alu_wait_time.accumulated, stat->stat_hmc_alu_completed);
+    sinuca_engine.write_statistics_value_ratio(get_type_component_label(), get_label(), "stat_accumulated_hmc_alur_wait_time", stat->stat_hmc_alur_wait_time.accumulated, stat->stat_hmc_alur_completed);
 
     for (uint32_t i = 0; i < this->channels_per_controller; i++) {
         this->channels[i].print_statistics();
@@ -1155,3 +1151,28 @@ void memory_controller_t::print_configuration() {
     }
 };
 
+// ============================================================================
+/// The MSHR is drained before saving, the tokens are all back at their owners.
+void memory_controller_t::checkpoint(checkpoint_t *checkpoint) {
+    ERROR_ASSERT_PRINTF(checkpoint->get_is_restore() || this->is_drained(), "Checkpoint with requests inside the MSHR.\n")
+    checkpoint->section(this->get_label());
+
+    /// The warm images do not keep the DRAM state
+    if (checkpoint->get_is_warm()) {
+        return;
+    }
+
+    checkpoint->value(this->send_ready_cycle);
+    checkpoint->value(this->recv_ready_cycle);
+
+    /// Statistics, not kept by the warm images
+    if (!checkpoint->get_is_warm()) {
+        checkpoint->value(this->statistics);
+    }
+
+    checkpoint->check_size(this->get_channels_per_controller());
+    for (uint32_t i = 0; i < this->get_channels_per_controller(); i++) {
+        this->channels[i].checkpoint(checkpoint);
+    }
+};
+
@@ -18,6 +18,27 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+/// Statistics of the memory controller, see statistics_registry.hpp
+#define MEMORY_CONTROLLER_STATISTICS(COUNTER, LATENCY) \
+    COUNTER(stat_accesses) \
+    COUNTER(stat_instruction_completed) \
+    COUNTER(stat_read_completed) \
+    COUNTER(stat_prefetch_completed) \
+    COUNTER(stat_write_completed) \
+    COUNTER(stat_writeback_completed) \
+    COUNTER(stat_hmc_alu_completed) \
+    COUNTER(stat_hmc_alur_completed) \
+    COUNTER(stat_full_mshr_request_buffer) \
+    COUNTER(stat_full_mshr_prefetch_buffer) \
+    COUNTER(stat_full_mshr_write_buffer) \
+    LATENCY(instruction_wait_time) \
+    LATENCY(read_wait_time) \
+    LATENCY(prefetch_wait_time) \
+    LATENCY(write_wait_time) \
+    LATENCY(writeback_wait_time) \
+    LATENCY(hmc_alu_wait_time) \
+    LATENCY(hmc_alur_wait_time)
+
 class memory_controller_t : public interconnection_interface_t {
     private:
         // ====================================================================
@@ -113,49 +134,9 @@ class memory_controller_t : public interconnection_interface_t {
         // ====================================================================
         /// Statistics related
         // ====================================================================
-        uint64_t stat_accesses;
-
-        uint64_t stat_instruction_completed;
-        uint64_t stat_read_completed;
-        uint64_t stat_prefetch_completed;
-        uint64_t stat_write_completed;
-        uint64_t stat_writeback_completed;
-
-        uint64_t stat_min_instruction_wait_time;
-        uint64_t stat_max_instruction_wait_time;
-        uint64_t stat_accumulated_instruction_wait_time;
-
-        uint64_t stat_min_read_wait_time;
-        uint64_t stat_max_read_wait_time;
-        uint64_t stat_accumulated_read_wait_time;
-
-        uint64_t stat_min_prefetch_wait_time;
-        uint64_t stat_max_prefetch_wait_time;
-        uint64_t stat_accumulated_prefetch_wait_time;
-
-        uint64_t stat_min_write_wait_time;
-        uint64_t stat_max_write_wait_time;
-        uint64_t stat_accumulated_write_wait_time;
-
-        uint64_t stat_min_writeback_wait_time;
-        uint64_t stat_max_writeback_wait_time;
-        uint64_t stat_accumulated_writeback_wait_time;
-
-        // HMC
-        uint64_t stat_hmc_alu_completed;
-        uint64_t stat_hmc_alur_completed;
-
-        uint64_t stat_min_hmc_alu_wait_time;
-        uint64_t stat_max_hmc_alu_wait_time;
-        uint64_t stat_accumulated_hmc_alu_wait_time;
-
-        uint64_t stat_min_hmc_alur_wait_time;
-        uint64_t stat_max_hmc_alur_wait_time;
-        uint64_t stat_accumulated_hmc_alur_wait_time;
-
-        uint64_t stat_full_mshr_request_buffer;
-        uint64_t stat_full_mshr_prefetch_buffer;
-        uint64_t stat_full_mshr_write_buffer;
+        struct statistics_t {
+            MEMORY_CONTROLLER_STATISTICS(STATISTICS_DECLARE_COUNTER, STATISTICS_DECLARE_LATENCY)
+        } statistics;
 
 
     public:
@@ -170,6 +151,7 @@ class memory_controller_t : public interconnection_interface_t {
         // ====================================================================
         /// Basic Methods
         void allocate();
+        void set_channel_timing(uint32_t channel);
         void clock(uint32_t sub_cycle);
         int32_t send_package(memory_package_t *package);
         bool receive_package(memory_package_t *package, uint32_t input_port, uint32_t transmission_latency);
@@ -184,6 +166,15 @@ class memory_controller_t : public interconnection_interface_t {
         void reset_statistics();
         void print_statistics();
         void print_configuration();
+
+        /// Checkpoint Methods
+        void checkpoint(checkpoint_t *checkpoint);
+
+        /// Idle-Cycle Skipping Methods
+        uint64_t get_next_event_cycle();
+        bool check_token_credit(uint32_t src_id, memory_operation_t memory_operation);
+        void skip_token_credit(uint32_t src_id, memory_operation_t memory_operation, uint64_t cycles);
+        void skip_cycles(uint64_t cycles);
         // ====================================================================
 
         /// MASKS
@@ -204,6 +195,9 @@ class memory_controller_t : public interconnection_interface_t {
         }
 
         void insert_mshr_born_ordered(memory_package_t* package);
+        inline bool is_drained() {
+            return this->mshr_born_ordered.empty();
+        };
 
         int32_t allocate_request(memory_package_t* package);
         int32_t allocate_write(memory_package_t* package);
@@ -265,75 +259,41 @@ class memory_controller_t : public interconnection_interface_t {
         // ====================================================================
         void memory_stats(memory_package_t *package);
 
-        INSTANTIATE_GET_SET_ADD(uint64_t, stat_accesses)
-
-        INSTANTIATE_GET_SET_ADD(uint64_t, stat_full_mshr_request_buffer);
-        INSTANTIATE_GET_SET_ADD(uint64_t, stat_full_mshr_prefetch_buffer);
-        INSTANTIATE_GET_SET_ADD(uint64_t, stat_full_mshr_write_buffer);
-
-        INSTANTIATE_GET_SET(uint64_t, stat_instruction_completed)
-        INSTANTIATE_GET_SET(uint64_t, stat_read_completed)
-        INSTANTIATE_GET_SET(uint64_t, stat_prefetch_completed)
-        INSTANTIATE_GET_SET(uint64_t, stat_write_completed)
-        INSTANTIATE_GET_SET(uint64_t, stat_writeback_completed)
+        MEMORY_CONTROLLER_STATISTICS(STATISTICS_COUNTER_METHODS, STATISTICS_LATENCY_METHODS)
 
         inline void add_stat_instruction_completed(uint64_t born_cycle) {
-            this->stat_instruction_completed++;
-            uint64_t new_time = sinuca_engine.get_global_cycle() - born_cycle;
-            this->stat_accumulated_instruction_wait_time += new_time;
-            if (this->stat_min_instruction_wait_time > new_time) this->stat_min_instruction_wait_time = new_time;
-            if (this->stat_max_instruction_wait_time < new_time) this->stat_max_instruction_wait_time = new_time;
+            this->statistics.stat_instruction_completed++;
+            this->add_stat_instruction_wait_time(born_cycle);
         };
 
         inline void add_stat_read_completed(uint64_t born_cycle) {
-            this->stat_read_completed++;
-            uint64_t new_time = sinuca_engine.get_global_cycle() - born_cycle;
-            this->stat_accumulated_read_wait_time += new_time;
-            if (this->stat_min_read_wait_time > new_time) this->stat_min_read_wait_time = new_time;
-            if (this->stat_max_read_wait_time < new_time) this->stat_max_read_wait_time = new_time;
+            this->statistics.stat_read_completed++;
+            this->add_stat_read_wait_time(born_cycle);
         };
 
         inline void add_stat_prefetch_completed(uint64_t born_cycle) {
-            this->stat_prefetch_completed++;
-            uint64_t new_time = sinuca_engine.get_global_cycle() - born_cycle;
-            this->stat_accumulated_prefetch_wait_time += new_time;
-            if (this->stat_min_prefetch_wait_time > new_time) this->stat_min_prefetch_wait_time = new_time;
-            if (this->stat_max_prefetch_wait_time < new_time) this->stat_max_prefetch_wait_time = new_time;
+            this->statistics.stat_prefetch_completed++;
+            this->add_stat_prefetch_wait_time(born_cycle);
         };
 
-
         inline void add_stat_write_completed(uint64_t born_cycle) {
-            this->stat_write_completed++;
-            uint64_t new_time = sinuca_engine.get_global_cycle() - born_cycle;
-            this->stat_accumulated_write_wait_time += new_time;
-            if (this->stat_min_write_wait_time > new_time) this->stat_min_write_wait_time = new_time;
-            if (this->stat_max_write_wait_time < new_time) this->stat_max_write_wait_time = new_time;
+            this->statistics.stat_write_completed++;
+            this->add_stat_write_wait_time(born_cycle);
         };
 
         inline void add_stat_writeback_completed(uint64_t born_cycle) {
-            this->stat_writeback_completed++;
-            uint64_t new_time = sinuca_engine.get_global_cycle() - born_cycle;
-            this->stat_accumulated_writeback_wait_time += new_time;
-            if (this->stat_min_writeback_wait_time > new_time) this->stat_min_writeback_wait_time = new_time;
-            if (this->stat_max_writeback_wait_time < new_time) this->stat_max_writeback_wait_time = new_time;
+            this->statistics.stat_writeback_completed++;
+            this->add_stat_writeback_wait_time(born_cycle);
         };
 
         // HMC
-        INSTANTIATE_GET_SET(uint64_t, stat_hmc_alu_completed)
-        INSTANTIATE_GET_SET(uint64_t, stat_hmc_alur_completed)
-
         inline void add_stat_hmc_alu_completed(uint64_t born_cycle) {
-            this->stat_hmc_alu_completed++;
-            uint64_t new_time = sinuca_engine.get_global_cycle() - born_cycle;
-            this->stat_accumulated_hmc_alu_wait_time += new_time;
-            if (this->stat_min_hmc_alu_wait_time > new_time) this->stat_min_hmc_alu_wait_time = new_time;
-            if (this->stat_max_hmc_alu_wait_time < new_time) this->stat_max_hmc_alu_wait_time = new_time;
+            this->statistics.stat_hmc_alu_completed++;
+            this->add_stat_hmc_alu_wait_time(born_cycle);
         };
+
         inline void add_stat_hmc_alur_completed(uint64_t born_cycle) {
-            this->stat_hmc_alur_completed++;
-            uint64_t new_time = sinuca_engine.get_global_cycle() - born_cycle;
-            this->stat_accumulated_hmc_alur_wait_time += new_time;
-            if (this->stat_min_hmc_alur_wait_time > new_time) this->stat_min_hmc_alur_wait_time = new_time;
-            if (this->stat_max_hmc_alur_wait_time < new_time) this->stat_max_hmc_alur_wait_time = new_time;
+            this->statistics.stat_hmc_alur_completed++;
+            this->add_stat_hmc_alur_wait_time(born_cycle);
         };
 };
@@ -61,6 +61,8 @@ opcode_package_t::opcode_package_t(const opcode_package_t &package) {
     is_predicated = package.is_predicated;
     is_prefetch = package.is_prefetch;
 
+    static_opcode = package.static_opcode;
+
     /// SINUCA Control Variables
     opcode_number = package.opcode_number;
     state = package.state;
@@ -148,6 +150,8 @@ void opcode_package_t::package_clean() {
     this->is_predicated = false;
     this->is_prefetch = false;
 
+    this->static_opcode = 0;
+
     /// SINUCA Control Variables
     this->opcode_number = 0;
     this->state = PACKAGE_STATE_FREE;
@@ -495,6 +499,56 @@ void opcode_package_t::trace_string_to_opcode(char *input_string) {
 };
 
 
+// =============================================================================
+/// Convert Binary Static Trace record into Instruction (see trace_binary.hpp)
+void opcode_package_t::trace_binary_to_opcode(const trace_binary_opcode_t *record) {
+    memcpy(this->opcode_assembly, record->opcode_assembly, sizeof(char) * MAX_ASSEMBLY_SIZE);
+    this->opcode_assembly[MAX_ASSEMBLY_SIZE - 1] = '\0';
+
+    this->opcode_operation = instruction_operation_t(record->opcode_operation);
+    this->opcode_address = record->opcode_address;
+    this->opcode_size = record->opcode_size;
+
+    memcpy(this->read_regs, record->read_regs, sizeof(int32_t) * MAX_REGISTERS);
+    memcpy(this->write_regs, record->write_regs, sizeof(int32_t) * MAX_REGISTERS);
+
+    this->base_reg = record->base_reg;
+    this->index_reg = record->index_reg;
+
+    this->is_read = (record->flags & TRACE_BINARY_IS_READ) != 0;
+    this->is_read2 = (record->flags & TRACE_BINARY_IS_READ2) != 0;
+    this->is_write = (record->flags & TRACE_BINARY_IS_WRITE) != 0;
+    this->is_conditional = (record->flags & TRACE_BINARY_IS_CONDITIONAL) != 0;
+    this->is_predicated = (record->flags & TRACE_BINARY_IS_PREDICATED) != 0;
+    this->is_prefetch = (record->flags & TRACE_BINARY_IS_PREFETCH) != 0;
+};
+
+// =============================================================================
+/// Convert Binary Memory Trace record into Instruction Memory Operands
+void opcode_package_t::trace_binary_to_read(const trace_binary_memory_t *record, uint32_t actual_bbl) {
+    ERROR_ASSERT_PRINTF(record->is_write == 0, "MemoryTraceFile Type (R) expected.\n Inst: %s\n", this->content_to_string().c_str())
+    ERROR_ASSERT_PRINTF(record->bbl == actual_bbl, "Wrong bbl inside memory_trace. Actual bbl (%u) - trace has (%u)\n", actual_bbl, record->bbl)
+    this->read_size = record->size;
+    this->read_address = record->address;
+};
+
+// =============================================================================
+void opcode_package_t::trace_binary_to_read2(const trace_binary_memory_t *record, uint32_t actual_bbl) {
+    ERROR_ASSERT_PRINTF(record->is_write == 0, "MemoryTraceFile Type (R) expected.\n Inst: %s\n", this->content_to_string().c_str())
+    ERROR_ASSERT_PRINTF(record->bbl == actual_bbl, "Wrong bbl inside memory_trace. Actual bbl (%u) - trace has (%u)\n", actual_bbl, record->bbl)
+    this->read2_size = record->size;
+    this->read2_address = record->address;
+};
+
+// =============================================================================
+void opcode_package_t::trace_binary_to_write(const trace_binary_memory_t *record, uint32_t actual_bbl) {
+    ERROR_ASSERT_PRINTF(record->is_write == 1, "MemoryTraceFile Type (W) expected.\n Inst: %s\n", this->content_to_string().c_str())
+    ERROR_ASSERT_PRINTF(record->bbl == actual_bbl, "Wrong bbl inside memory_trace. Actual bbl (%u) - trace has (%u)\n", actual_bbl, record->bbl)
+    this->write_size = record->size;
+    this->write_address = record->address;
+};
+
+
 // =============================================================================
 int32_t opcode_package_t::find_free(opcode_package_t *input_array, uint32_t size_array) {
     for (uint32_t i = 0; i < size_array ; i++) {
@@ -26,7 +26,7 @@
 class opcode_package_t {
     public:
         /// TRACE Variables
-        char opcode_assembly[MAX_ASSEMBLY_SIZE];
+        char opcode_assembly[MAX_ASSEMBLY_SIZE];    /// Only while parsing, afterwards use trace_static_dict_t::get_assembly()
         instruction_operation_t opcode_operation;
         uint64_t opcode_address;
         uint32_t opcode_size;
@@ -53,6 +53,8 @@ class opcode_package_t {
         bool is_predicated;
         bool is_prefetch;
 
+        uint32_t static_opcode;     /// Position inside the trace_static_dict_t, with the decoded uops
+
         /// SINUCA Control Variables
         uint64_t opcode_number;
         package_state_t state;
@@ -77,6 +79,11 @@ class opcode_package_t {
         void trace_string_to_read2(char *input_string, uint32_t actual_bbl);
         void trace_string_to_write(char *input_string, uint32_t actual_bbl);
 
+        void trace_binary_to_opcode(const trace_binary_opcode_t *record);
+        void trace_binary_to_read(const trace_binary_memory_t *record, uint32_t actual_bbl);
+        void trace_binary_to_read2(const trace_binary_memory_t *record, uint32_t actual_bbl);
+        void trace_binary_to_write(const trace_binary_memory_t *record, uint32_t actual_bbl);
+
         opcode_package_t& operator=(const opcode_package_t &package);
         bool operator==(const opcode_package_t &package);
 
@@ -32,7 +32,6 @@ uop_package_t::~uop_package_t(){
 // =============================================================================
 uop_package_t::uop_package_t(const uop_package_t& package) {
     /// TRACE Variables
-    strncpy(opcode_assembly, package.opcode_assembly, sizeof(char) * MAX_ASSEMBLY_SIZE);
     opcode_operation = package.opcode_operation;
     opcode_address = package.opcode_address;
     opcode_size = package.opcode_size;
@@ -64,7 +63,6 @@ uop_package_t& uop_package_t::operator=(const uop_package_t& package) {
 // =============================================================================
 bool uop_package_t::operator==(const uop_package_t &package) {
     /// TRACE Variables
-    if (strcmp(this->opcode_assembly, package.opcode_assembly) != 0) return FAIL;
     if (this->opcode_operation != package.opcode_operation) return FAIL;
     if (this->opcode_address != package.opcode_address) return FAIL;
     if (this->opcode_size != package.opcode_size) return FAIL;
@@ -87,25 +85,41 @@ bool uop_package_t::operator==(const uop_package_t &package) {
 };
 
 // =============================================================================
-void uop_package_t::opcode_to_uop(uint64_t uop_number, instruction_operation_t uop_operation, uint64_t memory_address, uint32_t memory_size, opcode_package_t opcode) {
-    ERROR_ASSERT_PRINTF(this->state == PACKAGE_STATE_FREE,
-                        "Trying to decode to uop in a non-free location\n");
-
+/// The static uop already has the registers, only the dynamic fields come from the opcode
+void uop_package_t::opcode_to_uop(uint64_t uop_number, const trace_static_uop_t *static_uop, const opcode_package_t *opcode) {
     /// TRACE Variables
-    strncpy(this->opcode_assembly, opcode.opcode_assembly, sizeof(this->opcode_assembly));
-    this->opcode_operation = opcode.opcode_operation;
-    this->opcode_address = opcode.opcode_address;
-    this->opcode_size = opcode.opcode_size;
-
-    memcpy(this->read_regs, opcode.read_regs, sizeof(int32_t) * MAX_REGISTERS);
-    memcpy(this->write_regs, opcode.write_regs, sizeof(int32_t) * MAX_REGISTERS);
-
-    this->uop_operation = uop_operation;
-    this->memory_address = memory_address;
-    this->memory_size = memory_size;
+    this->opcode_operation = opcode->opcode_operation;
+    this->opcode_address = opcode->opcode_address;
+    this->opcode_size = opcode->opcode_size;
+
+    memcpy(this->read_regs, static_uop->read_regs, sizeof(int32_t) * MAX_REGISTERS);
+    memcpy(this->write_regs, static_uop->write_regs, sizeof(int32_t) * MAX_REGISTERS);
+
+    this->uop_operation = static_uop->uop_operation;
+    switch (static_uop->memory_operand) {
+        case TRACE_BINARY_IS_READ:
+            this->memory_address = opcode->read_address;
+            this->memory_size = opcode->read_size;
+        break;
+
+        case TRACE_BINARY_IS_READ2:
+            this->memory_address = opcode->read2_address;
+            this->memory_size = opcode->read2_size;
+        break;
+
+        case TRACE_BINARY_IS_WRITE:
+            this->memory_address = opcode->write_address;
+            this->memory_size = opcode->write_size;
+        break;
+
+        default:
+            this->memory_address = 0;
+            this->memory_size = 0;
+        break;
+    }
 
     /// SINUCA Control Variables
-    this->opcode_number = opcode.opcode_number;
+    this->opcode_number = opcode->opcode_number;
     this->uop_number = uop_number;
     this->state = PACKAGE_STATE_UNTREATED;
     this->ready_cycle = sinuca_engine.get_global_cycle();
@@ -115,7 +129,6 @@ void uop_package_t::opcode_to_uop(uint64_t uop_number, instruction_operation_t u
 // =============================================================================
 void uop_package_t::package_clean() {
     /// TRACE Variables
-    strcpy(this->opcode_assembly, "N/A");
     this->opcode_operation = INSTRUCTION_OPERATION_NOP;
     this->opcode_address = 0;
     this->opcode_size = 0;
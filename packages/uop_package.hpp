@@ -26,7 +26,6 @@ class uop_package_t {
     public:
 
         /// TRACE Variables
-        char opcode_assembly[MAX_ASSEMBLY_SIZE];
         instruction_operation_t opcode_operation;
         uint64_t opcode_address;
         uint32_t opcode_size;
@@ -57,7 +56,7 @@ class uop_package_t {
         uop_package_t& operator=(const uop_package_t &package);
         bool operator==(const uop_package_t &package);
 
-        void opcode_to_uop(uint64_t uop_number, instruction_operation_t uop_operation, uint64_t memory_address, uint32_t memory_size, opcode_package_t opcode);
+        void opcode_to_uop(uint64_t uop_number, const trace_static_uop_t *static_uop, const opcode_package_t *opcode);
 
         void package_clean();
         void package_untreated(uint32_t wait_time);
@@ -154,3 +154,20 @@ void prefetch_t::print_configuration() {
     sinuca_engine.write_statistics_small_separator();
     sinuca_engine.write_statistics_value(get_type_component_label(), get_label(), "offset_bits_mask", utils_t::address_to_binary(this->offset_bits_mask).c_str());
 };
+
+// ============================================================================
+/// The request buffer is drained together with the cache MSHR.
+void prefetch_t::checkpoint(checkpoint_t *checkpoint) {
+    ERROR_ASSERT_PRINTF(checkpoint->get_is_restore() || this->request_buffer.is_empty(), "Checkpoint with prefetches inside the request buffer.\n")
+    checkpoint->section(this->get_label());
+
+    /// Statistics, not kept by the warm images
+    if (!checkpoint->get_is_warm()) {
+        checkpoint->value(this->stat_created_prefetches);
+        checkpoint->value(this->stat_dropped_prefetches);
+        checkpoint->value(this->stat_full_buffer);
+        checkpoint->value(this->stat_upstride_prefetches);
+        checkpoint->value(this->stat_downstride_prefetches);
+        checkpoint->value(this->stat_request_matches);
+    }
+};
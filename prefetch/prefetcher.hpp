@@ -79,6 +79,9 @@ class prefetch_t : public interconnection_interface_t {
         void reset_statistics();
         void print_statistics();
         void print_configuration();
+
+        /// Checkpoint Methods
+        void checkpoint(checkpoint_t *checkpoint);
         // ====================================================================
 
         virtual void treat_prefetch(memory_package_t *package)=0;
@@ -377,3 +377,10 @@ void prefetch_stream_t::print_configuration() {
 
     sinuca_engine.write_statistics_value(get_type_component_label(), get_label(), "lifetime_cycles", lifetime_cycles);
 };
+
+// ============================================================================
+void prefetch_stream_t::checkpoint(checkpoint_t *checkpoint) {
+    prefetch_t::checkpoint(checkpoint);
+
+    checkpoint->array(this->stream_table, this->get_stream_table_size());
+};
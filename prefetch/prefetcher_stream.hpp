@@ -65,6 +65,9 @@ class prefetch_stream_t : public prefetch_t {
         void reset_statistics();
         void print_statistics();
         void print_configuration();
+
+        /// Checkpoint Methods
+        void checkpoint(checkpoint_t *checkpoint);
         // ====================================================================
 
         void treat_prefetch(memory_package_t *package);
@@ -392,3 +392,23 @@ void prefetch_stride_t::print_configuration() {
     sinuca_engine.write_statistics_value(get_type_component_label(), get_label(), "stride_table_size", stride_table_size);
     sinuca_engine.write_statistics_value(get_type_component_label(), get_label(), "prefetch_degree", prefetch_degree);
 };
+
+// ============================================================================
+void prefetch_stride_t::checkpoint(checkpoint_t *checkpoint) {
+    prefetch_t::checkpoint(checkpoint);
+
+    checkpoint->array(this->stride_table, this->get_stride_table_size());
+    checkpoint->value(this->last_request_address);
+    checkpoint->value(this->last_prefetch_address);
+
+    /// Statistics, not kept by the warm images
+    if (!checkpoint->get_is_warm()) {
+        checkpoint->value(this->stat_init_state);
+        checkpoint->value(this->stat_transient_state);
+        checkpoint->value(this->stat_steady_state);
+        checkpoint->value(this->stat_no_pred_state);
+        checkpoint->value(this->stat_allocate_stride_ok);
+        checkpoint->value(this->stat_allocate_stride_fail);
+        checkpoint->value(this->stat_next_line_prefetches);
+    }
+};
@@ -79,6 +79,9 @@ class prefetch_stride_t : public prefetch_t {
         void reset_statistics();
         void print_statistics();
         void print_configuration();
+
+        /// Checkpoint Methods
+        void checkpoint(checkpoint_t *checkpoint);
         // ====================================================================
 
         void treat_prefetch(memory_package_t *package);
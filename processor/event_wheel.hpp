@@ -0,0 +1,136 @@
+/*
+ * Copyright (C) 2010~2014  Marco Antonio Zanata Alves
+ *                          (mazalves at inf.ufrgs.br)
+ *                          GPPD - Parallel and Distributed Processing Group
+ *                          Universidade Federal do Rio Grande do Sul
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _PROCESSOR_EVENT_WHEEL_HPP_
+#define _PROCESSOR_EVENT_WHEEL_HPP_
+
+// ============================================================================
+/// One event and the cycle it happens
+template <class EW_TYPE>
+class event_wheel_entry_t {
+    public:
+        uint64_t cycle;
+        EW_TYPE event;
+};
+
+// ============================================================================
+/// Timing wheel, the events are kept in the bucket of (cycle % size).
+/// Each cycle only visits its own bucket, the events more than one lap away
+/// stay in the bucket until their lap. The events are drained in any order.
+template <class EW_TYPE>
+class event_wheel_t {
+    private:
+        std::vector< event_wheel_entry_t<EW_TYPE> > *buckets;
+        uint32_t size;                  /// Power of 2
+        uint64_t mask;
+        uint64_t drain_cycle;           /// First cycle not drained
+        uint32_t count;
+
+    public:
+        event_wheel_t() {
+            this->buckets = NULL;
+            this->size = 0;
+            this->mask = 0;
+            this->drain_cycle = 0;
+            this->count = 0;
+        };
+
+        ~event_wheel_t() {
+            delete []this->buckets;
+        };
+
+        /// Copy Assignment Operator
+        event_wheel_t& operator=(const event_wheel_t& other) {
+            ERROR_PRINTF("Avoid copying this structure for performance reasons.\n")
+            return *this;
+        };
+
+        /// The wheel gets the next power of 2 of the cycles
+        void allocate(uint32_t cycles) {
+            ERROR_ASSERT_PRINTF(this->buckets == NULL, "Event wheel already allocated.\n")
+            this->size = 1;
+            while (this->size < cycles) {
+                this->size <<= 1;
+            }
+            this->mask = this->size - 1;
+            this->buckets = new std::vector< event_wheel_entry_t<EW_TYPE> >[this->size];
+        };
+
+        inline uint32_t get_size() {
+            return this->count;
+        };
+
+        inline bool is_empty() {
+            return (this->count == 0);
+        };
+
+        /// The events of cycles already drained go to the next drain
+        inline void insert(uint64_t cycle, const EW_TYPE& event) {
+            event_wheel_entry_t<EW_TYPE> entry;
+            entry.cycle = std::max(cycle, this->drain_cycle);
+            entry.event = event;
+            this->buckets[entry.cycle & this->mask].push_back(entry);
+            this->count++;
+        };
+
+        /// Moves the events up to the cycle (included) to the end of ready
+        void drain(uint64_t cycle, std::vector<EW_TYPE> *ready) {
+            if (this->count != 0 && cycle >= this->drain_cycle) {
+                /// After a skip longer than the wheel every bucket is visited once
+                uint64_t last_cycle = std::min(cycle, this->drain_cycle + this->mask);
+                for (uint64_t bucket_cycle = this->drain_cycle; bucket_cycle <= last_cycle && this->count != 0; bucket_cycle++) {
+                    std::vector< event_wheel_entry_t<EW_TYPE> > *bucket = &this->buckets[bucket_cycle & this->mask];
+                    for (uint32_t i = 0; i < bucket->size(); ) {
+                        if ((*bucket)[i].cycle <= cycle) {
+                            ready->push_back((*bucket)[i].event);
+                            (*bucket)[i] = bucket->back();
+                            bucket->pop_back();
+                            this->count--;
+                        }
+                        else {
+                            i++;
+                        }
+                    }
+                }
+            }
+            this->drain_cycle = std::max(this->drain_cycle, cycle + 1);
+        };
+
+        /// First cycle with an event, or the max uint64_t without events
+        uint64_t get_next_cycle() {
+            uint64_t next_cycle = std::numeric_limits<uint64_t>::max();
+            if (this->count == 0) {
+                return next_cycle;
+            }
+            /// One lap from the first cycle not drained, the first event in its own lap is the next
+            for (uint64_t bucket_cycle = this->drain_cycle; bucket_cycle <= this->drain_cycle + this->mask; bucket_cycle++) {
+                std::vector< event_wheel_entry_t<EW_TYPE> > *bucket = &this->buckets[bucket_cycle & this->mask];
+                for (uint32_t i = 0; i < bucket->size(); i++) {
+                    if ((*bucket)[i].cycle == bucket_cycle) {
+                        return bucket_cycle;
+                    }
+                    next_cycle = std::min(next_cycle, (*bucket)[i].cycle);
+                }
+            }
+            return next_cycle;
+        };
+};
+
+#endif  // _PROCESSOR_EVENT_WHEEL_HPP_
@@ -24,12 +24,10 @@
 // ============================================================================
 memory_order_buffer_line_t::memory_order_buffer_line_t() {
     this->package_clean();
-    this->mem_deps_ptr_array = NULL;
 };
 
 // ============================================================================
 memory_order_buffer_line_t::~memory_order_buffer_line_t() {
-    utils_t::template_delete_array<memory_order_buffer_line_t*>(mem_deps_ptr_array);
 };
 
 
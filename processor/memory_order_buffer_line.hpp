@@ -26,7 +26,7 @@ class memory_order_buffer_line_t {
         /// Memory Dependencies Control
         bool uop_executed;
         uint32_t wait_mem_deps_number;                  /// Must wait BEFORE execution
-        memory_order_buffer_line_t* *mem_deps_ptr_array;     /// Elements to wake-up AFTER execution
+        wake_up_list_t<memory_order_buffer_line_t> mem_deps_list;   /// Elements to wake-up AFTER execution
 
         // ====================================================================
         /// Methods
@@ -107,6 +107,14 @@ processor_t::processor_t() {
     this->ready_cycle_fu_mem_load = NULL;
     this->ready_cycle_fu_mem_store = NULL;
 
+    this->dispatch_ready_mask = 0;
+    this->execution_dispatch_order = 0;
+
+    this->unified_reservation_station_first = NULL;
+    this->unified_reservation_station_last = NULL;
+    this->unified_reservation_station_size = 0;
+    this->unified_reservation_station_window_end = NULL;
+
 
     /// Integer Funcional Units
     this->number_fu_int_alu = 0;
@@ -184,6 +192,15 @@ processor_t::processor_t() {
     this->got_instruction_token = false;
     this->got_request_token = false;
 
+    this->skip_branch_stall = false;
+    this->skip_sync_stall = false;
+    this->skip_full_fetch_buffer = false;
+    this->skip_full_decode_buffer = false;
+    this->skip_full_reorder_buffer = false;
+    this->skip_full_memory_order_buffer_read = false;
+    this->skip_full_memory_order_buffer_write = false;
+    this->skip_read_token = false;
+    this->skip_write_token = false;
 };
 
 // ============================================================================
@@ -259,8 +276,37 @@ void processor_t::allocate() {
     this->ready_cycle_fu_mem_load = utils_t::template_allocate_initialize_array<uint64_t>(this->number_fu_mem_load, 0);
     this->ready_cycle_fu_mem_store = utils_t::template_allocate_initialize_array<uint64_t>(this->number_fu_mem_store, 0);
 
+    // ====================================================================
+    /// Dispatch queues of each Functional Unit class
+    const uint32_t fu_number[FUNCTIONAL_UNIT_NUMBER] = { this->number_fu_int_alu, this->number_fu_int_mul, this->number_fu_int_div,
+                                                        this->number_fu_fp_alu, this->number_fu_fp_mul, this->number_fu_fp_div,
+                                                        this->number_fu_mem_load, this->number_fu_mem_store };
+    const uint32_t fu_latency[FUNCTIONAL_UNIT_NUMBER] = { this->latency_fu_int_alu, this->latency_fu_int_mul, this->latency_fu_int_div,
+                                                        this->latency_fu_fp_alu, this->latency_fu_fp_mul, this->latency_fu_fp_div,
+                                                        this->latency_fu_mem_load, this->latency_fu_mem_store };
+    const uint32_t fu_wait_between[FUNCTIONAL_UNIT_NUMBER] = { this->wait_between_fu_int_alu, this->wait_between_fu_int_mul, this->wait_between_fu_int_div,
+                                                        this->wait_between_fu_fp_alu, this->wait_between_fu_fp_mul, this->wait_between_fu_fp_div,
+                                                        this->wait_between_fu_mem_load, this->wait_between_fu_mem_store };
+    uint64_t *const fu_ready_cycle[FUNCTIONAL_UNIT_NUMBER] = { this->ready_cycle_fu_int_alu, this->ready_cycle_fu_int_mul, this->ready_cycle_fu_int_div,
+                                                        this->ready_cycle_fu_fp_alu, this->ready_cycle_fu_fp_mul, this->ready_cycle_fu_fp_div,
+                                                        this->ready_cycle_fu_mem_load, this->ready_cycle_fu_mem_store };
+    uint64_t *const fu_stat_dispatch_cycles[FUNCTIONAL_UNIT_NUMBER] = { &this->statistics.stat_dispatch_cycles_fu_int_alu, &this->statistics.stat_dispatch_cycles_fu_int_mul, &this->statistics.stat_dispatch_cycles_fu_int_div,
+                                                        &this->statistics.stat_dispatch_cycles_fu_fp_alu, &this->statistics.stat_dispatch_cycles_fu_fp_mul, &this->statistics.stat_dispatch_cycles_fu_fp_div,
+                                                        &this->statistics.stat_dispatch_cycles_fu_mem_load, &this->statistics.stat_dispatch_cycles_fu_mem_store };
+    for (uint32_t i = 0; i < FUNCTIONAL_UNIT_NUMBER; i++) {
+        this->fu_number[i] = fu_number[i];
+        this->fu_latency[i] = fu_latency[i];
+        this->fu_wait_between[i] = fu_wait_between[i];
+        this->fu_ready_cycle[i] = fu_ready_cycle[i];
+        this->fu_stat_dispatch_cycles[i] = fu_stat_dispatch_cycles[i];
+        this->dispatch_ready[i].reserve(this->reorder_buffer_size);
+    }
+    this->dispatch_waiting.reserve(this->reorder_buffer_size);
+
     /// Fetch Buffer
     this->fetch_buffer.allocate(this->fetch_buffer_size);
+    this->fetch_waiting_pool.allocate(this->fetch_buffer_size);
+    this->fetch_waiting.reserve(this->fetch_buffer_size);
 
     /// Decode Buffer
     ERROR_ASSERT_PRINTF(this->decode_buffer_size >= MAX_UOP_DECODED,
@@ -269,15 +315,16 @@ void processor_t::allocate() {
 
     /// ReOrder Buffer
     this->reorder_buffer = utils_t::template_allocate_array<reorder_buffer_line_t>(this->reorder_buffer_size);
-    for (uint32_t i = 0; i < this->reorder_buffer_size; i++) {
-        this->reorder_buffer[i].reg_deps_ptr_array = utils_t::template_allocate_initialize_array<reorder_buffer_line_t*>(this->reorder_buffer_size, NULL);
-    }
+    /// Each uop waits for at most one producer per read register
+    this->reg_deps_pool.allocate(this->reorder_buffer_size * MAX_REGISTERS);
     this->reorder_buffer_position_start = 0;
     this->reorder_buffer_position_end = 0;
     this->reorder_buffer_position_used = 0;
 
-    this->unified_functional_units.reserve(this->reorder_buffer_size);
-    this->unified_reservation_station.reserve(this->reorder_buffer_size);
+    /// One lap of the execution wheel covers the longest functional unit
+    this->execution_wheel.allocate(*std::max_element(this->fu_latency, this->fu_latency + FUNCTIONAL_UNIT_NUMBER) + 1);
+    this->execution_done_functional_unit.reserve(this->reorder_buffer_size);
+    this->execution_done_read.reserve(this->memory_order_buffer_read_size);
 
     /// Register Alias Table for Renaming
     this->register_alias_table_size = 260; /// Number of registers on the trace (258 is used for SiNUCA only maintain the dependency between uops)
@@ -291,14 +338,9 @@ void processor_t::allocate() {
     ERROR_ASSERT_PRINTF(this->stage_execution_width <= total_dispatched, "Execution width must be less or equal to the number of functional units (%u).\n", total_dispatched);
 
     this->memory_order_buffer_read = utils_t::template_allocate_array<memory_order_buffer_line_t>(this->memory_order_buffer_read_size);
-    for (uint32_t i = 0; i < this->memory_order_buffer_read_size; i++) {
-        this->memory_order_buffer_read[i].mem_deps_ptr_array = utils_t::template_allocate_initialize_array<memory_order_buffer_line_t*>(this->reorder_buffer_size, NULL);
-    }
-
     this->memory_order_buffer_write = utils_t::template_allocate_array<memory_order_buffer_line_t>(this->memory_order_buffer_write_size);
-    for (uint32_t i = 0; i < this->memory_order_buffer_write_size; i++) {
-        this->memory_order_buffer_write[i].mem_deps_ptr_array = utils_t::template_allocate_initialize_array<memory_order_buffer_line_t*>(this->reorder_buffer_size, NULL);
-    }
+    /// Each request waits for at most the last load and the last store of its hash
+    this->mem_deps_pool.allocate((this->memory_order_buffer_read_size + this->memory_order_buffer_write_size) * 2);
 
     /// DISAMBIGUATION OFFSET MASK
     ERROR_ASSERT_PRINTF(utils_t::check_if_power_of_two(this->disambiguation_load_hash_size), "Wrong disambiguation_load_hash_size.\n")
@@ -515,6 +557,64 @@ bool processor_t::is_busy() {
 }
 
 
+// ============================================================================
+/// No opcode inside the pipeline (the trace may continue)
+bool processor_t::is_drained() {
+    return (this->fetch_buffer.is_empty() &&
+            this->decode_buffer.is_empty() &&
+            reorder_buffer_position_used == 0);
+}
+
+// ============================================================================
+/// Functional warm-up: fetch one opcode and update the branch predictor and
+/// the caches without the pipeline. The next opcode stays in trace_next_opcode,
+/// so the stage_fetch continues from the same point.
+bool processor_t::functional_fetch() {
+    /// Synchronizations have no meaning without timing, the cores waiting on them are released
+    this->sync_status = SYNC_FREE;
+    if (this->trace_over) {
+        return FAIL;
+    }
+
+    opcode_package_t actual_opcode = this->trace_next_opcode;
+    this->trace_next_opcode.package_clean();
+    if (!sinuca_engine.trace_reader->trace_fetch(this->core_id, &this->trace_next_opcode)) {
+        this->trace_over = true;
+        return FAIL;
+    }
+
+    if (actual_opcode.state == PACKAGE_STATE_FREE || actual_opcode.sync_type != SYNC_FREE) {
+        return OK;
+    }
+
+    /// The pipeline continues the opcode sequence
+    this->fetch_opcode_counter++;
+    this->decode_opcode_counter++;
+
+    this->branch_predictor->predict_branch(actual_opcode, this->trace_next_opcode);
+
+    directory_controller_t *directory_controller = sinuca_engine.directory_controller;
+    directory_controller->functional_access(this->inst_cache, actual_opcode.opcode_address,
+                                            actual_opcode.opcode_address & this->not_fetch_offset_bits_mask, MEMORY_OPERATION_INST);
+
+    /// HMC operations are not cached
+    if (actual_opcode.opcode_operation == INSTRUCTION_OPERATION_HMC_ALU ||
+        actual_opcode.opcode_operation == INSTRUCTION_OPERATION_HMC_ALUR) {
+        return OK;
+    }
+
+    if (actual_opcode.is_read) {
+        directory_controller->functional_access(this->data_cache, actual_opcode.opcode_address, actual_opcode.read_address, MEMORY_OPERATION_READ);
+    }
+    if (actual_opcode.is_read2) {
+        directory_controller->functional_access(this->data_cache, actual_opcode.opcode_address, actual_opcode.read2_address, MEMORY_OPERATION_READ);
+    }
+    if (actual_opcode.is_write) {
+        directory_controller->functional_access(this->data_cache, actual_opcode.opcode_address, actual_opcode.write_address, MEMORY_OPERATION_WRITE);
+    }
+    return OK;
+};
+
 // ============================================================================
 void processor_t::stage_fetch() {
     PROCESSOR_DEBUG_PRINTF("stage_fetch()\n");
@@ -539,6 +639,11 @@ void processor_t::stage_fetch() {
             break;
         }
 
+        /// If the sampled simulation is draining the pipeline
+        if (sinuca_engine.trace_reader->get_trace_opcode_total() >= sinuca_engine.get_fetch_limit()) {
+            break;
+        }
+
         /// Get the next opcode
         if (this->trace_next_opcode.state == PACKAGE_STATE_FREE) {
             valid_opcode = sinuca_engine.trace_reader->trace_fetch(this->core_id, &this->trace_next_opcode);
@@ -592,11 +697,7 @@ void processor_t::stage_fetch() {
     for (i = 0; i < this->stage_fetch_width ; i++) {
 
         /// Locate the next opcode to be treated
-        for (pos_buffer = 0; pos_buffer < this->fetch_buffer.get_size(); pos_buffer++) {
-            if (this->fetch_buffer[pos_buffer].opcode_number == this->fetch_opcode_counter) {
-                break;
-            }
-        }
+        pos_buffer = this->get_fetch_request_position();
 
         /// If next opcode not ready, wait
         if (pos_buffer == this->fetch_buffer.get_size() ||
@@ -608,20 +709,14 @@ void processor_t::stage_fetch() {
 
 
         /// Check if the we are already waiting the same address.
-        bool waiting = false;
-        for (uint32_t k = 0; k < pos_buffer; k++) {
-            if (this->fetch_buffer[k].state == PACKAGE_STATE_WAIT &&
-            /// Make sure the instruction starts and ends inside the block
-            this->cmp_fetch_block(this->fetch_buffer[k].opcode_address, this->fetch_buffer[pos_buffer].opcode_address)) {
-                waiting = true;
-                break;
-            }
-        }
+        uint64_t fetch_block = this->fetch_buffer[pos_buffer].opcode_address & this->not_fetch_offset_bits_mask;
+        std::unordered_map<uint64_t, wake_up_list_t<opcode_package_t> >::iterator waiting = this->fetch_waiting.find(fetch_block);
 
         /// Requested Line
-        if (waiting == true) {
+        if (waiting != this->fetch_waiting.end()) {
             PROCESSOR_DEBUG_PRINTF("\t JUST REQUESTED THE SAME BLOCK (WAIT)\n");
             fetch_buffer[pos_buffer].package_wait(1);
+            this->fetch_waiting_pool.push_back(&waiting->second, &this->fetch_buffer[pos_buffer]);
         }
         /// Line Buffer
         else if (this->cmp_fetch_block(this->fetch_buffer[pos_buffer].opcode_address, this->fetch_opcode_address_line_buffer)) {
@@ -633,6 +728,7 @@ void processor_t::stage_fetch() {
             if (transmission_latency != POSITION_FAIL) {  /// Try to send to the IC.
                 PROCESSOR_DEBUG_PRINTF("\t REQUESTING THE INSTRUCTION (WAIT)\n");
                 fetch_buffer[pos_buffer].package_wait(transmission_latency);
+                this->fetch_waiting_pool.push_back(&this->fetch_waiting[fetch_block], &this->fetch_buffer[pos_buffer]);
             }
             else {  /// Inst. Cache cannot receive, stall the fetch for one cycle.
                 PROCESSOR_DEBUG_PRINTF("\t COULD NOT REQUEST THE INSTRUCTION (-)\n");
@@ -689,6 +785,7 @@ int32_t processor_t::send_instruction_package(opcode_package_t *inst_package) {
 ///  3rd. uop BRANCH
 ///  4th. uop ALU
 ///  5th. uop WRITE MEM. + unaligned
+/// The uops of each static instruction come from trace_static_dict_t::decode_uops
 // ============================================================================
 /// To maintain the right dependencies between the uops and opcodes
 /// If the opcode generates multiple uops, they must be in this format:
@@ -738,241 +835,26 @@ void processor_t::stage_decode() {
         this->decode_opcode_counter++;
 
 
-        // DECODE HMC ====================================================
-        if (this->fetch_buffer.front()->opcode_operation == INSTRUCTION_OPERATION_HMC_ALU    ||
-            this->fetch_buffer.front()->opcode_operation == INSTRUCTION_OPERATION_HMC_ALUR   ){
-
-            new_uop.package_clean();
-            new_uop.opcode_to_uop(this->decode_uop_counter++,
-                                    this->fetch_buffer.front()->opcode_operation,
-                                    this->fetch_buffer.front()->read_address,
-                                    this->fetch_buffer.front()->read_size,
-                                    *this->fetch_buffer.front());
-
-            new_uop.package_ready(this->stage_decode_cycles);
-            PROCESSOR_DEBUG_PRINTF("\t Decode[%d] %s\n", pos_buffer, new_uop.content_to_string().c_str());
-
-            pos_buffer = this->decode_buffer.push_back(new_uop);
-            ERROR_ASSERT_PRINTF(pos_buffer != POSITION_FAIL, "Decoding more uops than MAX_UOP_DECODED (%d)", MAX_UOP_DECODED)
-
-            /// Remove the oldest OPCODE (just decoded) from the fetch buffer
-            this->fetch_buffer.pop_front();
-            continue;
-        }
-
-        /// DECODE READ ====================================================
-        if (this->fetch_buffer.front()->is_read) {
-            new_uop.package_clean();
-            new_uop.opcode_to_uop(this->decode_uop_counter++,
-                                    INSTRUCTION_OPERATION_MEM_LOAD,
-                                    this->fetch_buffer.front()->read_address,
-                                    this->fetch_buffer.front()->read_size,
-                                    *this->fetch_buffer.front());
-
-            /// Fix the dependencies between uops
-            /// READ    ReadRegs    = BaseRegs + IndexRegs
-            ///         WriteRegs   = 258 (Aux Register)
-            if (this->fetch_buffer.front()->opcode_operation != INSTRUCTION_OPERATION_MEM_LOAD){
-                // ===== Read Regs =============================================
-                /// Clear RRegs
-                for (uint32_t i = 0; i < MAX_REGISTERS; i++) {
-                    new_uop.read_regs[i] = POSITION_FAIL;
-                }
-                /// Insert BASE and INDEX into RReg
-                new_uop.read_regs[0] = this->fetch_buffer.front()->base_reg;
-                new_uop.read_regs[1] = this->fetch_buffer.front()->index_reg;
-
-                // ===== Write Regs =============================================
-                /// Clear WRegs
-                for (uint32_t i = 0; i < MAX_REGISTERS; i++) {
-                    new_uop.write_regs[i] = POSITION_FAIL;
-                }
-                /// Insert 258 into WRegs
-                new_uop.write_regs[0] = 258;
-            }
-
-            new_uop.package_ready(this->stage_decode_cycles);
-            PROCESSOR_DEBUG_PRINTF("\t Decode[%d] %s\n", pos_buffer, new_uop.content_to_string().c_str());
-
-            pos_buffer = this->decode_buffer.push_back(new_uop);
-            ERROR_ASSERT_PRINTF(pos_buffer != POSITION_FAIL, "Decoding more uops than MAX_UOP_DECODED (%d)", MAX_UOP_DECODED)
-        }
-
-        /// DECODE READ 2 ==================================================
-        if (this->fetch_buffer.front()->is_read2) {
-            new_uop.package_clean();
-            new_uop.opcode_to_uop(this->decode_uop_counter++,
-                                    INSTRUCTION_OPERATION_MEM_LOAD,
-                                    this->fetch_buffer.front()->read2_address,
-                                    this->fetch_buffer.front()->read2_size,
-                                    *this->fetch_buffer.front());
-
-            /// Fix the dependencies between uops
-            /// READ    ReadRegs    = BaseRegs + IndexRegs
-            ///         WriteRegs   = 258 (Aux Register)
-            if (this->fetch_buffer.front()->opcode_operation != INSTRUCTION_OPERATION_MEM_LOAD){
-                // ===== Read Regs =============================================
-                /// Clear RRegs
-                for (uint32_t i = 0; i < MAX_REGISTERS; i++) {
-                    new_uop.read_regs[i] = POSITION_FAIL;
-                }
-                /// Insert BASE and INDEX into RReg
-                new_uop.read_regs[0] = this->fetch_buffer.front()->base_reg;
-                new_uop.read_regs[1] = this->fetch_buffer.front()->index_reg;
-
-                // ===== Write Regs =============================================
-                /// Clear WRegs
-                for (uint32_t i = 0; i < MAX_REGISTERS; i++) {
-                    new_uop.write_regs[i] = POSITION_FAIL;
-                }
-                /// Insert 258 into WRegs
-                new_uop.write_regs[0] = 258;
-            }
-
-            new_uop.package_ready(this->stage_decode_cycles);
-            PROCESSOR_DEBUG_PRINTF("\t Decode[%d] %s\n", pos_buffer, new_uop.content_to_string().c_str());
-
-            pos_buffer = this->decode_buffer.push_back(new_uop);
-            ERROR_ASSERT_PRINTF(pos_buffer != POSITION_FAIL, "Decoding more uops than MAX_UOP_DECODED (%d)", MAX_UOP_DECODED)
-        }
-
-        /// DECODE ALU =====================================================
-        if (this->fetch_buffer.front()->opcode_operation != INSTRUCTION_OPERATION_MEM_LOAD &&
-        this->fetch_buffer.front()->opcode_operation != INSTRUCTION_OPERATION_MEM_STORE &&
-        this->fetch_buffer.front()->opcode_operation != INSTRUCTION_OPERATION_BRANCH) {
-            new_uop.package_clean();
-            new_uop.opcode_to_uop(this->decode_uop_counter++,
-                                    this->fetch_buffer.front()->opcode_operation,
-                                    0,
-                                    0,
-                                    *this->fetch_buffer.front());
-
-            /// Fix the dependencies between uops
-            /// ALU     ReadRegs    = * + 258 (Aux Register) (if is_read)
-            ///         WriteRegs   = * + 258 (Aux Register) (if is_write)
-            if (this->fetch_buffer.front()->is_read || this->fetch_buffer.front()->is_read2){
-                // ===== Read Regs =============================================
-                /// Insert Reg258 into RReg
-                bool inserted_258 = false;
-                for (uint32_t i = 0; i < MAX_REGISTERS; i++) {
-                    if (new_uop.read_regs[i] == POSITION_FAIL) {
-                        new_uop.read_regs[i] = 258;
-                        inserted_258 = true;
-                        break;
-                    }
-                }
-                ERROR_ASSERT_PRINTF(inserted_258, "Could not insert register_258, all MAX_REGISTERS(%d) used.", MAX_REGISTERS)
-            }
-            if (this->fetch_buffer.front()->is_write){
-                // ===== Write Regs =============================================
-                /// Insert Reg258 into WReg
-                bool inserted_258 = false;
-                for (uint32_t i = 0; i < MAX_REGISTERS; i++) {
-                    if (new_uop.write_regs[i] == POSITION_FAIL) {
-                        new_uop.write_regs[i] = 258;
-                        inserted_258 = true;
-                        break;
-                    }
-                }
-                ERROR_ASSERT_PRINTF(inserted_258, "Could not insert register_258, all MAX_REGISTERS(%d) used.", MAX_REGISTERS)
-            }
-
-            new_uop.package_ready(this->stage_decode_cycles);
-            PROCESSOR_DEBUG_PRINTF("\t Decode[%d] %s\n", pos_buffer, new_uop.content_to_string().c_str());
-
-            pos_buffer = this->decode_buffer.push_back(new_uop);
-            ERROR_ASSERT_PRINTF(pos_buffer != POSITION_FAIL, "Decoding more uops than MAX_UOP_DECODED (%d)", MAX_UOP_DECODED)
-        }
-
-        /// DECODE BRANCH ==================================================
-        if (this->fetch_buffer.front()->opcode_operation == INSTRUCTION_OPERATION_BRANCH) {
-            new_uop.package_clean();
-            new_uop.opcode_to_uop(this->decode_uop_counter++,
-                                    INSTRUCTION_OPERATION_BRANCH,
-                                    0,
-                                    0,
-                                    *this->fetch_buffer.front());
+        /// The uops were cracked once per static instruction, only stamp the dynamic fields
+        opcode_package_t *opcode = this->fetch_buffer.front();
+        uint32_t uops_count;
+        const trace_static_uop_t *static_uops = sinuca_engine.trace_reader->get_static_dict()->get_uops(opcode->static_opcode, &uops_count);
+        for (uint32_t j = 0; j < uops_count; j++) {
+            new_uop.opcode_to_uop(this->decode_uop_counter++, &static_uops[j], opcode);
 
             /// If the instruction is a branch
-            this->inflight_branches++;
-
-            /// Fix the dependencies between uops
-            /// ALU     ReadRegs    = * + 258 (Aux Register) (if is_read)
-            ///         WriteRegs   = * + 258 (Aux Register) (if is_write)
-            if (this->fetch_buffer.front()->is_read || this->fetch_buffer.front()->is_read2){
-                // ===== Read Regs =============================================
-                /// Insert Reg258 into RReg
-                bool inserted_258 = false;
-                for (uint32_t i = 0; i < MAX_REGISTERS; i++) {
-                    if (new_uop.read_regs[i] == POSITION_FAIL) {
-                        new_uop.read_regs[i] = 258;
-                        inserted_258 = true;
-                        break;
-                    }
-                }
-                ERROR_ASSERT_PRINTF(inserted_258, "Could not insert register_258, all MAX_REGISTERS(%d) used.", MAX_REGISTERS)
-            }
-            if (this->fetch_buffer.front()->is_write){
-                // ===== Write Regs =============================================
-                /// Insert Reg258 into WReg
-                bool inserted_258 = false;
-                for (uint32_t i = 0; i < MAX_REGISTERS; i++) {
-                    if (new_uop.write_regs[i] == POSITION_FAIL) {
-                        new_uop.write_regs[i] = 258;
-                        inserted_258 = true;
-                        break;
-                    }
-                }
-                ERROR_ASSERT_PRINTF(inserted_258, "Could not insert register_258, all MAX_REGISTERS(%d) used.", MAX_REGISTERS)
+            if (new_uop.uop_operation == INSTRUCTION_OPERATION_BRANCH) {
+                this->inflight_branches++;
             }
 
             new_uop.package_ready(this->stage_decode_cycles);
             PROCESSOR_DEBUG_PRINTF("\t Decode[%d] %s\n", pos_buffer, new_uop.content_to_string().c_str());
 
             /// Solve the Branch Prediction
-            this->solve_branch(this->fetch_buffer.front()->opcode_number, PROCESSOR_STAGE_DECODE, this->fetch_buffer.front()->opcode_operation);
-
-            pos_buffer = this->decode_buffer.push_back(new_uop);
-            ERROR_ASSERT_PRINTF(pos_buffer != POSITION_FAIL, "Decoding more uops than MAX_UOP_DECODED (%d)", MAX_UOP_DECODED)
-        }
-
-
-        /// DECODE WRITE ===================================================
-        if (this->fetch_buffer.front()->is_write) {
-            new_uop.package_clean();
-            new_uop.opcode_to_uop(this->decode_uop_counter++,
-                                    INSTRUCTION_OPERATION_MEM_STORE,
-                                    this->fetch_buffer.front()->write_address,
-                                    this->fetch_buffer.front()->write_size,
-                                    *this->fetch_buffer.front());
-
-            /// Fix the dependencies between uops
-            /// WRITE   ReadRegs    = * + 258 (Aux Register)
-            ///         WriteRegs   = NULL
-            if (this->fetch_buffer.front()->opcode_operation != INSTRUCTION_OPERATION_MEM_STORE){
-                // ===== Read Regs =============================================
-                /// Insert Reg258 into RReg
-                bool inserted_258 = false;
-                for (uint32_t i = 0; i < MAX_REGISTERS; i++) {
-                    if (new_uop.read_regs[i] == POSITION_FAIL) {
-                        new_uop.read_regs[i] = 258;
-                        inserted_258 = true;
-                        break;
-                    }
-                }
-                ERROR_ASSERT_PRINTF(inserted_258, "Could not insert register_258, all MAX_REGISTERS(%d) used.", MAX_REGISTERS)
-
-                // ===== Write Regs =============================================
-                /// Clear WRegs
-                for (uint32_t i = 0; i < MAX_REGISTERS; i++) {
-                    new_uop.write_regs[i] = POSITION_FAIL;
-                }
-
+            if (new_uop.uop_operation == INSTRUCTION_OPERATION_BRANCH) {
+                this->solve_branch(opcode->opcode_number, PROCESSOR_STAGE_DECODE, opcode->opcode_operation);
             }
 
-            new_uop.package_ready(this->stage_decode_cycles);
-            PROCESSOR_DEBUG_PRINTF("\t Decode[%d] %s\n", pos_buffer, new_uop.content_to_string().c_str());
-
             pos_buffer = this->decode_buffer.push_back(new_uop);
             ERROR_ASSERT_PRINTF(pos_buffer != POSITION_FAIL, "Decoding more uops than MAX_UOP_DECODED (%d)", MAX_UOP_DECODED)
         }
@@ -994,13 +876,8 @@ void processor_t::make_register_dependencies(reorder_buffer_line_t *new_rob_line
         ERROR_ASSERT_PRINTF(read_register < this->register_alias_table_size, "Read Register (%d) > Register Alias Table Size (%d)\n", read_register, this->register_alias_table_size);
         /// If there is a dependency
         if (this->register_alias_table[read_register] != NULL) {
-            for (uint32_t j = 0; j < this->reorder_buffer_size; j++) {
-                if (this->register_alias_table[read_register]->reg_deps_ptr_array[j] == NULL) {
-                    this->register_alias_table[read_register]->reg_deps_ptr_array[j] = new_rob_line;
-                    new_rob_line->wait_reg_deps_number++;
-                    break;
-                }
-            }
+            this->reg_deps_pool.push_back(&this->register_alias_table[read_register]->reg_deps_list, new_rob_line);
+            new_rob_line->wait_reg_deps_number++;
         }
     }
 
@@ -1039,26 +916,16 @@ void processor_t::make_memory_dependencies(memory_order_buffer_line_t *new_mob_l
     /// Create R -> W,  R -> R
     if (this->disambiguation_load_hash[load_hash] != NULL){
         old_mob_line = disambiguation_load_hash[load_hash];
-        for (uint32_t k = 0; k < this->reorder_buffer_size; k++) {
-            if (old_mob_line->mem_deps_ptr_array[k] == NULL) {
-                old_mob_line->mem_deps_ptr_array[k] = new_mob_line;
-                new_mob_line->wait_mem_deps_number++;
-                break;
-            }
-        }
+        this->mem_deps_pool.push_back(&old_mob_line->mem_deps_list, new_mob_line);
+        new_mob_line->wait_mem_deps_number++;
     }
 
 
     /// Create W -> R, W -> W deps.
     if (this->disambiguation_store_hash[store_hash] != NULL){
         old_mob_line = disambiguation_store_hash[store_hash];
-        for (uint32_t k = 0; k < this->reorder_buffer_size; k++) {
-            if (old_mob_line->mem_deps_ptr_array[k] == NULL) {
-                old_mob_line->mem_deps_ptr_array[k] = new_mob_line;
-                new_mob_line->wait_mem_deps_number++;
-                break;
-            }
-        }
+        this->mem_deps_pool.push_back(&old_mob_line->mem_deps_list, new_mob_line);
+        new_mob_line->wait_mem_deps_number++;
     }
 
     /// Add the new entry into LOAD or STORE hash
@@ -1128,7 +995,7 @@ void processor_t::stage_rename() {
         this->reorder_buffer[position_rob].uop.package_ready(this->stage_rename_cycles + this->stage_dispatch_cycles);
         this->reorder_buffer[position_rob].mob_ptr = mob_line;
         /// Insert into the reservation station
-        this->unified_reservation_station.push_back(&this->reorder_buffer[position_rob]);
+        this->reservation_station_insert(&this->reorder_buffer[position_rob]);
 
         /// Solve the Branch Prediction
         if (this->reorder_buffer[position_rob].uop.uop_operation == INSTRUCTION_OPERATION_BRANCH) {
@@ -1137,6 +1004,9 @@ void processor_t::stage_rename() {
 
         /// Make Reg. Deps
         this->make_register_dependencies(&this->reorder_buffer[position_rob]);
+        if (this->reorder_buffer[position_rob].wait_reg_deps_number == 0) {
+            this->dispatch_insert(&this->reorder_buffer[position_rob]);
+        }
 
 
         // =====================================================================
@@ -1219,215 +1089,203 @@ void processor_t::stage_rename() {
 };
 
 // ============================================================================
-void processor_t::stage_dispatch() {
-    PROCESSOR_DEBUG_PRINTF("stage_dispatch()\n");
-
-    /// Reset the number of instructions dispatched in this cycle
-    uint32_t total_dispatched = 0;
-
-    /// Control the total dispatched
-    uint32_t fu_int_alu = 0;
-    uint32_t fu_int_mul = 0;
-    uint32_t fu_int_div = 0;
+/// Heap orders of the dispatch queues, the front is the first ready / the oldest uop
+static bool dispatch_ready_later(reorder_buffer_line_t *rob_lineA, reorder_buffer_line_t *rob_lineB) {
+    return rob_lineA->uop.ready_cycle > rob_lineB->uop.ready_cycle;
+};
 
-    uint32_t fu_fp_alu = 0;
-    uint32_t fu_fp_mul = 0;
-    uint32_t fu_fp_div = 0;
+static bool dispatch_younger(reorder_buffer_line_t *rob_lineA, reorder_buffer_line_t *rob_lineB) {
+    return rob_lineA->uop.uop_number > rob_lineB->uop.uop_number;
+};
 
-    uint32_t fu_mem_load = 0;
-    uint32_t fu_mem_store = 0;
+/// Heap order of the results and answers drained from the execution wheel
+static bool execution_later(const execution_event_t& eventA, const execution_event_t& eventB) {
+    return eventA.order > eventB.order;
+};
 
-    for (uint32_t k = 0; k < this->unified_reservation_station.size() && k < unified_reservation_station_window_size; k++) {
-        reorder_buffer_line_t* reorder_buffer_line = this->unified_reservation_station[k];
+// ============================================================================
+/// Functional unit class able to execute the operation
+functional_unit_t processor_t::get_functional_unit(instruction_operation_t operation) {
+    switch (operation) {
+        // BRANCHES, INTEGERS ALU, NOP and NOT IDENTIFIED
+        case INSTRUCTION_OPERATION_BRANCH:
+        case INSTRUCTION_OPERATION_INT_ALU:
+        case INSTRUCTION_OPERATION_NOP:
+        case INSTRUCTION_OPERATION_OTHER:
+            return FUNCTIONAL_UNIT_INT_ALU;
+        break;
+        case INSTRUCTION_OPERATION_INT_MUL:
+            return FUNCTIONAL_UNIT_INT_MUL;
+        break;
+        case INSTRUCTION_OPERATION_INT_DIV:
+            return FUNCTIONAL_UNIT_INT_DIV;
+        break;
+        case INSTRUCTION_OPERATION_FP_ALU:
+            return FUNCTIONAL_UNIT_FP_ALU;
+        break;
+        case INSTRUCTION_OPERATION_FP_MUL:
+            return FUNCTIONAL_UNIT_FP_MUL;
+        break;
+        case INSTRUCTION_OPERATION_FP_DIV:
+            return FUNCTIONAL_UNIT_FP_DIV;
+        break;
+        case INSTRUCTION_OPERATION_MEM_LOAD:
+        case INSTRUCTION_OPERATION_HMC_ALUR:
+            return FUNCTIONAL_UNIT_MEM_LOAD;
+        break;
+        case INSTRUCTION_OPERATION_MEM_STORE:
+        case INSTRUCTION_OPERATION_HMC_ALU:
+            return FUNCTIONAL_UNIT_MEM_STORE;
+        break;
+        case INSTRUCTION_OPERATION_BARRIER:
+            ERROR_PRINTF("Invalid instruction BARRIER being dispatched.\n");
+        break;
+    }
+    return FUNCTIONAL_UNIT_NUMBER;
+};
 
-        /// No other Functional Unit is available
-        if (total_dispatched >= this->stage_dispatch_width) {
-            break;
-        }
+// ============================================================================
+/// The uop inside the reservation station has no register dependency left,
+/// its ready_cycle does not change until the dispatch.
+void processor_t::dispatch_insert(reorder_buffer_line_t *rob_line) {
+    this->dispatch_waiting.push_back(rob_line);
+    std::push_heap(this->dispatch_waiting.begin(), this->dispatch_waiting.end(), dispatch_ready_later);
+};
 
-        if (reorder_buffer_line->wait_reg_deps_number == 0 &&
-        reorder_buffer_line->uop.ready_cycle <= sinuca_engine.get_global_cycle()) {
-            ERROR_ASSERT_PRINTF(reorder_buffer_line->stage == PROCESSOR_STAGE_RENAME, "Reservation Station with package not in Rename Stage.\n")
-            ERROR_ASSERT_PRINTF(reorder_buffer_line->uop.state == PACKAGE_STATE_READY, "Reservation Station with package not Ready.\n")
-            PROCESSOR_DEBUG_PRINTF("\t Dispatching package\n");
+// ============================================================================
+/// The renamed uop is the youngest entry, the window only grows while all entries fit
+void processor_t::reservation_station_insert(reorder_buffer_line_t *rob_line) {
+    rob_line->reservation_station_prev = this->unified_reservation_station_last;
+    rob_line->reservation_station_next = NULL;
+    if (this->unified_reservation_station_last == NULL) {
+        this->unified_reservation_station_first = rob_line;
+    }
+    else {
+        this->unified_reservation_station_last->reservation_station_next = rob_line;
+    }
+    this->unified_reservation_station_last = rob_line;
 
-            bool dispatched = false;
+    this->unified_reservation_station_size++;
+    if (this->unified_reservation_station_size == this->unified_reservation_station_window_size + 1) {
+        this->unified_reservation_station_window_end = rob_line->reservation_station_prev;
+    }
+};
 
-            switch (reorder_buffer_line->uop.uop_operation) {
-            // =============================================================
-                // BRANCHES
-                case INSTRUCTION_OPERATION_BRANCH:
-                // INTEGERS ALU ===============================================
-                case INSTRUCTION_OPERATION_INT_ALU:
-                // NOP
-                case INSTRUCTION_OPERATION_NOP:
-                // NOT IDENTIFIED
-                case INSTRUCTION_OPERATION_OTHER:
-                    if (fu_int_alu < this->number_fu_int_alu) {
-                        for (uint32_t i = 0; i < this->number_fu_int_alu; i++) {
-                            if (this->ready_cycle_fu_int_alu[i] <= sinuca_engine.get_global_cycle()) {
-
-                                /// Solve the Branch Prediction
-                                if (reorder_buffer_line->uop.uop_operation == INSTRUCTION_OPERATION_BRANCH) {
-                                    this->solve_branch(reorder_buffer_line->uop.opcode_number, PROCESSOR_STAGE_DISPATCH, reorder_buffer_line->uop.uop_operation);
-                                }
-
-                                this->ready_cycle_fu_int_alu[i] = sinuca_engine.get_global_cycle() + this->wait_between_fu_int_alu;
-
-                                fu_int_alu++;
-                                dispatched = true;
-                                reorder_buffer_line->stage = PROCESSOR_STAGE_EXECUTION;
-                                this->stat_dispatch_cycles_fu_int_alu += sinuca_engine.get_global_cycle() - reorder_buffer_line->uop.ready_cycle;
-                                reorder_buffer_line->uop.package_ready(this->latency_fu_int_alu);
-                                break;
-                            }
-                        }
-                    }
-                break;
-                // INTEGERS MUL ===============================================
-                case INSTRUCTION_OPERATION_INT_MUL:
-                    if (fu_int_mul < this->number_fu_int_mul) {
-                        for (uint32_t i = 0; i < this->number_fu_int_mul; i++) {
-                            if (this->ready_cycle_fu_int_mul[i] <= sinuca_engine.get_global_cycle()) {
-                                this->ready_cycle_fu_int_mul[i] = sinuca_engine.get_global_cycle() + this->wait_between_fu_int_mul;
-
-                                fu_int_mul++;
-                                dispatched = true;
-                                reorder_buffer_line->stage = PROCESSOR_STAGE_EXECUTION;
-                                this->stat_dispatch_cycles_fu_int_mul += sinuca_engine.get_global_cycle() - reorder_buffer_line->uop.ready_cycle;
-                                reorder_buffer_line->uop.package_ready(this->latency_fu_int_mul);
-                                break;
-                            }
-                        }
-                    }
-                break;
-                // INTEGERS DIV ===============================================
-                case INSTRUCTION_OPERATION_INT_DIV:
-                    if (fu_int_div < this->number_fu_int_div) {
-                        for (uint32_t i = 0; i < this->number_fu_int_div; i++) {
-                            if (this->ready_cycle_fu_int_div[i] <= sinuca_engine.get_global_cycle()) {
-                                this->ready_cycle_fu_int_div[i] = sinuca_engine.get_global_cycle() + this->wait_between_fu_int_div;
-
-                                fu_int_div++;
-                                dispatched = true;
-                                reorder_buffer_line->stage = PROCESSOR_STAGE_EXECUTION;
-                                this->stat_dispatch_cycles_fu_int_div += sinuca_engine.get_global_cycle() - reorder_buffer_line->uop.ready_cycle;
-                                reorder_buffer_line->uop.package_ready(this->latency_fu_int_div);
-                                break;
-                            }
-                        }
-                    }
-                break;
+// ============================================================================
+/// Only entries inside the window are dispatched, so the next entry after
+/// the window end slides into the window
+void processor_t::reservation_station_remove(reorder_buffer_line_t *rob_line) {
+    if (this->unified_reservation_station_window_end != NULL) {
+        ERROR_ASSERT_PRINTF(rob_line->uop.uop_number <= this->unified_reservation_station_window_end->uop.uop_number, "Dispatched package outside the Reservation Station window.\n")
+        if (this->unified_reservation_station_size - 1 > this->unified_reservation_station_window_size) {
+            this->unified_reservation_station_window_end = this->unified_reservation_station_window_end->reservation_station_next;
+        }
+        else {
+            this->unified_reservation_station_window_end = NULL;
+        }
+    }
+    this->unified_reservation_station_size--;
 
-                // =============================================================
-                // FLOAT POINT ALU ============================================
-                case INSTRUCTION_OPERATION_FP_ALU:
-                    if (fu_fp_alu < this->number_fu_fp_alu) {
-                        for (uint32_t i = 0; i < this->number_fu_fp_alu; i++) {
-                            if (this->ready_cycle_fu_fp_alu[i] <= sinuca_engine.get_global_cycle()) {
-                                this->ready_cycle_fu_fp_alu[i] = sinuca_engine.get_global_cycle() + this->wait_between_fu_fp_alu;
-
-                                fu_fp_alu++;
-                                dispatched = true;
-                                reorder_buffer_line->stage = PROCESSOR_STAGE_EXECUTION;
-                                this->stat_dispatch_cycles_fu_fp_alu += sinuca_engine.get_global_cycle() - reorder_buffer_line->uop.ready_cycle;
-                                reorder_buffer_line->uop.package_ready(this->latency_fu_fp_alu);
-                                break;
-                            }
-                        }
-                    }
-                break;
-                // FLOAT POINT MUL ============================================
-                case INSTRUCTION_OPERATION_FP_MUL:
-                    if (fu_fp_mul < this->number_fu_fp_mul) {
-                        for (uint32_t i = 0; i < this->number_fu_fp_mul; i++) {
-                            if (this->ready_cycle_fu_fp_mul[i] <= sinuca_engine.get_global_cycle()) {
-                                this->ready_cycle_fu_fp_mul[i] = sinuca_engine.get_global_cycle() + this->wait_between_fu_fp_mul;
-
-                                fu_fp_mul++;
-                                dispatched = true;
-                                reorder_buffer_line->stage = PROCESSOR_STAGE_EXECUTION;
-                                this->stat_dispatch_cycles_fu_fp_mul += sinuca_engine.get_global_cycle() - reorder_buffer_line->uop.ready_cycle;
-                                reorder_buffer_line->uop.package_ready(this->latency_fu_fp_mul);
-                                break;
-                            }
-                        }
-                    }
-                break;
-                // FLOAT POINT DIV ============================================
-                case INSTRUCTION_OPERATION_FP_DIV:
-                    if (fu_fp_div < this->number_fu_fp_div) {
-                        for (uint32_t i = 0; i < this->number_fu_fp_div; i++) {
-                            if (this->ready_cycle_fu_fp_div[i] <= sinuca_engine.get_global_cycle()) {
-                                this->ready_cycle_fu_fp_div[i] = sinuca_engine.get_global_cycle() + this->wait_between_fu_fp_div;
-
-                                fu_fp_div++;
-                                dispatched = true;
-                                reorder_buffer_line->stage = PROCESSOR_STAGE_EXECUTION;
-                                this->stat_dispatch_cycles_fu_fp_div += sinuca_engine.get_global_cycle() - reorder_buffer_line->uop.ready_cycle;
-                                reorder_buffer_line->uop.package_ready(this->latency_fu_fp_div);
-                                break;
-                            }
-                        }
-                    }
-                break;
+    if (rob_line->reservation_station_prev == NULL) {
+        this->unified_reservation_station_first = rob_line->reservation_station_next;
+    }
+    else {
+        rob_line->reservation_station_prev->reservation_station_next = rob_line->reservation_station_next;
+    }
+    if (rob_line->reservation_station_next == NULL) {
+        this->unified_reservation_station_last = rob_line->reservation_station_prev;
+    }
+    else {
+        rob_line->reservation_station_next->reservation_station_prev = rob_line->reservation_station_prev;
+    }
+    rob_line->reservation_station_prev = NULL;
+    rob_line->reservation_station_next = NULL;
+};
 
-                // =============================================================
-                // MEMORY OPERATIONS ==========================================
-                case INSTRUCTION_OPERATION_MEM_LOAD:
-                case INSTRUCTION_OPERATION_HMC_ALUR:
-                    if (fu_mem_load < this->number_fu_mem_load) {
-                        for (uint32_t i = 0; i < this->number_fu_mem_load; i++) {
-                            if (this->ready_cycle_fu_mem_load[i] <= sinuca_engine.get_global_cycle()) {
-                                this->ready_cycle_fu_mem_load[i] = sinuca_engine.get_global_cycle() + this->wait_between_fu_mem_load;
-
-                                fu_mem_load++;
-                                dispatched = true;
-                                reorder_buffer_line->stage = PROCESSOR_STAGE_EXECUTION;
-                                this->stat_dispatch_cycles_fu_mem_load += sinuca_engine.get_global_cycle() - reorder_buffer_line->uop.ready_cycle;
-                                reorder_buffer_line->uop.package_ready(this->latency_fu_mem_load);
-                                break;
-                            }
-                        }
-                    }
-                break;
+// ============================================================================
+/// The read answer is ready, it leaves the MOB on its ready_cycle
+void processor_t::execution_insert_read(memory_order_buffer_line_t *mob_line) {
+    execution_event_t event;
+    event.order = mob_line - this->memory_order_buffer_read;
+    event.rob_line = NULL;
+    event.mob_line = mob_line;
+    this->execution_wheel.insert(mob_line->memory_request.ready_cycle, event);
+};
 
-                case INSTRUCTION_OPERATION_MEM_STORE:
-                case INSTRUCTION_OPERATION_HMC_ALU:
-                    if (fu_mem_store < this->number_fu_mem_store) {
-                        for (uint32_t i = 0; i < this->number_fu_mem_store; i++) {
-                            if (this->ready_cycle_fu_mem_store[i] <= sinuca_engine.get_global_cycle()) {
-                                this->ready_cycle_fu_mem_store[i] = sinuca_engine.get_global_cycle() + this->wait_between_fu_mem_store;
-
-                                fu_mem_store++;
-                                dispatched = true;
-                                reorder_buffer_line->stage = PROCESSOR_STAGE_EXECUTION;
-                                this->stat_dispatch_cycles_fu_mem_store += sinuca_engine.get_global_cycle() - reorder_buffer_line->uop.ready_cycle;
-                                reorder_buffer_line->uop.package_ready(this->latency_fu_mem_store);
-                                break;
-                            }
-                        }
-                    }
-                break;
+// ============================================================================
+/// Dispatches the oldest ready uops with a free functional unit, in the same
+/// order of a scan over the first unified_reservation_station_window_size
+/// entries of the reservation station not dispatched in this cycle.
+void processor_t::stage_dispatch() {
+    PROCESSOR_DEBUG_PRINTF("stage_dispatch()\n");
+    uint64_t cycle = sinuca_engine.get_global_cycle();
+
+    /// The operands are ready, wait for a functional unit of the class
+    while (!this->dispatch_waiting.empty() &&
+    this->dispatch_waiting.front()->uop.ready_cycle <= cycle) {
+        reorder_buffer_line_t *reorder_buffer_line = this->dispatch_waiting.front();
+        std::pop_heap(this->dispatch_waiting.begin(), this->dispatch_waiting.end(), dispatch_ready_later);
+        this->dispatch_waiting.pop_back();
+
+        functional_unit_t fu = this->get_functional_unit(reorder_buffer_line->uop.uop_operation);
+        this->dispatch_ready[fu].push_back(reorder_buffer_line);
+        std::push_heap(this->dispatch_ready[fu].begin(), this->dispatch_ready[fu].end(), dispatch_younger);
+        this->dispatch_ready_mask |= 1u << fu;
+    }
 
-                case INSTRUCTION_OPERATION_BARRIER:
-                    ERROR_PRINTF("Invalid instruction BARRIER being dispatched.\n");
-                break;
+    /// Up to stage_dispatch_width uops per cycle
+    for (uint32_t total_dispatched = 0; this->dispatch_ready_mask != 0 && total_dispatched < this->stage_dispatch_width; total_dispatched++) {
+        /// The dispatched entries leave the reservation station, so the window moves
+        uint64_t window_last = this->get_dispatch_window_last();
+
+        /// Oldest uop among the classes with a free unit
+        uint32_t fu = FUNCTIONAL_UNIT_NUMBER;
+        for (uint32_t mask = this->dispatch_ready_mask; mask != 0; mask &= mask - 1) {
+            uint32_t i = __builtin_ctz(mask);
+            if (this->dispatch_ready[i].front()->uop.uop_number <= window_last &&
+            this->fu_ready_cycle[i][0] <= cycle &&
+            (fu == FUNCTIONAL_UNIT_NUMBER || this->dispatch_ready[i].front()->uop.uop_number < this->dispatch_ready[fu].front()->uop.uop_number)) {
+                fu = i;
             }
+        }
+        if (fu == FUNCTIONAL_UNIT_NUMBER) {
+            break;
+        }
 
-            if (dispatched == true) {
-                total_dispatched++;
-                /// Insert into the Functional Unit
-                this->unified_functional_units.push_back(reorder_buffer_line);
-                /// Remove from the Reservation Station
-                this->unified_reservation_station.erase(this->unified_reservation_station.begin() + k);
-                k--;
-            }
-            else {
-                PROCESSOR_DEBUG_PRINTF("\t\t Could not insert on functional_unit\n");
-            }
+        reorder_buffer_line_t* reorder_buffer_line = this->dispatch_ready[fu].front();
+        std::pop_heap(this->dispatch_ready[fu].begin(), this->dispatch_ready[fu].end(), dispatch_younger);
+        this->dispatch_ready[fu].pop_back();
+        if (this->dispatch_ready[fu].empty()) {
+            this->dispatch_ready_mask &= ~(1u << fu);
+        }
+
+        ERROR_ASSERT_PRINTF(reorder_buffer_line->stage == PROCESSOR_STAGE_RENAME, "Reservation Station with package not in Rename Stage.\n")
+        ERROR_ASSERT_PRINTF(reorder_buffer_line->uop.state == PACKAGE_STATE_READY, "Reservation Station with package not Ready.\n")
+        PROCESSOR_DEBUG_PRINTF("\t Dispatching package on %s\n", get_enum_functional_unit_char(static_cast<functional_unit_t>(fu)));
 
+        /// Solve the Branch Prediction
+        if (reorder_buffer_line->uop.uop_operation == INSTRUCTION_OPERATION_BRANCH) {
+            this->solve_branch(reorder_buffer_line->uop.opcode_number, PROCESSOR_STAGE_DISPATCH, reorder_buffer_line->uop.uop_operation);
         }
+
+        /// The first free unit goes back to the heap busy
+        uint64_t *ready_cycle_fu = this->fu_ready_cycle[fu];
+        std::pop_heap(ready_cycle_fu, ready_cycle_fu + this->fu_number[fu], std::greater<uint64_t>());
+        ready_cycle_fu[this->fu_number[fu] - 1] = cycle + this->fu_wait_between[fu];
+        std::push_heap(ready_cycle_fu, ready_cycle_fu + this->fu_number[fu], std::greater<uint64_t>());
+
+        reorder_buffer_line->stage = PROCESSOR_STAGE_EXECUTION;
+        *this->fu_stat_dispatch_cycles[fu] += cycle - reorder_buffer_line->uop.ready_cycle;
+        reorder_buffer_line->uop.package_ready(this->fu_latency[fu]);
+
+        /// Insert into the Functional Unit
+        execution_event_t event;
+        event.order = this->execution_dispatch_order++;
+        event.rob_line = reorder_buffer_line;
+        event.mob_line = NULL;
+        this->execution_wheel.insert(reorder_buffer_line->uop.ready_cycle, event);
+        /// Remove from the Reservation Station
+        this->reservation_station_remove(reorder_buffer_line);
     }
 };
 
@@ -1437,116 +1295,120 @@ void processor_t::stage_execution() {
     int32_t position_mem;
 
     // ========================================================================
-    /// REMOVE MEMORY PACKAGE READS which are ready!
-    if (this->memory_order_buffer_read_received != 0){
-        /// Control Parallel Requests
-        for (uint32_t slot = 0; slot < this->memory_order_buffer_read_size; slot++) {
-            if (this->memory_order_buffer_read[slot].memory_request.state == PACKAGE_STATE_READY &&
-            this->memory_order_buffer_read[slot].memory_request.ready_cycle <= sinuca_engine.get_global_cycle()) {
-                ERROR_ASSERT_PRINTF(this->memory_order_buffer_read[slot].uop_executed == true, "Removing memory read before being executed.\n")
-                ERROR_ASSERT_PRINTF(this->memory_order_buffer_read[slot].wait_mem_deps_number == 0, "Number of memory dependencies should be zero.\n")
-                ERROR_ASSERT_PRINTF(this->memory_order_buffer_read[slot].memory_request.is_answer == true, "Removing a package from MOB which is not answer.\n")
-                /// Solve ROB, and send to COMMIT
-                this->memory_order_buffer_read[slot].rob_ptr->stage = PROCESSOR_STAGE_COMMIT;
-                this->memory_order_buffer_read[slot].rob_ptr->uop.package_ready(this->stage_commit_cycles);
-                this->memory_order_buffer_read[slot].rob_ptr->mob_ptr = NULL;
-                this->solve_register_dependency(this->memory_order_buffer_read[slot].rob_ptr);
-                this->solve_memory_dependency(&this->memory_order_buffer_read[slot]);
-                /// Clean MOB line.
-                this->memory_order_buffer_read[slot].package_clean();
-                this->memory_order_buffer_read_received--;
-                break;
-            }
+    /// Results and answers up to this cycle, taken in dispatch order and MOB slot order
+    if (!this->execution_wheel.is_empty()) {
+        this->execution_wheel.drain(sinuca_engine.get_global_cycle(), &this->execution_drained);
+        for (uint32_t i = 0; i < this->execution_drained.size(); i++) {
+            std::vector<execution_event_t> *done = (this->execution_drained[i].mob_line == NULL) ? &this->execution_done_functional_unit
+                                                                                                 : &this->execution_done_read;
+            done->push_back(this->execution_drained[i]);
+            std::push_heap(done->begin(), done->end(), execution_later);
         }
+        this->execution_drained.clear();
+    }
+
+    // ========================================================================
+    /// REMOVE MEMORY PACKAGE READS which are ready! (One per cycle, first slot)
+    if (!this->execution_done_read.empty()) {
+        memory_order_buffer_line_t *mob_line = this->execution_done_read.front().mob_line;
+        std::pop_heap(this->execution_done_read.begin(), this->execution_done_read.end(), execution_later);
+        this->execution_done_read.pop_back();
+
+        ERROR_ASSERT_PRINTF(mob_line->memory_request.state == PACKAGE_STATE_READY, "Removing memory read not ready.\n")
+        ERROR_ASSERT_PRINTF(mob_line->uop_executed == true, "Removing memory read before being executed.\n")
+        ERROR_ASSERT_PRINTF(mob_line->wait_mem_deps_number == 0, "Number of memory dependencies should be zero.\n")
+        ERROR_ASSERT_PRINTF(mob_line->memory_request.is_answer == true, "Removing a package from MOB which is not answer.\n")
+        /// Solve ROB, and send to COMMIT
+        mob_line->rob_ptr->stage = PROCESSOR_STAGE_COMMIT;
+        mob_line->rob_ptr->uop.package_ready(this->stage_commit_cycles);
+        mob_line->rob_ptr->mob_ptr = NULL;
+        this->solve_register_dependency(mob_line->rob_ptr);
+        this->solve_memory_dependency(mob_line);
+        /// Clean MOB line.
+        mob_line->package_clean();
+        this->memory_order_buffer_read_received--;
     }
 
     // ========================================================================
     /// Commit the executed
     // ========================================================================
     uint32_t total_executed = 0;
-    for (uint32_t k = 0; k < this->unified_functional_units.size(); k++) {
-        reorder_buffer_line_t* reorder_buffer_line = this->unified_functional_units[k];
+    while (!this->execution_done_functional_unit.empty()) {
+        reorder_buffer_line_t* reorder_buffer_line = this->execution_done_functional_unit.front().rob_line;
 
         /// No other Functional Unit is available
         if (total_executed >= this->stage_execution_width) {
             break;
         }
 
-        if (reorder_buffer_line->uop.ready_cycle <= sinuca_engine.get_global_cycle()) {
-            ERROR_ASSERT_PRINTF(reorder_buffer_line->stage == PROCESSOR_STAGE_EXECUTION, "Functional Unit with package not in Execution Stage.\n%s\n",
-                                                                                        reorder_buffer_line->content_to_string().c_str());
-            ERROR_ASSERT_PRINTF(reorder_buffer_line->uop.state == PACKAGE_STATE_READY, "Functional Unit with package not Ready.\n")
+        /// Remove from the Functional Units
+        std::pop_heap(this->execution_done_functional_unit.begin(), this->execution_done_functional_unit.end(), execution_later);
+        this->execution_done_functional_unit.pop_back();
+
+        ERROR_ASSERT_PRINTF(reorder_buffer_line->stage == PROCESSOR_STAGE_EXECUTION, "Functional Unit with package not in Execution Stage.\n%s\n",
+                                                                                    reorder_buffer_line->content_to_string().c_str());
+        ERROR_ASSERT_PRINTF(reorder_buffer_line->uop.state == PACKAGE_STATE_READY, "Functional Unit with package not Ready.\n")
+
+        switch (reorder_buffer_line->uop.uop_operation) {
+        // =============================================================
+            // BRANCHES
+            case INSTRUCTION_OPERATION_BRANCH:
+                /// Solve the Branch Prediction
+                this->solve_branch(reorder_buffer_line->uop.opcode_number, PROCESSOR_STAGE_EXECUTION, reorder_buffer_line->uop.uop_operation);
+            // INTEGERS ===============================================
+            case INSTRUCTION_OPERATION_INT_ALU:
+            case INSTRUCTION_OPERATION_NOP:
+            case INSTRUCTION_OPERATION_OTHER:
+
+            case INSTRUCTION_OPERATION_INT_MUL:
+            case INSTRUCTION_OPERATION_INT_DIV:
+            // FLOAT POINT ===============================================
+            case INSTRUCTION_OPERATION_FP_ALU:
+            case INSTRUCTION_OPERATION_FP_MUL:
+            case INSTRUCTION_OPERATION_FP_DIV:
+            // INTEGERS ==================================================
+                PROCESSOR_DEBUG_PRINTF("\t Executing package:%s\n", reorder_buffer_line->uop.content_to_string().c_str());
+                reorder_buffer_line->stage = PROCESSOR_STAGE_COMMIT;
+                reorder_buffer_line->uop.package_ready(this->stage_execution_cycles + this->stage_commit_cycles);
+                this->solve_register_dependency(reorder_buffer_line);
+                total_executed++;
+            break;
 
-            switch (reorder_buffer_line->uop.uop_operation) {
-            // =============================================================
-                // BRANCHES
-                case INSTRUCTION_OPERATION_BRANCH:
-                    /// Solve the Branch Prediction
-                    this->solve_branch(reorder_buffer_line->uop.opcode_number, PROCESSOR_STAGE_EXECUTION, reorder_buffer_line->uop.uop_operation);
-                // INTEGERS ===============================================
-                case INSTRUCTION_OPERATION_INT_ALU:
-                case INSTRUCTION_OPERATION_NOP:
-                case INSTRUCTION_OPERATION_OTHER:
+            // MEMORY LOAD/STORE ==========================================
+            /// FUNC_UNIT_MEM_LOAD => READ_BUFFER
+            case INSTRUCTION_OPERATION_MEM_LOAD:
+            case INSTRUCTION_OPERATION_HMC_ALUR:
+            {
+                ERROR_ASSERT_PRINTF(reorder_buffer_line->mob_ptr != NULL, "Read with a NULL pointer to MOB")
+                this->memory_order_buffer_read_executed++;
+                reorder_buffer_line->mob_ptr->uop_executed = true;
+                /// Waits for the cache to send the answer
+                reorder_buffer_line->uop.state = PACKAGE_STATE_TRANSMIT;
+                reorder_buffer_line->uop.package_ready(this->stage_execution_cycles);
+                total_executed++;
+            }
+            break;
 
-                case INSTRUCTION_OPERATION_INT_MUL:
-                case INSTRUCTION_OPERATION_INT_DIV:
-                // FLOAT POINT ===============================================
-                case INSTRUCTION_OPERATION_FP_ALU:
-                case INSTRUCTION_OPERATION_FP_MUL:
-                case INSTRUCTION_OPERATION_FP_DIV:
-                // INTEGERS ==================================================
-                    PROCESSOR_DEBUG_PRINTF("\t Executing package:%s\n", reorder_buffer_line->uop.content_to_string().c_str());
-                    reorder_buffer_line->stage = PROCESSOR_STAGE_COMMIT;
-                    reorder_buffer_line->uop.package_ready(this->stage_execution_cycles + this->stage_commit_cycles);
-                    this->solve_register_dependency(reorder_buffer_line);
-                    total_executed++;
-                    /// Remove from the Functional Units
-                    this->unified_functional_units.erase(this->unified_functional_units.begin() + k);
-                    k--;
-                break;
 
-                // MEMORY LOAD/STORE ==========================================
-                /// FUNC_UNIT_MEM_LOAD => READ_BUFFER
-                case INSTRUCTION_OPERATION_MEM_LOAD:
-                case INSTRUCTION_OPERATION_HMC_ALUR:
-                {
-                    ERROR_ASSERT_PRINTF(reorder_buffer_line->mob_ptr != NULL, "Read with a NULL pointer to MOB")
-                    this->memory_order_buffer_read_executed++;
-                    reorder_buffer_line->mob_ptr->uop_executed = true;
-                    /// Waits for the cache to send the answer
-                    reorder_buffer_line->uop.state = PACKAGE_STATE_TRANSMIT;
-                    reorder_buffer_line->uop.package_ready(this->stage_execution_cycles);
-                    total_executed++;
-                    /// Remove from the Functional Units
-                    this->unified_functional_units.erase(this->unified_functional_units.begin() + k);
-                    k--;
-                }
-                break;
+            /// FUNC_UNIT_MEM_STORE => WRITE_BUFFER
+            case INSTRUCTION_OPERATION_MEM_STORE:
+            case INSTRUCTION_OPERATION_HMC_ALU:
+            {
+                ERROR_ASSERT_PRINTF(reorder_buffer_line->mob_ptr != NULL, "Write with a NULL pointer to MOB")
+                this->memory_order_buffer_write_executed++;
+                reorder_buffer_line->mob_ptr->uop_executed = true;
 
+                /// Waits for the cache to receive the package
+                reorder_buffer_line->uop.state = PACKAGE_STATE_TRANSMIT;
+                reorder_buffer_line->uop.package_ready(this->stage_execution_cycles);
 
-                /// FUNC_UNIT_MEM_STORE => WRITE_BUFFER
-                case INSTRUCTION_OPERATION_MEM_STORE:
-                case INSTRUCTION_OPERATION_HMC_ALU:
-                {
-                    ERROR_ASSERT_PRINTF(reorder_buffer_line->mob_ptr != NULL, "Write with a NULL pointer to MOB")
-                    this->memory_order_buffer_write_executed++;
-                    reorder_buffer_line->mob_ptr->uop_executed = true;
-
-                    /// Waits for the cache to receive the package
-                    reorder_buffer_line->uop.state = PACKAGE_STATE_TRANSMIT;
-                    reorder_buffer_line->uop.package_ready(this->stage_execution_cycles);
-
-                    total_executed++;
-                    /// Remove from the Functional Units
-                    this->unified_functional_units.erase(this->unified_functional_units.begin() + k);
-                    k--;
-                }
-                break;
-
-                case INSTRUCTION_OPERATION_BARRIER:
-                    ERROR_PRINTF("Invalid instruction BARRIER being executed.\n");
-                break;
+                total_executed++;
             }
+            break;
+
+            case INSTRUCTION_OPERATION_BARRIER:
+                ERROR_PRINTF("Invalid instruction BARRIER being executed.\n");
+            break;
         }
     }
 
@@ -1637,19 +1499,15 @@ void processor_t::solve_register_dependency(reorder_buffer_line_t *rob_line) {
     /// SOLVE REGISTER DEPENDENCIES - RAT
     // =========================================================================
     /// Send message to acknowledge the dependency is over
-    for (uint32_t j = 0; j < this->reorder_buffer_size; j++) {
-        /// There is an unsolved dependency
-        if (rob_line->reg_deps_ptr_array[j] != NULL) {
-            rob_line->reg_deps_ptr_array[j]->wait_reg_deps_number--;
-            /// This update the ready cycle, and it is usefull to compute the time each instruction waits for the functional unit
-            if (rob_line->reg_deps_ptr_array[j]->uop.ready_cycle <= sinuca_engine.get_global_cycle()) {
-                rob_line->reg_deps_ptr_array[j]->uop.ready_cycle = sinuca_engine.get_global_cycle() + this->register_forward_latency;
-            }
-            rob_line->reg_deps_ptr_array[j] = NULL;
+    while (!rob_line->reg_deps_list.is_empty()) {
+        reorder_buffer_line_t *deps_line = this->reg_deps_pool.pop_front(&rob_line->reg_deps_list);
+        deps_line->wait_reg_deps_number--;
+        /// This update the ready cycle, and it is usefull to compute the time each instruction waits for the functional unit
+        if (deps_line->uop.ready_cycle <= sinuca_engine.get_global_cycle()) {
+            deps_line->uop.ready_cycle = sinuca_engine.get_global_cycle() + this->register_forward_latency;
         }
-        /// All the dependencies are solved
-        else {
-            break;
+        if (deps_line->wait_reg_deps_number == 0) {
+            this->dispatch_insert(deps_line);
         }
     }
 }
@@ -1687,14 +1545,11 @@ void processor_t::solve_memory_dependency(memory_order_buffer_line_t *mob_line)
     /// SOLVE MEMORY DEPENDENCIES - MOB
     // =========================================================================
     /// Send message to acknowledge the dependency is over
-    for (uint32_t j = 0; j < this->reorder_buffer_size; j++) {
-        /// All the dependencies are solved
-        if (mob_line->mem_deps_ptr_array[j] == NULL) {
-            break;
-        }
+    while (!mob_line->mem_deps_list.is_empty()) {
+        memory_order_buffer_line_t *deps_line = this->mem_deps_pool.pop_front(&mob_line->mem_deps_list);
 
         /// Keep track of false positives
-        if (mob_line->mem_deps_ptr_array[j]->memory_request.memory_address != mob_line->memory_request.memory_address) {
+        if (deps_line->memory_request.memory_address != mob_line->memory_request.memory_address) {
             if (mob_line->memory_request.memory_operation == MEMORY_OPERATION_READ) {
                 add_stat_disambiguation_read_false_positive();
             }
@@ -1704,14 +1559,14 @@ void processor_t::solve_memory_dependency(memory_order_buffer_line_t *mob_line)
         }
 
         /// There is an unsolved dependency
-        mob_line->mem_deps_ptr_array[j]->wait_mem_deps_number--;
+        deps_line->wait_mem_deps_number--;
 
         if (this->solve_address_to_address) {
-            if (mob_line->mem_deps_ptr_array[j]->uop_executed == true &&
-            mob_line->mem_deps_ptr_array[j]->wait_mem_deps_number == 0 &&
-            mob_line->mem_deps_ptr_array[j]->memory_request.memory_operation == MEMORY_OPERATION_READ &&
-            mob_line->mem_deps_ptr_array[j]->memory_request.memory_address == mob_line->memory_request.memory_address &&
-            mob_line->mem_deps_ptr_array[j]->memory_request.memory_size == mob_line->memory_request.memory_size) {
+            if (deps_line->uop_executed == true &&
+            deps_line->wait_mem_deps_number == 0 &&
+            deps_line->memory_request.memory_operation == MEMORY_OPERATION_READ &&
+            deps_line->memory_request.memory_address == mob_line->memory_request.memory_address &&
+            deps_line->memory_request.memory_size == mob_line->memory_request.memory_size) {
                 /// Solve the LOAD->LOAD and STORE->LOAD
 
                 PROCESSOR_DEBUG_PRINTF("THIS: %s %" PRIu64 " \t",
@@ -1719,24 +1574,22 @@ void processor_t::solve_memory_dependency(memory_order_buffer_line_t *mob_line)
                                         mob_line->memory_request.memory_address);
 
                 PROCESSOR_DEBUG_PRINTF("SOLVES: %s %" PRIu64 "\n",
-                                        mob_line->mem_deps_ptr_array[j]->memory_request.memory_operation == MEMORY_OPERATION_READ ? "READ" : "WRITE",
-                                        mob_line->mem_deps_ptr_array[j]->memory_request.memory_address);
+                                        deps_line->memory_request.memory_operation == MEMORY_OPERATION_READ ? "READ" : "WRITE",
+                                        deps_line->memory_request.memory_address);
 
                 this->add_stat_address_to_address();
-                mob_line->mem_deps_ptr_array[j]->memory_request.state = PACKAGE_STATE_READY;
-                mob_line->mem_deps_ptr_array[j]->memory_request.ready_cycle =  sinuca_engine.get_global_cycle() + this->register_forward_latency;
-                mob_line->mem_deps_ptr_array[j]->memory_request.is_answer = true;
+                deps_line->memory_request.state = PACKAGE_STATE_READY;
+                deps_line->memory_request.ready_cycle =  sinuca_engine.get_global_cycle() + this->register_forward_latency;
+                deps_line->memory_request.is_answer = true;
 
                 /// Remove from the executed "list"
                 this->memory_order_buffer_read_executed--;
                 /// Add to the received "list"
                 this->memory_order_buffer_read_received++;
+                this->execution_insert_read(deps_line);
 
             }
         }
-
-        /// This update the ready cycle, and it is usefull to compute the time each instruction waits for the functional unit
-        mob_line->mem_deps_ptr_array[j] = NULL;
     }
 };
 
@@ -1854,6 +1707,14 @@ void processor_t::stage_commit() {
 
 // ============================================================================
 void processor_t::clock(uint32_t subcycle) {
+    this->clock_pipeline(subcycle);
+    this->clock_fetch(subcycle);
+};
+
+// ============================================================================
+/// Stages after the fetch, they only touch this core and its first level caches,
+/// so the parallel clock runs them for different cores at the same time.
+void processor_t::clock_pipeline(uint32_t subcycle) {
     (void) subcycle;
     PROCESSOR_DEBUG_PRINTF("==================== ID(%u) ", this->get_id());
     PROCESSOR_DEBUG_PRINTF("====================\n");
@@ -1895,6 +1756,13 @@ void processor_t::clock(uint32_t subcycle) {
         /// Store on Decode Buffer
         this->stage_decode();
     }
+};
+
+// ============================================================================
+/// The fetch reads the shared trace reader and synchronizes with the other cores,
+/// it always runs in the cores order.
+void processor_t::clock_fetch(uint32_t subcycle) {
+    (void) subcycle;
 
     /// Something to be done this cycle. -- Improve the performance
     if (!this->trace_over || !this->fetch_buffer.is_empty()) {
@@ -1905,14 +1773,217 @@ void processor_t::clock(uint32_t subcycle) {
     }
 
     if (this->trace_over) {
-        this->stat_idle_cycles++;
+        this->statistics.stat_idle_cycles++;
     }
     else {
-        this->stat_active_cycles++;
+        this->statistics.stat_active_cycles++;
     }
 
 };
 
+// ============================================================================
+/// Mirrors the stop conditions of each stage: returns the current cycle when
+/// some stage would change the pipeline, otherwise the first ready_cycle which
+/// unblocks a stage. Stages waiting for the caches or other cores only wake up
+/// with their packages. The stall statistics of the blocked stages are kept to
+/// be counted on the skipped cycles.
+uint64_t processor_t::get_next_event_cycle() {
+    uint64_t cycle = sinuca_engine.get_global_cycle();
+    uint64_t next_cycle = std::numeric_limits<uint64_t>::max();
+
+    this->skip_branch_stall = false;
+    this->skip_sync_stall = false;
+    this->skip_full_fetch_buffer = false;
+    this->skip_full_decode_buffer = false;
+    this->skip_full_reorder_buffer = false;
+    this->skip_full_memory_order_buffer_read = false;
+    this->skip_full_memory_order_buffer_write = false;
+    this->skip_read_token = false;
+    this->skip_write_token = false;
+
+    if (this->reorder_buffer_position_used != 0) {
+        /// COMMIT
+        reorder_buffer_line_t *rob_line = &this->reorder_buffer[this->reorder_buffer_position_start];
+        if (rob_line->stage == PROCESSOR_STAGE_COMMIT &&
+        rob_line->uop.state == PACKAGE_STATE_READY) {
+            next_cycle = std::min(next_cycle, rob_line->uop.ready_cycle);
+        }
+
+        /// EXECUTION - Reads answered and functional units
+        if (!this->execution_done_read.empty() || !this->execution_done_functional_unit.empty()) {
+            return cycle;
+        }
+        next_cycle = std::min(next_cycle, this->execution_wheel.get_next_cycle());
+
+        /// EXECUTION - Requests to be sent (retried every cycle)
+        if (this->memory_order_buffer_read_executed != 0) {
+            if (this->oldest_read_to_send != NULL) {
+                /// Only the oldest is retried, waiting for a token given back by the cache
+                memory_package_t *package = &this->oldest_read_to_send->memory_request;
+                if (this->got_request_token ||
+                sinuca_engine.interconnection_interface_array[package->id_dst]->check_token_credit(this->id, package->memory_operation)) {
+                    return cycle;
+                }
+                this->skip_read_token = true;
+            }
+            else for (uint32_t slot = 0; slot < this->memory_order_buffer_read_size; slot++) {
+                if (this->memory_order_buffer_read[slot].memory_request.state == PACKAGE_STATE_TRANSMIT &&
+                this->memory_order_buffer_read[slot].wait_mem_deps_number == 0 &&
+                this->memory_order_buffer_read[slot].uop_executed == true) {
+                    next_cycle = std::min(next_cycle, this->memory_order_buffer_read[slot].memory_request.ready_cycle);
+                }
+            }
+        }
+        if (this->memory_order_buffer_write_executed != 0) {
+            if (this->oldest_write_to_send != NULL) {
+                memory_package_t *package = &this->oldest_write_to_send->memory_request;
+                if (this->got_write_token ||
+                sinuca_engine.interconnection_interface_array[package->id_dst]->check_token_credit(this->id, package->memory_operation)) {
+                    return cycle;
+                }
+                this->skip_write_token = true;
+            }
+            else for (uint32_t slot = 0; slot < this->memory_order_buffer_write_size; slot++) {
+                if (this->memory_order_buffer_write[slot].memory_request.state == PACKAGE_STATE_TRANSMIT &&
+                this->memory_order_buffer_write[slot].wait_mem_deps_number == 0 &&
+                this->memory_order_buffer_write[slot].uop_executed == true) {
+                    next_cycle = std::min(next_cycle, this->memory_order_buffer_write[slot].memory_request.ready_cycle);
+                }
+            }
+        }
+
+        /// DISPATCH - Operands ready (might still wait for the unit) and oldest ready of each class
+        if (!this->dispatch_waiting.empty()) {
+            next_cycle = std::min(next_cycle, this->dispatch_waiting.front()->uop.ready_cycle);
+        }
+        uint64_t window_last = this->get_dispatch_window_last();
+        for (uint32_t mask = this->dispatch_ready_mask; mask != 0; mask &= mask - 1) {
+            uint32_t i = __builtin_ctz(mask);
+            if (this->dispatch_ready[i].front()->uop.uop_number <= window_last) {
+                next_cycle = std::min(next_cycle, std::max(this->dispatch_ready[i].front()->uop.ready_cycle, this->fu_ready_cycle[i][0]));
+            }
+        }
+    }
+
+    /// RENAME
+    if (!this->decode_buffer.is_empty() &&
+    this->decode_buffer.front()->state == PACKAGE_STATE_READY) {
+        uop_package_t *uop = this->decode_buffer.front();
+        if (uop->ready_cycle > cycle) {
+            next_cycle = std::min(next_cycle, uop->ready_cycle);
+        }
+        else if ((uop->uop_operation == INSTRUCTION_OPERATION_MEM_LOAD || uop->uop_operation == INSTRUCTION_OPERATION_HMC_ALUR) &&
+        memory_order_buffer_line_t::find_free(this->memory_order_buffer_read, this->memory_order_buffer_read_size) == POSITION_FAIL) {
+            this->skip_full_memory_order_buffer_read = true;
+        }
+        else if ((uop->uop_operation == INSTRUCTION_OPERATION_MEM_STORE || uop->uop_operation == INSTRUCTION_OPERATION_HMC_ALU) &&
+        memory_order_buffer_line_t::find_free(this->memory_order_buffer_write, this->memory_order_buffer_write_size) == POSITION_FAIL) {
+            this->skip_full_memory_order_buffer_write = true;
+        }
+        else if (this->reorder_buffer_position_used >= this->reorder_buffer_size) {
+            this->skip_full_reorder_buffer = true;
+        }
+        else {
+            return cycle;
+        }
+    }
+
+    /// DECODE
+    if (!this->fetch_buffer.is_empty() &&
+    this->inflight_branches <= this->inflight_branches_size &&
+    this->fetch_buffer.front()->state == PACKAGE_STATE_READY) {
+        if (this->fetch_buffer.front()->ready_cycle > cycle) {
+            next_cycle = std::min(next_cycle, this->fetch_buffer.front()->ready_cycle);
+        }
+        else if (this->decode_buffer.get_capacity() - this->decode_buffer.get_size() < MAX_UOP_DECODED) {
+            this->skip_full_decode_buffer = true;
+        }
+        else {
+            return cycle;
+        }
+    }
+
+    /// FETCH
+    if (!this->trace_over || !this->fetch_buffer.is_empty()) {
+        /// Trace => Fetch_Buffer
+        if (this->branch_solve_stage != PROCESSOR_STAGE_FETCH ||
+        this->branch_flush_cycle_ready > cycle) {
+            this->skip_branch_stall = true;
+            if (this->branch_solve_stage == PROCESSOR_STAGE_FETCH) {
+                next_cycle = std::min(next_cycle, this->branch_flush_cycle_ready);
+            }
+        }
+        else if (this->sync_status != SYNC_FREE && this->sync_status != SYNC_CRITICAL_START) {
+            this->skip_sync_stall = true;
+        }
+        else if (sinuca_engine.trace_reader->get_trace_opcode_total() >= sinuca_engine.get_fetch_limit()) {
+            /// The pipeline is being drained
+        }
+        else if (this->trace_next_opcode.state == PACKAGE_STATE_FREE ||
+        this->trace_next_opcode.sync_type != SYNC_FREE) {
+            return cycle;
+        }
+        else if (this->trace_next_opcode.opcode_operation == INSTRUCTION_OPERATION_BRANCH && this->branch_per_fetch == 0) {
+            /// Branches are never fetched
+        }
+        else if (this->fetch_buffer.is_full()) {
+            this->skip_full_fetch_buffer = true;
+        }
+        else {
+            return cycle;
+        }
+
+        /// Fetch_Buffer => Inst.Cache
+        uint32_t pos_buffer = this->get_fetch_request_position();
+        if (pos_buffer < this->fetch_buffer.get_size() &&
+        this->fetch_buffer[pos_buffer].state == PACKAGE_STATE_UNTREATED) {
+            next_cycle = std::min(next_cycle, this->fetch_buffer[pos_buffer].ready_cycle);
+        }
+    }
+
+    return next_cycle;
+};
+
+// ============================================================================
+void processor_t::skip_cycles(uint64_t cycles) {
+    if (this->skip_branch_stall) {
+        this->statistics.stat_branch_stall_cycles += cycles;
+    }
+    if (this->skip_sync_stall) {
+        this->statistics.stat_sync_stall_cycles += cycles;
+    }
+    if (this->skip_full_fetch_buffer) {
+        this->statistics.stat_full_fetch_buffer += cycles;
+    }
+    if (this->skip_full_decode_buffer) {
+        this->statistics.stat_full_decode_buffer += cycles;
+    }
+    if (this->skip_full_reorder_buffer) {
+        this->statistics.stat_full_reorder_buffer += cycles;
+    }
+    if (this->skip_full_memory_order_buffer_read) {
+        this->statistics.stat_full_memory_order_buffer_read += cycles;
+    }
+    if (this->skip_full_memory_order_buffer_write) {
+        this->statistics.stat_full_memory_order_buffer_write += cycles;
+    }
+    if (this->skip_read_token) {
+        memory_package_t *package = &this->oldest_read_to_send->memory_request;
+        sinuca_engine.interconnection_interface_array[package->id_dst]->skip_token_credit(this->id, package->memory_operation, cycles);
+    }
+    if (this->skip_write_token) {
+        memory_package_t *package = &this->oldest_write_to_send->memory_request;
+        sinuca_engine.interconnection_interface_array[package->id_dst]->skip_token_credit(this->id, package->memory_operation, cycles);
+    }
+
+    if (this->trace_over) {
+        this->statistics.stat_idle_cycles += cycles;
+    }
+    else {
+        this->statistics.stat_active_cycles += cycles;
+    }
+};
+
 // ============================================================================
 int32_t processor_t::send_package(memory_package_t *package) {
     ERROR_ASSERT_PRINTF(!package->is_answer, "Processor is trying to send an answer.\n")
@@ -1994,6 +2065,7 @@ int32_t processor_t::send_package(memory_package_t *package) {
 
 // ============================================================================
 bool processor_t::receive_package(memory_package_t *package, uint32_t input_port, uint32_t transmission_latency) {
+    profile_scope_t profile(&this->profile_receive);
 
     PROCESSOR_DEBUG_PRINTF("receive_package() port:%u, package:%s\n", input_port, package->content_to_string().c_str());
     ERROR_ASSERT_PRINTF(package->id_owner == this->get_id(), "Received some package for a different owner.\n");
@@ -2010,18 +2082,17 @@ bool processor_t::receive_package(memory_package_t *package, uint32_t input_port
                 /// Add to the buffer the whole line fetched
                 this->fetch_opcode_address_line_buffer = package->memory_address;
 
-                /// Find packages WAITING
-                for (uint32_t k = 0; k < this->fetch_buffer.get_size(); k++) {
-                    /// Wake up ALL instructions waiting
-                    if (this->fetch_buffer[k].state == PACKAGE_STATE_WAIT &&
-                    this->cmp_fetch_block(package->memory_address, this->fetch_buffer[k].opcode_address)) {
-                        this->add_stat_instruction_read_completed(this->fetch_buffer[k].born_cycle);
-                        PROCESSOR_DEBUG_PRINTF("\t WANTED INSTRUCTION\n");
-                        this->fetch_buffer[k].package_ready(transmission_latency);
-                        slot = k;
-                    }
+                /// Wake up ALL instructions waiting the block
+                std::unordered_map<uint64_t, wake_up_list_t<opcode_package_t> >::iterator waiting = this->fetch_waiting.find(package->memory_address & this->not_fetch_offset_bits_mask);
+                ERROR_ASSERT_PRINTF(waiting != this->fetch_waiting.end(), "Processor Read Instruction done, but it is not on the fetch-buffer anymore.\n")
+                while (!waiting->second.is_empty()) {
+                    opcode_package_t *opcode = this->fetch_waiting_pool.pop_front(&waiting->second);
+                    ERROR_ASSERT_PRINTF(opcode->state == PACKAGE_STATE_WAIT, "Fetch buffer opcode waiting the block is not WAIT.\n")
+                    this->add_stat_instruction_read_completed(opcode->born_cycle);
+                    PROCESSOR_DEBUG_PRINTF("\t WANTED INSTRUCTION\n");
+                    opcode->package_ready(transmission_latency);
                 }
-                ERROR_ASSERT_PRINTF(slot != POSITION_FAIL, "Processor Read Instruction done, but it is not on the fetch-buffer anymore.\n")
+                this->fetch_waiting.erase(waiting);
                 this->recv_ready_cycle[input_port] = sinuca_engine.get_global_cycle() + transmission_latency;
                 return OK;
             }
@@ -2045,6 +2116,7 @@ bool processor_t::receive_package(memory_package_t *package, uint32_t input_port
                 this->memory_order_buffer_read[slot].memory_request.is_answer = true;
                 this->recv_ready_cycle[input_port] = sinuca_engine.get_global_cycle() + transmission_latency;
                 this->memory_order_buffer_read_received++;
+                this->execution_insert_read(&this->memory_order_buffer_read[slot]);
                 return OK;
             }
         break;
@@ -2121,75 +2193,10 @@ void processor_t::periodic_check(){
 // ============================================================================
 void processor_t::reset_statistics() {
 
-    this->set_stat_reset_fetch_opcode_counter(this->fetch_opcode_counter);
-    this->set_stat_reset_decode_uop_counter(this->decode_uop_counter);
-
-    this->set_stat_active_cycles(0);
-    this->set_stat_idle_cycles(0);
-
-    this->set_stat_branch_stall_cycles(0);
-    this->set_stat_sync_stall_cycles(0);
-
-    this->stat_full_fetch_buffer = 0;
-    this->stat_full_decode_buffer = 0;
-    this->stat_full_reorder_buffer = 0;
-    this->stat_full_memory_order_buffer_read = 0;
-    this->stat_full_memory_order_buffer_write = 0;
-
-    /// Executed Instructions
-    this->set_stat_nop_completed(0);
-    this->set_stat_branch_completed(0);
-    this->set_stat_other_completed(0);
-
-    this->set_stat_int_alu_completed(0);
-    this->set_stat_int_mul_completed(0);
-    this->set_stat_int_div_completed(0);
-
-    this->set_stat_fp_alu_completed(0);
-    this->set_stat_fp_mul_completed(0);
-    this->set_stat_fp_div_completed(0);
-
-    this->set_stat_memory_read_completed(0);
-    this->set_stat_instruction_read_completed(0);
-    this->set_stat_memory_write_completed(0);
-
-    this->set_stat_address_to_address(0);
-    this->set_stat_disambiguation_read_false_positive(0);
-    this->set_stat_disambiguation_write_false_positive(0);
-
-    // HMC Executed Instructions
-    this->set_stat_hmc_completed(0);
-
-    /// Dispatch Cycles Stall
-    this->set_stat_dispatch_cycles_fu_int_alu(0);
-    this->set_stat_dispatch_cycles_fu_int_mul(0);
-    this->set_stat_dispatch_cycles_fu_int_div(0);
-
-    this->set_stat_dispatch_cycles_fu_fp_alu(0);
-    this->set_stat_dispatch_cycles_fu_fp_mul(0);
-    this->set_stat_dispatch_cycles_fu_fp_div(0);
-
-    this->set_stat_dispatch_cycles_fu_mem_load(0);
-    this->set_stat_dispatch_cycles_fu_mem_store(0);
-
-    /// Memory Cycles Stall
-    this->stat_min_instruction_read_wait_time = MAX_ALIVE_TIME;
-    this->stat_max_instruction_read_wait_time = 0;
-    this->stat_accumulated_instruction_read_wait_time = 0;
-
-    this->stat_min_memory_read_wait_time = MAX_ALIVE_TIME;
-    this->stat_max_memory_read_wait_time = 0;
-    this->stat_accumulated_memory_read_wait_time = 0;
-
-    this->stat_min_memory_write_wait_time = MAX_ALIVE_TIME;
-    this->stat_max_memory_write_wait_time = 0;
-    this->stat_accumulated_memory_write_wait_time = 0;
-
-    // HMC Cycles Stall
-    this->stat_min_hmc_wait_time = MAX_ALIVE_TIME;
-    this->stat_max_hmc_wait_time = 0;
-    this->stat_accumulated_hmc_wait_time = 0;
+    this->stat_reset_fetch_opcode_counter = this->fetch_opcode_counter;
+    this->stat_reset_decode_uop_counter = this->decode_uop_counter;
 
+    memset(&this->statistics, 0, sizeof(this->statistics));
 
     this->branch_predictor->reset_statistics();
     return;
@@ -2203,9 +2210,10 @@ void processor_t::print_statistics() {
     sinuca_engine.write_statistics_comments(title);
     sinuca_engine.write_statistics_big_separator();
 
-    sinuca_engine.write_statistics_value(get_type_component_label(), get_label(), "stat_active_cycles", this->stat_active_cycles);
-    sinuca_engine.write_statistics_value(get_type_component_label(), get_label(), "stat_idle_cycles", this->stat_idle_cycles);
+    PROCESSOR_STATISTICS(STATISTICS_PRINT_COUNTER, STATISTICS_PRINT_LATENCY)
 
+    /// Derived from the statistics above
+    const statistics_t *stat = &this->statistics;
     sinuca_engine.write_statistics_small_separator();
     sinuca_engine.write_statistics_value(get_type_component_label(), get_label(), "fetch_opcode_counter", this->fetch_opcode_counter);
     sinuca_engine.write_statistics_value(get_type_component_label(), get_label(), "decode_uop_counter", this->decode_uop_counter);
@@ -2223,111 +2231,46 @@ void processor_t::print_statistics() {
                                                                                                                        sinuca_engine.get_global_cycle() - sinuca_engine.get_reset_cycle());
 
     sinuca_engine.write_statistics_small_separator();
-    sinuca_engine.write_statistics_value(get_type_component_label(), get_label(), "stat_sync_stall_cycles", stat_sync_stall_cycles);
-    sinuca_engine.write_statistics_value_ratio(get_type_component_label(), get_label(), "stat_sync_stall_cycles_ratio_warm", this->stat_sync_stall_cycles,
+    sinuca_engine.write_statistics_value_ratio(get_type_component_label(), get_label(), "stat_sync_stall_cycles_ratio_warm", stat->stat_sync_stall_cycles,
                                                                                                                        sinuca_engine.get_global_cycle() - sinuca_engine.get_reset_cycle());
 
     sinuca_engine.write_statistics_value_ratio(get_type_component_label(), get_label(), "opcode_per_cycle_ratio_warm_nosync", this->fetch_opcode_counter - this->stat_reset_fetch_opcode_counter,
-                                                                                                                       sinuca_engine.get_global_cycle() - sinuca_engine.get_reset_cycle() - stat_sync_stall_cycles);
+                                                                                                                       sinuca_engine.get_global_cycle() - sinuca_engine.get_reset_cycle() - stat->stat_sync_stall_cycles);
     sinuca_engine.write_statistics_value_ratio(get_type_component_label(), get_label(), "uop_per_cycle_ratio_warm_nosync", this->decode_uop_counter - this->stat_reset_decode_uop_counter,
-                                                                                                                       sinuca_engine.get_global_cycle() - sinuca_engine.get_reset_cycle() - stat_sync_stall_cycles);
+                                                                                                                       sinuca_engine.get_global_cycle() - sinuca_engine.get_reset_cycle() - stat->stat_sync_stall_cycles);
 
     sinuca_engine.write_statistics_small_separator();
-    sinuca_engine.write_statistics_value(get_type_component_label(), get_label(), "stat_branch_stall_cycles", stat_branch_stall_cycles);
-    sinuca_engine.write_statistics_value_ratio(get_type_component_label(), get_label(), "stat_branch_stall_cycles_ratio_warm", this->stat_branch_stall_cycles,
+    sinuca_engine.write_statistics_value_ratio(get_type_component_label(), get_label(), "stat_branch_stall_cycles_ratio_warm", stat->stat_branch_stall_cycles,
                                                                                                                        sinuca_engine.get_global_cycle() - sinuca_engine.get_reset_cycle());
 
-    /// ROB and MOB Statistics
-    sinuca_engine.write_statistics_small_separator();
-
-    sinuca_engine.write_statistics_value(get_type_component_label(), get_label(), "stat_full_fetch_buffer", stat_full_fetch_buffer);
-    sinuca_engine.write_statistics_value(get_type_component_label(), get_label(), "stat_full_decode_buffer", stat_full_decode_buffer);
-    sinuca_engine.write_statistics_value(get_type_component_label(), get_label(), "stat_full_reorder_buffer", stat_full_reorder_buffer);
-    sinuca_engine.write_statistics_value(get_type_component_label(), get_label(), "stat_full_memory_order_buffer_read", stat_full_memory_order_buffer_read);
-    sinuca_engine.write_statistics_value(get_type_component_label(), get_label(), "stat_full_memory_order_buffer_write", stat_full_memory_order_buffer_write);
-
     /// Executed Instructions
     sinuca_engine.write_statistics_small_separator();
-    sinuca_engine.write_statistics_value(get_type_component_label(), get_label(), "stat_nop_completed", stat_nop_completed);
-    sinuca_engine.write_statistics_value(get_type_component_label(), get_label(), "stat_branch_completed", stat_branch_completed);
-    sinuca_engine.write_statistics_value(get_type_component_label(), get_label(), "stat_other_completed", stat_other_completed);
-
-    sinuca_engine.write_statistics_small_separator();
-    sinuca_engine.write_statistics_value(get_type_component_label(), get_label(), "stat_int_all_completed", stat_int_alu_completed + stat_int_mul_completed + stat_int_div_completed);
-    sinuca_engine.write_statistics_value(get_type_component_label(), get_label(), "stat_int_alu_completed", stat_int_alu_completed);
-    sinuca_engine.write_statistics_value(get_type_component_label(), get_label(), "stat_int_mul_completed", stat_int_mul_completed);
-    sinuca_engine.write_statistics_value(get_type_component_label(), get_label(), "stat_int_div_completed", stat_int_div_completed);
-
-    sinuca_engine.write_statistics_small_separator();
-    sinuca_engine.write_statistics_value(get_type_component_label(), get_label(), "stat_fp_all_completed", stat_fp_alu_completed + stat_fp_mul_completed + stat_fp_div_completed);
-    sinuca_engine.write_statistics_value(get_type_component_label(), get_label(), "stat_fp_alu_completed", stat_fp_alu_completed);
-    sinuca_engine.write_statistics_value(get_type_component_label(), get_label(), "stat_fp_mul_completed", stat_fp_mul_completed);
-    sinuca_engine.write_statistics_value(get_type_component_label(), get_label(), "stat_fp_div_completed", stat_fp_div_completed);
-
-    sinuca_engine.write_statistics_small_separator();
-    sinuca_engine.write_statistics_value(get_type_component_label(), get_label(), "stat_instruction_read_completed", stat_instruction_read_completed);
-    sinuca_engine.write_statistics_value(get_type_component_label(), get_label(), "stat_memory_read_completed", stat_memory_read_completed);
-    sinuca_engine.write_statistics_value(get_type_component_label(), get_label(), "stat_memory_write_completed", stat_memory_write_completed);
-
-    sinuca_engine.write_statistics_value(get_type_component_label(), get_label(), "stat_address_to_address", stat_address_to_address);
-    sinuca_engine.write_statistics_value(get_type_component_label(), get_label(), "stat_disambiguation_read_false_positive", stat_disambiguation_read_false_positive);
-    sinuca_engine.write_statistics_value(get_type_component_label(), get_label(), "stat_disambiguation_write_false_positive", stat_disambiguation_write_false_positive);
-
-    // HMC
-    sinuca_engine.write_statistics_value(get_type_component_label(), get_label(), "stat_hmc_completed", stat_hmc_completed);
-
-    /// Dispatch Cycles Stall
-    sinuca_engine.write_statistics_small_separator();
-    sinuca_engine.write_statistics_value(get_type_component_label(), get_label(), "stat_dispatch_cycles_fu_int_alu", stat_dispatch_cycles_fu_int_alu);
-    sinuca_engine.write_statistics_value(get_type_component_label(), get_label(), "stat_dispatch_cycles_fu_int_mul", stat_dispatch_cycles_fu_int_mul);
-    sinuca_engine.write_statistics_value(get_type_component_label(), get_label(), "stat_dispatch_cycles_fu_int_div", stat_dispatch_cycles_fu_int_div);
-
-    sinuca_engine.write_statistics_small_separator();
-    sinuca_engine.write_statistics_value(get_type_component_label(), get_label(), "stat_dispatch_cycles_fu_fp_alu", stat_dispatch_cycles_fu_fp_alu);
-    sinuca_engine.write_statistics_value(get_type_component_label(), get_label(), "stat_dispatch_cycles_fu_fp_mul", stat_dispatch_cycles_fu_fp_mul);
-    sinuca_engine.write_statistics_value(get_type_component_label(), get_label(), "stat_dispatch_cycles_fu_fp_div", stat_dispatch_cycles_fu_fp_div);
-
-    sinuca_engine.write_statistics_small_separator();
-    sinuca_engine.write_statistics_value(get_type_component_label(), get_label(), "stat_dispatch_cycles_fu_mem_load", stat_dispatch_cycles_fu_mem_load);
-    sinuca_engine.write_statistics_value(get_type_component_label(), get_label(), "stat_dispatch_cycles_fu_mem_store", stat_dispatch_cycles_fu_mem_store);
+    sinuca_engine.write_statistics_value(get_type_component_label(), get_label(), "stat_int_all_completed", stat->stat_int_alu_completed + stat->stat_int_mul_completed + stat->stat_int_div_completed);
+    sinuca_engine.write_statistics_value(get_type_component_label(), get_label(), "stat_fp_all_completed", stat->stat_fp_alu_completed + stat->stat_fp_mul_completed + stat->stat_fp_div_completed);
 
     /// Dispatch Cycles Stall per Uop
     sinuca_engine.write_statistics_small_separator();
-    sinuca_engine.write_statistics_value_ratio(get_type_component_label(), get_label(), "stat_dispatch_cycles_fu_int_alu_ratio", stat_dispatch_cycles_fu_int_alu, stat_int_alu_completed);
-    sinuca_engine.write_statistics_value_ratio(get_type_component_label(), get_label(), "stat_dispatch_cycles_fu_int_mul_ratio", stat_dispatch_cycles_fu_int_mul, stat_int_mul_completed);
-    sinuca_engine.write_statistics_value_ratio(get_type_component_label(), get_label(), "stat_dispatch_cycles_fu_int_div_ratio", stat_dispatch_cycles_fu_int_div, stat_int_div_completed);
+    sinuca_engine.write_statistics_value_ratio(get_type_component_label(), get_label(), "stat_dispatch_cycles_fu_int_alu_ratio", stat->stat_dispatch_cycles_fu_int_alu, stat->stat_int_alu_completed);
+    sinuca_engine.write_statistics_value_ratio(get_type_component_label(), get_label(), "stat_dispatch_cycles_fu_int_mul_ratio", stat->stat_dispatch_cycles_fu_int_mul, stat->stat_int_mul_completed);
+    sinuca_engine.write_statistics_value_ratio(get_type_component_label(), get_label(), "stat_dispatch_cycles_fu_int_div_ratio", stat->stat_dispatch_cycles_fu_int_div, stat->stat_int_div_completed);
 
     sinuca_engine.write_statistics_small_separator();
-    sinuca_engine.write_statistics_value_ratio(get_type_component_label(), get_label(), "stat_dispatch_cycles_fu_fp_alu_ratio", stat_dispatch_cycles_fu_fp_alu, stat_fp_alu_completed);
-    sinuca_engine.write_statistics_value_ratio(get_type_component_label(), get_label(), "stat_dispatch_cycles_fu_fp_mul_ratio", stat_dispatch_cycles_fu_fp_mul, stat_fp_mul_completed);
-    sinuca_engine.write_statistics_value_ratio(get_type_component_label(), get_label(), "stat_dispatch_cycles_fu_fp_div_ratio", stat_dispatch_cycles_fu_fp_div, stat_fp_div_completed);
+    sinuca_engine.write_statistics_value_ratio(get_type_component_label(), get_label(), "stat_dispatch_cycles_fu_fp_alu_ratio", stat->stat_dispatch_cycles_fu_fp_alu, stat->stat_fp_alu_completed);
+    sinuca_engine.write_statistics_value_ratio(get_type_component_label(), get_label(), "stat_dispatch_cycles_fu_fp_mul_ratio", stat->stat_dispatch_cycles_fu_fp_mul, stat->stat_fp_mul_completed);
+    sinuca_engine.write_statistics_value_ratio(get_type_component_label(), get_label(), "stat_dispatch_cycles_fu_fp_div_ratio", stat->stat_dispatch_cycles_fu_fp_div, stat->stat_fp_div_completed);
 
     sinuca_engine.write_statistics_small_separator();
-    sinuca_engine.write_statistics_value_ratio(get_type_component_label(), get_label(), "stat_dispatch_cycles_fu_mem_load_ratio", stat_dispatch_cycles_fu_mem_load, stat_memory_read_completed);
-    sinuca_engine.write_statistics_value_ratio(get_type_component_label(), get_label(), "stat_dispatch_cycles_fu_mem_store_ratio", stat_dispatch_cycles_fu_mem_store, stat_memory_write_completed);
+    sinuca_engine.write_statistics_value_ratio(get_type_component_label(), get_label(), "stat_dispatch_cycles_fu_mem_load_ratio", stat->stat_dispatch_cycles_fu_mem_load, stat->stat_memory_read_completed);
+    sinuca_engine.write_statistics_value_ratio(get_type_component_label(), get_label(), "stat_dispatch_cycles_fu_mem_store_ratio", stat->stat_dispatch_cycles_fu_mem_store, stat->stat_memory_write_completed);
 
     /// Memory Cycles Stall
     sinuca_engine.write_statistics_small_separator();
-    sinuca_engine.write_statistics_value(get_type_component_label(), get_label(), "stat_min_instruction_read_wait_time", stat_min_instruction_read_wait_time);
-    sinuca_engine.write_statistics_value(get_type_component_label(), get_label(), "stat_max_instruction_read_wait_time", stat_max_instruction_read_wait_time);
-
-    sinuca_engine.write_statistics_value(get_type_component_label(), get_label(), "stat_min_memory_read_wait_time", stat_min_memory_read_wait_time);
-    sinuca_engine.write_statistics_value(get_type_component_label(), get_label(), "stat_max_memory_read_wait_time", stat_max_memory_read_wait_time);
-
-    sinuca_engine.write_statistics_value(get_type_component_label(), get_label(), "stat_min_memory_write_wait_time", stat_min_memory_write_wait_time);
-    sinuca_engine.write_statistics_value(get_type_component_label(), get_label(), "stat_max_memory_write_wait_time", stat_max_memory_write_wait_time);
-
-    sinuca_engine.write_statistics_small_separator();
-    sinuca_engine.write_statistics_value_ratio(get_type_component_label(), get_label(), "stat_accumulated_instruction_read_wait_time_ratio", stat_accumulated_instruction_read_wait_time, stat_instruction_read_completed);
-    sinuca_engine.write_statistics_value_ratio(get_type_component_label(), get_label(), "stat_accumulated_memory_read_wait_time_ratio", stat_accumulated_memory_read_wait_time, stat_memory_read_completed);
-    sinuca_engine.write_statistics_value_ratio(get_type_component_label(), get_label(), "stat_accumulated_memory_write_wait_time_ratio", stat_accumulated_memory_write_wait_time, stat_memory_write_completed);
-
+    sinuca_engine.write_statistics_value_ratio(get_type_component_label(), get_label(), "stat_accumulated_instruction_read_wait_time_ratio", stat->stat_instruction_read_wait_time.accumulated, stat->stat_instruction_read_completed);
+    sinuca_engine.write_statistics_value_ratio(get_type_component_label(), get_label(), "stat_accumulated_memory_read_wait_time_ratio", stat->stat_memory_read_wait_time.accumulated, stat->stat_memory_read_completed);
+    sinuca_engine.write_statistics_value_ratio(get_type_component_label(), get_label(), "stat_accumulated_memory_write_wait_time_ratio", stat->stat_memory_write_wait_time.accumulated, stat->stat_memory_write_completed);
 
     // HMC Cycles Stall
-    sinuca_engine.write_statistics_small_separator();
-    sinuca_engine.write_statistics_value(get_type_component_label(), get_label(), "stat_min_hmc_wait_time", stat_min_hmc_wait_time);
-    sinuca_engine.write_statistics_value(get_type_component_label(), get_label(), "stat_max_hmc_wait_time", stat_max_hmc_wait_time);
-    sinuca_engine.write_statistics_value_ratio(get_type_component_label(), get_label(), "stat_accumulated_hmc_wait_time_ratio", stat_accumulated_hmc_wait_time, stat_memory_read_completed);
+    sinuca_engine.write_statistics_value_ratio(get_type_component_label(), get_label(), "stat_accumulated_hmc_wait_time_ratio", stat->stat_hmc_wait_time.accumulated, stat->stat_memory_read_completed);
 
 
 
@@ -2447,6 +2390,67 @@ void processor_t::print_configuration() {
     this->branch_predictor->print_configuration();
 };
 
+// ============================================================================
+/// The pipeline is drained before saving, only the control variables, the
+/// next opcode (already taken from the trace) and the branch predictor remain.
+void processor_t::checkpoint(checkpoint_t *checkpoint) {
+    ERROR_ASSERT_PRINTF(checkpoint->get_is_restore() || this->is_drained(), "Checkpoint with opcodes inside the pipeline.\n")
+    checkpoint->section(this->get_label());
+
+    /// Position inside the trace, also kept by the warm images
+    checkpoint->value(this->sync_status);
+    checkpoint->value(this->sync_status_time);
+    checkpoint->value(this->trace_over);
+    checkpoint->value(this->trace_next_opcode);
+    checkpoint->value(this->fetch_opcode_address);
+    checkpoint->value(this->fetch_opcode_address_line_buffer);
+    checkpoint->value(this->fetch_opcode_counter);
+    checkpoint->value(this->decode_opcode_counter);
+    checkpoint->value(this->decode_uop_counter);
+    checkpoint->value(this->rename_uop_counter);
+    checkpoint->value(this->commit_uop_counter);
+
+    /// Pipeline timing, not kept by the warm images
+    if (!checkpoint->get_is_warm()) {
+        checkpoint->value(this->branch_solve_stage);
+        checkpoint->value(this->branch_opcode_number);
+        checkpoint->value(this->branch_flush_cycle_ready);
+        checkpoint->value(this->inflight_branches);
+
+        checkpoint->value(this->reorder_buffer_position_start);
+        checkpoint->value(this->reorder_buffer_position_end);
+        checkpoint->value(this->memory_order_buffer_read_executed);
+        checkpoint->value(this->memory_order_buffer_read_received);
+        checkpoint->value(this->memory_order_buffer_write_executed);
+        checkpoint->value(this->got_instruction_token);
+        checkpoint->value(this->got_request_token);
+        checkpoint->value(this->got_write_token);
+
+        checkpoint->array(this->recv_ready_cycle, this->get_max_ports());
+        checkpoint->array(this->ready_cycle_fu_int_alu, this->number_fu_int_alu);
+        checkpoint->array(this->ready_cycle_fu_int_mul, this->number_fu_int_mul);
+        checkpoint->array(this->ready_cycle_fu_int_div, this->number_fu_int_div);
+        checkpoint->array(this->ready_cycle_fu_fp_alu, this->number_fu_fp_alu);
+        checkpoint->array(this->ready_cycle_fu_fp_mul, this->number_fu_fp_mul);
+        checkpoint->array(this->ready_cycle_fu_fp_div, this->number_fu_fp_div);
+        checkpoint->array(this->ready_cycle_fu_mem_load, this->number_fu_mem_load);
+        checkpoint->array(this->ready_cycle_fu_mem_store, this->number_fu_mem_store);
+        /// Units kept as min-heaps by stage_dispatch()
+        for (uint32_t i = 0; i < FUNCTIONAL_UNIT_NUMBER; i++) {
+            std::make_heap(this->fu_ready_cycle[i], this->fu_ready_cycle[i] + this->fu_number[i], std::greater<uint64_t>());
+        }
+    }
+
+    /// Statistics, not kept by the warm images
+    if (!checkpoint->get_is_warm()) {
+        checkpoint->value(this->statistics);
+        checkpoint->value(this->stat_reset_fetch_opcode_counter);
+        checkpoint->value(this->stat_reset_decode_uop_counter);
+    }
+
+    this->branch_predictor->checkpoint(checkpoint);
+};
+
 // ============================================================================
 /// Reorder Buffer Methods
 // ============================================================================
@@ -2473,7 +2477,7 @@ int32_t processor_t::rob_insert() {
  */
 void processor_t::rob_remove() {
     ERROR_ASSERT_PRINTF(this->reorder_buffer_position_used > 0, "Trying to remove from ROB with no used position.\n");
-    ERROR_ASSERT_PRINTF(this->reorder_buffer[this->reorder_buffer_position_start].reg_deps_ptr_array[0] == NULL, "Removing from ROB without solve the dependencies.\n");
+    ERROR_ASSERT_PRINTF(this->reorder_buffer[this->reorder_buffer_position_start].reg_deps_list.is_empty(), "Removing from ROB without solve the dependencies.\n");
 
     this->reorder_buffer[this->reorder_buffer_position_start].package_clean();
 
@@ -23,6 +23,55 @@
 #ifndef _PROCESSOR_PROCESSOR_HPP_
 #define _PROCESSOR_PROCESSOR_HPP_
 
+/// Statistics of the processor, see statistics_registry.hpp
+#define PROCESSOR_STATISTICS(COUNTER, LATENCY) \
+    COUNTER(stat_active_cycles) \
+    COUNTER(stat_idle_cycles) \
+    COUNTER(stat_branch_stall_cycles) \
+    COUNTER(stat_sync_stall_cycles) \
+    COUNTER(stat_full_fetch_buffer) \
+    COUNTER(stat_full_decode_buffer) \
+    COUNTER(stat_full_reorder_buffer) \
+    COUNTER(stat_full_memory_order_buffer_read) \
+    COUNTER(stat_full_memory_order_buffer_write) \
+    COUNTER(stat_nop_completed) \
+    COUNTER(stat_branch_completed) \
+    COUNTER(stat_other_completed) \
+    COUNTER(stat_int_alu_completed) \
+    COUNTER(stat_int_mul_completed) \
+    COUNTER(stat_int_div_completed) \
+    COUNTER(stat_fp_alu_completed) \
+    COUNTER(stat_fp_mul_completed) \
+    COUNTER(stat_fp_div_completed) \
+    COUNTER(stat_instruction_read_completed) \
+    COUNTER(stat_memory_read_completed) \
+    COUNTER(stat_memory_write_completed) \
+    COUNTER(stat_address_to_address) \
+    COUNTER(stat_disambiguation_read_false_positive) \
+    COUNTER(stat_disambiguation_write_false_positive) \
+    COUNTER(stat_hmc_completed) \
+    COUNTER(stat_dispatch_cycles_fu_int_alu) \
+    COUNTER(stat_dispatch_cycles_fu_int_mul) \
+    COUNTER(stat_dispatch_cycles_fu_int_div) \
+    COUNTER(stat_dispatch_cycles_fu_fp_alu) \
+    COUNTER(stat_dispatch_cycles_fu_fp_mul) \
+    COUNTER(stat_dispatch_cycles_fu_fp_div) \
+    COUNTER(stat_dispatch_cycles_fu_mem_load) \
+    COUNTER(stat_dispatch_cycles_fu_mem_store) \
+    LATENCY(instruction_read_wait_time) \
+    LATENCY(memory_read_wait_time) \
+    LATENCY(memory_write_wait_time) \
+    LATENCY(hmc_wait_time)
+
+// ============================================================================
+/// Functional unit result (rob_line) or read answer (mob_line) on the execution wheel
+class execution_event_t {
+    public:
+        uint64_t order;                         /// Dispatch order of the results, MOB slot of the answers
+        reorder_buffer_line_t *rob_line;
+        memory_order_buffer_line_t *mob_line;
+};
+
 class processor_t : public interconnection_interface_t {
     public:
         /// Branch Predictor
@@ -148,6 +197,9 @@ class processor_t : public interconnection_interface_t {
 
         /// Fetch buffer
         circular_buffer_t<opcode_package_t> fetch_buffer;
+        /// Fetch block => opcodes WAITING the inst. cache answer
+        std::unordered_map<uint64_t, wake_up_list_t<opcode_package_t> > fetch_waiting;
+        wake_up_pool_t<opcode_package_t> fetch_waiting_pool;
         /// Decode buffer
         circular_buffer_t<uop_package_t> decode_buffer;
 
@@ -157,6 +209,10 @@ class processor_t : public interconnection_interface_t {
         uint32_t reorder_buffer_position_end;
         uint32_t reorder_buffer_position_used;
 
+        /// Nodes of the register and memory wake-up lists
+        wake_up_pool_t<reorder_buffer_line_t> reg_deps_pool;
+        wake_up_pool_t<memory_order_buffer_line_t> mem_deps_pool;
+
         /// Register Alias Table for Renaming
         uint32_t register_alias_table_size;
         reorder_buffer_line_t* *register_alias_table;
@@ -174,9 +230,18 @@ class processor_t : public interconnection_interface_t {
         uint64_t disambiguation_load_hash_bits_shift;
         uint64_t disambiguation_store_hash_bits_shift;
 
-        /// Containers to fast the execution, with pointers of UOPs ready.
-        container_ptr_reorder_buffer_line_t unified_reservation_station;    /// dispatch->execute
-        container_ptr_reorder_buffer_line_t unified_functional_units;       /// execute->commit
+        /// Reservation station (dispatch->execute), list of the ROB lines in age order
+        reorder_buffer_line_t *unified_reservation_station_first;
+        reorder_buffer_line_t *unified_reservation_station_last;
+        uint32_t unified_reservation_station_size;
+        reorder_buffer_line_t *unified_reservation_station_window_end;     /// Last entry inside the window, NULL while all entries fit
+
+        /// execute->commit, the functional units results and the read answers by completion cycle
+        event_wheel_t<execution_event_t> execution_wheel;
+        std::vector<execution_event_t> execution_drained;
+        std::vector<execution_event_t> execution_done_functional_unit;    /// Min-heap by dispatch order
+        std::vector<execution_event_t> execution_done_read;               /// Min-heap by MOB slot
+        uint64_t execution_dispatch_order;
 
         // ====================================================================
         /// Integer Functional Units
@@ -195,6 +260,18 @@ class processor_t : public interconnection_interface_t {
         uint64_t *ready_cycle_fu_mem_load;
         uint64_t *ready_cycle_fu_mem_store;
 
+        // ====================================================================
+        /// Dispatch queues of each functional unit class, so the dispatch
+        /// cost follows the ready uops and not the reservation station window
+        uint32_t fu_number[FUNCTIONAL_UNIT_NUMBER];
+        uint32_t fu_latency[FUNCTIONAL_UNIT_NUMBER];
+        uint32_t fu_wait_between[FUNCTIONAL_UNIT_NUMBER];
+        uint64_t *fu_ready_cycle[FUNCTIONAL_UNIT_NUMBER];               /// Min-heaps, [0] is the first unit free
+        uint64_t *fu_stat_dispatch_cycles[FUNCTIONAL_UNIT_NUMBER];
+        container_ptr_reorder_buffer_line_t dispatch_waiting;                       /// Min-heap by ready_cycle, no register dependency left
+        container_ptr_reorder_buffer_line_t dispatch_ready[FUNCTIONAL_UNIT_NUMBER]; /// Min-heaps by uop_number, operands ready
+        uint32_t dispatch_ready_mask;                                               /// Bit per class with a non-empty dispatch_ready
+
         memory_order_buffer_line_t *memory_order_buffer_read;
         memory_order_buffer_line_t *memory_order_buffer_write;
         /// Number of positions used inside MOB
@@ -209,82 +286,28 @@ class processor_t : public interconnection_interface_t {
         bool got_request_token;
         bool got_write_token;
 
+        /// Stall statistics counted on each cycle skipped while idle
+        bool skip_branch_stall;
+        bool skip_sync_stall;
+        bool skip_full_fetch_buffer;
+        bool skip_full_decode_buffer;
+        bool skip_full_reorder_buffer;
+        bool skip_full_memory_order_buffer_read;
+        bool skip_full_memory_order_buffer_write;
+        bool skip_read_token;
+        bool skip_write_token;
+
         // ====================================================================
         /// Statistics related
         // ====================================================================
-        uint64_t stat_active_cycles;
-        uint64_t stat_idle_cycles;
-
-        uint64_t stat_branch_stall_cycles;
-        uint64_t stat_sync_stall_cycles;
+        struct statistics_t {
+            PROCESSOR_STATISTICS(STATISTICS_DECLARE_COUNTER, STATISTICS_DECLARE_LATENCY)
+        } statistics;
 
+        /// Opcodes and uops at the last reset, the counters themselves are never reset
         uint64_t stat_reset_fetch_opcode_counter;
         uint64_t stat_reset_decode_uop_counter;
 
-        /// Full ROB and MOB statistics
-        uint64_t stat_full_fetch_buffer;
-        uint64_t stat_full_decode_buffer;
-        uint64_t stat_full_reorder_buffer;
-        uint64_t stat_full_memory_order_buffer_read;
-        uint64_t stat_full_memory_order_buffer_write;
-
-        /// Executed Instructions
-        uint64_t stat_nop_completed;
-        uint64_t stat_branch_completed;
-        uint64_t stat_other_completed;
-
-        uint64_t stat_int_alu_completed;
-        uint64_t stat_int_mul_completed;
-        uint64_t stat_int_div_completed;
-
-        uint64_t stat_fp_alu_completed;
-        uint64_t stat_fp_mul_completed;
-        uint64_t stat_fp_div_completed;
-
-        uint64_t stat_instruction_read_completed;
-        uint64_t stat_memory_read_completed;
-        uint64_t stat_memory_write_completed;
-        uint64_t stat_address_to_address;
-
-        uint64_t stat_disambiguation_read_false_positive;
-        uint64_t stat_disambiguation_write_false_positive;
-
-
-        // Executed HMC
-        uint64_t stat_hmc_completed;
-
-        /// Dispatch Cycles Stall
-        uint64_t stat_dispatch_cycles_fu_int_alu;
-        uint64_t stat_dispatch_cycles_fu_int_mul;
-        uint64_t stat_dispatch_cycles_fu_int_div;
-
-        uint64_t stat_dispatch_cycles_fu_fp_alu;
-        uint64_t stat_dispatch_cycles_fu_fp_mul;
-        uint64_t stat_dispatch_cycles_fu_fp_div;
-
-        uint64_t stat_dispatch_cycles_fu_mem_load;
-        uint64_t stat_dispatch_cycles_fu_mem_store;
-
-        /// Memory Cycles Stall
-        uint64_t stat_min_instruction_read_wait_time;
-        uint64_t stat_max_instruction_read_wait_time;
-        uint64_t stat_accumulated_instruction_read_wait_time;
-
-        uint64_t stat_min_memory_read_wait_time;
-        uint64_t stat_max_memory_read_wait_time;
-        uint64_t stat_accumulated_memory_read_wait_time;
-
-        uint64_t stat_min_memory_write_wait_time;
-        uint64_t stat_max_memory_write_wait_time;
-        uint64_t stat_accumulated_memory_write_wait_time;
-
-        // HMC Cycles Stall
-        uint64_t stat_min_hmc_wait_time;
-        uint64_t stat_max_hmc_wait_time;
-        uint64_t stat_accumulated_hmc_wait_time;
-
-
-
     public:
         // ====================================================================
         /// Methods
@@ -300,6 +323,8 @@ class processor_t : public interconnection_interface_t {
         /// Basic Methods
         void allocate();
         void clock(uint32_t sub_cycle);
+        void clock_pipeline(uint32_t sub_cycle);
+        void clock_fetch(uint32_t sub_cycle);
         int32_t send_package(memory_package_t *package);
         bool receive_package(memory_package_t *package, uint32_t input_port, uint32_t transmission_latency);
         /// Token Controller Methods
@@ -312,10 +337,33 @@ class processor_t : public interconnection_interface_t {
         void reset_statistics();
         void print_statistics();
         void print_configuration();
+
+        /// Checkpoint Methods
+        void checkpoint(checkpoint_t *checkpoint);
+
+        /// Idle-Cycle Skipping Methods
+        uint64_t get_next_event_cycle();
+        void skip_cycles(uint64_t cycles);
         // ====================================================================
 
         void synchronize(sync_t new_sync);
         void solve_branch(uint64_t opcode_number, processor_stage_t processor_stage, instruction_operation_t operation);
+        bool functional_fetch();
+        bool is_drained();
+        functional_unit_t get_functional_unit(instruction_operation_t operation);
+        void dispatch_insert(reorder_buffer_line_t *rob_line);
+        void reservation_station_insert(reorder_buffer_line_t *rob_line);
+        void reservation_station_remove(reorder_buffer_line_t *rob_line);
+        void execution_insert_read(memory_order_buffer_line_t *mob_line);
+
+        /// uop_number of the last reservation station entry inside the window
+        inline uint64_t get_dispatch_window_last() {
+            if (this->unified_reservation_station_window_end != NULL) {
+                return this->unified_reservation_station_window_end->uop.uop_number;
+            }
+            return std::numeric_limits<uint64_t>::max();
+        };
+
         void stage_fetch();
         void stage_decode();
         void stage_rename();
@@ -327,6 +375,16 @@ class processor_t : public interconnection_interface_t {
             return (memory_addressA & this->not_fetch_offset_bits_mask) == (memory_addressB & this->not_fetch_offset_bits_mask);
         }
 
+        /// Position of the next opcode to request (fetch_opcode_counter) or the size when it is not fetched yet.
+        /// The opcode numbers inside the fetch buffer are consecutive.
+        inline uint32_t get_fetch_request_position() {
+            if (this->fetch_buffer.is_empty()) {
+                return 0;
+            }
+            uint64_t position = this->fetch_opcode_counter - this->fetch_buffer.front()->opcode_number;
+            return (position < this->fetch_buffer.get_size()) ? position : this->fetch_buffer.get_size();
+        }
+
         inline bool cmp_index_tag(uint64_t memory_addressA, uint64_t memory_addressB) {
             return (memory_addressA & this->not_offset_bits_mask) == (memory_addressB & this->not_offset_bits_mask);
         }
@@ -445,87 +503,27 @@ class processor_t : public interconnection_interface_t {
         // ====================================================================
         /// Statistics related
         // ====================================================================
-        INSTANTIATE_GET_SET_ADD(uint64_t, stat_active_cycles)
-        INSTANTIATE_GET_SET_ADD(uint64_t, stat_idle_cycles)
-
-        INSTANTIATE_GET_SET_ADD(uint64_t, stat_branch_stall_cycles)
-        INSTANTIATE_GET_SET_ADD(uint64_t, stat_sync_stall_cycles)
-
-        INSTANTIATE_GET_SET_ADD(uint64_t, stat_reset_fetch_opcode_counter)
-        INSTANTIATE_GET_SET_ADD(uint64_t, stat_reset_decode_uop_counter)
-
-        INSTANTIATE_GET_SET_ADD(uint64_t, stat_full_fetch_buffer)
-        INSTANTIATE_GET_SET_ADD(uint64_t, stat_full_decode_buffer)
-        INSTANTIATE_GET_SET_ADD(uint64_t, stat_full_reorder_buffer)
-        INSTANTIATE_GET_SET_ADD(uint64_t, stat_full_memory_order_buffer_read)
-        INSTANTIATE_GET_SET_ADD(uint64_t, stat_full_memory_order_buffer_write)
-
-        INSTANTIATE_GET_SET_ADD(uint64_t, stat_nop_completed)
-        INSTANTIATE_GET_SET_ADD(uint64_t, stat_branch_completed)
-        INSTANTIATE_GET_SET_ADD(uint64_t, stat_other_completed)
-
-        INSTANTIATE_GET_SET_ADD(uint64_t, stat_int_alu_completed)
-        INSTANTIATE_GET_SET_ADD(uint64_t, stat_int_mul_completed)
-        INSTANTIATE_GET_SET_ADD(uint64_t, stat_int_div_completed)
-
-        INSTANTIATE_GET_SET_ADD(uint64_t, stat_fp_alu_completed)
-        INSTANTIATE_GET_SET_ADD(uint64_t, stat_fp_mul_completed)
-        INSTANTIATE_GET_SET_ADD(uint64_t, stat_fp_div_completed)
-
-        INSTANTIATE_GET_SET_ADD(uint64_t, stat_instruction_read_completed)
-        INSTANTIATE_GET_SET_ADD(uint64_t, stat_memory_read_completed)
-        INSTANTIATE_GET_SET_ADD(uint64_t, stat_memory_write_completed)
-
-        INSTANTIATE_GET_SET_ADD(uint64_t, stat_disambiguation_read_false_positive)
-        INSTANTIATE_GET_SET_ADD(uint64_t, stat_disambiguation_write_false_positive)
-
-        INSTANTIATE_GET_SET_ADD(uint64_t, stat_dispatch_cycles_fu_int_alu)
-        INSTANTIATE_GET_SET_ADD(uint64_t, stat_dispatch_cycles_fu_int_mul)
-        INSTANTIATE_GET_SET_ADD(uint64_t, stat_dispatch_cycles_fu_int_div)
-
-        INSTANTIATE_GET_SET_ADD(uint64_t, stat_dispatch_cycles_fu_fp_alu)
-        INSTANTIATE_GET_SET_ADD(uint64_t, stat_dispatch_cycles_fu_fp_mul)
-        INSTANTIATE_GET_SET_ADD(uint64_t, stat_dispatch_cycles_fu_fp_div)
-
-        INSTANTIATE_GET_SET_ADD(uint64_t, stat_dispatch_cycles_fu_mem_load)
-        INSTANTIATE_GET_SET_ADD(uint64_t, stat_dispatch_cycles_fu_mem_store)
-
-        INSTANTIATE_GET_SET_ADD(uint64_t, stat_address_to_address)
+        PROCESSOR_STATISTICS(STATISTICS_COUNTER_METHODS, STATISTICS_LATENCY_METHODS)
 
         inline void add_stat_instruction_read_completed(uint64_t born_cycle) {
-            this->stat_instruction_read_completed++;
-            uint64_t new_time = (sinuca_engine.get_global_cycle() - born_cycle);
-            stat_accumulated_instruction_read_wait_time += new_time;
-            if (this->stat_min_instruction_read_wait_time > new_time) this->stat_min_instruction_read_wait_time = new_time;
-            if (this->stat_max_instruction_read_wait_time < new_time) this->stat_max_instruction_read_wait_time = new_time;
+            this->statistics.stat_instruction_read_completed++;
+            this->add_stat_instruction_read_wait_time(born_cycle);
         };
 
         inline void add_stat_memory_read_completed(uint64_t born_cycle) {
-            this->stat_memory_read_completed++;
-            uint64_t new_time = (sinuca_engine.get_global_cycle() - born_cycle);
-            this->stat_accumulated_memory_read_wait_time += new_time;
-            if (this->stat_min_memory_read_wait_time > new_time) this->stat_min_memory_read_wait_time = new_time;
-            if (this->stat_max_memory_read_wait_time < new_time) this->stat_max_memory_read_wait_time = new_time;
+            this->statistics.stat_memory_read_completed++;
+            this->add_stat_memory_read_wait_time(born_cycle);
         };
 
         inline void add_stat_memory_write_completed(uint64_t born_cycle) {
-            this->stat_memory_write_completed++;
-            uint64_t new_time = (sinuca_engine.get_global_cycle() - born_cycle);
-            this->stat_accumulated_memory_write_wait_time += new_time;
-            if (this->stat_min_memory_write_wait_time > new_time) this->stat_min_memory_write_wait_time = new_time;
-            if (this->stat_max_memory_write_wait_time < new_time) this->stat_max_memory_write_wait_time = new_time;
+            this->statistics.stat_memory_write_completed++;
+            this->add_stat_memory_write_wait_time(born_cycle);
         };
 
         // HMC
-        INSTANTIATE_GET_SET_ADD(uint64_t, stat_hmc_completed)
         inline void add_stat_hmc_completed(uint64_t born_cycle) {
-            this->stat_hmc_completed++;
-            uint64_t new_time = (sinuca_engine.get_global_cycle() - born_cycle);
-            this->stat_accumulated_hmc_wait_time += new_time;
-            if (this->stat_min_hmc_wait_time > new_time) this->stat_min_hmc_wait_time = new_time;
-            if (this->stat_max_hmc_wait_time < new_time) this->stat_max_hmc_wait_time = new_time;
+            this->statistics.stat_hmc_completed++;
+            this->add_stat_hmc_wait_time(born_cycle);
         };
-
-
 };
 #endif  // _PROCESSOR_PROCESSOR_HPP_
@@ -24,12 +24,10 @@
 // ============================================================================
 reorder_buffer_line_t::reorder_buffer_line_t() {
     this->package_clean();
-    this->reg_deps_ptr_array = NULL;
 };
 
 // ============================================================================
 reorder_buffer_line_t::~reorder_buffer_line_t() {
-    utils_t::template_delete_array<reorder_buffer_line_t*>(reg_deps_ptr_array);
 };
 
 // ============================================================================
@@ -38,6 +36,8 @@ void reorder_buffer_line_t::package_clean() {
     this->stage = PROCESSOR_STAGE_DECODE;
     this->mob_ptr = NULL;
     this->wait_reg_deps_number = 0;
+    this->reservation_station_prev = NULL;
+    this->reservation_station_next = NULL;
 };
 
 // ============================================================================
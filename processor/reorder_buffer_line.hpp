@@ -24,9 +24,12 @@ class reorder_buffer_line_t {
         processor_stage_t stage;                    /// Stage of the uOP
         /// Register Dependencies Control
         uint32_t wait_reg_deps_number;                  /// Must wait BEFORE execution
-        reorder_buffer_line_t* *reg_deps_ptr_array;     /// Elements to wake-up AFTER execution
+        wake_up_list_t<reorder_buffer_line_t> reg_deps_list;   /// Elements to wake-up AFTER execution
 
         memory_order_buffer_line_t* mob_ptr;                 /// mob pointer
+        /// Reservation station, age-ordered list of the uOPs not dispatched
+        reorder_buffer_line_t *reservation_station_prev;
+        reorder_buffer_line_t *reservation_station_next;
         // ====================================================================
         /// Methods
         // ====================================================================
@@ -0,0 +1,126 @@
+/*
+ * Copyright (C) 2010~2014  Marco Antonio Zanata Alves
+ *                          (mazalves at inf.ufrgs.br)
+ *                          GPPD - Parallel and Distributed Processing Group
+ *                          Universidade Federal do Rio Grande do Sul
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _PROCESSOR_WAKE_UP_LIST_HPP_
+#define _PROCESSOR_WAKE_UP_LIST_HPP_
+
+// ============================================================================
+/// One consumer waiting for a producer
+template <class WL_TYPE>
+class wake_up_node_t {
+    public:
+        WL_TYPE *consumer;
+        wake_up_node_t *next;
+};
+
+// ============================================================================
+/// Consumers to wake-up when the producer executes, in the order they were added.
+/// The nodes come from the wake_up_pool_t of the processor.
+template <class WL_TYPE>
+class wake_up_list_t {
+    public:
+        wake_up_node_t<WL_TYPE> *head;
+        wake_up_node_t<WL_TYPE> *tail;
+
+        wake_up_list_t() {
+            this->head = NULL;
+            this->tail = NULL;
+        };
+
+        inline bool is_empty() {
+            return (this->head == NULL);
+        };
+};
+
+// ============================================================================
+/// Nodes of all the wake-up lists of one processor, allocated once.
+/// Adding and removing a consumer is O(1), the free nodes are kept in a list.
+template <class WL_TYPE>
+class wake_up_pool_t {
+    private:
+        wake_up_node_t<WL_TYPE> *nodes;
+        wake_up_node_t<WL_TYPE> *free_list;
+        uint32_t capacity;
+
+    public:
+        wake_up_pool_t() {
+            this->nodes = NULL;
+            this->free_list = NULL;
+            this->capacity = 0;
+        };
+
+        ~wake_up_pool_t() {
+            delete []this->nodes;
+        };
+
+        /// Copy Assignment Operator
+        wake_up_pool_t& operator=(const wake_up_pool_t& other) {
+            ERROR_PRINTF("Avoid copying this structure for performance reasons.\n")
+            return *this;
+        };
+
+        void allocate(uint32_t elements) {
+            ERROR_ASSERT_PRINTF(this->nodes == NULL, "Wake-up pool already allocated.\n")
+            this->capacity = elements;
+            this->nodes = new wake_up_node_t<WL_TYPE>[elements];
+            for (uint32_t i = 0; i < elements; i++) {
+                this->nodes[i].consumer = NULL;
+                this->nodes[i].next = (i + 1 < elements) ? &this->nodes[i + 1] : NULL;
+            }
+            this->free_list = (elements > 0) ? &this->nodes[0] : NULL;
+        };
+
+        inline uint32_t get_capacity() {
+            return this->capacity;
+        };
+
+        /// Add the consumer at the end of the list
+        inline void push_back(wake_up_list_t<WL_TYPE> *list, WL_TYPE *consumer) {
+            ERROR_ASSERT_PRINTF(this->free_list != NULL, "Wake-up pool with all the %u nodes used.\n", this->capacity)
+            wake_up_node_t<WL_TYPE> *node = this->free_list;
+            this->free_list = node->next;
+
+            node->consumer = consumer;
+            node->next = NULL;
+            if (list->tail == NULL) {
+                list->head = node;
+            }
+            else {
+                list->tail->next = node;
+            }
+            list->tail = node;
+        };
+
+        /// Remove the oldest consumer of a non-empty list
+        inline WL_TYPE* pop_front(wake_up_list_t<WL_TYPE> *list) {
+            wake_up_node_t<WL_TYPE> *node = list->head;
+            WL_TYPE *consumer = node->consumer;
+
+            list->head = node->next;
+            if (list->head == NULL) {
+                list->tail = NULL;
+            }
+            node->next = this->free_list;
+            this->free_list = node;
+            return consumer;
+        };
+};
+
+#endif  // _PROCESSOR_WAKE_UP_LIST_HPP_
@@ -0,0 +1,84 @@
+/*
+ * Copyright (C) 2010~2014  Marco Antonio Zanata Alves
+ *                          (mazalves at inf.ufrgs.br)
+ *                          GPPD - Parallel and Distributed Processing Group
+ *                          Universidade Federal do Rio Grande do Sul
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+#include "./sinuca.hpp"
+
+#ifndef _PROFILE_HPP_
+#define _PROFILE_HPP_
+
+// ============================================================================
+/// Host time spent by one profiled method of one component (-profile).
+// ============================================================================
+class profile_counter_t {
+    public:
+        uint64_t ns;        /// Host nanoseconds, without the nested profiled calls
+        uint64_t calls;
+
+        profile_counter_t() {
+            this->ns = 0;
+            this->calls = 0;
+        };
+};
+
+/// Host time of the profiled calls made inside the current one (per host thread)
+extern thread_local uint64_t profile_nested_ns;
+
+// ============================================================================
+/// Accounts the host time of its scope into the counter when -profile is set.
+/// The nested profiled calls are accounted only to their own counters, so a
+/// cache receive_package made by the processor clock is not added twice.
+// ============================================================================
+class profile_scope_t {
+    private:
+        profile_counter_t *counter;
+        uint64_t start_ns;
+        uint64_t parent_nested_ns;
+        uint32_t calls;
+
+    public:
+        inline profile_scope_t(profile_counter_t *input_counter, uint32_t input_calls = 1) {
+            this->counter = NULL;
+            if (sinuca_engine.arg_profile) {
+                this->counter = input_counter;
+                this->calls = input_calls;
+                this->parent_nested_ns = profile_nested_ns;
+                profile_nested_ns = 0;
+                this->start_ns = now_ns();
+            }
+        };
+
+        inline ~profile_scope_t() {
+            if (this->counter != NULL) {
+                uint64_t elapsed_ns = now_ns() - this->start_ns;
+                this->counter->ns += elapsed_ns - profile_nested_ns;
+                this->counter->calls += this->calls;
+                profile_nested_ns = this->parent_nested_ns + elapsed_ns;
+            }
+        };
+
+        static inline uint64_t now_ns() {
+            struct timespec now;
+            clock_gettime(CLOCK_MONOTONIC, &now);
+            return (uint64_t)now.tv_sec * 1000000000ULL + now.tv_nsec;
+        };
+};
+
+#endif  // _PROFILE_HPP_
@@ -20,9 +20,18 @@
 
 #include "./sinuca.hpp"
 #include <string>
+#include <unistd.h>
+#include <dirent.h>
+#include <sys/wait.h>
 
 sinuca_engine_t sinuca_engine;
 
+/// Multi-configuration sweep
+static std::vector<char*> sweep_configuration;
+static std::vector<char*> sweep_variant;
+static uint32_t sweep_jobs = 1;
+static const char *sweep_result_prefix = "sinuca_sweep";
+
 // =============================================================================
 static void display_use() {
     SINUCA_PRINTF("SiNUCA simulates multi-core architectures with non-uniform cache architectures.\n\n");
@@ -36,15 +45,200 @@ static void display_use() {
     SINUCA_PRINTF("\t -config     \t FILE          \t Configuration file which describes the architecture. **Required\n");
     SINUCA_PRINTF("\t -trace      \t FILE          \t Trace file base name. **Required\n");
     SINUCA_PRINTF("\t -result     \t FILE          \t Output result file name. Default is \"stdout\".\n");
+    SINUCA_PRINTF("\t -result_format \t FORMAT      \t Result file format: text, json (one object per line) or binary. Default is text.\n");
     SINUCA_PRINTF("\t -warmup     \t INSTRUCTIONS  \t Warm-up instructions (opcodes) before start statistics. Default is 0.\n");
+    SINUCA_PRINTF("\t -fast_forward \t               \t Warm-up the caches, prefetchers and branch predictors functionally, without the pipeline.\n");
+    SINUCA_PRINTF("\t -sampling   \t P,D,W         \t Sampled simulation, each P opcodes: functional warm-up, W detailed warm-up and D detailed sample opcodes.\n");
+    SINUCA_PRINTF("\t -checkpoint_at \t INSTRUCTIONS  \t Drain the pipelines after these instructions (opcodes) and save the checkpoint.\n");
+    SINUCA_PRINTF("\t -checkpoint \t FILE          \t Checkpoint file written at -checkpoint_at.\n");
+    SINUCA_PRINTF("\t -restore    \t FILE          \t Start the simulation from a checkpoint saved with the same structure sizes.\n");
+    SINUCA_PRINTF("\t -warm_save  \t FILE          \t Save the caches, predictors and prefetchers at the end of the warm-up.\n");
+    SINUCA_PRINTF("\t -warm_load  \t FILE          \t Load a warm image of the same trace and structure sizes, skipping its warm-up.\n");
     SINUCA_PRINTF("\t -stopat     \t INSTRUCTIONS  \t Instructions (opcodes) to be executed before stop the simulation. Default is trace size.\n");
     SINUCA_PRINTF("\t -compressed \t BOOL          \t Set between the compressed (true) and uncompressed (false) trace file. Default is true.\n");
     SINUCA_PRINTF("\t -graph      \t FILE          \t Output graph file name to be used with GraphViz.\n");
     SINUCA_PRINTF("\t -affinity   \t THREADS       \t Inform a different affinity between the trace files and the cores.\n");
+    SINUCA_PRINTF("\t -trace_prefetch \t OPCODES   \t Decode the trace ahead with one thread per core, keeping up to OPCODES ready. Default is 0 (disabled).\n");
+    SINUCA_PRINTF("\t -trace_read_ahead \t CHUNKS   \t Chunks of each chunked trace file inflated ahead by the worker threads. Default is 2.\n");
+    SINUCA_PRINTF("\t -trace_mmap \t               \t Memory map the uncompressed trace files instead of reading them with zlib.\n");
+    SINUCA_PRINTF("\t -no_idle_skip \t               \t Clock every cycle, even when all the components are waiting.\n");
+    SINUCA_PRINTF("\t -threads    \t THREADS       \t Host threads clocking the cores pipelines in parallel. Default is 1.\n");
+    SINUCA_PRINTF("\t -profile    \t               \t Measure the host time of each component, written with the statistics.\n");
+    SINUCA_PRINTF("\t -interval   \t CYCLES        \t Write the statistics deltas of each CYCLES interval as a CSV time series.\n");
+    SINUCA_PRINTF("\t -interval_opcodes \t OPCODES \t Write the statistics deltas of each OPCODES interval as a CSV time series.\n");
+    SINUCA_PRINTF("\t -interval_file \t FILE        \t Interval time series file. Default is RESULT.interval.csv (or sinuca.interval.csv).\n");
+    SINUCA_PRINTF("\t -sweep      \t FILE,FILE,... \t Simulate the trace with each configuration file, decoding the trace only once.\n");
+    SINUCA_PRINTF("\t -variants   \t FILE,FILE,... \t Fork one simulation per variant file after the warm-up, each changing some latencies and policies.\n");
+    SINUCA_PRINTF("\t -sweep_jobs \t JOBS          \t Configurations of the sweep (or variants) simulated at the same time. Default is 1.\n");
 
     exit(EXIT_FAILURE);
 };
 
+// =============================================================================
+/// Removes the trace decoded for the sweep
+static void sweep_remove_directory(const char *directory) {
+    DIR *dir = opendir(directory);
+    if (dir == NULL) {
+        return;
+    }
+    struct dirent *entry;
+    while ((entry = readdir(dir)) != NULL) {
+        if (strcmp(entry->d_name, ".") != 0 && strcmp(entry->d_name, "..") != 0) {
+            unlink((std::string(directory) + "/" + entry->d_name).c_str());
+        }
+    }
+    closedir(dir);
+    rmdir(directory);
+};
+
+// =============================================================================
+/// Runs one process per input file, at most sweep_jobs at the same time. Each
+/// run writes RESULT.NAME and its log into RESULT.NAME.log, where NAME is the
+/// file name without the extension. Returns the run index in the children and
+/// POSITION_FAIL in the parent, after all the runs are finished.
+static int32_t sweep_fork(const std::vector<char*> &input, uint32_t *failed) {
+    struct stat buf;
+    std::vector<std::string> result_name;
+    for (uint32_t i = 0; i < input.size(); i++) {
+        std::string name = input[i];
+        name = name.substr(name.rfind('/') + 1);
+        name = name.substr(0, name.rfind('.'));
+        result_name.push_back(std::string(sweep_result_prefix) + "." + name);
+        for (uint32_t j = 0; j < i; j++) {
+            ERROR_ASSERT_PRINTF(result_name[j] != result_name[i], "Sweep files with the same name: %s\n", name.c_str())
+        }
+        ERROR_ASSERT_PRINTF(stat(result_name[i].c_str(), &buf) != 0, "Result file already exist: %s\n", result_name[i].c_str())
+    }
+
+    std::vector<pid_t> running(input.size(), 0);
+    uint32_t jobs = 0;
+    for (uint32_t i = 0; i <= input.size(); i++) {
+        /// Wait for a free job, or all of them after the last run
+        while (jobs > 0 && (jobs == sweep_jobs || i == input.size())) {
+            int status;
+            pid_t pid = wait(&status);
+            for (uint32_t j = 0; j < i; j++) {
+                if (running[j] == pid) {
+                    bool ok = WIFEXITED(status) && WEXITSTATUS(status) == EXIT_SUCCESS;
+                    *failed += !ok;
+                    SINUCA_PRINTF("Sweep: %s %s\n", input[j], ok ? "finished" : "FAILED")
+                    running[j] = 0;
+                    jobs--;
+                }
+            }
+        }
+        if (i == input.size()) {
+            break;
+        }
+
+        SINUCA_PRINTF("Sweep: %s -> %s\n", input[i], result_name[i].c_str())
+        fflush(stdout);
+        running[i] = fork();
+        ERROR_ASSERT_PRINTF(running[i] >= 0, "Could not fork the sweep run.\n")
+        if (running[i] == 0) {
+            sinuca_engine.arg_result_file_name = utils_t::template_allocate_array<char>(result_name[i].size() + 1);
+            strcpy(sinuca_engine.arg_result_file_name, result_name[i].c_str());
+            if (sinuca_engine.arg_interval_cycles != 0 || sinuca_engine.arg_interval_opcodes != 0) {
+                std::string interval_name = result_name[i] + ".interval.csv";
+                sinuca_engine.arg_interval_file_name = utils_t::template_allocate_array<char>(interval_name.size() + 1);
+                strcpy(sinuca_engine.arg_interval_file_name, interval_name.c_str());
+            }
+            ERROR_ASSERT_PRINTF(freopen((result_name[i] + ".log").c_str(), "w", stdout) != NULL, "Could not open the sweep log.\n")
+            dup2(fileno(stdout), STDERR_FILENO);
+            return i;
+        }
+        jobs++;
+    }
+    return POSITION_FAIL;
+};
+
+// =============================================================================
+/// The text trace is converted once into an uncompressed binary trace, which
+/// is memory mapped by one process per configuration (the engine is a global
+/// object), so the page cache is shared and no run decompresses or parses it.
+/// Returns only in the children, the parent exits when all runs are finished.
+static void sweep_configurations() {
+    std::string trace_name = sinuca_engine.arg_trace_file_name;
+    std::string directory;
+    struct stat buf;
+
+    if (stat((trace_name + ".tid0.stat.bin").c_str(), &buf) != 0) {
+        char exe_name[TRACE_FILE_NAME_SIZE];
+        ssize_t size = readlink("/proc/self/exe", exe_name, sizeof(exe_name) - 1);
+        ERROR_ASSERT_PRINTF(size > 0, "Could not find the SiNUCA binary path.\n")
+        exe_name[size] = '\0';
+        std::string converter = exe_name;
+        converter = converter.substr(0, converter.rfind('/') + 1) + "sinuca_trace_converter";
+
+        const char *tmp_dir = getenv("TMPDIR");
+        directory = std::string(tmp_dir != NULL ? tmp_dir : "/tmp") + "/sinuca_sweep.XXXXXX";
+        ERROR_ASSERT_PRINTF(mkdtemp(&directory[0]) != NULL, "Could not create the sweep directory %s.\n", directory.c_str())
+        std::string binary_name = directory + "/" + trace_name.substr(trace_name.rfind('/') + 1);
+
+        SINUCA_PRINTF("Sweep: decoding %s into %s\n", trace_name.c_str(), binary_name.c_str())
+        fflush(stdout);
+        pid_t pid = fork();
+        ERROR_ASSERT_PRINTF(pid >= 0, "Could not fork the trace converter.\n")
+        if (pid == 0) {
+            execl(converter.c_str(), converter.c_str(), "-trace", trace_name.c_str(), "-output", binary_name.c_str(), "-compress", "0", (char*)NULL);
+            _exit(EXIT_FAILURE);
+        }
+        int status;
+        waitpid(pid, &status, 0);
+        if (!WIFEXITED(status) || WEXITSTATUS(status) != EXIT_SUCCESS) {
+            sweep_remove_directory(directory.c_str());
+            ERROR_PRINTF("Could not convert the trace with %s.\n", converter.c_str())
+        }
+        trace_name = binary_name;
+    }
+
+    uint32_t failed = 0;
+    int32_t run = sweep_fork(sweep_configuration, &failed);
+    if (run != POSITION_FAIL) {
+        sinuca_engine.arg_configuration_file_name = sweep_configuration[run];
+        sinuca_engine.arg_trace_file_name = utils_t::template_allocate_array<char>(trace_name.size() + 1);
+        strcpy(sinuca_engine.arg_trace_file_name, trace_name.c_str());
+        sinuca_engine.arg_trace_mmap = true;
+        return;
+    }
+
+    if (!directory.empty()) {
+        sweep_remove_directory(directory.c_str());
+    }
+    SINUCA_PRINTF("Sweep: %u configuration(s), %u failed\n", (uint32_t)sweep_configuration.size(), failed)
+    exit(failed == 0 ? EXIT_SUCCESS : EXIT_FAILURE);
+};
+
+// =============================================================================
+/// The warm-up runs once and ends with the machine drained, then one process
+/// per variant file (the engine is a global object) applies its latencies and
+/// policies and simulates the rest of the trace from the same warm state.
+/// Returns only in the children, the parent exits when all runs are finished.
+static void sweep_variants() {
+    if (!sinuca_engine.arg_fast_forward && sinuca_engine.arg_warm_save_file_name == NULL) {
+        sinuca_engine.global_detailed(sinuca_engine.arg_warmup_instructions, true);
+    }
+    SINUCA_PRINTF("Variants Fork - Cycle: %-12" PRIu64 " Opcodes: %-12" PRIu64 "\n", sinuca_engine.get_global_cycle(), sinuca_engine.trace_reader->get_trace_opcode_total());
+
+    /// Threads do not survive the fork
+    sinuca_engine.stop_clock_threads();
+    sinuca_engine.trace_reader->prepare_fork();
+
+    uint32_t failed = 0;
+    int32_t run = sweep_fork(sweep_variant, &failed);
+    if (run != POSITION_FAIL) {
+        sinuca_engine.trace_reader->reopen_trace_files();
+        sinuca_engine.global_open_output_files();
+        sinuca_engine.apply_variant(sweep_variant[run]);
+        sinuca_engine.start_clock_threads();
+        SINUCA_PRINTF("Variant Applied: %s\n", sweep_variant[run]);
+        return;
+    }
+
+    SINUCA_PRINTF("Variants: %u file(s), %u failed\n", (uint32_t)sweep_variant.size(), failed)
+    exit(failed == 0 ? EXIT_SUCCESS : EXIT_FAILURE);
+};
+
 // =============================================================================
 static void process_argv(int argc, char **argv) {
     uint32_t req_args_processed = 0;
@@ -53,8 +247,27 @@ static void process_argv(int argc, char **argv) {
     sinuca_engine.arg_configuration_file_name = NULL;
     sinuca_engine.arg_trace_file_name = NULL;
     sinuca_engine.arg_result_file_name = NULL;
+    sinuca_engine.arg_result_format = STATISTICS_FORMAT_TEXT;
     sinuca_engine.arg_warmup_instructions = 0;
+    sinuca_engine.arg_fast_forward = false;
+    sinuca_engine.arg_sampling_period = 0;
+    sinuca_engine.arg_sampling_detailed = 0;
+    sinuca_engine.arg_sampling_warming = 0;
+    sinuca_engine.arg_checkpoint_instructions = 0;
+    sinuca_engine.arg_checkpoint_file_name = NULL;
+    sinuca_engine.arg_restore_file_name = NULL;
+    sinuca_engine.arg_warm_save_file_name = NULL;
+    sinuca_engine.arg_warm_load_file_name = NULL;
     sinuca_engine.arg_stopat_instructions = 0;
+    sinuca_engine.arg_trace_prefetch = 0;
+    sinuca_engine.arg_trace_read_ahead = 2;
+    sinuca_engine.arg_trace_mmap = false;
+    sinuca_engine.arg_idle_skip = true;
+    sinuca_engine.arg_clock_threads = 1;
+    sinuca_engine.arg_profile = false;
+    sinuca_engine.arg_interval_cycles = 0;
+    sinuca_engine.arg_interval_opcodes = 0;
+    sinuca_engine.arg_interval_file_name = NULL;
     sinuca_engine.arg_graph_file_name = NULL;
     sinuca_engine.arg_default_affinity = true;
 
@@ -86,6 +299,23 @@ static void process_argv(int argc, char **argv) {
                 display_use();
             }
         }
+        else if (strcmp(*argv, "-result_format") == 0) {
+            argc--;
+            argv++;
+            if (strcmp(*argv, "text") == 0) {
+                sinuca_engine.arg_result_format = STATISTICS_FORMAT_TEXT;
+            }
+            else if (strcmp(*argv, "json") == 0) {
+                sinuca_engine.arg_result_format = STATISTICS_FORMAT_JSON;
+            }
+            else if (strcmp(*argv, "binary") == 0) {
+                sinuca_engine.arg_result_format = STATISTICS_FORMAT_BINARY;
+            }
+            else {
+                SINUCA_PRINTF(">> Result format should be text, json or binary.\n\n")
+                display_use();
+            }
+        }
         else if (strcmp(*argv, "-warmup") == 0) {
             argc--;
             argv++;
@@ -95,6 +325,56 @@ static void process_argv(int argc, char **argv) {
                 display_use();
             }
         }
+        else if (strcmp(*argv, "-fast_forward") == 0) {
+            sinuca_engine.arg_fast_forward = true;
+        }
+        else if (strcmp(*argv, "-sampling") == 0) {
+            argc--;
+            argv++;
+            if (sscanf(*argv, "%u,%u,%u", &sinuca_engine.arg_sampling_period, &sinuca_engine.arg_sampling_detailed, &sinuca_engine.arg_sampling_warming) != 3 ||
+            sinuca_engine.arg_sampling_detailed == 0 ||
+            (uint64_t)sinuca_engine.arg_sampling_detailed + sinuca_engine.arg_sampling_warming > sinuca_engine.arg_sampling_period) {
+                SINUCA_PRINTF(">> Sampling should be PERIOD,DETAILED,WARMING with DETAILED + WARMING <= PERIOD.\n\n")
+                display_use();
+            }
+        }
+        else if (strcmp(*argv, "-checkpoint_at") == 0) {
+            argc--;
+            argv++;
+            sinuca_engine.arg_checkpoint_instructions = atoi(*argv);
+            if (atoi(*argv) <= 0) {
+                SINUCA_PRINTF(">> Checkpoint instructions should be greater than zero.\n\n")
+                display_use();
+            }
+        }
+        else if (strcmp(*argv, "-checkpoint") == 0) {
+            argc--;
+            argv++;
+            sinuca_engine.arg_checkpoint_file_name = *argv;
+        }
+        else if (strcmp(*argv, "-restore") == 0) {
+            argc--;
+            argv++;
+            sinuca_engine.arg_restore_file_name = *argv;
+            if (stat(sinuca_engine.arg_restore_file_name, &buf) == true) {
+                SINUCA_PRINTF("Checkpoint file does not exist: %s\n\n", sinuca_engine.arg_restore_file_name)
+                display_use();
+            }
+        }
+        else if (strcmp(*argv, "-warm_save") == 0) {
+            argc--;
+            argv++;
+            sinuca_engine.arg_warm_save_file_name = *argv;
+        }
+        else if (strcmp(*argv, "-warm_load") == 0) {
+            argc--;
+            argv++;
+            sinuca_engine.arg_warm_load_file_name = *argv;
+            if (stat(sinuca_engine.arg_warm_load_file_name, &buf) == true) {
+                SINUCA_PRINTF("Warm image file does not exist: %s\n\n", sinuca_engine.arg_warm_load_file_name)
+                display_use();
+            }
+        }
         else if (strcmp(*argv, "-stopat") == 0) {
             argc--;
             argv++;
@@ -104,6 +384,93 @@ static void process_argv(int argc, char **argv) {
                 display_use();
             }
         }
+        else if (strcmp(*argv, "-trace_prefetch") == 0) {
+            argc--;
+            argv++;
+            sinuca_engine.arg_trace_prefetch = atoi(*argv);
+            if (atoi(*argv) < 0) {
+                SINUCA_PRINTF(">> Trace prefetch opcodes should be greater or equal than zero.\n\n")
+                display_use();
+            }
+        }
+        else if (strcmp(*argv, "-trace_read_ahead") == 0) {
+            argc--;
+            argv++;
+            sinuca_engine.arg_trace_read_ahead = atoi(*argv);
+            if (atoi(*argv) < 0) {
+                SINUCA_PRINTF(">> Trace read-ahead chunks should be greater or equal than zero.\n\n")
+                display_use();
+            }
+        }
+        else if (strcmp(*argv, "-trace_mmap") == 0) {
+            sinuca_engine.arg_trace_mmap = true;
+        }
+        else if (strcmp(*argv, "-profile") == 0) {
+            sinuca_engine.arg_profile = true;
+        }
+        else if (strcmp(*argv, "-interval") == 0) {
+            argc--;
+            argv++;
+            sinuca_engine.arg_interval_cycles = atoi(*argv);
+            if (atoi(*argv) <= 0) {
+                SINUCA_PRINTF(">> Interval cycles should be greater than zero.\n\n")
+                display_use();
+            }
+        }
+        else if (strcmp(*argv, "-interval_opcodes") == 0) {
+            argc--;
+            argv++;
+            sinuca_engine.arg_interval_opcodes = atoi(*argv);
+            if (atoi(*argv) <= 0) {
+                SINUCA_PRINTF(">> Interval opcodes should be greater than zero.\n\n")
+                display_use();
+            }
+        }
+        else if (strcmp(*argv, "-interval_file") == 0) {
+            argc--;
+            argv++;
+            sinuca_engine.arg_interval_file_name = *argv;
+        }
+        else if (strcmp(*argv, "-no_idle_skip") == 0) {
+            sinuca_engine.arg_idle_skip = false;
+        }
+        else if (strcmp(*argv, "-threads") == 0) {
+            argc--;
+            argv++;
+            sinuca_engine.arg_clock_threads = atoi(*argv);
+            if (atoi(*argv) <= 0) {
+                SINUCA_PRINTF(">> Threads should be greater than zero.\n\n")
+                display_use();
+            }
+        }
+        else if (strcmp(*argv, "-sweep") == 0) {
+            argc--;
+            argv++;
+            char *pch = strtok(*argv, ",");
+            while (pch != NULL) {
+                sweep_configuration.push_back(pch);
+                pch = strtok(NULL, ",");
+            }
+            req_args_processed++;
+        }
+        else if (strcmp(*argv, "-variants") == 0) {
+            argc--;
+            argv++;
+            char *pch = strtok(*argv, ",");
+            while (pch != NULL) {
+                sweep_variant.push_back(pch);
+                pch = strtok(NULL, ",");
+            }
+        }
+        else if (strcmp(*argv, "-sweep_jobs") == 0) {
+            argc--;
+            argv++;
+            sweep_jobs = atoi(*argv);
+            if (atoi(*argv) <= 0) {
+                SINUCA_PRINTF(">> Sweep jobs should be greater than zero.\n\n")
+                display_use();
+            }
+        }
         else if (strcmp(*argv, "-graph") == 0) {
             argc--;
             argv++;
@@ -150,6 +517,100 @@ static void process_argv(int argc, char **argv) {
         display_use();
     }
 
+    if (sinuca_engine.arg_sampling_period != 0 && sinuca_engine.arg_warmup_instructions != 0) {
+        SINUCA_PRINTF(">> Sampling already warms-up each sample, do not use it with warm-up.\n\n")
+        display_use();
+    }
+
+    if ((sinuca_engine.arg_checkpoint_file_name != NULL) != (sinuca_engine.arg_checkpoint_instructions != 0)) {
+        SINUCA_PRINTF(">> Checkpoint requires both the file (-checkpoint) and the instructions (-checkpoint_at).\n\n")
+        display_use();
+    }
+
+    if (sinuca_engine.arg_sampling_period != 0 && (sinuca_engine.arg_checkpoint_file_name != NULL || sinuca_engine.arg_restore_file_name != NULL)) {
+        SINUCA_PRINTF(">> Sampling cannot be used with checkpoint or restore.\n\n")
+        display_use();
+    }
+
+    if (sinuca_engine.arg_warm_save_file_name != NULL && sinuca_engine.arg_warmup_instructions == 0) {
+        SINUCA_PRINTF(">> Warm image requires the warm-up instructions (-warmup).\n\n")
+        display_use();
+    }
+
+    if ((sinuca_engine.arg_warm_save_file_name != NULL || sinuca_engine.arg_warm_load_file_name != NULL) &&
+    (sinuca_engine.arg_sampling_period != 0 || sinuca_engine.arg_restore_file_name != NULL)) {
+        SINUCA_PRINTF(">> Warm images cannot be used with sampling or restore.\n\n")
+        display_use();
+    }
+
+    if (!sweep_configuration.empty() && sinuca_engine.arg_configuration_file_name != NULL) {
+        SINUCA_PRINTF(">> Use either one configuration (-config) or the sweep (-sweep).\n\n")
+        display_use();
+    }
+
+    if (!sweep_configuration.empty() &&
+    (sinuca_engine.arg_checkpoint_file_name != NULL || sinuca_engine.arg_warm_save_file_name != NULL || sinuca_engine.arg_graph_file_name != NULL)) {
+        SINUCA_PRINTF(">> Sweep configurations would write the same checkpoint, warm image or graph file.\n\n")
+        display_use();
+    }
+
+    if (!sweep_variant.empty() && (!sweep_configuration.empty() || sinuca_engine.arg_warmup_instructions == 0)) {
+        SINUCA_PRINTF(">> Variants require the warm-up instructions (-warmup) and cannot be used with the sweep.\n\n")
+        display_use();
+    }
+
+    if (!sweep_variant.empty() &&
+    (sinuca_engine.arg_trace_prefetch != 0 || sinuca_engine.arg_checkpoint_file_name != NULL || sinuca_engine.arg_graph_file_name != NULL)) {
+        SINUCA_PRINTF(">> Variants cannot be used with the trace prefetch, checkpoint or graph.\n\n")
+        display_use();
+    }
+
+    if (sinuca_engine.arg_result_format != STATISTICS_FORMAT_TEXT && sinuca_engine.arg_result_file_name == NULL) {
+        SINUCA_PRINTF(">> The json and binary result formats require the result file (-result).\n\n")
+        display_use();
+    }
+
+    if (sinuca_engine.arg_interval_cycles != 0 && sinuca_engine.arg_interval_opcodes != 0) {
+        SINUCA_PRINTF(">> Use either the interval cycles (-interval) or opcodes (-interval_opcodes).\n\n")
+        display_use();
+    }
+
+    if (sinuca_engine.arg_interval_cycles == 0 && sinuca_engine.arg_interval_opcodes == 0 && sinuca_engine.arg_interval_file_name != NULL) {
+        SINUCA_PRINTF(">> Interval file requires the interval (-interval or -interval_opcodes).\n\n")
+        display_use();
+    }
+
+    if ((sinuca_engine.arg_interval_cycles != 0 || sinuca_engine.arg_interval_opcodes != 0) && sinuca_engine.arg_sampling_period != 0) {
+        SINUCA_PRINTF(">> Intervals cannot be used with sampling, the samples are not contiguous.\n\n")
+        display_use();
+    }
+
+    if (sinuca_engine.arg_interval_file_name != NULL && (!sweep_configuration.empty() || !sweep_variant.empty())) {
+        SINUCA_PRINTF(">> Sweep and variants write one interval file per run, named after its result file.\n\n")
+        display_use();
+    }
+
+    /// Without the sweep or variants, named after the result file
+    if ((sinuca_engine.arg_interval_cycles != 0 || sinuca_engine.arg_interval_opcodes != 0) &&
+    sinuca_engine.arg_interval_file_name == NULL && sweep_configuration.empty() && sweep_variant.empty()) {
+        std::string interval_name = std::string(sinuca_engine.arg_result_file_name != NULL ? sinuca_engine.arg_result_file_name : "sinuca") + ".interval.csv";
+        sinuca_engine.arg_interval_file_name = utils_t::template_allocate_array<char>(interval_name.size() + 1);
+        strcpy(sinuca_engine.arg_interval_file_name, interval_name.c_str());
+    }
+
+    /// The -result name becomes the prefix of each run result
+    if (!sweep_configuration.empty() || !sweep_variant.empty()) {
+        if (sinuca_engine.arg_result_file_name != NULL) {
+            sweep_result_prefix = sinuca_engine.arg_result_file_name;
+        }
+        sinuca_engine.arg_result_file_name = NULL;
+    }
+
+    /// Only the sweep children return, each with its own configuration
+    if (!sweep_configuration.empty()) {
+        sweep_configurations();
+    }
+
     ERROR_ASSERT_PRINTF(sinuca_engine.arg_configuration_file_name != NULL, "Configuration file not defined.\n");
     ERROR_ASSERT_PRINTF(sinuca_engine.arg_trace_file_name != NULL, "Trace file not defined.\n");
 
@@ -165,8 +626,22 @@ static void process_argv(int argc, char **argv) {
     SINUCA_PRINTF("CONFIGURATION PATH: %s\n", sinuca_engine.arg_configuration_path      != NULL ? sinuca_engine.arg_configuration_path      : "MISSING");
     SINUCA_PRINTF("TRACE FILE:         %s\n", sinuca_engine.arg_trace_file_name         != NULL ? sinuca_engine.arg_trace_file_name         : "MISSING");
     SINUCA_PRINTF("RESULT FILE:        %s\n", sinuca_engine.arg_result_file_name        != NULL ? sinuca_engine.arg_result_file_name        : "MISSING");
+    SINUCA_PRINTF("RESULT FORMAT:      %s\n", get_enum_statistics_format_char(sinuca_engine.arg_result_format));
     SINUCA_PRINTF("WARM-UP OPCODES:    %u\n", sinuca_engine.arg_warmup_instructions);
+    SINUCA_PRINTF("FAST-FORWARD:       %s\n", sinuca_engine.arg_fast_forward ? "ON" : "OFF");
+    SINUCA_PRINTF("SAMPLING:           %u,%u,%u\n", sinuca_engine.arg_sampling_period, sinuca_engine.arg_sampling_detailed, sinuca_engine.arg_sampling_warming);
+    SINUCA_PRINTF("CHECKPOINT:         %s at %u\n", sinuca_engine.arg_checkpoint_file_name != NULL ? sinuca_engine.arg_checkpoint_file_name : "MISSING", sinuca_engine.arg_checkpoint_instructions);
+    SINUCA_PRINTF("RESTORE:            %s\n", sinuca_engine.arg_restore_file_name != NULL ? sinuca_engine.arg_restore_file_name : "MISSING");
+    SINUCA_PRINTF("WARM SAVE:          %s\n", sinuca_engine.arg_warm_save_file_name != NULL ? sinuca_engine.arg_warm_save_file_name : "MISSING");
+    SINUCA_PRINTF("WARM LOAD:          %s\n", sinuca_engine.arg_warm_load_file_name != NULL ? sinuca_engine.arg_warm_load_file_name : "MISSING");
     SINUCA_PRINTF("STOP-AT OPCODES:    %u\n", sinuca_engine.arg_stopat_instructions);
+    SINUCA_PRINTF("TRACE PREFETCH:     %u\n", sinuca_engine.arg_trace_prefetch);
+    SINUCA_PRINTF("TRACE READ AHEAD:   %u\n", sinuca_engine.arg_trace_read_ahead);
+    SINUCA_PRINTF("TRACE MMAP:         %s\n", sinuca_engine.arg_trace_mmap ? "ON" : "OFF");
+    SINUCA_PRINTF("IDLE SKIP:          %s\n", sinuca_engine.arg_idle_skip ? "ON" : "OFF");
+    SINUCA_PRINTF("THREADS:            %u\n", sinuca_engine.arg_clock_threads);
+    SINUCA_PRINTF("PROFILE:            %s\n", sinuca_engine.arg_profile ? "ON" : "OFF");
+    SINUCA_PRINTF("INTERVAL:           %u cycles, %u opcodes, %s\n", sinuca_engine.arg_interval_cycles, sinuca_engine.arg_interval_opcodes, sinuca_engine.arg_interval_file_name != NULL ? sinuca_engine.arg_interval_file_name : "MISSING");
     SINUCA_PRINTF("GRAPH FILE:         %s\n", sinuca_engine.arg_graph_file_name         != NULL ? sinuca_engine.arg_graph_file_name        : "MISSING");
     SINUCA_PRINTF("AFFINITY:           %s\n", sinuca_engine.arg_default_affinity ? "DEFAULT" : "USER DEFINED");
     for (uint32_t i=0; i<core_affinity; i++) {
@@ -289,8 +764,54 @@ int main(int argc, char **argv) {
     SINUCA_PRINTF("\n");
     SINUCA_PRINTF("=====================  Simulating  =====================\n");
 
+    /// The restored state replaces the allocated one, including the statistics
+    if (sinuca_engine.arg_restore_file_name != NULL) {
+        sinuca_engine.global_checkpoint(sinuca_engine.arg_restore_file_name, true, false);
+        SINUCA_PRINTF("Checkpoint Restored - Cycle: %-12" PRIu64 " Opcodes: %-12" PRIu64 "\n", sinuca_engine.get_global_cycle(), sinuca_engine.trace_reader->get_trace_opcode_total());
+    }
+
+    /// The warm-up was done by the run which saved the image
+    if (sinuca_engine.arg_warm_load_file_name != NULL) {
+        sinuca_engine.global_checkpoint(sinuca_engine.arg_warm_load_file_name, true, true);
+        sinuca_engine.global_reset_statistics();
+        SINUCA_PRINTF("Warm Image Loaded - Cycle: %-12" PRIu64 " Opcodes: %-12" PRIu64 "\n", sinuca_engine.get_global_cycle(), sinuca_engine.trace_reader->get_trace_opcode_total());
+    }
+
     SINUCA_PRINTF("Warm-Up Start - Cycle: %-12" PRIu64 "\n", sinuca_engine.get_global_cycle() );
 
+    /// Functional Warm-Up, the pipeline continues from the last fetched opcodes
+    if (sinuca_engine.arg_fast_forward && sinuca_engine.arg_warmup_instructions != 0) {
+        sinuca_engine.global_fast_forward(sinuca_engine.arg_warmup_instructions);
+        SINUCA_PRINTF("Fast-Forward End - Cycle: %-12" PRIu64 "\n", sinuca_engine.get_global_cycle() );
+    }
+
+    /// Learning state at the warm-up end, the functional warm-up has no requests in flight
+    if (sinuca_engine.arg_warm_save_file_name != NULL) {
+        if (!sinuca_engine.arg_fast_forward) {
+            sinuca_engine.global_detailed(sinuca_engine.arg_warmup_instructions, true);
+        }
+        sinuca_engine.global_checkpoint(sinuca_engine.arg_warm_save_file_name, false, true);
+        SINUCA_PRINTF("Warm Image Saved - Cycle: %-12" PRIu64 " Opcodes: %-12" PRIu64 "\n", sinuca_engine.get_global_cycle(), sinuca_engine.trace_reader->get_trace_opcode_total());
+    }
+
+    /// Only the variant children return, each with its own latencies and policies
+    if (!sweep_variant.empty()) {
+        sweep_variants();
+    }
+
+    /// Drained pipelines at the checkpoint, the simulation continues after saving it
+    if (sinuca_engine.arg_checkpoint_file_name != NULL) {
+        sinuca_engine.global_detailed(sinuca_engine.arg_checkpoint_instructions, true);
+        sinuca_engine.global_checkpoint(sinuca_engine.arg_checkpoint_file_name, false, false);
+        SINUCA_PRINTF("Checkpoint Saved - Cycle: %-12" PRIu64 " Opcodes: %-12" PRIu64 "\n", sinuca_engine.get_global_cycle(), sinuca_engine.trace_reader->get_trace_opcode_total());
+    }
+
+    /// Sampled simulation until the traces end, the clock below finishes the pipelines
+    if (sinuca_engine.arg_sampling_period != 0) {
+        sinuca_engine.global_sampling();
+        SINUCA_PRINTF("Sampling End - Cycle: %-12" PRIu64 " Samples: %-12" PRIu64 "\n", sinuca_engine.get_global_cycle(), sinuca_engine.sampling_samples);
+    }
+
     /// Start CLOCK
     while (sinuca_engine.get_is_simulation_allocated() && sinuca_engine.alive()) {
         /// Spawn Warmup - is_warmup is set inside the trace_reader
@@ -306,6 +827,7 @@ int main(int argc, char **argv) {
             SINUCA_PRINTF("Heart-Beat - Cycle: %-12" PRIu64 "", sinuca_engine.get_global_cycle() );
             SINUCA_PRINTF("%s\n", simulation_status_to_string().c_str());
         }
+        sinuca_engine.global_interval();
 
         /// Spawn Periodic Check
         if ((sinuca_engine.get_global_cycle() % PERIODIC_CHECK) == 0) {
@@ -314,6 +836,7 @@ int main(int argc, char **argv) {
 
         /// Spawn Clock Signal
         sinuca_engine.global_clock();
+        sinuca_engine.global_skip_idle_cycles();
     }
 
     SINUCA_PRINTF("Evicting all cache lines... \n")
@@ -33,6 +33,7 @@
 #include <sys/types.h>
 #include <sys/stat.h>
 #include <sys/time.h>
+#include <sys/resource.h>
 #include <inttypes.h>
 #include <stdint.h>
 #include <signal.h>
@@ -46,10 +47,18 @@
 #include <cstring>
 #include <cmath>
 #include <fstream>
+#include <algorithm>
+#include <functional>
 #include <limits>
 #include <vector>
 #include <string>
 #include <unordered_map>
+#include <atomic>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <deque>
+#include <chrono>
 
 /// Embedded Libraries
 #include "./extra_libs/include/zlib.h"
@@ -59,6 +68,12 @@
 /// Classes
 // ============================================================================
 class trace_reader_t;
+class trace_ring_t;
+class trace_chunk_reader_t;
+class trace_chunk_pool_t;
+class trace_mmap_t;
+class trace_static_dict_t;
+class trace_static_uop_t;
 class sinuca_engine_t;
 /// Packages
 class opcode_package_t;
@@ -119,6 +134,7 @@ class memory_channel_t;
 class memory_controller_t;
 /// Useful static methods
 class utils_t;
+class checkpoint_t;
 template<class CB_TYPE> class circular_buffer_t;
 
 // ============================================================================
@@ -132,6 +148,7 @@ extern sinuca_engine_t sinuca_engine;
 #define HEART_BEAT      10000000  /// Period to inform the Progress
 #define MAX_ALIVE_TIME   1000000  /// Max Time for a request to be solved
 #define PERIODIC_CHECK  10000000  /// Period between the Periodic Check
+#define IDLE_SKIP_BACKOFF     64  /// Max cycles between idle-skip checks after finding busy components
 // ~ #define PERIODIC_CHECK  1  /// Period between the Periodic Check
 
 // ~ #define INITIALIZE_DEBUG 100000    /// Cycle to start the DEBUG_PRINTF (0 to disable)
@@ -142,6 +159,9 @@ extern sinuca_engine_t sinuca_engine;
 #define INFINITE (std::numeric_limits<uint32_t>::max())             /// interconnection_controller_t
 #define UNDESIRABLE (sinuca_engine.get_interconnection_interface_array_size()) /// interconnection_controller_t
 #define TRACE_LINE_SIZE 512     /// trace_reader_t (should not be smaller than on trace line)
+#define TRACE_FILE_NAME_SIZE 500   /// trace_reader_t (trace file names)
+#define TRACE_BINARY_BUFFER_SIZE 4096   /// trace_reader_t (records read at once from the binary trace)
+#define TRACE_PREFETCH_SLEEP_US 50     /// trace_reader_t (prefetch thread back-off when its ring is full)
 #define CONVERSION_SIZE 65
 #define MAX_UOP_DECODED 5       /// processor_t (Max number of uops from one opcode)
 #define MAX_REGISTERS 6         /// opcode_package_t uop_package_t  (Max number of register (read or write) for one opcode/uop)
@@ -293,13 +313,23 @@ typedef std::vector <memory_controller_t*>          container_ptr_memory_control
 
 /// Sinuca Headers
 #include "./enumerations.hpp"
+#include "./trace_reader/trace_binary.hpp"
+#include "./trace_reader/trace_index.hpp"
+#include "./trace_reader/trace_chunk_pool.hpp"
+#include "./trace_reader/trace_chunk_reader.hpp"
+#include "./trace_reader/trace_mmap.hpp"
 #include "./trace_reader/trace_reader.hpp"
 
 #include "./packages/opcode_package.hpp"
 #include "./packages/uop_package.hpp"
 #include "./packages/memory_package.hpp"
+#include "./trace_reader/trace_static_dict.hpp"
 
+#include "./statistics_binary.hpp"
+#include "./statistics_writer.hpp"
+#include "./statistics_registry.hpp"
 #include "./sinuca_engine.hpp"
+#include "./profile.hpp"
 
 // ============================================================================
 /// Interconnection Components
@@ -328,6 +358,8 @@ typedef std::vector <memory_controller_t*>          container_ptr_memory_control
 #include "./branch_predictor/branch_predictor_perfect.hpp"
 #include "./branch_predictor/branch_predictor_disable.hpp"
 
+#include "./processor/wake_up_list.hpp"
+#include "./processor/event_wheel.hpp"
 #include "./processor/memory_order_buffer_line.hpp"
 #include "./processor/reorder_buffer_line.hpp"
 #include "./processor/processor.hpp"
@@ -374,6 +406,8 @@ typedef std::vector <memory_controller_t*>          container_ptr_memory_control
 /// Useful Methods
 // ============================================================================
 #include "./utils.hpp"
+#include "./checkpoint.hpp"
 #include "./circular_buffer.hpp"
+#include "./trace_reader/trace_ring.hpp"
 
 #endif  // _SINUCA_SINUCA_HPP_
@@ -150,6 +150,9 @@ void sinuca_engine_t::initialize() {
 
     this->directory_controller->allocate();
     this->interconnection_controller->allocate();
+
+    this->start_active_components();
+    this->start_clock_threads();
 };
 
 // ============================================================================
@@ -1789,3 +1792,227 @@ void sinuca_engine_t::make_connections() {
         CONFIGURATOR_DEBUG_PRINTF("========================\n");
     }
 };
+
+// ============================================================================
+/// Changes the parameters which may be modified on a drained simulator, used
+/// by the variants forked after the warm-up. The variant file has the format
+/// of the configuration, the components are found by LABEL and only the given
+/// parameters are changed.
+void sinuca_engine_t::apply_variant(const char *file_name) {
+    libconfig::Config cfg;
+    try {
+        cfg.readFile(file_name);
+    }
+    catch (libconfig::FileIOException &fioex) {
+        ERROR_PRINTF("I/O error while reading file %s.\n", file_name)
+    }
+    catch (libconfig::ParseException &pex) {
+        ERROR_PRINTF("Parse error at %s on line %d: %s\n", pex.getFile(), pex.getLine(), pex.getError());
+    }
+    ERROR_ASSERT_PRINTF(this->is_drained(), "Variant applied with packages inside the components.\n")
+
+    libconfig::Setting &cfg_root = cfg.getRoot();
+    try {
+        // ====================================================================
+        /// CACHE_MEMORY PARAMETERS
+        // ====================================================================
+        if (cfg_root.exists("CACHE_MEMORY")) {
+            libconfig::Setting &cfg_cache_memory_list = cfg_root["CACHE_MEMORY"];
+            for (int32_t i = 0; i < cfg_cache_memory_list.getLength(); i++) {
+                libconfig::Setting &cfg_cache_memory = cfg_cache_memory_list[i];
+                const char *label = cfg_cache_memory["LABEL"];
+                cache_memory_t *cache_memory = NULL;
+                for (uint32_t j = 0; j < this->get_cache_memory_array_size(); j++) {
+                    if (strcmp(this->cache_memory_array[j]->get_label(), label) == 0) {
+                        cache_memory = this->cache_memory_array[j];
+                    }
+                }
+                ERROR_ASSERT_PRINTF(cache_memory != NULL, "Variant CACHE_MEMORY not found: \"%s\"\n", label)
+
+                bool resize_mshr = false;
+                for (int32_t j = 0; j < cfg_cache_memory.getLength(); j++) {
+                    libconfig::Setting &cfg_parameter = cfg_cache_memory[j];
+                    const char *parameter = cfg_parameter.getName();
+
+                    if (strcmp(parameter, "LABEL") == 0) {
+                        continue;
+                    }
+                    else if (strcmp(parameter, "PENALTY_READ") == 0) {
+                        cache_memory->set_penalty_read(cfg_parameter);
+                    }
+                    else if (strcmp(parameter, "PENALTY_WRITE") == 0) {
+                        cache_memory->set_penalty_write(cfg_parameter);
+                    }
+                    else if (strcmp(parameter, "MSHR_REQUEST_BUFFER_SIZE") == 0) {
+                        cache_memory->set_mshr_request_buffer_size(cfg_parameter);
+                        resize_mshr = true;
+                    }
+                    else if (strcmp(parameter, "MSHR_PREFETCH_BUFFER_SIZE") == 0) {
+                        cache_memory->set_mshr_prefetch_buffer_size(cfg_parameter);
+                        resize_mshr = true;
+                    }
+                    else if (strcmp(parameter, "MSHR_WRITE_BUFFER_SIZE") == 0) {
+                        cache_memory->set_mshr_write_buffer_size(cfg_parameter);
+                        resize_mshr = true;
+                    }
+                    else if (strcmp(parameter, "MSHR_EVICTION_BUFFER_SIZE") == 0) {
+                        cache_memory->set_mshr_eviction_buffer_size(cfg_parameter);
+                        resize_mshr = true;
+                    }
+                    else if (strcmp(parameter, "REPLACEMENT_POLICY") == 0) {
+                        if (strcasecmp(cfg_parameter, "FIFO") ==  0) {
+                            cache_memory->set_replacement_policy(REPLACEMENT_FIFO);
+                        }
+                        else if (strcasecmp(cfg_parameter, "LRF") ==  0) {
+                            cache_memory->set_replacement_policy(REPLACEMENT_LRF);
+                        }
+                        else if (strcasecmp(cfg_parameter, "LRU") ==  0) {
+                            cache_memory->set_replacement_policy(REPLACEMENT_LRU);
+                        }
+                        else if (strcasecmp(cfg_parameter, "INVALID_OR_LRU") ==  0) {
+                            cache_memory->set_replacement_policy(REPLACEMENT_INVALID_OR_LRU);
+                        }
+                        else if (strcasecmp(cfg_parameter, "DEAD_OR_LRU") ==  0) {
+                            cache_memory->set_replacement_policy(REPLACEMENT_DEAD_OR_LRU);
+                        }
+                        else if (strcasecmp(cfg_parameter, "RANDOM") ==  0) {
+                            cache_memory->set_replacement_policy(REPLACEMENT_RANDOM);
+                        }
+                        else {
+                            ERROR_PRINTF("Variant CACHE_MEMORY %s found a strange VALUE %s for PARAMETER %s\n", label, cfg_parameter.c_str(), parameter);
+                        }
+                    }
+                    else if (strcmp(parameter, "PREFETCHER") == 0) {
+                        for (int32_t k = 0; k < cfg_parameter.getLength(); k++) {
+                            libconfig::Setting &cfg_prefetcher = cfg_parameter[k];
+                            const char *prefetcher_parameter = cfg_prefetcher.getName();
+                            prefetch_policy_t type = cache_memory->prefetcher->get_prefetcher_type();
+
+                            if (strcmp(prefetcher_parameter, "PREFETCH_DEGREE") == 0 && type == PREFETCHER_STRIDE) {
+                                static_cast<prefetch_stride_t*>(cache_memory->prefetcher)->set_prefetch_degree(cfg_prefetcher);
+                            }
+                            else if (strcmp(prefetcher_parameter, "PREFETCH_DEGREE") == 0 && type == PREFETCHER_STREAM) {
+                                static_cast<prefetch_stream_t*>(cache_memory->prefetcher)->set_prefetch_degree(cfg_prefetcher);
+                            }
+                            else if (strcmp(prefetcher_parameter, "PREFETCH_DISTANCE") == 0 && type == PREFETCHER_STREAM) {
+                                static_cast<prefetch_stream_t*>(cache_memory->prefetcher)->set_prefetch_distance(cfg_prefetcher);
+                            }
+                            else if (strcmp(prefetcher_parameter, "FULL_BUFFER") == 0) {
+                                if (strcasecmp(cfg_prefetcher, "OVERRIDE") ==  0) {
+                                    cache_memory->prefetcher->set_full_buffer_type(FULL_BUFFER_OVERRIDE);
+                                }
+                                else if (strcasecmp(cfg_prefetcher, "STOP") ==  0) {
+                                    cache_memory->prefetcher->set_full_buffer_type(FULL_BUFFER_STOP);
+                                }
+                                else {
+                                    ERROR_PRINTF("Variant CACHE_MEMORY %s found a strange VALUE %s for PARAMETER %s\n", label, cfg_prefetcher.c_str(), prefetcher_parameter);
+                                }
+                            }
+                            else {
+                                ERROR_PRINTF("Variant CACHE_MEMORY-Prefetcher %s cannot change PARAMETER: \"%s\"\n", label, prefetcher_parameter);
+                            }
+                        }
+                    }
+                    else {
+                        ERROR_PRINTF("Variant CACHE_MEMORY %s cannot change PARAMETER: \"%s\"\n", label, parameter);
+                    }
+                }
+                if (resize_mshr) {
+                    cache_memory->allocate_mshr();
+                }
+            }
+        }
+
+        // ====================================================================
+        /// MEMORY_CONTROLLER PARAMETERS
+        // ====================================================================
+        if (cfg_root.exists("MEMORY_CONTROLLER")) {
+            libconfig::Setting &cfg_memory_controller_list = cfg_root["MEMORY_CONTROLLER"];
+            for (int32_t i = 0; i < cfg_memory_controller_list.getLength(); i++) {
+                libconfig::Setting &cfg_memory_controller = cfg_memory_controller_list[i];
+                const char *label = cfg_memory_controller["LABEL"];
+                memory_controller_t *memory_controller = NULL;
+                for (uint32_t j = 0; j < this->get_memory_controller_array_size(); j++) {
+                    if (strcmp(this->memory_controller_array[j]->get_label(), label) == 0) {
+                        memory_controller = this->memory_controller_array[j];
+                    }
+                }
+                ERROR_ASSERT_PRINTF(memory_controller != NULL, "Variant MEMORY_CONTROLLER not found: \"%s\"\n", label)
+
+                for (int32_t j = 0; j < cfg_memory_controller.getLength(); j++) {
+                    libconfig::Setting &cfg_parameter = cfg_memory_controller[j];
+                    const char *parameter = cfg_parameter.getName();
+
+                    if (strcmp(parameter, "LABEL") == 0) {
+                        continue;
+                    }
+                    else if (strcmp(parameter, "PAGE_POLICY") == 0) {
+                        if (strcasecmp(cfg_parameter, "OPEN_ROW") ==  0) {
+                            memory_controller->set_page_policy(PAGE_POLICY_OPEN_ROW);
+                        }
+                        else if (strcasecmp(cfg_parameter, "CLOSE_ROW") ==  0) {
+                            memory_controller->set_page_policy(PAGE_POLICY_CLOSE_ROW);
+                        }
+                        else {
+                            ERROR_PRINTF("Variant MEMORY_CONTROLLER %s found a strange VALUE %s for PARAMETER %s\n", label, cfg_parameter.c_str(), parameter);
+                        }
+                    }
+                    else if (strcmp(parameter, "CORE_TO_BUS_CLOCK_RATIO") == 0) {
+                        memory_controller->set_core_to_bus_clock_ratio(cfg_parameter);
+                    }
+                    else if (strcmp(parameter, "TIMING_AL") == 0) {
+                        memory_controller->set_timing_al(cfg_parameter);
+                    }
+                    else if (strcmp(parameter, "TIMING_CAS") == 0) {
+                        memory_controller->set_timing_cas(cfg_parameter);
+                    }
+                    else if (strcmp(parameter, "TIMING_CCD") == 0) {
+                        memory_controller->set_timing_ccd(cfg_parameter);
+                    }
+                    else if (strcmp(parameter, "TIMING_CWD") == 0) {
+                        memory_controller->set_timing_cwd(cfg_parameter);
+                    }
+                    else if (strcmp(parameter, "TIMING_FAW") == 0) {
+                        memory_controller->set_timing_faw(cfg_parameter);
+                    }
+                    else if (strcmp(parameter, "TIMING_RAS") == 0) {
+                        memory_controller->set_timing_ras(cfg_parameter);
+                    }
+                    else if (strcmp(parameter, "TIMING_RC") == 0) {
+                        memory_controller->set_timing_rc(cfg_parameter);
+                    }
+                    else if (strcmp(parameter, "TIMING_RCD") == 0) {
+                        memory_controller->set_timing_rcd(cfg_parameter);
+                    }
+                    else if (strcmp(parameter, "TIMING_RP") == 0) {
+                        memory_controller->set_timing_rp(cfg_parameter);
+                    }
+                    else if (strcmp(parameter, "TIMING_RRD") == 0) {
+                        memory_controller->set_timing_rrd(cfg_parameter);
+                    }
+                    else if (strcmp(parameter, "TIMING_RTP") == 0) {
+                        memory_controller->set_timing_rtp(cfg_parameter);
+                    }
+                    else if (strcmp(parameter, "TIMING_WR") == 0) {
+                        memory_controller->set_timing_wr(cfg_parameter);
+                    }
+                    else if (strcmp(parameter, "TIMING_WTR") == 0) {
+                        memory_controller->set_timing_wtr(cfg_parameter);
+                    }
+                    else {
+                        ERROR_PRINTF("Variant MEMORY_CONTROLLER %s cannot change PARAMETER: \"%s\"\n", label, parameter);
+                    }
+                }
+                for (uint32_t j = 0; j < memory_controller->get_channels_per_controller(); j++) {
+                    memory_controller->set_channel_timing(j);
+                }
+            }
+        }
+    }
+    catch (libconfig::SettingNotFoundException &nfex) {
+        ERROR_PRINTF("Variant %s has a component without LABEL\n", file_name);
+    }
+    catch (libconfig::SettingTypeException &tex) {
+        ERROR_PRINTF("Variant %s has a PARAMETER with wrong type: \"%s\"\n", file_name, tex.getPath());
+    }
+};
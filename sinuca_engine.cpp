@@ -20,14 +20,35 @@
 
 #include "./sinuca.hpp"
 
+thread_local uint64_t profile_nested_ns = 0;
+
 // =============================================================================
 sinuca_engine_t::sinuca_engine_t() {
     this->arg_configuration_file_name = NULL;
     this->arg_configuration_path = NULL;
     this->arg_trace_file_name = NULL;
     this->arg_result_file_name = NULL;
+    this->arg_result_format = STATISTICS_FORMAT_TEXT;
     this->arg_warmup_instructions = 0;
+    this->arg_fast_forward = false;
+    this->arg_sampling_period = 0;
+    this->arg_sampling_detailed = 0;
+    this->arg_sampling_warming = 0;
+    this->arg_checkpoint_instructions = 0;
+    this->arg_checkpoint_file_name = NULL;
+    this->arg_restore_file_name = NULL;
+    this->arg_warm_save_file_name = NULL;
+    this->arg_warm_load_file_name = NULL;
     this->arg_stopat_instructions = 0;
+    this->arg_trace_prefetch = 0;
+    this->arg_trace_read_ahead = 2;
+    this->arg_trace_mmap = false;
+    this->arg_idle_skip = true;
+    this->arg_clock_threads = 1;
+    this->arg_profile = false;
+    this->arg_interval_cycles = 0;
+    this->arg_interval_opcodes = 0;
+    this->arg_interval_file_name = NULL;
     this->arg_graph_file_name = NULL;
 
     for (uint32_t i = 0; i < MAX_CORES; i++) {
@@ -59,9 +80,20 @@ sinuca_engine_t::sinuca_engine_t() {
     this->stat_vm_max = 0.0;
     this->stat_rss_max = 0.0;
 
+    /// The engine is a global object, built before main()
+    gettimeofday(&this->stat_timer_startup, NULL);
+
     this->stat_old_memory_package = 0;
     this->stat_old_opcode_package = 0;
     this->stat_old_uop_package = 0;
+    this->stat_skipped_cycles = 0;
+    this->idle_skip_check_cycle = 0;
+    this->idle_skip_backoff = 0;
+
+    this->clock_threads = 1;
+    this->clock_thread = NULL;
+    this->active_component = NULL;
+    this->active_component_words = 0;
 
     this->interconnection_interface_array_size = 0;
     this->processor_array_size = 0;
@@ -77,8 +109,22 @@ sinuca_engine_t::sinuca_engine_t() {
     this->is_simulation_eof = false;
     this->is_runtime_debug = true;
     this->is_warmup = false;
+    this->fetch_limit = std::numeric_limits<uint64_t>::max();
     this->is_global_panic = false;
 
+    this->stat_capture = NULL;
+    this->stat_capture_names = NULL;
+    this->sampling_samples = 0;
+    this->sampling_opcodes = 0;
+    this->sampling_cycles = 0;
+    this->sampling_cpi_sum = 0.0;
+    this->sampling_cpi_squares = 0.0;
+    this->sampling_begin_cycle = 0;
+    this->sampling_begin_opcode = 0;
+    this->interval_begin_cycle = 0;
+    this->interval_begin_opcode = 0;
+    this->interval_next = 0;
+
     this->trace_reader = new trace_reader_t;
     this->directory_controller = NULL;
     this->interconnection_controller = NULL;
@@ -94,6 +140,9 @@ sinuca_engine_t::~sinuca_engine_t() {
 
     utils_t::template_delete_array<char>(this->arg_configuration_path);
 
+    this->stop_clock_threads();
+    utils_t::template_delete_array<std::atomic<uint64_t> >(this->active_component);
+
     /// De-Allocate memory to prevent memory leak
     utils_t::template_delete_array<interconnection_interface_t*>(this->interconnection_interface_array);
 
@@ -259,12 +308,477 @@ void sinuca_engine_t::global_clock() {
     DEBUG_PRINTF("========================================================================================================\n")
     DEBUG_PRINTF("======================================== Sinuca_Cycle %" PRIu64 "/%u ========================================\n\n\n", this->get_global_cycle(), sub_cycle)
 
-    for (uint32_t i = 0 ; i < this->get_interconnection_interface_array_size() ; i++) {
-        this->interconnection_interface_array[i]->clock(sub_cycle);
+    if (this->clock_threads > 1) {
+        /// The pipelines of all the cores run in parallel, then the fetch in the
+        /// cores order, followed by the shared components as in the serial clock
+        this->clock_phase_done.store(0);
+        this->clock_phase.fetch_add(1);
+        this->clock_pipelines(0);
+        while (this->clock_phase_done.load() != this->clock_threads - 1) {
+            std::this_thread::yield();
+        }
+        for (uint32_t i = 0 ; i < this->get_processor_array_size() ; i++) {
+            profile_scope_t profile(&this->processor_array[i]->profile_clock);
+            this->processor_array[i]->clock_fetch(sub_cycle);
+        }
     }
+    else {
+        for (uint32_t i = 0 ; i < this->get_processor_array_size() ; i++) {
+            profile_scope_t profile(&this->processor_array[i]->profile_clock);
+            this->processor_array[i]->clock(sub_cycle);
+        }
+    }
+    this->clock_active_components(sub_cycle);
     this->global_cycle++;
 };
 
+// =============================================================================
+/// The processors are clocked every cycle (per-cycle statistics), the other
+/// components only while they have packages inside. A drained component leaves
+/// the active set after its clock, and receiving a package puts it back.
+void sinuca_engine_t::start_active_components() {
+    this->active_component_words = (this->get_interconnection_interface_array_size() + 63) / 64;
+    this->active_component = utils_t::template_allocate_array<std::atomic<uint64_t> >(this->active_component_words);
+    for (uint32_t i = 0; i < this->active_component_words; i++) {
+        this->active_component[i].store(0);
+    }
+    for (uint32_t i = this->get_processor_array_size(); i < this->get_interconnection_interface_array_size(); i++) {
+        this->wake_component(i);
+    }
+};
+
+// =============================================================================
+/// Clocks the active components in the id order, as the serial clock. The ones
+/// woken up by a previous component in the same cycle are also clocked.
+void sinuca_engine_t::clock_active_components(uint32_t sub_cycle) {
+    for (uint32_t word = 0; word < this->active_component_words; word++) {
+        uint64_t bits = this->active_component[word].load(std::memory_order_relaxed);
+        while (bits != 0) {
+            uint32_t bit = __builtin_ctzll(bits);
+            interconnection_interface_t *component = this->interconnection_interface_array[word * 64 + bit];
+            {
+                profile_scope_t profile(&component->profile_clock);
+                component->clock(sub_cycle);
+            }
+            if (component->is_drained()) {
+                this->active_component[word].fetch_and(~(1ull << bit), std::memory_order_relaxed);
+            }
+            bits = this->active_component[word].load(std::memory_order_relaxed) & ~((2ull << bit) - 1);
+        }
+    }
+};
+
+// =============================================================================
+/// Each processor with its private first level caches is one partition, the
+/// partitions are split among the threads in blocks of consecutive cores.
+/// The stages after the fetch only change the core and its first level caches,
+/// so running them before every fetch keeps the serial results.
+void sinuca_engine_t::start_clock_threads() {
+    this->clock_threads = std::min(this->arg_clock_threads, this->get_processor_array_size());
+    if (this->clock_threads <= 1) {
+        this->clock_threads = 1;
+        return;
+    }
+
+    /// The components connected to each processor must be caches not shared with other processors
+    int32_t *owner = utils_t::template_allocate_initialize_array<int32_t>(this->get_interconnection_interface_array_size(), POSITION_FAIL);
+    for (uint32_t i = 0; i < this->get_processor_array_size(); i++) {
+        processor_t *processor = this->processor_array[i];
+        for (uint32_t port = 0; port < processor->get_max_ports(); port++) {
+            interconnection_interface_t *obj = processor->get_interface_output_component(port);
+            if (obj->get_type_component() != COMPONENT_CACHE_MEMORY ||
+            (owner[obj->get_id()] != POSITION_FAIL && owner[obj->get_id()] != (int32_t)i)) {
+                WARNING_PRINTF("%s is shared or not a cache, the clock will be serial.\n", obj->get_label())
+                this->clock_threads = 1;
+            }
+            owner[obj->get_id()] = i;
+        }
+    }
+    utils_t::template_delete_array<int32_t>(owner);
+    if (this->clock_threads == 1) {
+        return;
+    }
+
+    this->clock_phase.store(0);
+    this->clock_phase_done.store(0);
+    this->clock_stop.store(false);
+    this->clock_thread = utils_t::template_allocate_array<std::thread>(this->clock_threads);
+    for (uint32_t i = 1; i < this->clock_threads; i++) {
+        this->clock_thread[i] = std::thread(&sinuca_engine_t::clock_worker, this, i);
+    }
+};
+
+// =============================================================================
+void sinuca_engine_t::stop_clock_threads() {
+    if (this->clock_thread == NULL) {
+        return;
+    }
+
+    this->clock_stop.store(true);
+    for (uint32_t i = 1; i < this->clock_threads; i++) {
+        if (!this->clock_thread[i].joinable()) {
+            continue;
+        }
+        /// exit() may be called by a clock thread itself (ERROR_PRINTF)
+        if (this->clock_thread[i].get_id() == std::this_thread::get_id()) {
+            this->clock_thread[i].detach();
+        }
+        else {
+            this->clock_thread[i].join();
+        }
+    }
+    utils_t::template_delete_array<std::thread>(this->clock_thread);
+    this->clock_thread = NULL;
+    this->clock_threads = 1;
+};
+
+// =============================================================================
+void sinuca_engine_t::clock_pipelines(uint32_t thread) {
+    uint32_t first = (thread * this->get_processor_array_size()) / this->clock_threads;
+    uint32_t last = ((thread + 1) * this->get_processor_array_size()) / this->clock_threads;
+    for (uint32_t i = first; i < last; i++) {
+        /// The call is counted with the fetch
+        profile_scope_t profile(&this->processor_array[i]->profile_clock, 0);
+        this->processor_array[i]->clock_pipeline(0);
+    }
+};
+
+// =============================================================================
+void sinuca_engine_t::clock_worker(uint32_t thread) {
+    uint64_t phase = 0;
+    while (true) {
+        while (this->clock_phase.load() == phase) {
+            if (this->clock_stop.load()) {
+                return;
+            }
+            std::this_thread::yield();
+        }
+        phase++;
+        this->clock_pipelines(thread);
+        this->clock_phase_done.fetch_add(1);
+    }
+};
+
+// =============================================================================
+/// Jump over the cycles in which no component would change its state, only
+/// the per-cycle statistics, which are accounted at once. Each component
+/// reports its next event, and the new packages are only created on the
+/// events. Stops at the HEART_BEAT, PERIODIC_CHECK and -interval cycles.
+void sinuca_engine_t::global_skip_idle_cycles() {
+    /// The statistics are reset on the current cycle
+    if (!this->arg_idle_skip || this->is_warmup) {
+        return;
+    }
+    /// Asking every component costs almost one cycle, so busy phases are checked less often
+    if (this->global_cycle < this->idle_skip_check_cycle) {
+        return;
+    }
+
+    uint64_t next_cycle = std::numeric_limits<uint64_t>::max();
+    for (uint32_t i = 0 ; i < this->get_interconnection_interface_array_size() ; i++) {
+        next_cycle = std::min(next_cycle, this->interconnection_interface_array[i]->get_next_event_cycle());
+        if (next_cycle <= this->global_cycle) {
+            this->idle_skip_backoff = std::min(2 * this->idle_skip_backoff + 1, (uint32_t)IDLE_SKIP_BACKOFF);
+            this->idle_skip_check_cycle = this->global_cycle + this->idle_skip_backoff;
+            return;
+        }
+    }
+    /// Nothing scheduled, keep the normal clock
+    if (next_cycle == std::numeric_limits<uint64_t>::max()) {
+        return;
+    }
+
+    next_cycle = std::min(next_cycle, ((this->global_cycle + HEART_BEAT - 1) / HEART_BEAT) * HEART_BEAT);
+    next_cycle = std::min(next_cycle, ((this->global_cycle + PERIODIC_CHECK - 1) / PERIODIC_CHECK) * PERIODIC_CHECK);
+    if (this->arg_interval_cycles != 0 && !this->interval_names.empty()) {
+        next_cycle = std::min(next_cycle, this->interval_next);
+    }
+    if (next_cycle <= this->global_cycle) {
+        return;
+    }
+
+    uint64_t cycles = next_cycle - this->global_cycle;
+    for (uint32_t i = 0 ; i < this->get_interconnection_interface_array_size() ; i++) {
+        this->interconnection_interface_array[i]->skip_cycles(cycles);
+    }
+    this->global_cycle = next_cycle;
+    this->stat_skipped_cycles += cycles;
+    this->idle_skip_backoff = 0;
+};
+
+// =============================================================================
+/// Functional warm-up of the caches, directory, prefetchers and branch predictors.
+/// Each round fetches one opcode per core and counts as one cycle, so the LRU
+/// order between the cores is kept. Stops when the given opcodes were fetched,
+/// the pipelines must be drained before.
+void sinuca_engine_t::global_fast_forward(uint64_t opcodes) {
+    bool is_alive = true;
+
+    while (is_alive) {
+        is_alive = false;
+        for (uint32_t i = 0 ; i < this->get_processor_array_size() ; i++) {
+            if (this->trace_reader->get_trace_opcode_total() >= opcodes) {
+                return;
+            }
+            is_alive |= this->processor_array[i]->functional_fetch();
+        }
+        this->global_cycle++;
+
+        /// Progress Information
+        if ((this->global_cycle % HEART_BEAT) == 0) {
+            SINUCA_PRINTF("Fast-Forward - Opcodes: %-12" PRIu64 "\n", this->trace_reader->get_trace_opcode_total());
+        }
+    }
+};
+
+// =============================================================================
+/// Cycle-level simulation until the given opcodes were fetched.
+/// With drain the fetch stops there, and the pipelines and caches finish
+/// all the requests in flight.
+void sinuca_engine_t::global_detailed(uint64_t opcodes, bool drain) {
+    if (drain) {
+        this->set_fetch_limit(opcodes);
+    }
+
+    while (this->alive() && (this->trace_reader->get_trace_opcode_total() < opcodes || (drain && !this->is_drained()))) {
+        /// Spawn Warmup - is_warmup is set inside the trace_reader
+        if (this->is_warmup) {
+            SINUCA_PRINTF("Warm-Up End - Cycle: %-12" PRIu64 "\n", this->global_cycle);
+            this->global_reset_statistics();
+            this->is_warmup = false;
+        }
+
+        /// Progress Information
+        if ((this->global_cycle % HEART_BEAT) == 0) {
+            SINUCA_PRINTF("Heart-Beat - Cycle: %-12" PRIu64 " Opcodes: %-12" PRIu64 "\n", this->global_cycle, this->trace_reader->get_trace_opcode_total());
+        }
+        this->global_interval();
+
+        /// Spawn Periodic Check
+        if ((this->global_cycle % PERIODIC_CHECK) == 0) {
+            this->global_periodic_check();
+        }
+
+        this->global_clock();
+        this->global_skip_idle_cycles();
+    }
+    this->set_fetch_limit(std::numeric_limits<uint64_t>::max());
+};
+
+// =============================================================================
+bool sinuca_engine_t::is_drained() {
+    for (uint32_t i = 0 ; i < this->get_processor_array_size() ; i++) {
+        if (!this->processor_array[i]->is_drained()) {
+            return FAIL;
+        }
+    }
+    for (uint32_t i = 0 ; i < this->get_cache_memory_array_size() ; i++) {
+        if (!this->cache_memory_array[i]->is_drained()) {
+            return FAIL;
+        }
+    }
+    for (uint32_t i = 0 ; i < this->get_memory_controller_array_size() ; i++) {
+        if (!this->memory_controller_array[i]->is_drained()) {
+            return FAIL;
+        }
+    }
+    for (uint32_t i = 0 ; i < this->get_interconnection_router_array_size() ; i++) {
+        if (!this->interconnection_router_array[i]->is_drained()) {
+            return FAIL;
+        }
+    }
+    return (this->directory_controller->get_directory_lines_size() == 0);
+};
+
+// =============================================================================
+/// Save (or restore) the whole simulator state, the pipelines must be drained.
+/// With warm only the learning state is kept (see checkpoint_t).
+/// The trace reader goes first, so the cores fetch from the restored position.
+void sinuca_engine_t::global_checkpoint(const char *file_name, bool restore, bool warm) {
+    checkpoint_t checkpoint;
+
+    checkpoint.open(file_name, restore, warm);
+    checkpoint.section(this->get_label());
+
+    /// Keyed by the trace, without its directory
+    const char *trace_name = strrchr(this->arg_trace_file_name, '/');
+    checkpoint.section(trace_name != NULL ? trace_name + 1 : this->arg_trace_file_name);
+    checkpoint.check_size(this->get_global_line_size());
+
+    /// The cache lines keep the cycle of their last access
+    checkpoint.value(this->global_cycle);
+    if (!warm) {
+        checkpoint.value(this->reset_cycle);
+        checkpoint.value(this->is_warmup);
+        checkpoint.value(this->stat_old_memory_package);
+        checkpoint.value(this->stat_old_opcode_package);
+        checkpoint.value(this->stat_old_uop_package);
+    }
+    checkpoint.check_size(this->get_processor_array_size());
+    checkpoint.array(this->is_processor_trace_eof, this->get_processor_array_size());
+
+    this->trace_reader->checkpoint(&checkpoint);
+
+    checkpoint.check_size(this->get_interconnection_interface_array_size());
+    for (uint32_t i = 0 ; i < this->get_interconnection_interface_array_size() ; i++) {
+        this->interconnection_interface_array[i]->checkpoint(&checkpoint);
+    }
+    this->directory_controller->checkpoint(&checkpoint);
+    this->interconnection_controller->checkpoint(&checkpoint);
+
+    checkpoint.close();
+};
+
+// =============================================================================
+/// Sampled simulation, each period of opcodes runs:
+///     functional warm-up => detailed warm-up => detailed sample (drained)
+/// The integer statistics of the samples are extrapolated to the whole trace
+/// by print_sampling_statistics.
+void sinuca_engine_t::global_sampling() {
+    uint64_t period_start = 0;
+
+    while (!this->is_simulation_eof) {
+        uint64_t detailed_start = period_start + this->arg_sampling_period - this->arg_sampling_detailed;
+
+        this->global_fast_forward(detailed_start - this->arg_sampling_warming);
+        this->global_detailed(detailed_start, false);
+        if (this->is_simulation_eof) {
+            break;
+        }
+
+        this->sampling_begin_region();
+        this->global_detailed(detailed_start + this->arg_sampling_detailed, true);
+        this->sampling_end_region();
+
+        period_start += this->arg_sampling_period;
+    }
+
+    /// The warm-up reset spawned by the trace_reader would discard the samples
+    this->is_warmup = false;
+};
+
+// =============================================================================
+void sinuca_engine_t::sampling_begin_region() {
+    this->sampling_begin_cycle = this->global_cycle;
+    this->sampling_begin_opcode = this->trace_reader->get_trace_opcode_total();
+
+    this->sampling_region_begin.clear();
+    if (this->sampling_names.empty()) {
+        this->global_capture_statistics(&this->sampling_region_begin, &this->sampling_names);
+        this->sampling_rate_sum.resize(this->sampling_names.size(), 0.0);
+        this->sampling_rate_squares.resize(this->sampling_names.size(), 0.0);
+    }
+    else {
+        this->global_capture_statistics(&this->sampling_region_begin, NULL);
+    }
+};
+
+// =============================================================================
+void sinuca_engine_t::sampling_end_region() {
+    uint64_t opcodes = this->trace_reader->get_trace_opcode_total() - this->sampling_begin_opcode;
+    uint64_t cycles = this->global_cycle - this->sampling_begin_cycle;
+    if (opcodes == 0 || cycles == 0) {
+        return;
+    }
+
+    std::vector<uint64_t> region_end;
+    this->global_capture_statistics(&region_end, NULL);
+    ERROR_ASSERT_PRINTF(region_end.size() == this->sampling_names.size(), "The number of statistics changed between samples.\n")
+
+    for (uint32_t i = 0; i < region_end.size(); i++) {
+        double rate = static_cast<double>(static_cast<int64_t>(region_end[i] - this->sampling_region_begin[i])) / opcodes;
+        this->sampling_rate_sum[i] += rate;
+        this->sampling_rate_squares[i] += rate * rate;
+    }
+
+    double cpi = static_cast<double>(cycles) / opcodes;
+    this->sampling_cpi_sum += cpi;
+    this->sampling_cpi_squares += cpi * cpi;
+    this->sampling_opcodes += opcodes;
+    this->sampling_cycles += cycles;
+    this->sampling_samples++;
+};
+
+// =============================================================================
+/// Interval time series (-interval or -interval_opcodes), started on the first
+/// detailed cycle. Each line has the deltas of all the integer statistics, so
+/// the IPC, MPKI, row hits or router load of each interval come from two
+/// columns (e.g. the committed uops over the cycles).
+void sinuca_engine_t::global_interval() {
+    if (this->arg_interval_file_name == NULL) {
+        return;
+    }
+    if (this->interval_names.empty()) {
+        this->interval_start();
+        return;
+    }
+
+    uint64_t position = (this->arg_interval_cycles != 0) ? this->global_cycle : this->trace_reader->get_trace_opcode_total();
+    if (position >= this->interval_next) {
+        this->interval_write();
+    }
+};
+
+// =============================================================================
+void sinuca_engine_t::interval_start() {
+    this->interval_file.open(this->arg_interval_file_name, std::ofstream::trunc);
+    ERROR_ASSERT_PRINTF(this->interval_file.is_open() == true, "Could not open the interval file %s.\n", this->arg_interval_file_name)
+
+    this->interval_begin.clear();
+    this->global_capture_statistics(&this->interval_begin, &this->interval_names);
+    this->interval_begin_cycle = this->global_cycle;
+    this->interval_begin_opcode = this->trace_reader->get_trace_opcode_total();
+
+    std::string header = "cycle,cycles,opcodes";
+    for (uint32_t i = 0; i < this->interval_names.size(); i++) {
+        header += "," + this->interval_names[i];
+    }
+    header += "\n";
+    this->interval_file.write(header.c_str(), header.size());
+
+    /// The lines end on the multiples of the interval
+    if (this->arg_interval_cycles != 0) {
+        this->interval_next = (this->global_cycle / this->arg_interval_cycles + 1) * this->arg_interval_cycles;
+    }
+    else {
+        this->interval_next = (this->interval_begin_opcode / this->arg_interval_opcodes + 1) * this->arg_interval_opcodes;
+    }
+};
+
+// =============================================================================
+/// Writes the deltas since the last line, also called before the statistics
+/// reset (warm-up end) and at the simulation end.
+void sinuca_engine_t::interval_write() {
+    uint64_t opcode = this->trace_reader->get_trace_opcode_total();
+    if (this->global_cycle == this->interval_begin_cycle) {
+        return;
+    }
+
+    std::vector<uint64_t> interval_end;
+    this->global_capture_statistics(&interval_end, NULL);
+    ERROR_ASSERT_PRINTF(interval_end.size() == this->interval_names.size(), "The number of statistics changed between intervals.\n")
+
+    char buffer[TRACE_LINE_SIZE] = "\0";
+    snprintf(buffer, sizeof(buffer), "%" PRIu64 ",%" PRIu64 ",%" PRIu64 "", this->global_cycle, this->global_cycle - this->interval_begin_cycle, opcode - this->interval_begin_opcode);
+    std::string line = buffer;
+    for (uint32_t i = 0; i < interval_end.size(); i++) {
+        snprintf(buffer, sizeof(buffer), ",%" PRId64 "", static_cast<int64_t>(interval_end[i] - this->interval_begin[i]));
+        line += buffer;
+    }
+    line += "\n";
+    this->interval_file.write(line.c_str(), line.size());
+
+    this->interval_begin.swap(interval_end);
+    this->interval_begin_cycle = this->global_cycle;
+    this->interval_begin_opcode = opcode;
+
+    uint32_t period = (this->arg_interval_cycles != 0) ? this->arg_interval_cycles : this->arg_interval_opcodes;
+    uint64_t position = (this->arg_interval_cycles != 0) ? this->global_cycle : opcode;
+    if (position >= this->interval_next) {
+        this->interval_next = (position / period + 1) * period;
+    }
+};
+
 // =============================================================================
 void sinuca_engine_t::global_open_output_files(){
 
@@ -273,18 +787,14 @@ void sinuca_engine_t::global_open_output_files(){
     char       buffer[100];
     tstruct = *localtime(&now);
 
-    strftime(buffer, sizeof(buffer), "# SiNUCA # Y:%Y M:%m D:%d - Time:%X\n", &tstruct);
+    strftime(buffer, sizeof(buffer), " SiNUCA # Y:%Y M:%m D:%d - Time:%X", &tstruct);
 
-    /// Open the result file
-    if (this->result_file.is_open() == false && this->arg_result_file_name != NULL) {
-        /// Open a new file
-        this->result_file.open(this->arg_result_file_name, std::ofstream::app);
-        /// Check if the file was created
-        ERROR_ASSERT_PRINTF(this->result_file.is_open() == true, "Could not open the result file.\n")
+    /// Open the result file, the header is one comment
+    if (this->arg_result_file_name != NULL) {
+        this->statistics_writer.open(this->arg_result_file_name, this->arg_result_format);
+        this->statistics_writer.comment(buffer);
+        this->statistics_writer.close();
     }
-    this->result_file.write(buffer, strlen(buffer));
-    this->result_file.close();
-
 
     /// Open the graph file
     if (this->graph_file.is_open() == false && this->arg_graph_file_name != NULL) {
@@ -293,7 +803,7 @@ void sinuca_engine_t::global_open_output_files(){
         /// Check if the file was created
         ERROR_ASSERT_PRINTF(this->graph_file.is_open() == true, "Could not open the graph file.\n")
     }
-    this->graph_file.write(buffer, strlen(buffer));
+    this->graph_file << "#" << buffer << "\n";
     this->graph_file.close();
 
 };
@@ -329,6 +839,11 @@ void sinuca_engine_t::global_reset_statistics() {
         gettimeofday(&stat_timer_end, NULL);
     }
 
+    /// The interval before the reset is not lost
+    if (!this->interval_names.empty()) {
+        this->interval_write();
+    }
+
     /// Save the variables after the warmup
     this->set_reset_cycle(this->global_cycle);
 
@@ -338,119 +853,296 @@ void sinuca_engine_t::global_reset_statistics() {
     }
     this->directory_controller->reset_statistics();
     this->interconnection_controller->reset_statistics();
+
+    if (!this->interval_names.empty()) {
+        this->interval_begin.clear();
+        this->global_capture_statistics(&this->interval_begin, NULL);
+    }
 };
 
 // =============================================================================
+/// Raw text, only kept by the TEXT result format
 void sinuca_engine_t::write_statistics(const char *buffer) {
-    if (this->result_file.is_open() == true && this->arg_result_file_name != NULL) {
-        this->result_file.write(buffer, strlen(buffer));
-    }
-    else {
-        SINUCA_PRINTF("%s", buffer);
+    if (this->stat_capture != NULL) {
+        return;
     }
+    this->statistics_writer.text(buffer);
 };
 
 // =============================================================================
 void sinuca_engine_t::write_statistics_small_separator() {
-    char buffer[TRACE_LINE_SIZE * 4] = "\0";
-    snprintf(buffer, sizeof(buffer), "#=======================================\n");
-    this->write_statistics(buffer);
+    if (this->stat_capture != NULL) {
+        return;
+    }
+    this->statistics_writer.separator(false);
 };
 
 void sinuca_engine_t::write_statistics_big_separator() {
-    char buffer[TRACE_LINE_SIZE * 4] = "\0";
-    snprintf(buffer, sizeof(buffer), "#===============================================================================\n");
-    this->write_statistics(buffer);
+    if (this->stat_capture != NULL) {
+        return;
+    }
+    this->statistics_writer.separator(true);
 };
 
 // =============================================================================
 void sinuca_engine_t::write_statistics_comments(const char *comment) {
-    char buffer[TRACE_LINE_SIZE * 4] = "\0";
-    snprintf(buffer, sizeof(buffer), "#%s\n", comment);
-    this->write_statistics(buffer);
+    if (this->stat_capture != NULL) {
+        return;
+    }
+    this->statistics_writer.comment(comment);
 };
 
 
 // =============================================================================
 void sinuca_engine_t::write_statistics_value(const char *obj_type, const char *obj_label, const char *variable_name, const char *value) {
-    char buffer[TRACE_LINE_SIZE * 4] = "\0";
-    snprintf(buffer, sizeof(buffer), "%s.%s.%s:%s\n", obj_type, obj_label, variable_name, value);
-    this->write_statistics(buffer);
+    if (this->stat_capture != NULL) {
+        return;
+    }
+    this->statistics_writer.value(obj_type, obj_label, variable_name, value);
 };
 
 void sinuca_engine_t::write_statistics_value(const char *obj_type, const char *obj_label, const char *variable_name, bool value) {
-    char buffer[TRACE_LINE_SIZE * 4] = "\0";
-    snprintf(buffer, sizeof(buffer), "%s.%s.%s:%s\n", obj_type, obj_label, variable_name, value ? "TRUE" : "FALSE");
-    this->write_statistics(buffer);
+    if (this->stat_capture != NULL) {
+        return;
+    }
+    this->statistics_writer.value(obj_type, obj_label, variable_name, value);
 };
 
 
 void sinuca_engine_t::write_statistics_value(const char *obj_type, const char *obj_label, const char *variable_name, uint32_t value) {
-    char buffer[TRACE_LINE_SIZE * 4] = "\0";
-    snprintf(buffer, sizeof(buffer), "%s.%s.%s:%u\n", obj_type, obj_label, variable_name, value);
-    this->write_statistics(buffer);
+    if (this->stat_capture != NULL) {
+        this->stat_capture->push_back(value);
+        if (this->stat_capture_names != NULL) {
+            this->stat_capture_names->push_back(std::string(obj_type) + "." + obj_label + "." + variable_name);
+        }
+        return;
+    }
+    this->statistics_writer.value(obj_type, obj_label, variable_name, value);
 };
 
 void sinuca_engine_t::write_statistics_value(const char *obj_type, const char *obj_label, const char *variable_name, uint64_t value) {
-    char buffer[TRACE_LINE_SIZE * 4] = "\0";
-    snprintf(buffer, sizeof(buffer), "%s.%s.%s:%" PRIu64 "\n", obj_type, obj_label, variable_name, value);
-    this->write_statistics(buffer);
+    if (this->stat_capture != NULL) {
+        this->stat_capture->push_back(value);
+        if (this->stat_capture_names != NULL) {
+            this->stat_capture_names->push_back(std::string(obj_type) + "." + obj_label + "." + variable_name);
+        }
+        return;
+    }
+    this->statistics_writer.value(obj_type, obj_label, variable_name, value);
 };
 
 void sinuca_engine_t::write_statistics_value(const char *obj_type, const char *obj_label, const char *variable_name, float value) {
-    char buffer[TRACE_LINE_SIZE * 4] = "\0";
-    snprintf(buffer, sizeof(buffer), "%s.%s.%s:%f\n", obj_type, obj_label, variable_name, value);
-    this->write_statistics(buffer);
+    if (this->stat_capture != NULL) {
+        return;
+    }
+    this->statistics_writer.value(obj_type, obj_label, variable_name, static_cast<double>(value));
 };
 
 void sinuca_engine_t::write_statistics_value(const char *obj_type, const char *obj_label, const char *variable_name, double value) {
-    char buffer[TRACE_LINE_SIZE * 4] = "\0";
-    snprintf(buffer, sizeof(buffer), "%s.%s.%s:%f\n", obj_type, obj_label, variable_name, value);
-    this->write_statistics(buffer);
+    if (this->stat_capture != NULL) {
+        return;
+    }
+    this->statistics_writer.value(obj_type, obj_label, variable_name, value);
 };
 
 void sinuca_engine_t::write_statistics_value_percentage(const char *obj_type, const char *obj_label, const char *variable_name, uint64_t value, uint64_t total) {
-    char buffer[TRACE_LINE_SIZE * 4] = "\0";
+    if (this->stat_capture != NULL) {
+        return;
+    }
     if (value != 0 || total != 0) {
-        snprintf(buffer, sizeof(buffer), "%s.%s.%s:%f%%\n", obj_type, obj_label, variable_name, static_cast<double> (100.0 *value/total));
+        this->statistics_writer.value(obj_type, obj_label, variable_name, static_cast<double> (100.0 *value/total), true);
     }
     else {
-        snprintf(buffer, sizeof(buffer), "%s.%s.%s:%f%%\n", obj_type, obj_label, variable_name, static_cast<double> (0));
+        this->statistics_writer.value(obj_type, obj_label, variable_name, static_cast<double> (0), true);
     }
-    this->write_statistics(buffer);
 };
 
 void sinuca_engine_t::write_statistics_value_ratio(const char *obj_type, const char *obj_label, const char *variable_name, uint64_t value, uint64_t total) {
-    char buffer[TRACE_LINE_SIZE * 4] = "\0";
+    if (this->stat_capture != NULL) {
+        return;
+    }
     if (value != 0 || total != 0) {
-        snprintf(buffer, sizeof(buffer), "%s.%s.%s:%f\n", obj_type, obj_label, variable_name, static_cast<double> (1.0 *value/total));
+        this->statistics_writer.value(obj_type, obj_label, variable_name, static_cast<double> (1.0 *value/total));
     }
     else {
-        snprintf(buffer, sizeof(buffer), "%s.%s.%s:%f\n", obj_type, obj_label, variable_name, static_cast<double> (0));
+        this->statistics_writer.value(obj_type, obj_label, variable_name, static_cast<double> (0));
     }
-    this->write_statistics(buffer);
 };
 
 void sinuca_engine_t::write_statistics_value_ratio(const char *obj_type, const char *obj_label, const char *variable_name, double value, uint64_t total) {
-    char buffer[TRACE_LINE_SIZE * 4] = "\0";
+    if (this->stat_capture != NULL) {
+        return;
+    }
     if (value != 0 || total != 0) {
-        snprintf(buffer, sizeof(buffer), "%s.%s.%s:%f\n", obj_type, obj_label, variable_name, static_cast<double> (1.0 *value/total));
+        this->statistics_writer.value(obj_type, obj_label, variable_name, static_cast<double> (1.0 *value/total));
     }
     else {
-        snprintf(buffer, sizeof(buffer), "%s.%s.%s:%f\n", obj_type, obj_label, variable_name, static_cast<double> (0));
+        this->statistics_writer.value(obj_type, obj_label, variable_name, static_cast<double> (0));
+    }
+};
+
+// =============================================================================
+/// Every field is one uint64_t value, the interval and sampling captures keep them all
+void sinuca_engine_t::write_statistics_latency(const char *obj_type, const char *obj_label, const char *variable_name, const statistics_latency_t *latency) {
+    char name[TRACE_LINE_SIZE];
+
+    snprintf(name, sizeof(name), "stat_min_%s", variable_name);
+    this->write_statistics_value(obj_type, obj_label, name, (latency->count != 0) ? latency->min : 0);
+    snprintf(name, sizeof(name), "stat_max_%s", variable_name);
+    this->write_statistics_value(obj_type, obj_label, name, latency->max);
+    snprintf(name, sizeof(name), "stat_sum_%s", variable_name);
+    this->write_statistics_value(obj_type, obj_label, name, latency->accumulated);
+    snprintf(name, sizeof(name), "stat_count_%s", variable_name);
+    this->write_statistics_value(obj_type, obj_label, name, latency->count);
+
+    for (uint32_t i = 0; i < STATISTICS_HISTOGRAM_SIZE; i++) {
+        snprintf(name, sizeof(name), "stat_histogram_%s_%" PRIu64 "", variable_name, statistics_latency_t::bucket_begin(i));
+        this->write_statistics_value(obj_type, obj_label, name, latency->histogram[i]);
     }
-    this->write_statistics(buffer);
 };
 
 
+// =============================================================================
+/// The integer statistics of all components are stored instead of printed
+void sinuca_engine_t::global_capture_statistics(std::vector<uint64_t> *values, std::vector<std::string> *names) {
+    this->stat_capture = values;
+    this->stat_capture_names = names;
+
+    for (uint32_t i = 0 ; i < this->get_interconnection_interface_array_size() ; i++) {
+        this->interconnection_interface_array[i]->print_statistics();
+    }
+    this->directory_controller->print_statistics();
+    this->interconnection_controller->print_statistics();
+
+    this->stat_capture = NULL;
+    this->stat_capture_names = NULL;
+};
+
+// =============================================================================
+/// Host time of each component (-profile), the clock and receive_package of
+/// each instance, the sum per component type and the directory treat_* calls.
+/// The remaining time is spent by the engine (trace reading during the fast-
+/// forward, idle skip, periodic checks) and is reported as unprofiled.
+void sinuca_engine_t::print_profile_statistics(double time_spent) {
+    if (!this->arg_profile) {
+        return;
+    }
+
+    this->write_statistics_big_separator();
+    this->write_statistics_comments("Host Time Profile");
+    this->write_statistics_big_separator();
+
+    uint64_t type_clock_ns[COMPONENT_NUMBER] = {0};
+    uint64_t type_receive_ns[COMPONENT_NUMBER] = {0};
+    uint64_t total_ns = 0;
+    for (uint32_t i = 0 ; i < this->get_interconnection_interface_array_size() ; i++) {
+        interconnection_interface_t *component = this->interconnection_interface_array[i];
+        this->write_statistics_value(component->get_type_component_label(), component->get_label(), "profile_clock_s", component->profile_clock.ns / 1e9);
+        this->write_statistics_value(component->get_type_component_label(), component->get_label(), "profile_clock_calls", component->profile_clock.calls);
+        this->write_statistics_value(component->get_type_component_label(), component->get_label(), "profile_receive_s", component->profile_receive.ns / 1e9);
+        this->write_statistics_value(component->get_type_component_label(), component->get_label(), "profile_receive_calls", component->profile_receive.calls);
+        type_clock_ns[component->get_type_component()] += component->profile_clock.ns;
+        type_receive_ns[component->get_type_component()] += component->profile_receive.ns;
+        total_ns += component->profile_clock.ns + component->profile_receive.ns;
+    }
+
+    this->write_statistics_small_separator();
+    const char *directory_label = this->directory_controller->get_label();
+    this->write_statistics_value(directory_label, directory_label, "profile_treat_request_s", this->directory_controller->profile_treat_request.ns / 1e9);
+    this->write_statistics_value(directory_label, directory_label, "profile_treat_request_calls", this->directory_controller->profile_treat_request.calls);
+    this->write_statistics_value(directory_label, directory_label, "profile_treat_answer_s", this->directory_controller->profile_treat_answer.ns / 1e9);
+    this->write_statistics_value(directory_label, directory_label, "profile_treat_answer_calls", this->directory_controller->profile_treat_answer.calls);
+    this->write_statistics_value(directory_label, directory_label, "profile_treat_request_sent_s", this->directory_controller->profile_treat_request_sent.ns / 1e9);
+    this->write_statistics_value(directory_label, directory_label, "profile_treat_request_sent_calls", this->directory_controller->profile_treat_request_sent.calls);
+    type_clock_ns[COMPONENT_DIRECTORY_CONTROLLER] += this->directory_controller->profile_treat_request.ns +
+                                                    this->directory_controller->profile_treat_answer.ns +
+                                                    this->directory_controller->profile_treat_request_sent.ns;
+    total_ns += type_clock_ns[COMPONENT_DIRECTORY_CONTROLLER];
+
+    this->write_statistics_small_separator();
+    uint64_t time_spent_ns = time_spent * 1e9;
+    for (uint32_t type = 0; type < COMPONENT_NUMBER; type++) {
+        if (type_clock_ns[type] + type_receive_ns[type] == 0) {
+            continue;
+        }
+        const char *type_label = get_enum_component_char((component_t)type);
+        /// The directory time comes from the treat_* calls made by the caches
+        this->write_statistics_value("PROFILE", type_label, type == COMPONENT_DIRECTORY_CONTROLLER ? "treat_s" : "clock_s", type_clock_ns[type] / 1e9);
+        this->write_statistics_value("PROFILE", type_label, "receive_s", type_receive_ns[type] / 1e9);
+        this->write_statistics_value_percentage("PROFILE", type_label, "time_spent_ratio", type_clock_ns[type] + type_receive_ns[type], time_spent_ns);
+    }
+    this->write_statistics_value("PROFILE", get_label(), "unprofiled_s", time_spent_ns > total_ns ? (time_spent_ns - total_ns) / 1e9 : 0.0);
+
+    double instructions_simulated = 0;
+    for (uint32_t i = 0 ; i < this->get_processor_array_size() ; i++) {
+        instructions_simulated += this->trace_reader->get_trace_opcode_counter(i);
+    }
+    this->write_statistics_value("PROFILE", get_label(), "cycles_per_second", this->global_cycle / time_spent);
+    this->write_statistics_value("PROFILE", get_label(), "instructions_per_second", instructions_simulated / time_spent);
+};
+
+// =============================================================================
+/// Mean of each statistic per opcode over the samples, times the trace opcodes.
+/// The confidence intervals (95%) assume normal distribution of the samples.
+void sinuca_engine_t::print_sampling_statistics() {
+    if (this->sampling_samples == 0) {
+        return;
+    }
+
+    char title[50] = "";
+    snprintf(title, sizeof(title), "Sampling Statistics");
+    this->write_statistics_big_separator();
+    this->write_statistics_comments(title);
+    this->write_statistics_big_separator();
+
+    uint64_t total_opcodes = this->trace_reader->get_trace_opcode_total();
+    double samples = this->sampling_samples;
+
+    double cpi_mean = this->sampling_cpi_sum / samples;
+    double cpi_ci = 0.0;
+    if (this->sampling_samples > 1) {
+        double variance = (this->sampling_cpi_squares - samples * cpi_mean * cpi_mean) / (samples - 1);
+        cpi_ci = 1.96 * sqrt(variance > 0.0 ? variance : 0.0) / sqrt(samples);
+    }
+
+    this->write_statistics_value(get_type_component_label(), get_label(), "sampling_samples", this->sampling_samples);
+    this->write_statistics_value(get_type_component_label(), get_label(), "sampling_opcodes", this->sampling_opcodes);
+    this->write_statistics_value(get_type_component_label(), get_label(), "sampling_cycles", this->sampling_cycles);
+    this->write_statistics_value(get_type_component_label(), get_label(), "sampling_total_opcodes", total_opcodes);
+    this->write_statistics_value(get_type_component_label(), get_label(), "sampling_cpi", cpi_mean);
+    this->write_statistics_value(get_type_component_label(), get_label(), "sampling_cpi_ci95", cpi_ci);
+    this->write_statistics_value(get_type_component_label(), get_label(), "sampling_ipc", cpi_mean > 0.0 ? 1.0 / cpi_mean : 0.0);
+    this->write_statistics_value(get_type_component_label(), get_label(), "sampling_estimated_cycles", cpi_mean * total_opcodes);
+    this->write_statistics_value(get_type_component_label(), get_label(), "sampling_estimated_cycles_ci95", cpi_ci * total_opcodes);
+
+    this->write_statistics_small_separator();
+    for (uint32_t i = 0; i < this->sampling_names.size(); i++) {
+        /// Minimum and maximum are not extrapolated
+        if (this->sampling_names[i].find("_min_") != std::string::npos || this->sampling_names[i].find("_max_") != std::string::npos) {
+            continue;
+        }
+        double rate_mean = this->sampling_rate_sum[i] / samples;
+        double rate_ci = 0.0;
+        if (this->sampling_samples > 1) {
+            double variance = (this->sampling_rate_squares[i] - samples * rate_mean * rate_mean) / (samples - 1);
+            rate_ci = 1.96 * sqrt(variance > 0.0 ? variance : 0.0) / sqrt(samples);
+        }
+        this->write_statistics_value("SAMPLING", this->sampling_names[i].c_str(), "estimated", rate_mean * total_opcodes);
+        this->write_statistics_value("SAMPLING", this->sampling_names[i].c_str(), "estimated_ci95", rate_ci * total_opcodes);
+    }
+};
+
 // =============================================================================
 void sinuca_engine_t::global_print_statistics() {
-    /// Open the statistics file
-    if (this->result_file.is_open() == false && this->arg_result_file_name != NULL) {
-        this->result_file.open(this->arg_result_file_name, std::ofstream::app);
-        ERROR_ASSERT_PRINTF(this->result_file.is_open() == true, "Could not open the result file.\n")
+    /// Last (partial) interval
+    if (!this->interval_names.empty()) {
+        this->interval_write();
+        this->interval_file.close();
     }
 
+    /// Open the statistics file
+    this->statistics_writer.open(this->arg_result_file_name, this->arg_result_format);
+
     char title[50] = "";
     snprintf(title, sizeof(title), "Statistics of %s", this->get_label());
     this->write_statistics_big_separator();
@@ -462,6 +1154,9 @@ void sinuca_engine_t::global_print_statistics() {
     this->write_statistics_value(get_type_component_label(), get_label(), "time_spent_s", time_spent);
     this->write_statistics_value(get_type_component_label(), get_label(), "time_spent_m", time_spent / 60.0);
     this->write_statistics_value(get_type_component_label(), get_label(), "time_spent_h", time_spent / 3600.0);
+    double startup_time = stat_timer_start.tv_sec - stat_timer_startup.tv_sec + ((stat_timer_start.tv_usec - stat_timer_startup.tv_usec) / 1000000.0);
+    this->write_statistics_value(get_type_component_label(), get_label(), "startup_time_s", startup_time);
+    this->write_statistics_value(get_type_component_label(), get_label(), "skipped_cycles", stat_skipped_cycles);
 
     this->write_statistics_small_separator();
     utils_t::process_mem_usage(&this->stat_vm_end, &this->stat_rss_end);
@@ -478,6 +1173,9 @@ void sinuca_engine_t::global_print_statistics() {
     this->write_statistics_value(get_type_component_label(), get_label(), "stat_rss_allocate_mb", stat_rss_allocate);
     this->write_statistics_value(get_type_component_label(), get_label(), "stat_rss_end_mb", stat_rss_end);
     this->write_statistics_value(get_type_component_label(), get_label(), "stat_rss_max_mb", stat_rss_max);
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    this->write_statistics_value(get_type_component_label(), get_label(), "stat_rss_peak_mb", usage.ru_maxrss / 1024.0);
 
     this->write_statistics_small_separator();
     this->write_statistics_value(get_type_component_label(), get_label(), "stat_old_opcode_package", stat_old_opcode_package);
@@ -505,8 +1203,9 @@ void sinuca_engine_t::global_print_statistics() {
     for (uint32_t i = 0 ; i < this->get_processor_array_size() ; i++) {
         kilo_instructions_simulated += this->trace_reader->get_trace_opcode_counter(i) / 1000.0;
     }
-    this->write_statistics_value_ratio(get_type_component_label(), get_label(), "cycles_per_second_khz", global_cycle / 1000.0, time_spent);
-    this->write_statistics_value_ratio(get_type_component_label(), get_label(), "instruction_per_second_kips", kilo_instructions_simulated, time_spent);
+    /// The ratio with an integer total would truncate the time to seconds
+    this->write_statistics_value(get_type_component_label(), get_label(), "cycles_per_second_khz", global_cycle / 1000.0 / time_spent);
+    this->write_statistics_value(get_type_component_label(), get_label(), "instruction_per_second_kips", kilo_instructions_simulated / time_spent);
 
     // =========================================================================
     for (uint32_t i = 0 ; i < this->get_interconnection_interface_array_size() ; i++) {
@@ -515,19 +1214,17 @@ void sinuca_engine_t::global_print_statistics() {
     this->directory_controller->print_statistics();
     this->interconnection_controller->print_statistics();
 
+    this->print_profile_statistics(time_spent);
+    this->print_sampling_statistics();
+
     /// Close the statistics file
-    if (this->result_file.is_open() == true && this->arg_result_file_name != NULL) {
-        this->result_file.close();
-    }
+    this->statistics_writer.close();
 };
 
 // =============================================================================
 void sinuca_engine_t::global_print_configuration() {
     /// Open the statistics file
-    if (this->result_file.is_open() == false && this->arg_result_file_name != NULL) {
-        this->result_file.open(this->arg_result_file_name, std::ofstream::app);
-        ERROR_ASSERT_PRINTF(this->result_file.is_open() == true, "Could not open the result file.\n")
-    }
+    this->statistics_writer.open(this->arg_result_file_name, this->arg_result_format);
 
     char comment[50] = "";
     snprintf(comment, sizeof(comment), "Configuration of %s", this->get_label());
@@ -537,8 +1234,28 @@ void sinuca_engine_t::global_print_configuration() {
 
     this->write_statistics_value(get_type_component_label(), get_label(), "arg_configuration_file_name", arg_configuration_file_name);
     this->write_statistics_value(get_type_component_label(), get_label(), "arg_trace_file_name", arg_trace_file_name);
+    this->write_statistics_value(get_type_component_label(), get_label(), "trace_format", get_enum_trace_format_char(this->trace_reader->get_trace_format()));
     this->write_statistics_value(get_type_component_label(), get_label(), "arg_result_file_name", arg_result_file_name);
+    this->write_statistics_value(get_type_component_label(), get_label(), "arg_result_format", get_enum_statistics_format_char(arg_result_format));
     this->write_statistics_value(get_type_component_label(), get_label(), "arg_warmup_instructions", arg_warmup_instructions);
+    this->write_statistics_value(get_type_component_label(), get_label(), "arg_fast_forward", arg_fast_forward);
+    this->write_statistics_value(get_type_component_label(), get_label(), "arg_sampling_period", arg_sampling_period);
+    this->write_statistics_value(get_type_component_label(), get_label(), "arg_sampling_detailed", arg_sampling_detailed);
+    this->write_statistics_value(get_type_component_label(), get_label(), "arg_sampling_warming", arg_sampling_warming);
+    this->write_statistics_value(get_type_component_label(), get_label(), "arg_checkpoint_instructions", arg_checkpoint_instructions);
+    this->write_statistics_value(get_type_component_label(), get_label(), "arg_checkpoint_file_name", arg_checkpoint_file_name);
+    this->write_statistics_value(get_type_component_label(), get_label(), "arg_restore_file_name", arg_restore_file_name);
+    this->write_statistics_value(get_type_component_label(), get_label(), "arg_warm_save_file_name", arg_warm_save_file_name);
+    this->write_statistics_value(get_type_component_label(), get_label(), "arg_warm_load_file_name", arg_warm_load_file_name);
+    this->write_statistics_value(get_type_component_label(), get_label(), "arg_trace_prefetch", arg_trace_prefetch);
+    this->write_statistics_value(get_type_component_label(), get_label(), "arg_trace_read_ahead", arg_trace_read_ahead);
+    this->write_statistics_value(get_type_component_label(), get_label(), "arg_trace_mmap", arg_trace_mmap);
+    this->write_statistics_value(get_type_component_label(), get_label(), "arg_idle_skip", arg_idle_skip);
+    this->write_statistics_value(get_type_component_label(), get_label(), "arg_clock_threads", arg_clock_threads);
+    this->write_statistics_value(get_type_component_label(), get_label(), "arg_profile", arg_profile);
+    this->write_statistics_value(get_type_component_label(), get_label(), "arg_interval_cycles", arg_interval_cycles);
+    this->write_statistics_value(get_type_component_label(), get_label(), "arg_interval_opcodes", arg_interval_opcodes);
+    this->write_statistics_value(get_type_component_label(), get_label(), "arg_interval_file_name", arg_interval_file_name);
     this->write_statistics_value(get_type_component_label(), get_label(), "arg_default_core_affinity", arg_default_affinity);
 
     char name[100];
@@ -576,7 +1293,5 @@ void sinuca_engine_t::global_print_configuration() {
     this->interconnection_controller->print_configuration();
 
     /// Close the statistics file
-    if (this->result_file.is_open() == true && this->arg_result_file_name != NULL) {
-        this->result_file.close();
-    }
+    this->statistics_writer.close();
 };
@@ -28,8 +28,27 @@ class sinuca_engine_t {
         char *arg_configuration_path;
         char *arg_trace_file_name;
         char *arg_result_file_name;
+        statistics_format_t arg_result_format;
         uint32_t arg_warmup_instructions;
+        bool arg_fast_forward;
+        uint32_t arg_sampling_period;
+        uint32_t arg_sampling_detailed;
+        uint32_t arg_sampling_warming;
+        uint32_t arg_checkpoint_instructions;
+        char *arg_checkpoint_file_name;
+        char *arg_restore_file_name;
+        char *arg_warm_save_file_name;
+        char *arg_warm_load_file_name;
         uint32_t arg_stopat_instructions;
+        uint32_t arg_trace_prefetch;
+        uint32_t arg_trace_read_ahead;
+        bool arg_trace_mmap;
+        bool arg_idle_skip;
+        uint32_t arg_clock_threads;
+        bool arg_profile;
+        uint32_t arg_interval_cycles;
+        uint32_t arg_interval_opcodes;
+        char *arg_interval_file_name;
         bool arg_default_affinity;
         char *arg_graph_file_name;
         uint32_t thread_affinity[MAX_CORES];
@@ -38,8 +57,9 @@ class sinuca_engine_t {
         char *arg_map_file_name;
         std::ofstream map_file;
 
-        std::ofstream result_file;
+        statistics_writer_t statistics_writer;
         std::ofstream graph_file;
+        std::ofstream interval_file;
 
         /// Array of components
         interconnection_interface_t* *interconnection_interface_array;
@@ -75,6 +95,7 @@ class sinuca_engine_t {
         bool *is_processor_trace_eof;
         bool is_simulation_eof;
         bool is_warmup;
+        uint64_t fetch_limit;           /// The processors do not fetch beyond this opcode (trace_opcode_total)
 
         trace_reader_t *trace_reader;
         directory_controller_t *directory_controller;
@@ -85,6 +106,7 @@ class sinuca_engine_t {
         // ====================================================================
         /// Time statistics
         struct timeval stat_timer_start, stat_timer_end;
+        struct timeval stat_timer_startup;      /// Process start, the start-up lasts until stat_timer_start
         /// Memory Usage statistics
         /// virtual memory
         double stat_vm_start;
@@ -98,10 +120,45 @@ class sinuca_engine_t {
         double stat_rss_max;
         /// Save during warmup
         uint64_t reset_cycle;
+        /// Sampled simulation (one entry per integer statistic)
+        std::vector<uint64_t> *stat_capture;            /// Integer statistics are captured instead of printed
+        std::vector<std::string> *stat_capture_names;
+        std::vector<std::string> sampling_names;
+        std::vector<uint64_t> sampling_region_begin;
+        std::vector<double> sampling_rate_sum;          /// Statistic per opcode of each region
+        std::vector<double> sampling_rate_squares;
+        uint64_t sampling_samples;
+        uint64_t sampling_opcodes;
+        uint64_t sampling_cycles;
+        double sampling_cpi_sum;
+        double sampling_cpi_squares;
+        uint64_t sampling_begin_cycle;
+        uint64_t sampling_begin_opcode;
+        /// Interval time series (one column per integer statistic)
+        std::vector<std::string> interval_names;
+        std::vector<uint64_t> interval_begin;
+        uint64_t interval_begin_cycle;
+        uint64_t interval_begin_opcode;
+        uint64_t interval_next;         /// Cycle (or trace_opcode_total) of the next interval line
         /// Oldest Packages
         uint64_t stat_old_memory_package;
         uint64_t stat_old_opcode_package;
         uint64_t stat_old_uop_package;
+        /// Cycles jumped over while all the components were idle
+        uint64_t stat_skipped_cycles;
+        uint64_t idle_skip_check_cycle;    /// Next cycle to look for idle components
+        uint32_t idle_skip_backoff;        /// Doubles while the checks find busy components
+
+        /// Parallel clock of the processors pipelines
+        uint32_t clock_threads;                     /// Host threads clocking the processors (1 = serial clock)
+        std::thread *clock_thread;
+        std::atomic<uint64_t> clock_phase;          /// Incremented to start the pipelines of one cycle
+        std::atomic<uint32_t> clock_phase_done;     /// Threads done with the pipelines of the cycle
+        std::atomic<bool> clock_stop;
+
+        /// Caches, memory controllers and routers with packages inside (bit per component id)
+        std::atomic<uint64_t> *active_component;
+        uint32_t active_component_words;
 
         // ====================================================================
         /// Methods
@@ -130,10 +187,38 @@ class sinuca_engine_t {
         void initialize_interconnection_controller();
 
         void make_connections();
+        void apply_variant(const char *file_name);
 
         void global_panic();
         void global_periodic_check();
         void global_clock();
+        void start_clock_threads();
+        void stop_clock_threads();
+        void clock_pipelines(uint32_t thread);
+        void clock_worker(uint32_t thread);
+        void start_active_components();
+        void clock_active_components(uint32_t sub_cycle);
+        void global_skip_idle_cycles();
+        void global_fast_forward(uint64_t opcodes);
+        void global_detailed(uint64_t opcodes, bool drain);
+        bool is_drained();
+        void global_checkpoint(const char *file_name, bool restore, bool warm);
+
+        void global_sampling();
+        void sampling_begin_region();
+        void sampling_end_region();
+
+        void global_interval();
+        void interval_start();
+        void interval_write();
+
+        /// Puts a drained cache, memory controller or router back in the clock
+        inline void wake_component(uint32_t id) {
+            std::atomic<uint64_t> *word = &this->active_component[id >> 6];
+            if ((word->load(std::memory_order_relaxed) & (1ull << (id & 63))) == 0) {
+                word->fetch_or(1ull << (id & 63), std::memory_order_relaxed);
+            }
+        };
 
         INSTANTIATE_GET_SET(interconnection_interface_t**, interconnection_interface_array);
         INSTANTIATE_GET_SET(processor_t**, processor_array);
@@ -156,6 +241,7 @@ class sinuca_engine_t {
         INSTANTIATE_GET_SET(bool, is_runtime_debug);
         INSTANTIATE_GET_SET(bool, is_simulation_eof);
         INSTANTIATE_GET_SET(bool, is_warmup);
+        INSTANTIATE_GET_SET(uint64_t, fetch_limit);
 
         INSTANTIATE_GET_SET(uint64_t, global_cycle);
 
@@ -194,8 +280,12 @@ class sinuca_engine_t {
         void write_statistics_value_percentage(const char *obj_type, const char *obj_label, const char *variable_name, uint64_t value, uint64_t total);
         void write_statistics_value_ratio(const char *obj_type, const char *obj_label, const char *variable_name, uint64_t value, uint64_t total);
         void write_statistics_value_ratio(const char *obj_type, const char *obj_label, const char *variable_name, double value, uint64_t total);
+        void write_statistics_latency(const char *obj_type, const char *obj_label, const char *variable_name, const statistics_latency_t *latency);
 
         void global_reset_statistics();
+        void global_capture_statistics(std::vector<uint64_t> *values, std::vector<std::string> *names);
+        void print_profile_statistics(double time_spent);
+        void print_sampling_statistics();
         void global_print_statistics();
         void global_print_configuration();
         void global_print_graph();
@@ -0,0 +1,64 @@
+/*
+ * Copyright (C) 2010~2014  Marco Antonio Zanata Alves
+ *                          (mazalves at inf.ufrgs.br)
+ *                          GPPD - Parallel and Distributed Processing Group
+ *                          Universidade Federal do Rio Grande do Sul
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/// Binary Statistics Format
+// ============================================================================
+ /*! Result file of -result_format binary, shared by the statistics_writer_t
+  * and the stand-alone statistics reader.
+  * Records are in the host byte order, each one starting with its tag:
+  *
+  * 'H' STATISTICS_BINARY_MAGIC, uint32_t version   (new schema, every run)
+  * 'T' uint16_t type_id, type                  (component type, once)
+  * 'L' uint16_t component_id, uint16_t type_id, label   (component, once)
+  * 'N' uint16_t type_id, uint16_t counter_id, name      (once per type)
+  * 'U' uint16_t component_id, uint16_t counter_id, uint64_t value
+  * 'D' uint16_t component_id, uint16_t counter_id, double value
+  * 'P' uint16_t component_id, uint16_t counter_id, double percentage
+  * 'B' uint16_t component_id, uint16_t counter_id, uint8_t value
+  * 'S' uint16_t component_id, uint16_t counter_id, string value
+  * 'C' string comment
+  *
+  * where the strings are uint16_t length + characters. The schema records
+  * come before the first value using them, the runs appended to the same
+  * file start again from the 'H' record with new ids. The counter ids belong to the
+  * component type, every component of the type shares its names.
+  */
+#ifndef _SINUCA_STATISTICS_BINARY_HPP_
+#define _SINUCA_STATISTICS_BINARY_HPP_
+
+#include <stdint.h>
+
+#define STATISTICS_BINARY_MAGIC "SiNUCA Statistics\n"
+#define STATISTICS_BINARY_VERSION 2
+
+/// Schema records
+#define STATISTICS_BINARY_HEADER 'H'
+#define STATISTICS_BINARY_TYPE 'T'
+#define STATISTICS_BINARY_COMPONENT 'L'
+#define STATISTICS_BINARY_NAME 'N'
+/// Value records
+#define STATISTICS_BINARY_UINT64 'U'
+#define STATISTICS_BINARY_DOUBLE 'D'
+#define STATISTICS_BINARY_PERCENTAGE 'P'
+#define STATISTICS_BINARY_BOOL 'B'
+#define STATISTICS_BINARY_STRING 'S'
+#define STATISTICS_BINARY_COMMENT 'C'
+
+#endif  // _SINUCA_STATISTICS_BINARY_HPP_
@@ -0,0 +1,216 @@
+/*
+ * Copyright (C) 2010~2014  Marco Antonio Zanata Alves
+ *                          (mazalves at inf.ufrgs.br)
+ *                          GPPD - Parallel and Distributed Processing Group
+ *                          Universidade Federal do Rio Grande do Sul
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+/// Statistics Reader
+// ============================================================================
+ /*! Stand-alone tool which decodes the -result_format binary results
+  * described in statistics_binary.hpp back into the text result lines
+  * (TYPE.LABEL.name:value), without the text separators.
+  */
+#define __STDC_FORMAT_MACROS
+
+#include <inttypes.h>
+#include <stdint.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "../statistics_binary.hpp"
+
+#define READER_ERROR(...)       {\
+                                    fprintf(stderr, "ERROR: ");\
+                                    fprintf(stderr, __VA_ARGS__);\
+                                    exit(EXIT_FAILURE);\
+                                }
+
+#define READER_ASSERT(v, ...) if (!(v)) {\
+                                    fprintf(stderr, "ERROR_ASSERT: %s\n", #v);\
+                                    READER_ERROR(__VA_ARGS__);\
+                                }
+
+static FILE *input;
+
+// =============================================================================
+static void display_use() {
+    printf("Decodes SiNUCA binary results into the text result format.\n\n");
+    printf("Usage: sinuca_statistics_reader -result FILE [OPTIONS]\n\n");
+    printf(" DESCRIPTION\n");
+    printf("\t -result     \t FILE          \t Binary result file. **Required\n");
+    printf("\t -output     \t FILE          \t Text output file. Default is the standard output.\n");
+    exit(EXIT_FAILURE);
+};
+
+// =============================================================================
+template <class TYPE>
+static TYPE read_raw() {
+    TYPE value;
+    READER_ASSERT(fread(&value, sizeof(TYPE), 1, input) == 1, "Truncated binary result.\n")
+    return value;
+};
+
+// =============================================================================
+static std::string read_string() {
+    uint16_t size = read_raw<uint16_t>();
+    std::string text(size, '\0');
+    if (size > 0) {
+        READER_ASSERT(fread(&text[0], 1, size, input) == size, "Truncated binary result.\n")
+    }
+    return text;
+};
+
+// =============================================================================
+int main(int argc, char **argv) {
+    const char *result_file_name = NULL;
+    const char *output_file_name = NULL;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-result") == 0 && i + 1 < argc) {
+            result_file_name = argv[++i];
+        }
+        else if (strcmp(argv[i], "-output") == 0 && i + 1 < argc) {
+            output_file_name = argv[++i];
+        }
+        else {
+            display_use();
+        }
+    }
+    if (result_file_name == NULL) {
+        display_use();
+    }
+
+    input = fopen(result_file_name, "rb");
+    READER_ASSERT(input != NULL, "Could not open the result file %s.\n", result_file_name)
+    FILE *output = stdout;
+    if (output_file_name != NULL) {
+        output = fopen(output_file_name, "w");
+        READER_ASSERT(output != NULL, "Could not open the output file %s.\n", output_file_name)
+    }
+
+    /// Each run appended to the file starts its own schema
+    const char *magic = STATISTICS_BINARY_MAGIC;
+    uint32_t magic_size = strlen(magic);
+
+    /// Schema: type names, counter names per type, (type, label) per component
+    std::vector<std::string> types;
+    std::vector< std::vector<std::string> > counters;
+    std::vector<std::string> components;
+    std::vector<uint16_t> component_type;
+
+    int tag = fgetc(input);
+    READER_ASSERT(tag == STATISTICS_BINARY_HEADER, "Not a SiNUCA binary result.\n")
+    for (; tag != EOF; tag = fgetc(input)) {
+        switch (tag) {
+            case STATISTICS_BINARY_HEADER: {
+                std::string header(magic_size, '\0');
+                READER_ASSERT(fread(&header[0], 1, magic_size, input) == magic_size &&
+                            header == magic, "Not a SiNUCA binary result.\n")
+                uint32_t version = read_raw<uint32_t>();
+                READER_ASSERT(version == STATISTICS_BINARY_VERSION, "Binary result version %u, expected %u.\n", version, STATISTICS_BINARY_VERSION)
+                types.clear();
+                counters.clear();
+                components.clear();
+                component_type.clear();
+            }
+            continue;
+
+            case STATISTICS_BINARY_TYPE: {
+                uint16_t type_id = read_raw<uint16_t>();
+                READER_ASSERT(type_id == types.size(), "Type %u out of order.\n", type_id)
+                types.push_back(read_string());
+                counters.push_back(std::vector<std::string>());
+            }
+            continue;
+
+            case STATISTICS_BINARY_COMPONENT: {
+                uint16_t component_id = read_raw<uint16_t>();
+                uint16_t type_id = read_raw<uint16_t>();
+                READER_ASSERT(component_id == components.size(), "Component %u out of order.\n", component_id)
+                READER_ASSERT(type_id < types.size(), "Unknown type %u.\n", type_id)
+                /// The text key prefix, TYPE.LABEL.
+                components.push_back(types[type_id] + "." + read_string() + ".");
+                component_type.push_back(type_id);
+            }
+            continue;
+
+            case STATISTICS_BINARY_NAME: {
+                uint16_t type_id = read_raw<uint16_t>();
+                uint16_t counter_id = read_raw<uint16_t>();
+                READER_ASSERT(type_id < types.size(), "Unknown type %u.\n", type_id)
+                READER_ASSERT(counter_id == counters[type_id].size(), "Counter %u out of order.\n", counter_id)
+                counters[type_id].push_back(read_string());
+            }
+            continue;
+
+            case STATISTICS_BINARY_COMMENT:
+                fprintf(output, "#%s\n", read_string().c_str());
+            continue;
+
+            case STATISTICS_BINARY_UINT64:
+            case STATISTICS_BINARY_DOUBLE:
+            case STATISTICS_BINARY_PERCENTAGE:
+            case STATISTICS_BINARY_BOOL:
+            case STATISTICS_BINARY_STRING:
+            break;
+
+            default:
+                READER_ERROR("Unknown record tag 0x%02x.\n", tag)
+        }
+
+        /// Value records
+        uint16_t component_id = read_raw<uint16_t>();
+        uint16_t counter_id = read_raw<uint16_t>();
+        READER_ASSERT(component_id < components.size(), "Unknown component %u.\n", component_id)
+        const std::vector<std::string> &names = counters[component_type[component_id]];
+        READER_ASSERT(counter_id < names.size(), "Unknown counter %u.\n", counter_id)
+        fprintf(output, "%s%s:", components[component_id].c_str(), names[counter_id].c_str());
+
+        switch (tag) {
+            case STATISTICS_BINARY_UINT64:
+                fprintf(output, "%" PRIu64 "\n", read_raw<uint64_t>());
+            break;
+
+            case STATISTICS_BINARY_DOUBLE:
+                fprintf(output, "%f\n", read_raw<double>());
+            break;
+
+            case STATISTICS_BINARY_PERCENTAGE:
+                fprintf(output, "%f%%\n", read_raw<double>());
+            break;
+
+            case STATISTICS_BINARY_BOOL:
+                fprintf(output, "%s\n", read_raw<uint8_t>() ? "TRUE" : "FALSE");
+            break;
+
+            case STATISTICS_BINARY_STRING:
+                fprintf(output, "%s\n", read_string().c_str());
+            break;
+        }
+    }
+
+    fclose(input);
+    if (output != stdout) {
+        fclose(output);
+    }
+    return EXIT_SUCCESS;
+};
@@ -0,0 +1,110 @@
+/*
+ * Copyright (C) 2010~2014  Marco Antonio Zanata Alves
+ *                          (mazalves at inf.ufrgs.br)
+ *                          GPPD - Parallel and Distributed Processing Group
+ *                          Universidade Federal do Rio Grande do Sul
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/// Statistics Registry
+// ============================================================================
+ /*! A component lists its statistics once, as counters and latencies:
+  *
+  *     #define CACHE_MEMORY_STATISTICS(COUNTER, LATENCY) \
+  *         COUNTER(stat_accesses) \
+  *         LATENCY(read_wait_time)
+  *
+  * and the same list declares them contiguously in one struct, creates the
+  * get_/set_/add_ methods and prints them:
+  *
+  *     struct statistics_t {
+  *         CACHE_MEMORY_STATISTICS(STATISTICS_DECLARE_COUNTER, STATISTICS_DECLARE_LATENCY)
+  *     } statistics;
+  *     CACHE_MEMORY_STATISTICS(STATISTICS_COUNTER_METHODS, STATISTICS_LATENCY_METHODS)
+  *
+  *     CACHE_MEMORY_STATISTICS(STATISTICS_PRINT_COUNTER, STATISTICS_PRINT_LATENCY)
+  *
+  * A reset is one memset (everything starts at zero), and a checkpoint saves
+  * the whole struct. The derived values (sums, ratios) are still printed by
+  * each print_statistics().
+  */
+#ifndef _SINUCA_STATISTICS_REGISTRY_HPP_
+#define _SINUCA_STATISTICS_REGISTRY_HPP_
+
+#define STATISTICS_HISTOGRAM_SIZE 12    /// Latency buckets: [0,2) [2,4) [4,8) ... [2048,inf)
+
+// ============================================================================
+/// Latency of one kind of request, in cycles.
+// ============================================================================
+class statistics_latency_t {
+    public:
+        uint64_t count;
+        uint64_t accumulated;
+        uint64_t min;           /// Only valid with count != 0
+        uint64_t max;
+        uint64_t histogram[STATISTICS_HISTOGRAM_SIZE];
+
+        inline void add(uint64_t latency) {
+            if (this->count == 0 || latency < this->min) {
+                this->min = latency;
+            }
+            if (latency > this->max) {
+                this->max = latency;
+            }
+            this->accumulated += latency;
+            this->count++;
+
+            uint32_t bucket = (latency < 2) ? 0 : 63 - __builtin_clzll(latency);
+            this->histogram[std::min(bucket, (uint32_t)STATISTICS_HISTOGRAM_SIZE - 1)]++;
+        };
+
+        /// Lower latency of one histogram bucket
+        static inline uint64_t bucket_begin(uint32_t bucket) {
+            return (bucket == 0) ? 0 : (1ull << bucket);
+        };
+};
+
+// ============================================================================
+/// List expansions
+// ============================================================================
+#define STATISTICS_DECLARE_COUNTER(NAME) \
+    uint64_t NAME;
+
+#define STATISTICS_DECLARE_LATENCY(NAME) \
+    statistics_latency_t stat_ ## NAME;
+
+#define STATISTICS_COUNTER_METHODS(NAME) \
+    inline void add_ ## NAME() {\
+        this->statistics.NAME++;\
+    };\
+    inline void set_ ## NAME(uint64_t input_NAME) {\
+        this->statistics.NAME = input_NAME;\
+    };\
+    inline uint64_t get_ ## NAME() {\
+        return this->statistics.NAME;\
+    };
+
+#define STATISTICS_LATENCY_METHODS(NAME) \
+    inline void add_stat_ ## NAME(uint64_t born_cycle) {\
+        this->statistics.stat_ ## NAME.add(sinuca_engine.get_global_cycle() - born_cycle);\
+    };
+
+#define STATISTICS_PRINT_COUNTER(NAME) \
+    sinuca_engine.write_statistics_value(get_type_component_label(), get_label(), #NAME, this->statistics.NAME);
+
+#define STATISTICS_PRINT_LATENCY(NAME) \
+    sinuca_engine.write_statistics_latency(get_type_component_label(), get_label(), #NAME, &this->statistics.stat_ ## NAME);
+
+#endif  // _SINUCA_STATISTICS_REGISTRY_HPP_
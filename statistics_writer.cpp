@@ -0,0 +1,368 @@
+/*
+ * Copyright (C) 2010~2014  Marco Antonio Zanata Alves
+ *                          (mazalves at inf.ufrgs.br)
+ *                          GPPD - Parallel and Distributed Processing Group
+ *                          Universidade Federal do Rio Grande do Sul
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "./sinuca.hpp"
+
+// =============================================================================
+statistics_writer_t::statistics_writer_t() {
+    this->file_name[0] = '\0';
+    this->file = NULL;
+    this->format = STATISTICS_FORMAT_TEXT;
+    this->binary_clear();
+};
+
+// =============================================================================
+statistics_writer_t::~statistics_writer_t() {
+    this->close();
+};
+
+// =============================================================================
+/// The file is appended, the engine opens it for the configuration and again
+/// for the statistics. A binary file keeps its schema while it is the same,
+/// a new schema starts with its own header.
+void statistics_writer_t::open(const char *in_file_name, statistics_format_t in_format) {
+    if (this->file != NULL || in_file_name == NULL) {
+        return;
+    }
+
+    if (strcmp(this->file_name, in_file_name) != 0) {
+        this->binary_clear();
+    }
+    this->binary_component = POSITION_FAIL;
+    snprintf(this->file_name, sizeof(this->file_name), "%s", in_file_name);
+    this->format = in_format;
+
+    this->file = fopen(this->file_name, (this->format == STATISTICS_FORMAT_BINARY) ? "ab" : "a");
+    ERROR_ASSERT_PRINTF(this->file != NULL, "Could not open the result file %s.\n", this->file_name)
+
+    if (this->format == STATISTICS_FORMAT_BINARY && !this->binary_header) {
+        this->binary_header = true;
+        this->buffer.push_back(STATISTICS_BINARY_HEADER);
+        this->buffer.append(STATISTICS_BINARY_MAGIC);
+        this->append_raw<uint32_t>(STATISTICS_BINARY_VERSION);
+    }
+};
+
+// =============================================================================
+void statistics_writer_t::close() {
+    if (this->file == NULL) {
+        return;
+    }
+    this->flush();
+    fclose(this->file);
+    this->file = NULL;
+};
+
+// =============================================================================
+void statistics_writer_t::flush() {
+    if (this->buffer.empty()) {
+        return;
+    }
+    ERROR_ASSERT_PRINTF(fwrite(this->buffer.data(), 1, this->buffer.size(), this->file) == this->buffer.size(), "Could not write the result file %s.\n", this->file_name)
+    this->buffer.clear();
+};
+
+// =============================================================================
+void statistics_writer_t::append_string(const char *text) {
+    uint16_t size = std::min(strlen(text), (size_t)std::numeric_limits<uint16_t>::max());
+    this->append_raw<uint16_t>(size);
+    this->buffer.append(text, size);
+};
+
+// =============================================================================
+void statistics_writer_t::append_json_string(const char *text) {
+    this->buffer.push_back('"');
+    for (const char *c = text; *c != '\0'; c++) {
+        if (*c == '"' || *c == '\\') {
+            this->buffer.push_back('\\');
+            this->buffer.push_back(*c);
+        }
+        else if (static_cast<unsigned char>(*c) < 0x20) {
+            char escape[8];
+            snprintf(escape, sizeof(escape), "\\u%04x", static_cast<unsigned char>(*c));
+            this->buffer.append(escape);
+        }
+        else {
+            this->buffer.push_back(*c);
+        }
+    }
+    this->buffer.push_back('"');
+};
+
+// =============================================================================
+void statistics_writer_t::append_json_key(const char *obj_type, const char *obj_label, const char *variable_name) {
+    this->buffer.append("{\"type\":");
+    this->append_json_string(obj_type);
+    this->buffer.append(",\"label\":");
+    this->append_json_string(obj_label);
+    this->buffer.append(",\"name\":");
+    this->append_json_string(variable_name);
+    this->buffer.append(",\"value\":");
+};
+
+// =============================================================================
+void statistics_writer_t::binary_clear() {
+    this->binary_types.clear();
+    this->binary_type_id.clear();
+    this->binary_labels.clear();
+    this->binary_component_type.clear();
+    this->binary_component_id.clear();
+    this->binary_header = false;
+    this->binary_component = POSITION_FAIL;
+    this->binary_next_counter = 0;
+};
+
+// =============================================================================
+/// The values of one component come together, only a new component is searched
+void statistics_writer_t::binary_find_component(const char *obj_type, const char *obj_label) {
+    if (this->binary_component != POSITION_FAIL &&
+    strcmp(this->binary_labels[this->binary_component].c_str(), obj_label) == 0 &&
+    strcmp(this->binary_types[this->binary_component_type[this->binary_component]].name.c_str(), obj_type) == 0) {
+        return;
+    }
+
+    std::string key = std::string(obj_type) + "." + obj_label;
+    std::unordered_map<std::string, uint16_t>::iterator it = this->binary_component_id.find(key);
+    if (it != this->binary_component_id.end()) {
+        this->binary_component = it->second;
+        this->binary_next_counter = 0;
+        return;
+    }
+
+    uint16_t type_id;
+    std::unordered_map<std::string, uint16_t>::iterator type_it = this->binary_type_id.find(obj_type);
+    if (type_it == this->binary_type_id.end()) {
+        ERROR_ASSERT_PRINTF(this->binary_types.size() < UINT16_MAX, "Too many component types in the binary result.\n")
+        type_id = this->binary_types.size();
+        this->binary_types.push_back(statistics_binary_type_t());
+        this->binary_types.back().name = obj_type;
+        this->binary_type_id[obj_type] = type_id;
+        this->buffer.push_back(STATISTICS_BINARY_TYPE);
+        this->append_raw<uint16_t>(type_id);
+        this->append_string(obj_type);
+    }
+    else {
+        type_id = type_it->second;
+    }
+
+    ERROR_ASSERT_PRINTF(this->binary_labels.size() < UINT16_MAX, "Too many components in the binary result.\n")
+    uint16_t component_id = this->binary_labels.size();
+    this->binary_labels.push_back(obj_label);
+    this->binary_component_type.push_back(type_id);
+    this->binary_component_id[key] = component_id;
+    this->buffer.push_back(STATISTICS_BINARY_COMPONENT);
+    this->append_raw<uint16_t>(component_id);
+    this->append_raw<uint16_t>(type_id);
+    this->append_string(obj_label);
+
+    this->binary_component = component_id;
+    this->binary_next_counter = 0;
+};
+
+// =============================================================================
+/// The components of one type print the same counters in the same order, so
+/// the counter after the last one is tried first. The registry statistics are
+/// printed first, their counter ids are their position in the list.
+void statistics_writer_t::append_binary_key(char tag, const char *obj_type, const char *obj_label, const char *variable_name) {
+    this->binary_find_component(obj_type, obj_label);
+    uint16_t type_id = this->binary_component_type[this->binary_component];
+    statistics_binary_type_t *type = &this->binary_types[type_id];
+
+    uint16_t counter;
+    if (this->binary_next_counter < type->counter_names.size() &&
+    strcmp(type->counter_names[this->binary_next_counter].c_str(), variable_name) == 0) {
+        counter = this->binary_next_counter;
+    }
+    else {
+        std::unordered_map<std::string, uint16_t>::iterator it = type->counter_id.find(variable_name);
+        if (it != type->counter_id.end()) {
+            counter = it->second;
+        }
+        else {
+            ERROR_ASSERT_PRINTF(type->counter_names.size() < UINT16_MAX, "Too many counters of %s in the binary result.\n", obj_type)
+            counter = type->counter_names.size();
+            type->counter_names.push_back(variable_name);
+            type->counter_id[variable_name] = counter;
+            this->buffer.push_back(STATISTICS_BINARY_NAME);
+            this->append_raw<uint16_t>(type_id);
+            this->append_raw<uint16_t>(counter);
+            this->append_string(variable_name);
+        }
+    }
+    this->binary_next_counter = counter + 1;
+
+    this->buffer.push_back(tag);
+    this->append_raw<uint16_t>(this->binary_component);
+    this->append_raw<uint16_t>(counter);
+};
+
+// =============================================================================
+/// Raw text, only written by the TEXT format
+void statistics_writer_t::text(const char *line) {
+    if (this->file == NULL || this->format == STATISTICS_FORMAT_TEXT) {
+        this->write_text(line, strlen(line));
+    }
+};
+
+// =============================================================================
+void statistics_writer_t::comment(const char *comment) {
+    if (this->file == NULL || this->format == STATISTICS_FORMAT_TEXT) {
+        char line[TRACE_LINE_SIZE * 4];
+        int size = snprintf(line, sizeof(line), "#%s\n", comment);
+        this->write_text(line, std::min(size, (int)sizeof(line) - 1));
+        return;
+    }
+
+    if (this->format == STATISTICS_FORMAT_JSON) {
+        this->buffer.append("{\"comment\":");
+        this->append_json_string(comment);
+        this->buffer.append("}\n");
+    }
+    else {
+        this->buffer.push_back(STATISTICS_BINARY_COMMENT);
+        this->append_string(comment);
+    }
+    if (this->buffer.size() >= STATISTICS_BUFFER_SIZE) {
+        this->flush();
+    }
+};
+
+// =============================================================================
+/// Only used by the TEXT format
+void statistics_writer_t::separator(bool big) {
+    if (big) {
+        this->text("#===============================================================================\n");
+    }
+    else {
+        this->text("#=======================================\n");
+    }
+};
+
+// =============================================================================
+void statistics_writer_t::value(const char *obj_type, const char *obj_label, const char *variable_name, const char *value) {
+    if (this->file == NULL || this->format == STATISTICS_FORMAT_TEXT) {
+        char line[TRACE_LINE_SIZE * 4];
+        int size = snprintf(line, sizeof(line), "%s.%s.%s:%s\n", obj_type, obj_label, variable_name, value != NULL ? value : "(null)");
+        this->write_text(line, std::min(size, (int)sizeof(line) - 1));
+        return;
+    }
+
+    if (this->format == STATISTICS_FORMAT_JSON) {
+        this->append_json_key(obj_type, obj_label, variable_name);
+        if (value != NULL) {
+            this->append_json_string(value);
+        }
+        else {
+            this->buffer.append("null");
+        }
+        this->buffer.append("}\n");
+    }
+    else {
+        this->append_binary_key(STATISTICS_BINARY_STRING, obj_type, obj_label, variable_name);
+        this->append_string(value != NULL ? value : "(null)");
+    }
+    if (this->buffer.size() >= STATISTICS_BUFFER_SIZE) {
+        this->flush();
+    }
+};
+
+// =============================================================================
+void statistics_writer_t::value(const char *obj_type, const char *obj_label, const char *variable_name, bool value) {
+    if (this->file == NULL || this->format == STATISTICS_FORMAT_TEXT) {
+        this->value(obj_type, obj_label, variable_name, value ? "TRUE" : "FALSE");
+        return;
+    }
+
+    if (this->format == STATISTICS_FORMAT_JSON) {
+        this->append_json_key(obj_type, obj_label, variable_name);
+        this->buffer.append(value ? "true}\n" : "false}\n");
+    }
+    else {
+        this->append_binary_key(STATISTICS_BINARY_BOOL, obj_type, obj_label, variable_name);
+        this->append_raw<uint8_t>(value);
+    }
+    if (this->buffer.size() >= STATISTICS_BUFFER_SIZE) {
+        this->flush();
+    }
+};
+
+// =============================================================================
+void statistics_writer_t::value(const char *obj_type, const char *obj_label, const char *variable_name, uint32_t value) {
+    this->value(obj_type, obj_label, variable_name, static_cast<uint64_t>(value));
+};
+
+// =============================================================================
+void statistics_writer_t::value(const char *obj_type, const char *obj_label, const char *variable_name, uint64_t value) {
+    if (this->file == NULL || this->format == STATISTICS_FORMAT_TEXT) {
+        char line[TRACE_LINE_SIZE * 4];
+        int size = snprintf(line, sizeof(line), "%s.%s.%s:%" PRIu64 "\n", obj_type, obj_label, variable_name, value);
+        this->write_text(line, std::min(size, (int)sizeof(line) - 1));
+        return;
+    }
+
+    if (this->format == STATISTICS_FORMAT_JSON) {
+        char number[32];
+        snprintf(number, sizeof(number), "%" PRIu64 "}\n", value);
+        this->append_json_key(obj_type, obj_label, variable_name);
+        this->buffer.append(number);
+    }
+    else {
+        this->append_binary_key(STATISTICS_BINARY_UINT64, obj_type, obj_label, variable_name);
+        this->append_raw<uint64_t>(value);
+    }
+    if (this->buffer.size() >= STATISTICS_BUFFER_SIZE) {
+        this->flush();
+    }
+};
+
+// =============================================================================
+/// The text keeps the %f of the result files, JSON and binary the whole precision
+void statistics_writer_t::value(const char *obj_type, const char *obj_label, const char *variable_name, double value, bool percentage) {
+    if (this->file == NULL || this->format == STATISTICS_FORMAT_TEXT) {
+        char line[TRACE_LINE_SIZE * 4];
+        int size = snprintf(line, sizeof(line), "%s.%s.%s:%f%s\n", obj_type, obj_label, variable_name, value, percentage ? "%" : "");
+        this->write_text(line, std::min(size, (int)sizeof(line) - 1));
+        return;
+    }
+
+    if (this->format == STATISTICS_FORMAT_JSON) {
+        /// Integral values keep the ".0", so the readers still load a double
+        char number[64];
+        if (std::isfinite(value)) {
+            snprintf(number, sizeof(number), "%.17g", value);
+            if (strpbrk(number, ".e") == NULL) {
+                strcat(number, ".0");
+            }
+        }
+        else {
+            snprintf(number, sizeof(number), "null");
+        }
+        this->append_json_key(obj_type, obj_label, variable_name);
+        this->buffer.append(number);
+        this->buffer.append(percentage ? ",\"unit\":\"%\"}\n" : "}\n");
+    }
+    else {
+        this->append_binary_key(percentage ? STATISTICS_BINARY_PERCENTAGE : STATISTICS_BINARY_DOUBLE, obj_type, obj_label, variable_name);
+        this->append_raw<double>(value);
+    }
+    if (this->buffer.size() >= STATISTICS_BUFFER_SIZE) {
+        this->flush();
+    }
+};
@@ -0,0 +1,120 @@
+/*
+ * Copyright (C) 2010~2014  Marco Antonio Zanata Alves
+ *                          (mazalves at inf.ufrgs.br)
+ *                          GPPD - Parallel and Distributed Processing Group
+ *                          Universidade Federal do Rio Grande do Sul
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/// Statistics Writer
+// ============================================================================
+ /*! Buffered writer of the result file (-result_format), every statistic
+  * is one (component type, label, name) key and one value.
+  * TEXT:   TYPE.LABEL.name:value lines and #comments (the default).
+  * JSON:   one object per line, {"type":..,"label":..,"name":..,"value":..}
+  *         with "unit":"%" on the percentages, and {"comment":..}.
+  * BINARY: the component types, labels and counter names are written once
+  *         (statistics_binary.hpp), each value only carries the component
+  *         and counter ids. The components print their statistics in the
+  *         same order, so a value finds its counter id with one strcmp.
+  * Without a file (stdout) the statistics are always written as text.
+  */
+#ifndef _SINUCA_STATISTICS_WRITER_HPP_
+#define _SINUCA_STATISTICS_WRITER_HPP_
+
+#define STATISTICS_BUFFER_SIZE 1048576     /// Bytes kept before writing the file
+
+// ============================================================================
+/// Counter names of one component type inside the binary schema
+class statistics_binary_type_t {
+    public:
+        std::string name;
+        std::vector<std::string> counter_names;                   /// Counter id => name
+        std::unordered_map<std::string, uint16_t> counter_id;
+};
+
+// ============================================================================
+class statistics_writer_t {
+    private:
+        char file_name[TRACE_FILE_NAME_SIZE];
+        FILE *file;
+        statistics_format_t format;
+        std::string buffer;
+
+        /// Binary schema of the file
+        std::vector<statistics_binary_type_t> binary_types;
+        std::unordered_map<std::string, uint16_t> binary_type_id;
+        std::vector<std::string> binary_labels;                   /// Component id => label
+        std::vector<uint16_t> binary_component_type;              /// Component id => type id
+        std::unordered_map<std::string, uint16_t> binary_component_id;    /// TYPE.LABEL => component id
+        bool binary_header;                                       /// Header of the schema written
+        /// Component of the last value, and the counter expected next
+        int32_t binary_component;
+        uint16_t binary_next_counter;
+
+        void flush();
+        void append_string(const char *text);
+        void append_json_string(const char *text);
+        void append_json_key(const char *obj_type, const char *obj_label, const char *variable_name);
+        void append_binary_key(char tag, const char *obj_type, const char *obj_label, const char *variable_name);
+        void binary_clear();
+        void binary_find_component(const char *obj_type, const char *obj_label);
+
+        template <class TYPE>
+        inline void append_raw(TYPE value) {
+            this->buffer.append(reinterpret_cast<const char*>(&value), sizeof(TYPE));
+        };
+
+        /// Stdout or file
+        inline void write_text(const char *text, uint32_t size) {
+            if (this->file == NULL) {
+                fwrite(text, 1, size, stdout);
+                return;
+            }
+            this->buffer.append(text, size);
+            if (this->buffer.size() >= STATISTICS_BUFFER_SIZE) {
+                this->flush();
+            }
+        };
+
+    public:
+        // ====================================================================
+        /// Methods
+        // ====================================================================
+        statistics_writer_t();
+        ~statistics_writer_t();
+        inline const char* get_label() {
+            return "STATISTICS_WRITER";
+        };
+
+        void open(const char *in_file_name, statistics_format_t in_format);
+        void close();
+
+        inline bool is_open() {
+            return (this->file != NULL);
+        };
+
+        void text(const char *line);
+        void comment(const char *comment);
+        void separator(bool big);
+
+        void value(const char *obj_type, const char *obj_label, const char *variable_name, const char *value);
+        void value(const char *obj_type, const char *obj_label, const char *variable_name, bool value);
+        void value(const char *obj_type, const char *obj_label, const char *variable_name, uint32_t value);
+        void value(const char *obj_type, const char *obj_label, const char *variable_name, uint64_t value);
+        void value(const char *obj_type, const char *obj_label, const char *variable_name, double value, bool percentage = false);
+};
+
+#endif  // _SINUCA_STATISTICS_WRITER_HPP_
@@ -0,0 +1,101 @@
+#!/bin/sh
+#
+# Copyright (C) 2010~2014  Marco Antonio Zanata Alves
+#                          (mazalves at inf.ufrgs.br)
+#                          GPPD - Parallel and Distributed Processing Group
+#                          Universidade Federal do Rio Grande do Sul
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program.  If not, see <http://www.gnu.org/licenses/>.
+#
+# SiNUCA throughput benchmark: generates the synthetic traces (once), runs
+# each one on its config_examples configuration and reports the host KIPS,
+# the peak RSS and the start-up time. With -baseline FILE (a previous
+# benchmark.txt) it fails when a KIPS drops more than -tolerance percent.
+#
+# Usage: run_benchmark.sh [-output DIR] [-opcodes OPCODES] [-baseline FILE] [-tolerance PERCENT]
+
+ROOT=$(cd "$(dirname "$0")/.." && pwd)
+OUTPUT=benchmark_output
+OPCODES=250000
+BASELINE=
+TOLERANCE=10
+
+while [ $# -gt 0 ]; do
+    case "$1" in
+        -output)    OUTPUT=$2; shift ;;
+        -opcodes)   OPCODES=$2; shift ;;
+        -baseline)  BASELINE=$2; shift ;;
+        -tolerance) TOLERANCE=$2; shift ;;
+        *)          echo "Usage: $0 [-output DIR] [-opcodes OPCODES] [-baseline FILE] [-tolerance PERCENT]"; exit 1 ;;
+    esac
+    shift
+done
+
+# PATTERN CONFIGURATION THREADS
+BENCHMARKS="
+pointer_chase   sandy_1core     1
+stream          sandy_1core     1
+compute         sandy_1core     1
+locks           sandy_8cores    8
+nuca            sandy_8cores    8
+"
+
+mkdir -p "$OUTPUT" || exit 1
+RESULTS="$OUTPUT/benchmark.txt"
+# The baseline may be the benchmark.txt of the last run
+if [ -n "$BASELINE" ]; then
+    cat "$BASELINE" > "$OUTPUT/benchmark.baseline" || exit 1
+fi
+printf "# %-14s %-14s %12s %12s %12s\n" PATTERN CONFIGURATION KIPS PEAK_RSS_MB STARTUP_S > "$RESULTS"
+FAILED=0
+
+echo "$BENCHMARKS" | while read PATTERN CONFIGURATION THREADS; do
+    [ -z "$PATTERN" ] && continue
+    TRACE="$OUTPUT/$PATTERN.${THREADS}t.${OPCODES}"
+    NAME="$PATTERN.$CONFIGURATION"
+
+    if [ ! -f "$TRACE.tid0.stat.out.gz" ]; then
+        "$ROOT/sinuca_trace_synthetic" -pattern "$PATTERN" -threads "$THREADS" -opcodes "$OPCODES" -output "$TRACE" > /dev/null || exit 1
+    fi
+
+    rm -f "$OUTPUT/$NAME.result"
+    "$ROOT/sinuca" -config "$ROOT/config_examples/$CONFIGURATION/$CONFIGURATION.cfg" -trace "$TRACE" -result "$OUTPUT/$NAME.result" > "$OUTPUT/$NAME.log" 2>&1
+    if [ $? -ne 0 ]; then
+        echo "$NAME FAILED, see $OUTPUT/$NAME.log"
+        exit 1
+    fi
+
+    KIPS=$(sed -n 's/^SINUCA_ENGINE\.SINUCA_ENGINE\.instruction_per_second_kips://p' "$OUTPUT/$NAME.result")
+    RSS=$(sed -n 's/^SINUCA_ENGINE\.SINUCA_ENGINE\.stat_rss_peak_mb://p' "$OUTPUT/$NAME.result")
+    STARTUP=$(sed -n 's/^SINUCA_ENGINE\.SINUCA_ENGINE\.startup_time_s://p' "$OUTPUT/$NAME.result")
+    printf "  %-14s %-14s %12.1f %12.1f %12.3f\n" "$PATTERN" "$CONFIGURATION" "$KIPS" "$RSS" "$STARTUP" | tee -a "$RESULTS"
+done || exit 1
+
+if [ -n "$BASELINE" ]; then
+    # Same pattern and configuration, lower KIPS beyond the tolerance
+    awk -v tolerance="$TOLERANCE" '
+        /^#/ { next }
+        FNR == NR { baseline[$1 " " $2] = $3; next }
+        ($1 " " $2) in baseline {
+            minimum = baseline[$1 " " $2] * (1 - tolerance / 100.0)
+            if ($3 < minimum) {
+                printf("REGRESSION: %s %s %.1f KIPS < %.1f (baseline %.1f - %s%%)\n", $1, $2, $3, minimum, baseline[$1 " " $2], tolerance)
+                failed = 1
+            }
+        }
+        END { exit failed }
+    ' "$OUTPUT/benchmark.baseline" "$RESULTS" || FAILED=1
+fi
+
+exit $FAILED
@@ -0,0 +1,144 @@
+#!/bin/sh
+#
+# Copyright (C) 2010~2014  Marco Antonio Zanata Alves
+#                          (mazalves at inf.ufrgs.br)
+#                          GPPD - Parallel and Distributed Processing Group
+#                          Universidade Federal do Rio Grande do Sul
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program.  If not, see <http://www.gnu.org/licenses/>.
+#
+# SiNUCA regression tests over small synthetic traces. Each test prints
+# PASS or FAIL, the script fails when any test fails.
+#
+# Usage: run_tests.sh [-output DIR]
+
+ROOT=$(cd "$(dirname "$0")/.." && pwd)
+OUTPUT=test_output
+TIMEOUT=300
+
+while [ $# -gt 0 ]; do
+    case "$1" in
+        -output)    OUTPUT=$2; shift ;;
+        *)          echo "Usage: $0 [-output DIR]"; exit 1 ;;
+    esac
+    shift
+done
+
+mkdir -p "$OUTPUT" || exit 1
+FAILED=0
+
+pass() {
+    echo "PASS $1"
+}
+
+fail() {
+    echo "FAIL $1: $2"
+    FAILED=1
+}
+
+# NAME CONFIGURATION TRACE [ARGS], fails on a hang, an exit code or an ERROR
+simulate() {
+    NAME=$1; CONFIGURATION=$2; TRACE=$3; shift 3
+    rm -f "$OUTPUT/$NAME.result"
+    timeout "$TIMEOUT" "$ROOT/sinuca" -config "$ROOT/config_examples/$CONFIGURATION/$CONFIGURATION.cfg" -trace "$TRACE" -result "$OUTPUT/$NAME.result" "$@" > "$OUTPUT/$NAME.log" 2>&1
+    STATUS=$?
+    if [ $STATUS -eq 124 ]; then
+        fail "$NAME" "timeout after $TIMEOUT s, see $OUTPUT/$NAME.log"
+        return 1
+    elif [ $STATUS -ne 0 ] || grep -q "ERROR" "$OUTPUT/$NAME.log"; then
+        fail "$NAME" "exit code $STATUS, see $OUTPUT/$NAME.log"
+        return 1
+    fi
+    return 0
+}
+
+# NAME THREADS OPCODES, every thread of the trace fetched all its opcodes
+check_trace_over() {
+    NAME=$1; THREADS=$2; OPCODES=$3
+    FINISHED=$(grep -cE "^PROCESSOR\.CPU[0-9]+\.fetch_opcode_counter:$OPCODES$" "$OUTPUT/$NAME.result")
+    if [ "$FINISHED" -ne "$THREADS" ]; then
+        fail "$NAME" "$FINISHED of $THREADS threads fetched $OPCODES opcodes"
+        return 1
+    fi
+    pass "$NAME"
+}
+
+# =============================================================================
+# Barriers and critical sections of a multi-threaded trace inside the
+# functional warm-up: before the detailed part, up to the trace end and
+# between the detailed samples.
+LOCKS="$OUTPUT/locks.4t.40000"
+"$ROOT/sinuca_trace_synthetic" -pattern locks -threads 4 -opcodes 40000 -output "$LOCKS" > /dev/null || exit 1
+# The fetch counter also counts the synchronizations
+LOCKS_OPCODES=40003
+
+simulate fast_forward_barrier sandy_8cores "$LOCKS" -warmup 60000 -fast_forward &&
+    check_trace_over fast_forward_barrier 4 $LOCKS_OPCODES
+simulate fast_forward_trace_end sandy_8cores "$LOCKS" -warmup 1000000 -fast_forward &&
+    check_trace_over fast_forward_trace_end 4 $LOCKS_OPCODES
+simulate sampling_barrier sandy_8cores "$LOCKS" -sampling 20000,2000,1000 &&
+    check_trace_over sampling_barrier 4 $LOCKS_OPCODES
+
+# =============================================================================
+# A restored text trace starts from the nearest index checkpoint (one every
+# 1000000 opcodes), the restored run ends with the statistics of the saving
+# run. Restored once with the index built by the run and once with the file.
+STREAM="$OUTPUT/stream.1t.1200000"
+"$ROOT/sinuca_trace_synthetic" -pattern stream -threads 1 -opcodes 1200000 -output "$STREAM" > /dev/null || exit 1
+rm -f "$STREAM.tid0.dyn.out.gz.idx" "$OUTPUT/restore.ckpt"
+RESTORE_VARYING="\.(skipped_cycles|arg_[a-z_]*|time_spent_[smh]|startup_time_s|stat_vm_[a-z_]*|stat_rss_[a-z_]*|cycles_per_second_khz|instruction_per_second_kips):"
+
+# NAME, the checkpoint run has the same statistics
+check_restore() {
+    NAME=$1
+    grep -vE "^#|$RESTORE_VARYING" "$OUTPUT/restore_save.result" > "$OUTPUT/restore_save.values"
+    grep -vE "^#|$RESTORE_VARYING" "$OUTPUT/$NAME.result" > "$OUTPUT/$NAME.values"
+    if cmp -s "$OUTPUT/restore_save.values" "$OUTPUT/$NAME.values"; then
+        pass "$NAME"
+    else
+        fail "$NAME" "the statistics differ from the checkpoint run"
+    fi
+}
+
+if simulate restore_save sandy_1core "$STREAM" -checkpoint_at 1100000 -checkpoint "$OUTPUT/restore.ckpt"; then
+    rm -f "$STREAM.tid0.dyn.out.gz.idx"
+    simulate restore_new_index sandy_1core "$STREAM" -restore "$OUTPUT/restore.ckpt" &&
+        check_restore restore_new_index
+    simulate restore_index_file sandy_1core "$STREAM" -restore "$OUTPUT/restore.ckpt" &&
+        check_restore restore_index_file
+fi
+
+# =============================================================================
+# The binary result is smaller than the text result and decodes to the same
+# statistics (the text separators are not kept).
+RESULT_VARYING="\.(arg_result_file_name|arg_result_format|time_spent_[smh]|startup_time_s|stat_vm_[a-z_]*|stat_rss_[a-z_]*|cycles_per_second_khz|instruction_per_second_kips):"
+
+simulate result_text sandy_8cores "$LOCKS" -result_format text &&
+simulate result_binary sandy_8cores "$LOCKS" -result_format binary &&
+if ! "$ROOT/sinuca_statistics_reader" -result "$OUTPUT/result_binary.result" -output "$OUTPUT/result_binary.text"; then
+    fail result_binary "the binary result could not be decoded"
+elif [ $(wc -c < "$OUTPUT/result_binary.result") -ge $(wc -c < "$OUTPUT/result_text.result") ]; then
+    fail result_binary "the binary result is not smaller than the text result"
+else
+    # The run time and the simulation speed change between the runs
+    grep -v "^#" "$OUTPUT/result_text.result" | grep -vE "$RESULT_VARYING" > "$OUTPUT/result_text.values"
+    grep -v "^#" "$OUTPUT/result_binary.text" | grep -vE "$RESULT_VARYING" > "$OUTPUT/result_binary.values"
+    if cmp -s "$OUTPUT/result_text.values" "$OUTPUT/result_binary.values"; then
+        pass result_binary
+    else
+        fail result_binary "the decoded values differ from the text result"
+    fi
+fi
+
+exit $FAILED
@@ -0,0 +1,408 @@
+/*
+ * Copyright (C) 2010~2014  Marco Antonio Zanata Alves
+ *                          (mazalves at inf.ufrgs.br)
+ *                          GPPD - Parallel and Distributed Processing Group
+ *                          Universidade Federal do Rio Grande do Sul
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/// Synthetic Trace Generator
+// ============================================================================
+ /*! Stand-alone tool which writes text traces (<base>.tidN.{stat,dyn,mem}.out.gz)
+  * with a fixed access pattern, so the simulator throughput can be measured
+  * without Pin traces. The same pattern, seed and size give the same trace.
+  *     pointer_chase   dependent loads over a 64MB working set
+  *     stream          two loads and one store over three 16MB arrays
+  *     compute         floating point and integer chains over a 16KB buffer
+  *     locks           private work with critical sections and barriers
+  *     nuca            random reads and writes over a 16MB shared array
+  */
+#define __STDC_FORMAT_MACROS
+
+#include <inttypes.h>
+#include <stdint.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include "../extra_libs/include/zlib.h"
+
+#define SYNTHETIC_FILE_NAME_SIZE 500
+#define SYNTHETIC_LINE_SIZE 128
+#define SYNTHETIC_MAX_THREADS 32            /// Same as MAX_CORES
+#define SYNTHETIC_LINE_BYTES 64             /// Cache line size of the config_examples
+#define SYNTHETIC_PRIVATE_BASE 0x10000000ULL    /// Private data of each thread
+#define SYNTHETIC_PRIVATE_STRIDE 0x10000000ULL
+#define SYNTHETIC_SHARED_BASE 0x800000000ULL    /// Data shared by all the threads
+#define SYNTHETIC_CODE_BASE 4345024         /// First opcode address
+
+#define SYNTHETIC_ERROR(...)    {\
+                                    fprintf(stderr, "ERROR: ");\
+                                    fprintf(stderr, __VA_ARGS__);\
+                                    exit(EXIT_FAILURE);\
+                                }
+
+#define SYNTHETIC_ASSERT(v, ...) if (!(v)) {\
+                                    fprintf(stderr, "ERROR_ASSERT: %s\n", #v);\
+                                    SYNTHETIC_ERROR(__VA_ARGS__);\
+                                }
+
+// =============================================================================
+/// Opcodes of the static trace, in the opcode_package_t::trace_string_to_opcode
+/// order, without the address which is given by the position:
+/// ASSEMBLY OPERATION SIZE READS[N R...] WRITES[N W...] BASE INDEX IS_READ IS_READ2 IS_WRITE IS_CONDITIONAL IS_PREDICATED IS_PREFETCH
+/// The operations follow instruction_operation_t (1 INT_ALU, 2 INT_MUL, 4 FP_ALU,
+/// 5 FP_MUL, 6 FP_DIV, 7 BRANCH, 8 MEM_LOAD, 9 MEM_STORE).
+static const char *pointer_chase_bbl[] = {
+    "@",
+    "MOV 8 3 1 12 1 12 12 0 1 0 0 0 0 0",
+    "ADD 1 4 1 13 1 13 0 0 0 0 0 0 0 0",
+    "CMP 1 3 2 12 13 1 34 0 0 0 0 0 0 0 0",
+    "JNZ 7 2 1 34 1 35 0 0 0 0 0 1 0 0",
+    NULL
+};
+
+static const char *stream_bbl[] = {
+    "@",
+    "MOVSD 8 4 2 10 11 1 20 10 11 1 0 0 0 0 0",
+    "MOVSD 8 4 2 10 11 1 21 10 11 1 0 0 0 0 0",
+    "ADDSD 4 4 2 20 21 1 20 0 0 0 0 0 0 0 0",
+    "MOVSD 9 4 3 20 10 11 0 10 11 0 0 1 0 0 0",
+    "ADD 1 4 1 11 1 11 0 0 0 0 0 0 0 0",
+    "CMP 1 3 2 11 12 1 34 0 0 0 0 0 0 0 0",
+    "JNZ 7 2 1 34 1 35 0 0 0 0 0 1 0 0",
+    NULL
+};
+
+static const char *compute_bbl[] = {
+    "@",
+    "MOVSD 8 4 2 10 11 1 20 10 11 1 0 0 0 0 0",
+    "MULSD 5 4 2 20 21 1 21 0 0 0 0 0 0 0 0",
+    "ADDSD 4 4 2 21 22 1 22 0 0 0 0 0 0 0 0",
+    "MULSD 5 4 2 23 24 1 23 0 0 0 0 0 0 0 0",
+    "ADDSD 4 4 2 23 25 1 25 0 0 0 0 0 0 0 0",
+    "IMUL 2 4 2 13 14 1 13 0 0 0 0 0 0 0 0",
+    "ADD 1 4 1 15 1 15 0 0 0 0 0 0 0 0",
+    "ADD 1 4 1 11 1 11 0 0 0 0 0 0 0 0",
+    "CMP 1 3 2 11 12 1 34 0 0 0 0 0 0 0 0",
+    "JNZ 7 2 1 34 1 35 0 0 0 0 0 1 0 0",
+    "@",
+    "DIVSD 6 4 2 22 25 1 26 0 0 0 0 0 0 0 0",
+    "JMP 7 2 0 0 0 0 0 0 0 0 0 0",
+    NULL
+};
+
+static const char *locks_bbl[] = {
+    "@",
+    "MOV 8 4 2 10 11 1 16 10 11 1 0 0 0 0 0",
+    "ADD 1 4 2 16 17 1 17 0 0 0 0 0 0 0 0",
+    "IMUL 2 4 2 17 18 1 18 0 0 0 0 0 0 0 0",
+    "MOV 9 4 3 18 10 11 0 10 11 0 0 1 0 0 0",
+    "ADD 1 4 1 11 1 11 0 0 0 0 0 0 0 0",
+    "CMP 1 3 2 11 12 1 34 0 0 0 0 0 0 0 0",
+    "JNZ 7 2 1 34 1 35 0 0 0 0 0 1 0 0",
+    "@",
+    "MOV 8 4 1 14 1 19 14 0 1 0 0 0 0 0",
+    "ADD 1 4 1 19 1 19 0 0 0 0 0 0 0 0",
+    "MOV 9 4 2 19 14 0 14 0 0 0 1 0 0 0",
+    NULL
+};
+
+static const char *nuca_bbl[] = {
+    "@",
+    "MOV 8 4 2 14 15 1 16 14 15 1 0 0 0 0 0",
+    "MOV 8 4 2 10 11 1 17 10 11 1 0 0 0 0 0",
+    "ADD 1 4 2 16 17 1 18 0 0 0 0 0 0 0 0",
+    "ADD 1 4 1 11 1 11 0 0 0 0 0 0 0 0",
+    "CMP 1 3 2 11 12 1 34 0 0 0 0 0 0 0 0",
+    "JNZ 7 2 1 34 1 35 0 0 0 0 0 1 0 0",
+    "@",
+    "MOV 9 4 3 18 14 15 0 14 15 0 0 1 0 0 0",
+    "JMP 7 2 0 0 0 0 0 0 0 0 0 0",
+    NULL
+};
+
+// =============================================================================
+/// Files and state of one thread
+class synthetic_thread_t {
+    public:
+        gzFile dynamic_file;
+        gzFile memory_file;
+        uint32_t tid;
+        uint64_t opcodes;
+        uint64_t random;
+
+        /// Dynamic trace: one basic block
+        inline void bbl(uint32_t bbl, uint32_t size) {
+            gzprintf(this->dynamic_file, "%u\n", bbl);
+            this->opcodes += size;
+        };
+
+        /// Dynamic trace: one synchronization (sync_t)
+        inline void sync(uint32_t sync) {
+            gzprintf(this->dynamic_file, "$%u\n", sync);
+        };
+
+        /// Memory trace: one access of the basic block
+        inline void memory(char type, uint64_t address, uint32_t bbl) {
+            gzprintf(this->memory_file, "%c 8 %" PRIu64 " %u\n", type, address, bbl);
+        };
+
+        /// xorshift64, the same sequence for the same seed and thread
+        inline uint64_t next_random() {
+            this->random ^= this->random << 13;
+            this->random ^= this->random >> 7;
+            this->random ^= this->random << 17;
+            return this->random;
+        };
+
+        inline uint64_t private_base() {
+            return SYNTHETIC_PRIVATE_BASE + this->tid * SYNTHETIC_PRIVATE_STRIDE;
+        };
+};
+
+// =============================================================================
+static void display_use() {
+    printf("Writes synthetic SiNUCA text traces to measure the simulator throughput.\n\n");
+    printf("Usage: sinuca_trace_synthetic -pattern PATTERN -output TRACE [OPTIONS]\n");
+    printf("\t PATTERN is pointer_chase, stream, compute, locks or nuca.\n\n");
+    printf(" DESCRIPTION\n");
+    printf("\t -pattern    \t PATTERN       \t Access pattern of the trace. **Required\n");
+    printf("\t -output     \t FILE          \t Output trace file base name. **Required\n");
+    printf("\t -threads    \t THREADS       \t Threads of the trace. Default is 1 (8 for locks and nuca).\n");
+    printf("\t -opcodes    \t OPCODES       \t Opcodes of each thread. Default is 1000000.\n");
+    printf("\t -seed       \t SEED          \t Seed of the random addresses. Default is 1.\n");
+    exit(EXIT_FAILURE);
+};
+
+// =============================================================================
+static gzFile open_output(const char *base, uint32_t tid, const char *type) {
+    char file_name[SYNTHETIC_FILE_NAME_SIZE];
+    snprintf(file_name, sizeof(file_name), "%s.tid%u.%s.out.gz", base, tid, type);
+    gzFile file = gzopen(file_name, "wb1");
+    SYNTHETIC_ASSERT(file != NULL, "Could not create the file.\n%s\n", file_name);
+    gzprintf(file, "#\n# SiNUCA synthetic trace\n#\n");
+    return file;
+};
+
+// =============================================================================
+/// Static file, the addresses are consecutive. Returns the size of each BBL.
+static void write_static(const char *base, const char **bbl_lines, uint32_t *bbl_size) {
+    gzFile file = open_output(base, 0, "stat");
+    uint64_t address = SYNTHETIC_CODE_BASE;
+    uint32_t bbl = 0;
+
+    for (uint32_t i = 0; bbl_lines[i] != NULL; i++) {
+        if (bbl_lines[i][0] == '@') {
+            bbl++;
+            bbl_size[bbl] = 0;
+            gzprintf(file, "@%u\n", bbl);
+            continue;
+        }
+        char assembly[SYNTHETIC_LINE_SIZE];
+        uint32_t operation, size;
+        int consumed = 0;
+        SYNTHETIC_ASSERT(sscanf(bbl_lines[i], "%31s %u %u %n", assembly, &operation, &size, &consumed) == 3, "Wrong opcode %s\n", bbl_lines[i]);
+        gzprintf(file, "%s %u %" PRIu64 " %u %s\n", assembly, operation, address, size, bbl_lines[i] + consumed);
+        address += size;
+        bbl_size[bbl]++;
+    }
+    gzprintf(file, "#\n");
+    gzclose(file);
+};
+
+// =============================================================================
+/// Dependent loads, each address comes from the previous load
+static void pointer_chase(synthetic_thread_t *thread, const uint32_t *bbl_size, uint64_t opcodes) {
+    const uint64_t lines = (64ULL << 20) / SYNTHETIC_LINE_BYTES;
+    while (thread->opcodes < opcodes) {
+        thread->bbl(1, bbl_size[1]);
+        thread->memory('R', thread->private_base() + (thread->next_random() % lines) * SYNTHETIC_LINE_BYTES, 1);
+    }
+};
+
+// =============================================================================
+/// c[i] = a[i] + b[i]
+static void stream(synthetic_thread_t *thread, const uint32_t *bbl_size, uint64_t opcodes) {
+    const uint64_t array_size = 16ULL << 20;
+    for (uint64_t i = 0; thread->opcodes < opcodes; i++) {
+        uint64_t offset = (i * 8) % array_size;
+        thread->bbl(1, bbl_size[1]);
+        thread->memory('R', thread->private_base() + offset, 1);
+        thread->memory('R', thread->private_base() + array_size + offset, 1);
+        thread->memory('W', thread->private_base() + 2 * array_size + offset, 1);
+    }
+};
+
+// =============================================================================
+/// Arithmetic chains over a small buffer, one division each 16 iterations
+static void compute(synthetic_thread_t *thread, const uint32_t *bbl_size, uint64_t opcodes) {
+    const uint64_t buffer_size = 16ULL << 10;
+    for (uint64_t i = 0; thread->opcodes < opcodes; i++) {
+        thread->bbl(1, bbl_size[1]);
+        thread->memory('R', thread->private_base() + (i * 8) % buffer_size, 1);
+        if (i % 16 == 15) {
+            thread->bbl(2, bbl_size[2]);
+        }
+    }
+};
+
+// =============================================================================
+/// Private work, a critical section updating a shared counter each 8
+/// iterations and a barrier each 4096 iterations
+static void locks(synthetic_thread_t *thread, const uint32_t *bbl_size, uint64_t opcodes) {
+    const uint64_t private_size = 256ULL << 10;
+    for (uint64_t i = 0; thread->opcodes < opcodes; i++) {
+        thread->bbl(1, bbl_size[1]);
+        thread->memory('R', thread->private_base() + (i * 8) % private_size, 1);
+        thread->memory('W', thread->private_base() + private_size + (i * 8) % private_size, 1);
+        if (i % 8 == 7) {
+            uint64_t counter = SYNTHETIC_SHARED_BASE + (thread->next_random() % 16) * SYNTHETIC_LINE_BYTES;
+            thread->sync(2);    /// SYNC_CRITICAL_START
+            thread->bbl(2, bbl_size[2]);
+            thread->memory('R', counter, 2);
+            thread->memory('W', counter, 2);
+            thread->sync(3);    /// SYNC_CRITICAL_END
+        }
+        if (i % 4096 == 4095) {
+            thread->sync(0);    /// SYNC_BARRIER
+        }
+    }
+};
+
+// =============================================================================
+/// Random lines of a shared array spread over all the NUCA banks, one write
+/// each 4 reads, plus a private stream
+static void nuca(synthetic_thread_t *thread, const uint32_t *bbl_size, uint64_t opcodes) {
+    const uint64_t lines = (16ULL << 20) / SYNTHETIC_LINE_BYTES;
+    const uint64_t private_size = 1ULL << 20;
+    for (uint64_t i = 0; thread->opcodes < opcodes; i++) {
+        thread->bbl(1, bbl_size[1]);
+        thread->memory('R', SYNTHETIC_SHARED_BASE + (thread->next_random() % lines) * SYNTHETIC_LINE_BYTES, 1);
+        thread->memory('R', thread->private_base() + (i * 8) % private_size, 1);
+        if (i % 4 == 3) {
+            thread->bbl(2, bbl_size[2]);
+            thread->memory('W', SYNTHETIC_SHARED_BASE + (thread->next_random() % lines) * SYNTHETIC_LINE_BYTES, 2);
+        }
+    }
+};
+
+// =============================================================================
+int main(int argc, char **argv) {
+    const char *pattern = NULL;
+    const char *out_base = NULL;
+    uint32_t threads = 0;
+    uint64_t opcodes = 1000000;
+    uint64_t seed = 1;
+
+    argc--;
+    argv++;
+    while (argc > 0) {
+        if (strcmp(*argv, "-pattern") == 0 && argc > 1) {
+            argc--;
+            argv++;
+            pattern = *argv;
+        }
+        else if (strcmp(*argv, "-output") == 0 && argc > 1) {
+            argc--;
+            argv++;
+            out_base = *argv;
+        }
+        else if (strcmp(*argv, "-threads") == 0 && argc > 1) {
+            argc--;
+            argv++;
+            threads = atoi(*argv);
+            if (threads == 0 || threads > SYNTHETIC_MAX_THREADS) {
+                display_use();
+            }
+        }
+        else if (strcmp(*argv, "-opcodes") == 0 && argc > 1) {
+            argc--;
+            argv++;
+            opcodes = strtoull(*argv, NULL, 10);
+            if (opcodes == 0) {
+                display_use();
+            }
+        }
+        else if (strcmp(*argv, "-seed") == 0 && argc > 1) {
+            argc--;
+            argv++;
+            seed = strtoull(*argv, NULL, 10);
+        }
+        else {
+            display_use();
+        }
+        argc--;
+        argv++;
+    }
+
+    if (pattern == NULL || out_base == NULL) {
+        display_use();
+    }
+
+    const char **bbl_lines = NULL;
+    void (*generate)(synthetic_thread_t*, const uint32_t*, uint64_t) = NULL;
+    uint32_t default_threads = 1;
+    if (strcmp(pattern, "pointer_chase") == 0) {
+        bbl_lines = pointer_chase_bbl;
+        generate = pointer_chase;
+    }
+    else if (strcmp(pattern, "stream") == 0) {
+        bbl_lines = stream_bbl;
+        generate = stream;
+    }
+    else if (strcmp(pattern, "compute") == 0) {
+        bbl_lines = compute_bbl;
+        generate = compute;
+    }
+    else if (strcmp(pattern, "locks") == 0) {
+        bbl_lines = locks_bbl;
+        generate = locks;
+        default_threads = 8;
+    }
+    else if (strcmp(pattern, "nuca") == 0) {
+        bbl_lines = nuca_bbl;
+        generate = nuca;
+        default_threads = 8;
+    }
+    else {
+        SYNTHETIC_ERROR("Unknown pattern %s.\n", pattern);
+    }
+    if (threads == 0) {
+        threads = default_threads;
+    }
+
+    uint32_t bbl_size[8];
+    write_static(out_base, bbl_lines, bbl_size);
+
+    for (uint32_t tid = 0; tid < threads; tid++) {
+        synthetic_thread_t thread;
+        thread.dynamic_file = open_output(out_base, tid, "dyn");
+        thread.memory_file = open_output(out_base, tid, "mem");
+        thread.tid = tid;
+        thread.opcodes = 0;
+        /// xorshift never leaves zero
+        thread.random = (seed * 0x9E3779B97F4A7C15ULL) ^ (tid + 1);
+        generate(&thread, bbl_size, opcodes);
+        gzprintf(thread.dynamic_file, "#\n");
+        gzprintf(thread.memory_file, "#\n");
+        gzclose(thread.dynamic_file);
+        gzclose(thread.memory_file);
+    }
+
+    printf("Generated %u thread(s) of %s with %" PRIu64 " opcodes each.\n", threads, pattern, opcodes);
+    return EXIT_SUCCESS;
+};
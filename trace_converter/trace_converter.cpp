@@ -0,0 +1,543 @@
+/*
+ * Copyright (C) 2010~2014  Marco Antonio Zanata Alves
+ *                          (mazalves at inf.ufrgs.br)
+ *                          GPPD - Parallel and Distributed Processing Group
+ *                          Universidade Federal do Rio Grande do Sul
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/// Trace Converter
+// ============================================================================
+ /*! Stand-alone tool which converts the text traces
+  * (<base>.tidN.{stat,dyn,mem}.out.gz) into the binary trace format
+  * described in trace_reader/trace_binary.hpp (<base>.tidN.{stat,dyn,mem}.bin).
+  * With -chunked the dynamic and memory files are written as independent
+  * zlib chunks plus an index, which the simulator can seek and read ahead.
+  */
+#define __STDC_FORMAT_MACROS
+
+#include <sys/stat.h>
+#include <inttypes.h>
+#include <stdint.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+#include "../extra_libs/include/zlib.h"
+#include "../trace_reader/trace_binary.hpp"
+
+#define CONVERTER_LINE_SIZE 512
+#define CONVERTER_FILE_NAME_SIZE 500
+#define CONVERTER_BUFFER_SIZE TRACE_BINARY_CHUNK_RECORDS   /// Records written at once (one chunk when -chunked)
+
+#define CONVERTER_ERROR(...)    {\
+                                    fprintf(stderr, "ERROR: ");\
+                                    fprintf(stderr, __VA_ARGS__);\
+                                    exit(EXIT_FAILURE);\
+                                }
+
+#define CONVERTER_ASSERT(v, ...) if (!(v)) {\
+                                    fprintf(stderr, "ERROR_ASSERT: %s\n", #v);\
+                                    CONVERTER_ERROR(__VA_ARGS__);\
+                                }
+
+// =============================================================================
+static void display_use() {
+    printf("Converts SiNUCA text traces into the binary trace format.\n\n");
+    printf("Usage: sinuca_trace_converter -trace TRACE [OPTIONS]\n");
+    printf("\t TRACE is the base name for the (static, dynamic, memory) text trace files.\n\n");
+    printf(" DESCRIPTION\n");
+    printf("\t -trace      \t FILE          \t Input trace file base name. **Required\n");
+    printf("\t -output     \t FILE          \t Output trace file base name. Default is the input base name.\n");
+    printf("\t -compress   \t LEVEL         \t gzip level from 0 (uncompressed) to 9. Default is 1.\n");
+    printf("\t -chunked    \t               \t Dynamic and memory files in seekable chunks of %u records.\n", TRACE_BINARY_CHUNK_RECORDS);
+    exit(EXIT_FAILURE);
+};
+
+// =============================================================================
+static bool file_exists(const char *file_name) {
+    struct stat st;
+    return (stat(file_name, &st) == 0);
+};
+
+// =============================================================================
+static gzFile open_output(const char *file_name, int compress_level) {
+    char mode[8];
+    /// "T" writes a raw file, without the gzip wrapper
+    if (compress_level == 0) {
+        snprintf(mode, sizeof(mode), "wbT");
+    }
+    else {
+        snprintf(mode, sizeof(mode), "wb%d", compress_level);
+    }
+    gzFile file = gzopen(file_name, mode);
+    CONVERTER_ASSERT(file != NULL, "Could not create the file.\n%s\n", file_name);
+    return file;
+};
+
+// =============================================================================
+static void write_output(gzFile file, const void *buffer, uint64_t size) {
+    if (size == 0) {
+        return;
+    }
+    int bytes = gzwrite(file, buffer, size);
+    CONVERTER_ASSERT(bytes == (int)size, "Could not write %" PRIu64 " bytes.\n", size);
+};
+
+// =============================================================================
+static void fill_header(trace_binary_header_t *header, uint32_t version, uint32_t file_type, uint32_t record_size, uint32_t total_bbls, uint64_t total_records, uint64_t total_opcodes) {
+    memset(header, 0, sizeof(trace_binary_header_t));
+    memcpy(header->magic, TRACE_BINARY_MAGIC, TRACE_BINARY_MAGIC_SIZE);
+    header->version = version;
+    header->file_type = file_type;
+    header->record_size = record_size;
+    header->total_bbls = total_bbls;
+    header->total_records = total_records;
+    header->total_opcodes = total_opcodes;
+};
+
+// =============================================================================
+static void write_header(gzFile file, uint32_t file_type, uint32_t record_size, uint32_t total_bbls, uint64_t total_records, uint64_t total_opcodes) {
+    trace_binary_header_t header;
+    fill_header(&header, TRACE_BINARY_VERSION, file_type, record_size, total_bbls, total_records, total_opcodes);
+    write_output(file, &header, sizeof(header));
+};
+
+// =============================================================================
+/// Chunked files are raw, the compression is done per chunk
+static FILE* open_chunked_output(const char *file_name, uint32_t file_type, uint32_t record_size, uint32_t total_bbls, uint64_t total_records, uint64_t total_opcodes) {
+    trace_binary_header_t header;
+    FILE *file = fopen(file_name, "wb");
+    CONVERTER_ASSERT(file != NULL, "Could not create the file.\n%s\n", file_name);
+    fill_header(&header, TRACE_BINARY_VERSION_CHUNKED, file_type, record_size, total_bbls, total_records, total_opcodes);
+    CONVERTER_ASSERT(fwrite(&header, sizeof(header), 1, file) == 1, "Could not write the header.\n%s\n", file_name);
+    return file;
+};
+
+// =============================================================================
+/// Compress the records into one chunk and add it to the index
+static void write_chunk(FILE *file, int compress_level, const void *records, uint32_t total_records, uint32_t record_size,
+                        uint64_t first_opcode, uint64_t first_memory, std::vector<trace_binary_chunk_t> &chunks) {
+    if (total_records == 0) {
+        return;
+    }
+
+    uLongf compressed_size = compressBound((uLong)total_records * record_size);
+    std::vector<Bytef> compressed(compressed_size);
+    int status = compress2(compressed.data(), &compressed_size, (const Bytef*)records, (uLong)total_records * record_size, compress_level);
+    CONVERTER_ASSERT(status == Z_OK, "Could not compress the chunk (%d).\n", status);
+
+    trace_binary_chunk_t chunk;
+    memset(&chunk, 0, sizeof(chunk));
+    chunk.file_offset = ftell(file);
+    chunk.compressed_size = compressed_size;
+    chunk.total_records = total_records;
+    chunk.first_record = chunks.empty() ? 0 : chunks.back().first_record + chunks.back().total_records;
+    chunk.first_opcode = first_opcode;
+    chunk.first_memory = first_memory;
+    chunks.push_back(chunk);
+
+    CONVERTER_ASSERT(fwrite(compressed.data(), 1, compressed_size, file) == compressed_size, "Could not write %u bytes.\n", (uint32_t)compressed_size);
+};
+
+// =============================================================================
+/// Index and trailer go at the end of the chunked file
+static void close_chunked_output(FILE *file, const std::vector<trace_binary_chunk_t> &chunks) {
+    trace_binary_chunk_trailer_t trailer;
+    trailer.index_offset = ftell(file);
+    trailer.total_chunks = chunks.size();
+    if (!chunks.empty()) {
+        CONVERTER_ASSERT(fwrite(chunks.data(), sizeof(trace_binary_chunk_t), chunks.size(), file) == chunks.size(), "Could not write the chunk index.\n");
+    }
+    CONVERTER_ASSERT(fwrite(&trailer, sizeof(trailer), 1, file) == 1, "Could not write the chunk trailer.\n");
+    fclose(file);
+};
+
+// =============================================================================
+/// Write the buffered records into the gzip stream or as one new chunk
+static void write_records(gzFile gz_file, FILE *chunk_file, int compress_level, const void *records, uint32_t total_records, uint32_t record_size,
+                            uint64_t first_opcode, uint64_t first_memory, std::vector<trace_binary_chunk_t> &chunks) {
+    if (chunk_file != NULL) {
+        write_chunk(chunk_file, compress_level, records, total_records, record_size, first_opcode, first_memory, chunks);
+    }
+    else {
+        write_output(gz_file, records, (uint64_t)total_records * record_size);
+    }
+};
+
+// =============================================================================
+/// Read one line, without the line break. Returns false on EOF.
+static bool read_line(gzFile file, char *line) {
+    if (gzgets(file, line, CONVERTER_LINE_SIZE) == NULL) {
+        return false;
+    }
+    uint32_t size = strlen(line);
+    while (size > 0 && (line[size - 1] == '\n' || line[size - 1] == '\r')) {
+        line[--size] = '\0';
+    }
+    return true;
+};
+
+// =============================================================================
+/// Same fields as opcode_package_t::trace_string_to_opcode
+static void string_to_opcode(char *input_string, trace_binary_opcode_t *record) {
+    char *sub_string = NULL;
+    char *tmp_ptr = NULL;
+    uint32_t sub_fields, i;
+
+    memset(record, 0, sizeof(trace_binary_opcode_t));
+    memset(record->read_regs, -1, sizeof(record->read_regs));
+    memset(record->write_regs, -1, sizeof(record->write_regs));
+
+    #define NEXT_FIELD()    sub_string = strtok_r(sub_string == NULL ? input_string : NULL, " ", &tmp_ptr);\
+                            CONVERTER_ASSERT(sub_string != NULL, "Wrong number of fields in the static trace.\n")
+
+    NEXT_FIELD();
+    strncpy(record->opcode_assembly, sub_string, TRACE_BINARY_ASSEMBLY_SIZE - 1);
+
+    NEXT_FIELD();
+    record->opcode_operation = strtoul(sub_string, NULL, 10);
+    NEXT_FIELD();
+    record->opcode_address = strtoull(sub_string, NULL, 10);
+    NEXT_FIELD();
+    record->opcode_size = strtoul(sub_string, NULL, 10);
+
+    NEXT_FIELD();
+    sub_fields = strtoul(sub_string, NULL, 10);
+    CONVERTER_ASSERT(sub_fields <= TRACE_BINARY_MAX_REGISTERS, "Too many read registers (%u).\n", sub_fields);
+    for (i = 0; i < sub_fields; i++) {
+        NEXT_FIELD();
+        record->read_regs[i] = strtol(sub_string, NULL, 10);
+    }
+
+    NEXT_FIELD();
+    sub_fields = strtoul(sub_string, NULL, 10);
+    CONVERTER_ASSERT(sub_fields <= TRACE_BINARY_MAX_REGISTERS, "Too many write registers (%u).\n", sub_fields);
+    for (i = 0; i < sub_fields; i++) {
+        NEXT_FIELD();
+        record->write_regs[i] = strtol(sub_string, NULL, 10);
+    }
+
+    NEXT_FIELD();
+    record->base_reg = strtoul(sub_string, NULL, 10);
+    NEXT_FIELD();
+    record->index_reg = strtoul(sub_string, NULL, 10);
+
+    NEXT_FIELD();
+    record->flags |= (sub_string[0] == '1') ? TRACE_BINARY_IS_READ : 0;
+    NEXT_FIELD();
+    record->flags |= (sub_string[0] == '1') ? TRACE_BINARY_IS_READ2 : 0;
+    NEXT_FIELD();
+    record->flags |= (sub_string[0] == '1') ? TRACE_BINARY_IS_WRITE : 0;
+    NEXT_FIELD();
+    record->flags |= (sub_string[0] == '1') ? TRACE_BINARY_IS_CONDITIONAL : 0;
+    NEXT_FIELD();
+    record->flags |= (sub_string[0] == '1') ? TRACE_BINARY_IS_PREDICATED : 0;
+    NEXT_FIELD();
+    record->flags |= (sub_string[0] == '1') ? TRACE_BINARY_IS_PREFETCH : 0;
+
+    #undef NEXT_FIELD
+};
+
+// =============================================================================
+/// Static file: the whole dictionary is kept in memory (it is small)
+static void convert_static(const char *in_name, const char *out_name, int compress_level, std::vector<uint32_t> &bbl_size, std::vector<uint32_t> &bbl_memory_size) {
+    std::vector<trace_binary_opcode_t> records;
+    trace_binary_opcode_t record;
+    char line[CONVERTER_LINE_SIZE];
+    uint32_t BBL = 0;
+
+    gzFile in_file = gzopen(in_name, "rb");
+    CONVERTER_ASSERT(in_file != NULL, "Could not open the file.\n%s\n", in_name);
+
+    bbl_size.clear();
+    bbl_size.push_back(0);      /// BBL 0 is never used
+    bbl_memory_size.clear();
+    bbl_memory_size.push_back(0);
+    while (read_line(in_file, line)) {
+        if (line[0] == '\0' || line[0] == '#') {
+            continue;
+        }
+        else if (line[0] == '@') {
+            BBL = strtoul(line + 1, NULL, 10);
+            CONVERTER_ASSERT(BBL == bbl_size.size(), "Expected sequenced BBLs (%u).\n", BBL);
+            bbl_size.push_back(0);
+            bbl_memory_size.push_back(0);
+        }
+        else {
+            CONVERTER_ASSERT(BBL != 0, "Instruction outside a BBL.\n%s\n", line);
+            string_to_opcode(line, &record);
+            CONVERTER_ASSERT(record.opcode_address != 0, "Static trace file generating opcode address equal to zero.\n");
+            records.push_back(record);
+            bbl_size[BBL]++;
+            bbl_memory_size[BBL] += ((record.flags & TRACE_BINARY_IS_READ) != 0) +
+                                    ((record.flags & TRACE_BINARY_IS_READ2) != 0) +
+                                    ((record.flags & TRACE_BINARY_IS_WRITE) != 0);
+        }
+    }
+    gzclose(in_file);
+
+    gzFile out_file = open_output(out_name, compress_level);
+    write_header(out_file, TRACE_BINARY_FILE_STATIC, sizeof(trace_binary_opcode_t), bbl_size.size(), records.size(), records.size());
+    write_output(out_file, &bbl_size[0], sizeof(uint32_t) * bbl_size.size());
+    write_output(out_file, records.data(), sizeof(trace_binary_opcode_t) * records.size());
+    gzclose(out_file);
+
+    printf("%s => %s (%" PRIu64 " BBLs, %" PRIu64 " instructions)\n", in_name, out_name, (uint64_t)bbl_size.size() - 1, (uint64_t)records.size());
+};
+
+// =============================================================================
+/// Returns the dynamic record for one line, or false if the line is ignored
+static bool dynamic_line_to_record(const char *line, uint32_t *record) {
+    if (line[0] == '\0' || line[0] == '#') {
+        return false;
+    }
+    else if (line[0] == '$') {
+        *record = TRACE_BINARY_SYNC_FLAG | (uint32_t)strtoul(line + 1, NULL, 10);
+        return true;
+    }
+    /// BBL is always greater than 0, if strtoul == 0 the line could not be converted.
+    *record = (uint32_t)strtoul(line, NULL, 10);
+    return (*record != 0);
+};
+
+// =============================================================================
+/// Dynamic file: a first pass counts the records and opcodes for the header
+static void convert_dynamic(const char *in_name, const char *out_name, int compress_level, bool chunked,
+                            const std::vector<uint32_t> &bbl_size, const std::vector<uint32_t> &bbl_memory_size) {
+    std::vector<uint32_t> buffer;
+    std::vector<trace_binary_chunk_t> chunks;
+    char line[CONVERTER_LINE_SIZE];
+    uint64_t total_records = 0, total_opcodes = 0;
+    uint64_t opcodes = 0, memory = 0;                   /// Before the actual record
+    uint64_t buffer_opcodes = 0, buffer_memory = 0;     /// Before the first buffered record
+    uint32_t record;
+
+    gzFile in_file = gzopen(in_name, "rb");
+    CONVERTER_ASSERT(in_file != NULL, "Could not open the file.\n%s\n", in_name);
+    while (read_line(in_file, line)) {
+        if (dynamic_line_to_record(line, &record)) {
+            total_records++;
+            if (!(record & TRACE_BINARY_SYNC_FLAG)) {
+                CONVERTER_ASSERT(record < bbl_size.size(), "BBL %u not found in the static trace.\n", record);
+                total_opcodes += bbl_size[record];
+            }
+        }
+    }
+
+    gzFile out_file = NULL;
+    FILE *chunk_file = NULL;
+    if (chunked) {
+        chunk_file = open_chunked_output(out_name, TRACE_BINARY_FILE_DYNAMIC, sizeof(uint32_t), bbl_size.size(), total_records, total_opcodes);
+    }
+    else {
+        out_file = open_output(out_name, compress_level);
+        write_header(out_file, TRACE_BINARY_FILE_DYNAMIC, sizeof(uint32_t), bbl_size.size(), total_records, total_opcodes);
+    }
+
+    gzrewind(in_file);
+    while (read_line(in_file, line)) {
+        if (dynamic_line_to_record(line, &record)) {
+            if (buffer.empty()) {
+                buffer_opcodes = opcodes;
+                buffer_memory = memory;
+            }
+            buffer.push_back(record);
+            if (!(record & TRACE_BINARY_SYNC_FLAG)) {
+                opcodes += bbl_size[record];
+                memory += bbl_memory_size[record];
+            }
+            if (buffer.size() == CONVERTER_BUFFER_SIZE) {
+                write_records(out_file, chunk_file, compress_level, buffer.data(), buffer.size(), sizeof(uint32_t), buffer_opcodes, buffer_memory, chunks);
+                buffer.clear();
+            }
+        }
+    }
+    write_records(out_file, chunk_file, compress_level, buffer.data(), buffer.size(), sizeof(uint32_t), buffer_opcodes, buffer_memory, chunks);
+    if (chunked) {
+        close_chunked_output(chunk_file, chunks);
+    }
+    else {
+        gzclose(out_file);
+    }
+    gzclose(in_file);
+
+    printf("%s => %s (%" PRIu64 " BBLs, %" PRIu64 " opcodes)\n", in_name, out_name, total_records, total_opcodes);
+};
+
+// =============================================================================
+/// Returns the memory record for one line, or false if the line is ignored
+static bool memory_line_to_record(char *line, trace_binary_memory_t *record) {
+    char *sub_string = NULL;
+    char *tmp_ptr = NULL;
+
+    if (line[0] == '\0' || line[0] == '#') {
+        return false;
+    }
+    memset(record, 0, sizeof(trace_binary_memory_t));
+
+    sub_string = strtok_r(line, " ", &tmp_ptr);
+    CONVERTER_ASSERT(sub_string != NULL && (sub_string[0] == 'R' || sub_string[0] == 'W'), "MemoryTraceFile Type (R/W) expected.\n");
+    record->is_write = (sub_string[0] == 'W');
+
+    sub_string = strtok_r(NULL, " ", &tmp_ptr);
+    CONVERTER_ASSERT(sub_string != NULL, "MemoryTraceFile size expected.\n");
+    record->size = strtoul(sub_string, NULL, 10);
+
+    sub_string = strtok_r(NULL, " ", &tmp_ptr);
+    CONVERTER_ASSERT(sub_string != NULL, "MemoryTraceFile address expected.\n");
+    record->address = strtoull(sub_string, NULL, 10);
+
+    sub_string = strtok_r(NULL, " ", &tmp_ptr);
+    CONVERTER_ASSERT(sub_string != NULL, "MemoryTraceFile BBL expected.\n");
+    record->bbl = strtoul(sub_string, NULL, 10);
+    return true;
+};
+
+// =============================================================================
+/// Memory file: a first pass counts the records for the header
+static void convert_memory(const char *in_name, const char *out_name, int compress_level, bool chunked) {
+    std::vector<trace_binary_memory_t> buffer;
+    std::vector<trace_binary_chunk_t> chunks;
+    trace_binary_memory_t record;
+    char line[CONVERTER_LINE_SIZE];
+    uint64_t total_records = 0;
+
+    gzFile in_file = gzopen(in_name, "rb");
+    CONVERTER_ASSERT(in_file != NULL, "Could not open the file.\n%s\n", in_name);
+    while (read_line(in_file, line)) {
+        total_records += (line[0] != '\0' && line[0] != '#');
+    }
+
+    gzFile out_file = NULL;
+    FILE *chunk_file = NULL;
+    if (chunked) {
+        chunk_file = open_chunked_output(out_name, TRACE_BINARY_FILE_MEMORY, sizeof(trace_binary_memory_t), 0, total_records, 0);
+    }
+    else {
+        out_file = open_output(out_name, compress_level);
+        write_header(out_file, TRACE_BINARY_FILE_MEMORY, sizeof(trace_binary_memory_t), 0, total_records, 0);
+    }
+
+    gzrewind(in_file);
+    while (read_line(in_file, line)) {
+        if (memory_line_to_record(line, &record)) {
+            buffer.push_back(record);
+            if (buffer.size() == CONVERTER_BUFFER_SIZE) {
+                write_records(out_file, chunk_file, compress_level, buffer.data(), buffer.size(), sizeof(trace_binary_memory_t), 0, 0, chunks);
+                buffer.clear();
+            }
+        }
+    }
+    write_records(out_file, chunk_file, compress_level, buffer.data(), buffer.size(), sizeof(trace_binary_memory_t), 0, 0, chunks);
+    if (chunked) {
+        close_chunked_output(chunk_file, chunks);
+    }
+    else {
+        gzclose(out_file);
+    }
+    gzclose(in_file);
+
+    printf("%s => %s (%" PRIu64 " operands)\n", in_name, out_name, total_records);
+};
+
+// =============================================================================
+int main(int argc, char **argv) {
+    const char *in_base = NULL;
+    const char *out_base = NULL;
+    int compress_level = 1;
+    bool chunked = false;
+
+    argc--;
+    argv++;
+    while (argc > 0) {
+        if (strcmp(*argv, "-trace") == 0 && argc > 1) {
+            argc--;
+            argv++;
+            in_base = *argv;
+        }
+        else if (strcmp(*argv, "-output") == 0 && argc > 1) {
+            argc--;
+            argv++;
+            out_base = *argv;
+        }
+        else if (strcmp(*argv, "-compress") == 0 && argc > 1) {
+            argc--;
+            argv++;
+            compress_level = atoi(*argv);
+            if (compress_level < 0 || compress_level > 9) {
+                display_use();
+            }
+        }
+        else if (strcmp(*argv, "-chunked") == 0) {
+            chunked = true;
+        }
+        else {
+            display_use();
+        }
+        argc--;
+        argv++;
+    }
+
+    if (in_base == NULL) {
+        display_use();
+    }
+    if (out_base == NULL) {
+        out_base = in_base;
+    }
+
+    char in_name[CONVERTER_FILE_NAME_SIZE];
+    char out_name[CONVERTER_FILE_NAME_SIZE];
+    std::vector<uint32_t> bbl_size;
+    std::vector<uint32_t> bbl_memory_size;
+
+    snprintf(in_name, sizeof(in_name), "%s.tid0.stat.out.gz", in_base);
+    snprintf(out_name, sizeof(out_name), "%s.tid0.stat.bin", out_base);
+    convert_static(in_name, out_name, compress_level, bbl_size, bbl_memory_size);
+
+    /// Threads are numbered sequentially, stop at the first missing dynamic file
+    uint32_t tid;
+    for (tid = 0; ; tid++) {
+        snprintf(in_name, sizeof(in_name), "%s.tid%u.dyn.out.gz", in_base, tid);
+        if (!file_exists(in_name)) {
+            break;
+        }
+        snprintf(out_name, sizeof(out_name), "%s.tid%u.dyn.bin", out_base, tid);
+        convert_dynamic(in_name, out_name, compress_level, chunked, bbl_size, bbl_memory_size);
+
+        snprintf(in_name, sizeof(in_name), "%s.tid%u.mem.out.gz", in_base, tid);
+        snprintf(out_name, sizeof(out_name), "%s.tid%u.mem.bin", out_base, tid);
+        if (file_exists(in_name)) {
+            convert_memory(in_name, out_name, compress_level, chunked);
+        }
+        else if (chunked) {
+            /// Thread without memory operations
+            std::vector<trace_binary_chunk_t> chunks;
+            close_chunked_output(open_chunked_output(out_name, TRACE_BINARY_FILE_MEMORY, sizeof(trace_binary_memory_t), 0, 0, 0), chunks);
+        }
+        else {
+            /// Thread without memory operations
+            gzFile out_file = open_output(out_name, compress_level);
+            write_header(out_file, TRACE_BINARY_FILE_MEMORY, sizeof(trace_binary_memory_t), 0, 0, 0);
+            gzclose(out_file);
+        }
+    }
+    CONVERTER_ASSERT(tid > 0, "No dynamic trace file found for %s\n", in_base);
+
+    printf("Converted %u thread(s).\n", tid);
+    return EXIT_SUCCESS;
+};
@@ -0,0 +1,129 @@
+/*
+ * Copyright (C) 2010~2014  Marco Antonio Zanata Alves
+ *                          (mazalves at inf.ufrgs.br)
+ *                          GPPD - Parallel and Distributed Processing Group
+ *                          Universidade Federal do Rio Grande do Sul
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/// Binary Trace Format
+// ============================================================================
+ /*! Fixed-width packed version of the text traces.
+  * Shared by the trace_reader_t and the stand-alone trace converter.
+  * Every file starts with one trace_binary_header_t followed by records.
+  *
+  * <base>.tid0.stat.bin => header + uint32_t bbl_size[total_bbls] + trace_binary_opcode_t[total_records]
+  * <base>.tidN.dyn.bin  => header + uint32_t[total_records] (BBL number or TRACE_BINARY_SYNC_FLAG | sync_t)
+  * <base>.tidN.mem.bin  => header + trace_binary_memory_t[total_records]
+  *
+  * Files can be stored raw or gzip compressed, gzread handles both.
+  *
+  * Dynamic and memory files can also be chunked (version TRACE_BINARY_VERSION_CHUNKED),
+  * a raw file where the records are split into independent zlib blocks:
+  * <base>.tidN.{dyn,mem}.bin => header + blocks + trace_binary_chunk_t[total_chunks] + trace_binary_chunk_trailer_t
+  * Any block can be inflated alone, allowing read-ahead in other threads
+  * and seeking to any opcode (trace_reader_t::trace_seek).
+  *
+  * All the values are written in the host byte order.
+  */
+#ifndef _SINUCA_TRACE_BINARY_HPP_
+#define _SINUCA_TRACE_BINARY_HPP_
+
+#include <stdint.h>
+
+#define TRACE_BINARY_MAGIC "SiNUCAtr"       /// 8 chars, no '\0' stored
+#define TRACE_BINARY_MAGIC_SIZE 8
+#define TRACE_BINARY_VERSION 1
+#define TRACE_BINARY_VERSION_CHUNKED 2
+#define TRACE_BINARY_CHUNK_RECORDS 65536     /// Records inside each chunk
+
+#define TRACE_BINARY_MAX_REGISTERS 6        /// Must match MAX_REGISTERS
+#define TRACE_BINARY_ASSEMBLY_SIZE 32       /// Must match MAX_ASSEMBLY_SIZE
+
+/// File types
+#define TRACE_BINARY_FILE_STATIC 1
+#define TRACE_BINARY_FILE_DYNAMIC 2
+#define TRACE_BINARY_FILE_MEMORY 3
+
+/// Dynamic records with this bit set carry a sync_t instead of a BBL number
+#define TRACE_BINARY_SYNC_FLAG 0x80000000u
+
+/// Static records flags
+#define TRACE_BINARY_IS_READ        (1u << 0)
+#define TRACE_BINARY_IS_READ2       (1u << 1)
+#define TRACE_BINARY_IS_WRITE       (1u << 2)
+#define TRACE_BINARY_IS_CONDITIONAL (1u << 3)
+#define TRACE_BINARY_IS_PREDICATED  (1u << 4)
+#define TRACE_BINARY_IS_PREFETCH    (1u << 5)
+
+// ============================================================================
+struct trace_binary_header_t {
+    char magic[TRACE_BINARY_MAGIC_SIZE];
+    uint32_t version;
+    uint32_t file_type;
+    uint32_t record_size;       /// sizeof() of each record, to detect layout changes
+    uint32_t total_bbls;        /// Static: BBLs + 1 (BBL 0 is never used)
+    uint64_t total_records;     /// Records after the header
+    uint64_t total_opcodes;     /// Dynamic: opcodes executed by the thread
+};
+
+// ============================================================================
+struct trace_binary_opcode_t {
+    char opcode_assembly[TRACE_BINARY_ASSEMBLY_SIZE];
+    uint64_t opcode_address;
+    uint32_t opcode_operation;
+    uint32_t opcode_size;
+    int32_t read_regs[TRACE_BINARY_MAX_REGISTERS];      /// -1 when not used
+    int32_t write_regs[TRACE_BINARY_MAX_REGISTERS];     /// -1 when not used
+    uint32_t base_reg;
+    uint32_t index_reg;
+    uint32_t flags;
+    uint32_t reserved;
+};
+
+// ============================================================================
+struct trace_binary_memory_t {
+    uint64_t address;
+    uint32_t bbl;               /// Used only to check the trace synchronization
+    uint16_t size;
+    uint8_t is_write;
+    uint8_t reserved;
+};
+
+// ============================================================================
+/// Chunk index entry, one per block
+struct trace_binary_chunk_t {
+    uint64_t file_offset;       /// Position of the zlib block
+    uint32_t compressed_size;
+    uint32_t total_records;     /// Records inside the block
+    uint64_t first_record;      /// Records before the block
+    uint64_t first_opcode;      /// Dynamic: opcodes before the block
+    uint64_t first_memory;      /// Dynamic: memory records before the block
+};
+
+// ============================================================================
+/// Last bytes of a chunked file
+struct trace_binary_chunk_trailer_t {
+    uint64_t index_offset;      /// Position of the trace_binary_chunk_t array
+    uint64_t total_chunks;
+};
+
+static_assert(sizeof(trace_binary_header_t) == 40, "trace_binary_header_t layout changed");
+static_assert(sizeof(trace_binary_opcode_t) == 112, "trace_binary_opcode_t layout changed");
+static_assert(sizeof(trace_binary_memory_t) == 16, "trace_binary_memory_t layout changed");
+static_assert(sizeof(trace_binary_chunk_t) == 40, "trace_binary_chunk_t layout changed");
+static_assert(sizeof(trace_binary_chunk_trailer_t) == 16, "trace_binary_chunk_trailer_t layout changed");
+
+#endif  // _SINUCA_TRACE_BINARY_HPP_
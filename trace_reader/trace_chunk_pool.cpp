@@ -0,0 +1,119 @@
+/*
+ * Copyright (C) 2010~2014  Marco Antonio Zanata Alves
+ *                          (mazalves at inf.ufrgs.br)
+ *                          GPPD - Parallel and Distributed Processing Group
+ *                          Universidade Federal do Rio Grande do Sul
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "../sinuca.hpp"
+
+// =============================================================================
+trace_chunk_pool_t::trace_chunk_pool_t() {
+    this->is_stopping = false;
+};
+
+// =============================================================================
+trace_chunk_pool_t::~trace_chunk_pool_t() {
+    this->stop();
+};
+
+// =============================================================================
+/// One worker per host core, up to TRACE_CHUNK_POOL_THREADS
+void trace_chunk_pool_t::start() {
+    if (!this->workers.empty()) {
+        return;
+    }
+
+    uint32_t threads = std::thread::hardware_concurrency();
+    if (threads == 0) {
+        threads = 1;
+    }
+    if (threads > TRACE_CHUNK_POOL_THREADS) {
+        threads = TRACE_CHUNK_POOL_THREADS;
+    }
+
+    this->is_stopping = false;
+    for (uint32_t i = 0; i < threads; i++) {
+        this->workers.push_back(std::thread(&trace_chunk_pool_t::worker, this));
+    }
+};
+
+// =============================================================================
+/// The queued chunks are still inflated before the workers end
+void trace_chunk_pool_t::stop() {
+    if (this->workers.empty()) {
+        return;
+    }
+
+    std::unique_lock<std::mutex> guard(this->lock);
+    this->is_stopping = true;
+    this->job_queued.notify_all();
+    guard.unlock();
+
+    for (uint32_t i = 0; i < this->workers.size(); i++) {
+        this->workers[i].join();
+    }
+    this->workers.clear();
+};
+
+// =============================================================================
+void trace_chunk_pool_t::worker() {
+    std::unique_lock<std::mutex> guard(this->lock);
+    while (true) {
+        while (this->jobs.empty() && !this->is_stopping) {
+            this->job_queued.wait(guard);
+        }
+        if (this->jobs.empty()) {
+            return;
+        }
+
+        trace_chunk_job_t job = this->jobs.front();
+        this->jobs.pop_front();
+        guard.unlock();
+
+        job.reader->inflate_chunk(job.slot->chunk, job.slot->buffer, job.slot->compressed);
+
+        guard.lock();
+        job.slot->is_busy = false;
+        this->job_done.notify_all();
+    }
+};
+
+// =============================================================================
+/// Without workers (stopped pool) the chunk is inflated by the caller
+void trace_chunk_pool_t::submit(trace_chunk_reader_t *reader, trace_chunk_slot_t *slot) {
+    if (this->workers.empty()) {
+        reader->inflate_chunk(slot->chunk, slot->buffer, slot->compressed);
+        return;
+    }
+
+    trace_chunk_job_t job;
+    job.reader = reader;
+    job.slot = slot;
+
+    std::unique_lock<std::mutex> guard(this->lock);
+    slot->is_busy = true;
+    this->jobs.push_back(job);
+    this->job_queued.notify_one();
+};
+
+// =============================================================================
+void trace_chunk_pool_t::wait(trace_chunk_slot_t *slot) {
+    std::unique_lock<std::mutex> guard(this->lock);
+    while (slot->is_busy) {
+        this->job_done.wait(guard);
+    }
+};
@@ -0,0 +1,86 @@
+/*
+ * Copyright (C) 2010~2014  Marco Antonio Zanata Alves
+ *                          (mazalves at inf.ufrgs.br)
+ *                          GPPD - Parallel and Distributed Processing Group
+ *                          Universidade Federal do Rio Grande do Sul
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/// Trace Chunk Pool
+// ============================================================================
+ /*! Persistent worker threads inflating the chunks read ahead by every
+  * trace_chunk_reader_t of the simulation. Each reader queues its slots
+  * (trace_chunk_slot_t) and waits for them only when the chunk is needed.
+  * The workers are stopped before a fork and started again in the child.
+  */
+#ifndef _SINUCA_TRACE_CHUNK_POOL_HPP_
+#define _SINUCA_TRACE_CHUNK_POOL_HPP_
+
+#define TRACE_CHUNK_POOL_THREADS 4          /// Maximum worker threads
+#define TRACE_CHUNK_SLOT_EMPTY UINT64_MAX   /// Slot without chunk
+
+// ============================================================================
+/// One chunk inflated ahead, the buffers are swapped with the actual chunk
+class trace_chunk_slot_t {
+    public:
+        uint64_t chunk;
+        char *buffer;
+        char *compressed;
+        bool is_busy;                   /// Queued or being inflated, guarded by the pool lock
+
+        trace_chunk_slot_t() {
+            this->chunk = TRACE_CHUNK_SLOT_EMPTY;
+            this->buffer = NULL;
+            this->compressed = NULL;
+            this->is_busy = false;
+        };
+};
+
+// ============================================================================
+class trace_chunk_job_t {
+    public:
+        trace_chunk_reader_t *reader;
+        trace_chunk_slot_t *slot;
+};
+
+// ============================================================================
+class trace_chunk_pool_t {
+    private:
+        std::vector<std::thread> workers;
+        std::mutex lock;
+        std::condition_variable job_queued;
+        std::condition_variable job_done;
+        std::deque<trace_chunk_job_t> jobs;
+        bool is_stopping;
+
+        void worker();
+
+    public:
+        // ====================================================================
+        /// Methods
+        // ====================================================================
+        trace_chunk_pool_t();
+        ~trace_chunk_pool_t();
+        inline const char* get_label() {
+            return "TRACE_CHUNK_POOL";
+        };
+
+        void start();
+        void stop();
+        void submit(trace_chunk_reader_t *reader, trace_chunk_slot_t *slot);
+        void wait(trace_chunk_slot_t *slot);
+};
+
+#endif  // _SINUCA_TRACE_CHUNK_POOL_HPP_
@@ -0,0 +1,256 @@
+/*
+ * Copyright (C) 2010~2014  Marco Antonio Zanata Alves
+ *                          (mazalves at inf.ufrgs.br)
+ *                          GPPD - Parallel and Distributed Processing Group
+ *                          Universidade Federal do Rio Grande do Sul
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "../sinuca.hpp"
+/// Not in sinuca.hpp, fcntl.h defines LOCK_READ/LOCK_WRITE
+#include <fcntl.h>
+#include <unistd.h>
+
+#ifdef TRACE_READER_DEBUG
+    #define TRACE_READER_DEBUG_PRINTF(...) DEBUG_PRINTF(__VA_ARGS__);
+#else
+    #define TRACE_READER_DEBUG_PRINTF(...)
+#endif
+
+// =============================================================================
+trace_chunk_reader_t::trace_chunk_reader_t() {
+    this->file_name[0] = '\0';
+    this->file_descriptor = -1;
+    memset(&this->header, 0, sizeof(trace_binary_header_t));
+
+    this->chunks = NULL;
+    this->total_chunks = 0;
+    this->max_chunk_records = 0;
+    this->max_chunk_size = 0;
+
+    this->actual_chunk = 0;
+    this->actual_record = 0;
+    this->buffer = NULL;
+    this->compressed = NULL;
+
+    this->pool = NULL;
+    this->read_ahead = 0;
+    this->slots = NULL;
+};
+
+// =============================================================================
+trace_chunk_reader_t::~trace_chunk_reader_t() {
+    this->wait_ahead();
+
+    if (this->file_descriptor >= 0) {
+        close(this->file_descriptor);
+    }
+
+    utils_t::template_delete_array<trace_binary_chunk_t>(this->chunks);
+    utils_t::template_delete_array<char>(this->buffer);
+    utils_t::template_delete_array<char>(this->compressed);
+    for (uint32_t i = 0; i < this->read_ahead && this->slots != NULL; i++) {
+        utils_t::template_delete_array<char>(this->slots[i].buffer);
+        utils_t::template_delete_array<char>(this->slots[i].compressed);
+    }
+    utils_t::template_delete_array<trace_chunk_slot_t>(this->slots);
+};
+
+// =============================================================================
+/// The header was already read and validated by the trace_reader_t
+void trace_chunk_reader_t::open(const char *in_file_name, const trace_binary_header_t *in_header, trace_chunk_pool_t *in_pool, uint32_t in_read_ahead) {
+    trace_binary_chunk_trailer_t trailer;
+    struct stat st;
+
+    snprintf(this->file_name, sizeof(this->file_name), "%s", in_file_name);
+    this->header = *in_header;
+    this->pool = in_pool;
+
+    this->file_descriptor = ::open(this->file_name, O_RDONLY);
+    ERROR_ASSERT_PRINTF(this->file_descriptor >= 0, "Could not open the file.\n%s\n", this->file_name);
+    ERROR_ASSERT_PRINTF(fstat(this->file_descriptor, &st) == 0, "Could not stat the file.\n%s\n", this->file_name);
+    ERROR_ASSERT_PRINTF((uint64_t)st.st_size >= sizeof(trace_binary_header_t) + sizeof(trailer), "Chunked trace too small.\n%s\n", this->file_name);
+
+    /// Trailer => Index
+    ssize_t bytes = pread(this->file_descriptor, &trailer, sizeof(trailer), st.st_size - sizeof(trailer));
+    ERROR_ASSERT_PRINTF(bytes == sizeof(trailer), "Chunked trace trailer could not be read.\n%s\n", this->file_name);
+    ERROR_ASSERT_PRINTF(trailer.index_offset + trailer.total_chunks * sizeof(trace_binary_chunk_t) + sizeof(trailer) == (uint64_t)st.st_size,
+                        "Chunked trace index is corrupted.\n%s\n", this->file_name);
+
+    this->total_chunks = trailer.total_chunks;
+    if (this->total_chunks == 0) {
+        return;
+    }
+
+    this->chunks = utils_t::template_allocate_array<trace_binary_chunk_t>(this->total_chunks);
+    bytes = pread(this->file_descriptor, this->chunks, sizeof(trace_binary_chunk_t) * this->total_chunks, trailer.index_offset);
+    ERROR_ASSERT_PRINTF(bytes == (ssize_t)(sizeof(trace_binary_chunk_t) * this->total_chunks), "Chunked trace index could not be read.\n%s\n", this->file_name);
+
+    for (uint64_t i = 0; i < this->total_chunks; i++) {
+        if (this->chunks[i].total_records > this->max_chunk_records) this->max_chunk_records = this->chunks[i].total_records;
+        if (this->chunks[i].compressed_size > this->max_chunk_size) this->max_chunk_size = this->chunks[i].compressed_size;
+    }
+    ERROR_ASSERT_PRINTF(this->max_chunk_records > 0 && this->max_chunk_size > 0, "Chunked trace with empty chunks.\n%s\n", this->file_name);
+
+    this->buffer = utils_t::template_allocate_array<char>(this->max_chunk_records * this->header.record_size);
+    this->compressed = utils_t::template_allocate_array<char>(this->max_chunk_size);
+
+    /// No more slots than chunks to read ahead
+    this->read_ahead = std::min((uint64_t)in_read_ahead, this->total_chunks - 1);
+    if (this->read_ahead != 0) {
+        this->slots = utils_t::template_allocate_array<trace_chunk_slot_t>(this->read_ahead);
+        for (uint32_t i = 0; i < this->read_ahead; i++) {
+            this->slots[i].buffer = utils_t::template_allocate_array<char>(this->max_chunk_records * this->header.record_size);
+            this->slots[i].compressed = utils_t::template_allocate_array<char>(this->max_chunk_size);
+        }
+    }
+
+    this->load_chunk(0);
+    TRACE_READER_DEBUG_PRINTF("Chunked File = %s => %" PRIu64 " chunks\n", this->file_name, this->total_chunks);
+};
+
+// =============================================================================
+/// Read and inflate one chunk, also called by the pool workers
+void trace_chunk_reader_t::inflate_chunk(uint64_t chunk, char *output, char *input) {
+    const trace_binary_chunk_t *entry = &this->chunks[chunk];
+
+    ssize_t bytes = pread(this->file_descriptor, input, entry->compressed_size, entry->file_offset);
+    ERROR_ASSERT_PRINTF(bytes == (ssize_t)entry->compressed_size, "Chunk %" PRIu64 " could not be read.\n%s\n", chunk, this->file_name);
+
+    uLongf output_size = (uLongf)entry->total_records * this->header.record_size;
+    int status = uncompress((Bytef*)output, &output_size, (const Bytef*)input, entry->compressed_size);
+    ERROR_ASSERT_PRINTF(status == Z_OK && output_size == (uLongf)entry->total_records * this->header.record_size,
+                        "Chunk %" PRIu64 " could not be inflated (%d).\n%s\n", chunk, status, this->file_name);
+};
+
+// =============================================================================
+void trace_chunk_reader_t::wait_ahead() {
+    for (uint32_t i = 0; i < this->read_ahead; i++) {
+        this->pool->wait(&this->slots[i]);
+    }
+};
+
+// =============================================================================
+/// Make the chunk the actual one and keep the next read_ahead chunks queued
+void trace_chunk_reader_t::load_chunk(uint64_t chunk) {
+    uint32_t i;
+
+    /// The chunk may be already inflated ahead
+    for (i = 0; i < this->read_ahead; i++) {
+        if (this->slots[i].chunk == chunk) {
+            break;
+        }
+    }
+    if (i < this->read_ahead) {
+        this->pool->wait(&this->slots[i]);
+        std::swap(this->buffer, this->slots[i].buffer);
+        std::swap(this->compressed, this->slots[i].compressed);
+        this->slots[i].chunk = TRACE_CHUNK_SLOT_EMPTY;
+    }
+    else {
+        this->inflate_chunk(chunk, this->buffer, this->compressed);
+    }
+    this->actual_chunk = chunk;
+    this->actual_record = 0;
+
+    /// The workers inflate while the actual chunk is consumed
+    uint64_t last_ahead = std::min(chunk + this->read_ahead, this->total_chunks - 1);
+    for (uint64_t ahead = chunk + 1; ahead <= last_ahead; ahead++) {
+        trace_chunk_slot_t *free_slot = NULL;
+        for (i = 0; i < this->read_ahead; i++) {
+            if (this->slots[i].chunk == ahead) {
+                break;
+            }
+            /// Empty, or left behind by a seek
+            if (free_slot == NULL && (this->slots[i].chunk <= chunk || this->slots[i].chunk > last_ahead)) {
+                free_slot = &this->slots[i];
+            }
+        }
+        if (i < this->read_ahead) {
+            continue;
+        }
+        ERROR_ASSERT_PRINTF(free_slot != NULL, "No free read-ahead slot for chunk %" PRIu64 ".\n%s\n", ahead, this->file_name);
+        this->pool->wait(free_slot);
+        free_slot->chunk = ahead;
+        this->pool->submit(this, free_slot);
+    }
+};
+
+// =============================================================================
+/// Copy up to max_records sequential records, returns 0 on EOF
+uint32_t trace_chunk_reader_t::read(void *records, uint32_t max_records) {
+    if (this->total_chunks == 0) {
+        return 0;
+    }
+
+    if (this->actual_record == this->chunks[this->actual_chunk].total_records) {
+        if (this->actual_chunk + 1 == this->total_chunks) {
+            return 0;
+        }
+        this->load_chunk(this->actual_chunk + 1);
+    }
+
+    uint32_t count = this->chunks[this->actual_chunk].total_records - this->actual_record;
+    if (count > max_records) {
+        count = max_records;
+    }
+    memcpy(records, this->buffer + (uint64_t)this->actual_record * this->header.record_size, (uint64_t)count * this->header.record_size);
+    this->actual_record += count;
+    return count;
+};
+
+// =============================================================================
+/// Next read() starts at the given record
+void trace_chunk_reader_t::seek(uint64_t record) {
+    ERROR_ASSERT_PRINTF(record <= this->header.total_records, "Seek to record %" PRIu64 " beyond the trace.\n%s\n", record, this->file_name);
+    if (this->total_chunks == 0) {
+        return;
+    }
+
+    /// Binary search the last chunk starting before the record
+    uint64_t begin = 0, end = this->total_chunks;
+    while (end - begin > 1) {
+        uint64_t middle = (begin + end) / 2;
+        if (this->chunks[middle].first_record <= record) {
+            begin = middle;
+        }
+        else {
+            end = middle;
+        }
+    }
+
+    if (begin != this->actual_chunk) {
+        this->load_chunk(begin);
+    }
+    this->actual_record = record - this->chunks[begin].first_record;
+};
+
+// =============================================================================
+/// Dynamic files: last chunk starting before the given opcode
+uint64_t trace_chunk_reader_t::find_chunk_opcode(uint64_t opcode) {
+    ERROR_ASSERT_PRINTF(this->total_chunks != 0, "Empty chunked trace.\n%s\n", this->file_name);
+
+    uint64_t begin = 0, end = this->total_chunks;
+    while (end - begin > 1) {
+        uint64_t middle = (begin + end) / 2;
+        if (this->chunks[middle].first_opcode <= opcode) {
+            begin = middle;
+        }
+        else {
+            end = middle;
+        }
+    }
+    return begin;
+};
@@ -0,0 +1,80 @@
+/*
+ * Copyright (C) 2010~2014  Marco Antonio Zanata Alves
+ *                          (mazalves at inf.ufrgs.br)
+ *                          GPPD - Parallel and Distributed Processing Group
+ *                          Universidade Federal do Rio Grande do Sul
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/// Trace Chunk Reader
+// ============================================================================
+ /*! Reads one chunked binary trace file (see trace_binary.hpp).
+  * While the records of one chunk are consumed, the next read_ahead
+  * chunks are inflated by the workers of the trace_chunk_pool_t.
+  */
+#ifndef _SINUCA_TRACE_CHUNK_READER_HPP_
+#define _SINUCA_TRACE_CHUNK_READER_HPP_
+
+class trace_chunk_reader_t {
+    private:
+        char file_name[TRACE_FILE_NAME_SIZE];
+        int file_descriptor;
+        trace_binary_header_t header;
+
+        trace_binary_chunk_t *chunks;
+        uint64_t total_chunks;
+        uint32_t max_chunk_records;     /// Records of the biggest chunk
+        uint32_t max_chunk_size;        /// Compressed size of the biggest chunk
+
+        /// Chunk being consumed
+        uint64_t actual_chunk;
+        uint32_t actual_record;         /// Next record inside the chunk
+        char *buffer;
+        char *compressed;
+
+        /// Chunks being inflated ahead
+        trace_chunk_pool_t *pool;
+        uint32_t read_ahead;
+        trace_chunk_slot_t *slots;
+
+        void load_chunk(uint64_t chunk);
+
+    public:
+        // ====================================================================
+        /// Methods
+        // ====================================================================
+        trace_chunk_reader_t();
+        ~trace_chunk_reader_t();
+        inline const char* get_label() {
+            return "TRACE_CHUNK_READER";
+        };
+
+        void open(const char *in_file_name, const trace_binary_header_t *in_header, trace_chunk_pool_t *in_pool, uint32_t in_read_ahead);
+        void inflate_chunk(uint64_t chunk, char *output, char *input);
+        uint32_t read(void *records, uint32_t max_records);
+        void seek(uint64_t record);
+        void wait_ahead();
+        uint64_t find_chunk_opcode(uint64_t opcode);
+
+        inline const trace_binary_header_t* get_header() {
+            return &this->header;
+        };
+        inline const trace_binary_chunk_t* get_chunk(uint64_t chunk) {
+            return &this->chunks[chunk];
+        };
+        INSTANTIATE_GET_SET(uint64_t, total_chunks);
+};
+
+#endif  // _SINUCA_TRACE_CHUNK_READER_HPP_
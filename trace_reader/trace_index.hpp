@@ -0,0 +1,73 @@
+/*
+ * Copyright (C) 2010~2014  Marco Antonio Zanata Alves
+ *                          (mazalves at inf.ufrgs.br)
+ *                          GPPD - Parallel and Distributed Processing Group
+ *                          Universidade Federal do Rio Grande do Sul
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/// Trace Index
+// ============================================================================
+ /*! Sidecar file of one text dynamic trace, <base>.tidN.dyn.out.gz.idx
+  * Written by the trace_reader_t after the first counting pass, so the
+  * next runs do not need to read the whole dynamic trace at start-up.
+  * The checkpoints position the text traces when restoring a checkpoint.
+  * It is valid only while the size and mtime of the dynamic and static
+  * trace files are the same stored here.
+  *
+  * <base>.tidN.dyn.out.gz.idx => header + trace_index_checkpoint_t[total_checkpoints]
+  *
+  * Binary traces do not use it, their headers already have the counters.
+  * All the values are written in the host byte order.
+  */
+#ifndef _SINUCA_TRACE_INDEX_HPP_
+#define _SINUCA_TRACE_INDEX_HPP_
+
+#include <stdint.h>
+
+#define TRACE_INDEX_MAGIC "SiNUCAix"        /// 8 chars, no '\0' stored
+#define TRACE_INDEX_MAGIC_SIZE 8
+#define TRACE_INDEX_VERSION 1
+
+#define TRACE_INDEX_CHECKPOINT_INTERVAL 1000000  /// Opcodes between two checkpoints
+
+// ============================================================================
+struct trace_index_header_t {
+    char magic[TRACE_INDEX_MAGIC_SIZE];
+    uint32_t version;
+    uint32_t checkpoint_interval;
+    uint64_t dynamic_file_size;
+    int64_t dynamic_file_mtime;
+    uint64_t static_file_size;
+    int64_t static_file_mtime;
+    uint64_t total_opcodes;         /// Opcodes executed by the thread
+    uint64_t total_bbls;            /// BBL records inside the dynamic trace
+    uint64_t total_syncs;           /// Sync records inside the dynamic trace
+    uint64_t total_checkpoints;     /// Records after the header
+};
+
+// ============================================================================
+/// Position of the trace at the beginning of one BBL
+struct trace_index_checkpoint_t {
+    uint64_t opcode;                /// Opcodes before this BBL
+    uint64_t bbl;                   /// BBL records before this BBL
+    uint64_t memory;                /// Memory records before this BBL
+    uint64_t dynamic_offset;        /// Uncompressed offset of the BBL line (gzseek)
+};
+
+static_assert(sizeof(trace_index_header_t) == 80, "trace_index_header_t layout changed");
+static_assert(sizeof(trace_index_checkpoint_t) == 32, "trace_index_checkpoint_t layout changed");
+
+#endif  // _SINUCA_TRACE_INDEX_HPP_
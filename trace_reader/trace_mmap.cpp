@@ -0,0 +1,89 @@
+/*
+ * Copyright (C) 2010~2014  Marco Antonio Zanata Alves
+ *                          (mazalves at inf.ufrgs.br)
+ *                          GPPD - Parallel and Distributed Processing Group
+ *                          Universidade Federal do Rio Grande do Sul
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "../sinuca.hpp"
+/// Not in sinuca.hpp, fcntl.h defines LOCK_READ/LOCK_WRITE
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+
+#ifdef TRACE_READER_DEBUG
+    #define TRACE_READER_DEBUG_PRINTF(...) DEBUG_PRINTF(__VA_ARGS__);
+#else
+    #define TRACE_READER_DEBUG_PRINTF(...)
+#endif
+
+// =============================================================================
+trace_mmap_t::trace_mmap_t() {
+    this->file_name[0] = '\0';
+    this->file_descriptor = -1;
+    this->data = NULL;
+    this->size = 0;
+    this->position = 0;
+};
+
+// =============================================================================
+trace_mmap_t::~trace_mmap_t() {
+    if (this->data != NULL) {
+        munmap((void*)this->data, this->size);
+    }
+    if (this->file_descriptor >= 0) {
+        close(this->file_descriptor);
+    }
+};
+
+// =============================================================================
+/// Returns FAIL when the file is gzip compressed and must be read by zlib
+bool trace_mmap_t::open(const char *in_file_name) {
+    struct stat st;
+
+    snprintf(this->file_name, sizeof(this->file_name), "%s", in_file_name);
+    this->file_descriptor = ::open(this->file_name, O_RDONLY);
+    ERROR_ASSERT_PRINTF(this->file_descriptor >= 0, "Could not open the file.\n%s\n", this->file_name);
+    ERROR_ASSERT_PRINTF(fstat(this->file_descriptor, &st) == 0, "Could not stat the file.\n%s\n", this->file_name);
+    this->size = st.st_size;
+    this->position = 0;
+
+    /// Empty trace, nothing to map
+    if (this->size == 0) {
+        return OK;
+    }
+
+    /// gzip magic number
+    uint8_t magic[2] = {0, 0};
+    if (this->size >= 2 && pread(this->file_descriptor, magic, 2, 0) == 2 && magic[0] == 0x1f && magic[1] == 0x8b) {
+        close(this->file_descriptor);
+        this->file_descriptor = -1;
+        this->size = 0;
+        return FAIL;
+    }
+
+    void *mapping = mmap(NULL, this->size, PROT_READ, MAP_PRIVATE, this->file_descriptor, 0);
+    ERROR_ASSERT_PRINTF(mapping != MAP_FAILED, "Could not map the file.\n%s\n", this->file_name);
+    this->data = (const char*)mapping;
+
+    /// Read-ahead and early release of the consumed pages
+    madvise(mapping, this->size, MADV_SEQUENTIAL);
+    madvise(mapping, this->size, MADV_WILLNEED);
+
+    TRACE_READER_DEBUG_PRINTF("Mapped File = %s => %" PRIu64 " bytes\n", this->file_name, this->size);
+    return OK;
+};
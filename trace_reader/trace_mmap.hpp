@@ -0,0 +1,99 @@
+/*
+ * Copyright (C) 2010~2014  Marco Antonio Zanata Alves
+ *                          (mazalves at inf.ufrgs.br)
+ *                          GPPD - Parallel and Distributed Processing Group
+ *                          Universidade Federal do Rio Grande do Sul
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+/// Trace Memory Map
+// ============================================================================
+ /*! Read-only mapping of one uncompressed trace file (-trace_mmap).
+  * The lines and records are used directly from the mapped pages,
+  * the kernel page cache does the I/O with sequential read-ahead.
+  */
+#ifndef _SINUCA_TRACE_MMAP_HPP_
+#define _SINUCA_TRACE_MMAP_HPP_
+
+class trace_mmap_t {
+    private:
+        char file_name[TRACE_FILE_NAME_SIZE];
+        int file_descriptor;
+        const char *data;
+        uint64_t size;
+        uint64_t position;              /// Next byte to be consumed
+
+    public:
+        // ====================================================================
+        /// Methods
+        // ====================================================================
+        trace_mmap_t();
+        ~trace_mmap_t();
+        inline const char* get_label() {
+            return "TRACE_MMAP";
+        };
+
+        bool open(const char *in_file_name);
+
+        /// Next line without the line break, NULL on EOF
+        inline const char* next_line(const char **line_end) {
+            if (this->position >= this->size) {
+                return NULL;
+            }
+            const char *line = this->data + this->position;
+            const char *end = (const char*)memchr(line, '\n', this->size - this->position);
+            if (end == NULL) {
+                end = this->data + this->size;
+            }
+            this->position = (end - this->data) + 1;
+            *line_end = end;
+            return line;
+        };
+
+        /// Up to max_records fixed size records, *total_records is 0 on EOF
+        inline const void* next_records(uint32_t record_size, uint32_t max_records, uint32_t *total_records) {
+            uint64_t available = (this->size - this->position) / record_size;
+            if (available > max_records) {
+                available = max_records;
+            }
+            const void *records = this->data + this->position;
+            this->position += available * record_size;
+            *total_records = available;
+            return records;
+        };
+
+        /// Parse one unsigned number inside the line, skipping the leading spaces
+        static inline uint64_t parse_uint64(const char **string, const char *end) {
+            const char *actual = *string;
+            uint64_t result = 0;
+            while (actual < end && *actual == ' ') {
+                actual++;
+            }
+            for (; actual < end && (uint8_t)(*actual - '0') <= 9; actual++) {
+                result = result * 10 + (*actual - '0');
+            }
+            *string = actual;
+            return result;
+        };
+
+        inline const char* get_data() {
+            return this->data;
+        };
+        INSTANTIATE_GET_SET(uint64_t, size);
+        INSTANTIATE_GET_SET(uint64_t, position);
+};
+
+#endif  // _SINUCA_TRACE_MMAP_HPP_
@@ -27,16 +27,29 @@
     #define TRACE_READER_DEBUG_PRINTF(...)
 #endif
 
+static_assert(TRACE_BINARY_MAX_REGISTERS == MAX_REGISTERS, "Binary trace and opcode_package_t registers differ");
+static_assert(TRACE_BINARY_ASSEMBLY_SIZE == MAX_ASSEMBLY_SIZE, "Binary trace and opcode_package_t assembly differ");
+
 // =============================================================================
 trace_reader_t::trace_reader_t() {
+    this->trace_format = TRACE_FORMAT_TEXT;
+
     this->gzStaticTraceFile = NULL;
     this->gzDynamicTraceFile = NULL;
     this->gzMemoryTraceFile = NULL;
+    this->chunkDynamicTraceFile = NULL;
+    this->chunkMemoryTraceFile = NULL;
+    this->chunk_pool = NULL;
+    this->mmapStaticTraceFile = NULL;
+    this->mmapDynamicTraceFile = NULL;
+    this->mmapMemoryTraceFile = NULL;
+    this->index_checkpoints = NULL;
 
     this->trace_opcode_total = 0;
 
     this->insideBBL = NULL;
     this->trace_opcode_counter = NULL;
+    this->trace_sync_counter = NULL;
     this->trace_opcode_max = NULL;
 
     this->actual_bbl = NULL;
@@ -44,15 +57,39 @@ trace_reader_t::trace_reader_t() {
 
     this->total_bbls = 0;
     this->bbl_size = NULL;
+    this->bbl_memory_size = NULL;
+    this->static_dict = NULL;
+
+    this->static_file_name = NULL;
+    this->dynamic_file_name = NULL;
+    this->gz_dynamic_file_name = NULL;
+    this->gz_memory_file_name = NULL;
 
     this->line_static = NULL;
     this->line_dynamic = NULL;
     this->line_memory = NULL;
+
+    this->mapped_memory = NULL;
+
+    this->binary_dynamic = NULL;
+    this->binary_dynamic_position = NULL;
+    this->binary_dynamic_count = NULL;
+    this->binary_memory = NULL;
+    this->binary_memory_position = NULL;
+    this->binary_memory_count = NULL;
+
+    this->trace_prefetch_size = 0;
+    this->trace_prefetch_ring = NULL;
+    this->trace_prefetch_thread = NULL;
+    this->trace_prefetch_stop.store(false);
 };
 
 // =============================================================================
 trace_reader_t::~trace_reader_t() {
 
+    /// The prefetch threads still use the files
+    this->stop_trace_prefetch();
+
     /// Close trace files
     if (gzStaticTraceFile != NULL) {
         gzclose(gzStaticTraceFile);
@@ -60,31 +97,68 @@ trace_reader_t::~trace_reader_t() {
 
     if (gzDynamicTraceFile != NULL && gzMemoryTraceFile != NULL) {
         for (uint32_t i = 0; i < this->total_cores; i++) {
-            gzclose(gzDynamicTraceFile[i]);
-            gzclose(gzMemoryTraceFile[i]);
+            /// Binary traces may not have all the thread files
+            if (gzDynamicTraceFile[i] != NULL) {
+                gzclose(gzDynamicTraceFile[i]);
+            }
+            if (gzMemoryTraceFile[i] != NULL) {
+                gzclose(gzMemoryTraceFile[i]);
+            }
+        }
+    }
+
+    if (chunkDynamicTraceFile != NULL && chunkMemoryTraceFile != NULL) {
+        for (uint32_t i = 0; i < this->total_cores; i++) {
+            utils_t::template_delete_variable<trace_chunk_reader_t>(chunkDynamicTraceFile[i]);
+            utils_t::template_delete_variable<trace_chunk_reader_t>(chunkMemoryTraceFile[i]);
         }
     }
+    utils_t::template_delete_array<trace_chunk_reader_t*>(chunkDynamicTraceFile);
+    utils_t::template_delete_array<trace_chunk_reader_t*>(chunkMemoryTraceFile);
+    /// After the readers, which wait for their chunks
+    utils_t::template_delete_variable<trace_chunk_pool_t>(chunk_pool);
+
+    utils_t::template_delete_variable<trace_mmap_t>(mmapStaticTraceFile);
+    if (mmapDynamicTraceFile != NULL && mmapMemoryTraceFile != NULL) {
+        for (uint32_t i = 0; i < this->total_cores; i++) {
+            utils_t::template_delete_variable<trace_mmap_t>(mmapDynamicTraceFile[i]);
+            utils_t::template_delete_variable<trace_mmap_t>(mmapMemoryTraceFile[i]);
+        }
+    }
+    utils_t::template_delete_array<trace_mmap_t*>(mmapDynamicTraceFile);
+    utils_t::template_delete_array<trace_mmap_t*>(mmapMemoryTraceFile);
+    utils_t::template_delete_array<trace_binary_memory_t>(mapped_memory);
 
     /// De-Allocate memory to prevent memory leak
+    utils_t::template_delete_array<char>(static_file_name);
+    utils_t::template_delete_matrix<char>(dynamic_file_name, this->total_cores);
+    utils_t::template_delete_matrix<char>(gz_dynamic_file_name, this->total_cores);
+    utils_t::template_delete_matrix<char>(gz_memory_file_name, this->total_cores);
+
     utils_t::template_delete_array<char>(line_static);
     utils_t::template_delete_matrix<char>(line_dynamic, TRACE_LINE_SIZE);
     utils_t::template_delete_matrix<char>(line_memory, TRACE_LINE_SIZE);
 
+    utils_t::template_delete_matrix<uint32_t>(binary_dynamic, this->total_cores);
+    utils_t::template_delete_array<uint32_t>(binary_dynamic_position);
+    utils_t::template_delete_array<uint32_t>(binary_dynamic_count);
+    utils_t::template_delete_matrix<trace_binary_memory_t>(binary_memory, this->total_cores);
+    utils_t::template_delete_array<uint32_t>(binary_memory_position);
+    utils_t::template_delete_array<uint32_t>(binary_memory_count);
+
     utils_t::template_delete_array<gzFile>(gzDynamicTraceFile);
     utils_t::template_delete_array<gzFile>(gzMemoryTraceFile);
 
     utils_t::template_delete_array<uint32_t>(bbl_size);
+    utils_t::template_delete_array<uint32_t>(bbl_memory_size);
 
-    if (this->total_bbls != 0 && static_dict != NULL ) {
-        for (uint32_t i = 1; i < this->total_bbls; i++) {
-            utils_t::template_delete_array<opcode_package_t>(this->static_dict[i]);
-        }
-    }
-    utils_t::template_delete_array<opcode_package_t*>(static_dict);
+    utils_t::template_delete_variable<trace_static_dict_t>(static_dict);
 
     utils_t::template_delete_array<bool>(insideBBL);
     utils_t::template_delete_array<uint64_t>(trace_opcode_counter);
+    utils_t::template_delete_array<uint32_t>(trace_sync_counter);
     utils_t::template_delete_array<uint64_t>(trace_opcode_max);
+    utils_t::template_delete_array<std::vector<trace_index_checkpoint_t> >(index_checkpoints);
 
     utils_t::template_delete_array<uint32_t>(actual_bbl);
     utils_t::template_delete_array<uint32_t>(actual_bbl_opcode);
@@ -93,7 +167,7 @@ trace_reader_t::~trace_reader_t() {
 
 // =============================================================================
 void trace_reader_t::allocate(char *in_file, uint32_t number_cores) {
-    uint32_t i, k;
+    uint32_t i;
 
     this->total_cores = number_cores;
 
@@ -101,12 +175,90 @@ void trace_reader_t::allocate(char *in_file, uint32_t number_cores) {
     this->line_dynamic = utils_t::template_allocate_matrix<char>(this->total_cores, TRACE_LINE_SIZE);
     this->line_memory = utils_t::template_allocate_matrix<char>(this->total_cores, TRACE_LINE_SIZE);
 
+    this->static_file_name = utils_t::template_allocate_array<char>(TRACE_FILE_NAME_SIZE);
+    this->dynamic_file_name = utils_t::template_allocate_matrix<char>(this->total_cores, TRACE_FILE_NAME_SIZE);
+    this->gz_dynamic_file_name = utils_t::template_allocate_matrix<char>(this->total_cores, TRACE_FILE_NAME_SIZE);
+    this->gz_memory_file_name = utils_t::template_allocate_matrix<char>(this->total_cores, TRACE_FILE_NAME_SIZE);
+
+    this->mmapDynamicTraceFile = utils_t::template_allocate_initialize_array<trace_mmap_t*>(this->total_cores, NULL);
+    this->mmapMemoryTraceFile = utils_t::template_allocate_initialize_array<trace_mmap_t*>(this->total_cores, NULL);
+    this->mapped_memory = utils_t::template_allocate_array<trace_binary_memory_t>(this->total_cores);
+
     this->line_static[0] = '\0';
+    this->static_file_name[0] = '\0';
     for (i = 0; i < this->total_cores; i++) {
         this->line_dynamic[i][0] = '\0';
         this->line_memory[i][0] = '\0';
+        this->dynamic_file_name[i][0] = '\0';
+        this->gz_dynamic_file_name[i][0] = '\0';
+        this->gz_memory_file_name[i][0] = '\0';
+    }
+
+    // =======================================================================
+    // Trace Format
+    // =======================================================================
+    /// Prefer the binary trace when the converted files are available
+    char stat_file_name[500];
+    struct stat st;
+    snprintf(stat_file_name, sizeof(stat_file_name), "%s.tid0.stat.bin", in_file);
+    if (stat(stat_file_name, &st) == 0) {
+        this->trace_format = TRACE_FORMAT_BINARY;
+        this->open_binary_trace(in_file);
+    }
+    else {
+        this->trace_format = TRACE_FORMAT_TEXT;
+        this->open_text_trace(in_file);
+    }
+    TRACE_READER_DEBUG_PRINTF("Trace Format = %s\n", get_enum_trace_format_char(this->trace_format));
+
+    /// Obtain the total of BBLs
+    this->define_total_bbls();
+    this->bbl_size = utils_t::template_allocate_initialize_array<uint32_t>(this->total_bbls, 0);
+    this->define_total_bbl_size();
+
+    /// Allocate only the required space for the static file instructions
+    this->static_dict = new trace_static_dict_t;
+    this->static_dict->allocate(this->total_bbls, this->bbl_size);
+
+    if (this->trace_format == TRACE_FORMAT_BINARY) {
+        this->generate_static_dict_binary();
+    }
+    else {
+        this->generate_static_dict();
+    }
+    this->static_dict->finish();
+
+    /// Memory records of each BBL, to place the index checkpoints and to seek
+    this->bbl_memory_size = utils_t::template_allocate_initialize_array<uint32_t>(this->total_bbls, 0);
+    for (i = 1; i < this->total_bbls; i++) {
+        for (uint32_t j = 0; j < this->bbl_size[i]; j++) {
+            this->bbl_memory_size[i] += this->static_dict->get_memory_operands(i, j);
+        }
+    }
+
+    this->insideBBL = utils_t::template_allocate_initialize_array<bool>(this->total_cores, false);
+    this->trace_opcode_counter = utils_t::template_allocate_initialize_array<uint64_t>(this->total_cores, 1);
+    this->trace_sync_counter = utils_t::template_allocate_initialize_array<uint32_t>(this->total_cores, 0);
+    this->trace_opcode_max = utils_t::template_allocate_array<uint64_t>(this->total_cores);
+    this->index_checkpoints = utils_t::template_allocate_array<std::vector<trace_index_checkpoint_t> >(this->total_cores);
+    for (i = 0; i < this->total_cores; i++) {
+        this->trace_opcode_max[i] = this->trace_size(i);
     }
 
+    this->actual_bbl = utils_t::template_allocate_initialize_array<uint32_t>(this->total_cores, 0);
+    this->actual_bbl_opcode = utils_t::template_allocate_initialize_array<uint32_t>(this->total_cores, 0);
+
+    this->trace_prefetch_size = sinuca_engine.arg_trace_prefetch;
+    if (this->trace_prefetch_size != 0) {
+        this->start_trace_prefetch();
+    }
+};
+
+
+// =============================================================================
+void trace_reader_t::open_text_trace(char *in_file) {
+    uint32_t i, k;
+
     // =======================================================================
     // Static Trace File
     // =======================================================================
@@ -118,6 +270,7 @@ void trace_reader_t::allocate(char *in_file, uint32_t number_cores) {
     snprintf(stat_file_name, sizeof(stat_file_name), "%s.tid0.stat.out.gz", in_file);
     gzStaticTraceFile = gzopen(stat_file_name, "ro");   /// Open the .gz file
     ERROR_ASSERT_PRINTF(gzStaticTraceFile != NULL, "Could not open the file.\n%s\n", stat_file_name);
+    snprintf(this->static_file_name, TRACE_FILE_NAME_SIZE, "%s", stat_file_name);
 
     TRACE_READER_DEBUG_PRINTF("Static File = %s => READY !\n", stat_file_name);
 
@@ -133,6 +286,8 @@ void trace_reader_t::allocate(char *in_file, uint32_t number_cores) {
 
         dyn_file_name[0] = '\0';
         snprintf(dyn_file_name, sizeof(dyn_file_name), "%s.tid%d.dyn.out.gz", in_file, k);
+        /// Only real traces have an index
+        snprintf(this->dynamic_file_name[i], TRACE_FILE_NAME_SIZE, "%s", dyn_file_name);
 
         /// Create missing files in order to run single threaded app into a multi-core
         struct stat st;
@@ -141,6 +296,7 @@ void trace_reader_t::allocate(char *in_file, uint32_t number_cores) {
             WARNING_PRINTF("FILE NOT FOUND %s. ", dyn_file_name);
             snprintf(dyn_file_name, sizeof(dyn_file_name), "/tmp/NULL_tid%d.dyn.out.gz", k);
             WARNING_PRINTF("=> CREATED %s.\n", dyn_file_name);
+            this->dynamic_file_name[i][0] = '\0';
             gzDynamicTraceFile[i] = gzopen(dyn_file_name, "wo");    /// Open the .gz file
             gzwrite(gzDynamicTraceFile[i], "#Empty Trace\n", strlen("#Empty Trace\n"));
             gzclose(gzDynamicTraceFile[i]);
@@ -148,6 +304,10 @@ void trace_reader_t::allocate(char *in_file, uint32_t number_cores) {
 
         gzDynamicTraceFile[i] = gzopen(dyn_file_name, "ro");    /// Open the .gz file
         ERROR_ASSERT_PRINTF(gzDynamicTraceFile[i] != NULL, "Could not open the file.\n%s\n", dyn_file_name);
+        snprintf(this->gz_dynamic_file_name[i], TRACE_FILE_NAME_SIZE, "%s", dyn_file_name);
+        if (this->dynamic_file_name[i][0] != '\0') {
+            this->mmapDynamicTraceFile[i] = this->open_trace_mmap(dyn_file_name);
+        }
         TRACE_READER_DEBUG_PRINTF("Dynamic File = %s => READY !\n", dyn_file_name);
     }
 
@@ -163,11 +323,13 @@ void trace_reader_t::allocate(char *in_file, uint32_t number_cores) {
         k = sinuca_engine.thread_affinity[i];
 
         snprintf(mem_file_name, sizeof(mem_file_name), "%s.tid%d.mem.out.gz", in_file, k);
+        bool placeholder = false;
 
         /// Create missing files in order to run single threaded app into a multi-core
         struct stat st;
         /// file do not exist
         if (stat(mem_file_name, &st) != 0) {
+            placeholder = true;
             WARNING_PRINTF("FILE NOT FOUND %s. ", mem_file_name);
             snprintf(mem_file_name, sizeof(mem_file_name), "/tmp/NULL_tid%d.mem.out.gz", k);
             WARNING_PRINTF("=> CREATED %s.\n", mem_file_name);
@@ -178,31 +340,145 @@ void trace_reader_t::allocate(char *in_file, uint32_t number_cores) {
 
         gzMemoryTraceFile[i] = gzopen(mem_file_name, "ro");     /// Open the .gz file
         ERROR_ASSERT_PRINTF(gzMemoryTraceFile[i] != NULL, "Could not open the file.\n%s\n", mem_file_name);
+        snprintf(this->gz_memory_file_name[i], TRACE_FILE_NAME_SIZE, "%s", mem_file_name);
+        if (!placeholder) {
+            this->mmapMemoryTraceFile[i] = this->open_trace_mmap(mem_file_name);
+        }
         TRACE_READER_DEBUG_PRINTF("Memory File = %s => READY !\n", mem_file_name);
     }
+};
 
-    /// Obtain the total of BBLs
-    this->define_total_bbls();
-    this->bbl_size = utils_t::template_allocate_initialize_array<uint32_t>(this->total_bbls, 0);
-    this->define_total_bbl_size();
+// =============================================================================
+void trace_reader_t::open_binary_trace(char *in_file) {
+    trace_binary_header_t header;
+    uint32_t i, k;
 
-    /// Allocate only the required space for the static file packages
-    this->static_dict = utils_t::template_allocate_initialize_array<opcode_package_t*>(this->total_bbls, NULL);
-    for (i = 1; i < this->total_bbls; i++) {
-        this->static_dict[i] = utils_t::template_allocate_array<opcode_package_t>(this->bbl_size[i]);
-    }
+    // =======================================================================
+    // Static Trace File
+    // =======================================================================
+    char stat_file_name[500];
+    snprintf(stat_file_name, sizeof(stat_file_name), "%s.tid0.stat.bin", in_file);
+    gzStaticTraceFile = gzopen(stat_file_name, "rb");
+    ERROR_ASSERT_PRINTF(gzStaticTraceFile != NULL, "Could not open the file.\n%s\n", stat_file_name);
+    this->mmapStaticTraceFile = this->open_trace_mmap(stat_file_name);
+    TRACE_READER_DEBUG_PRINTF("Static File = %s => READY !\n", stat_file_name);
 
-    this->generate_static_dict();
+    // =======================================================================
+    // Dynamic and Memory Trace Files
+    // =======================================================================
+    /// Missing files are kept as NULL and behave as empty traces
+    char dyn_file_name[500];
+    char mem_file_name[500];
 
-    this->insideBBL = utils_t::template_allocate_initialize_array<bool>(this->total_cores, false);
-    this->trace_opcode_counter = utils_t::template_allocate_initialize_array<uint64_t>(this->total_cores, 1);
-    this->trace_opcode_max = utils_t::template_allocate_array<uint64_t>(this->total_cores);
+    gzDynamicTraceFile = utils_t::template_allocate_initialize_array<gzFile>(this->total_cores, NULL);
+    gzMemoryTraceFile = utils_t::template_allocate_initialize_array<gzFile>(this->total_cores, NULL);
+    chunkDynamicTraceFile = utils_t::template_allocate_initialize_array<trace_chunk_reader_t*>(this->total_cores, NULL);
+    chunkMemoryTraceFile = utils_t::template_allocate_initialize_array<trace_chunk_reader_t*>(this->total_cores, NULL);
     for (i = 0; i < this->total_cores; i++) {
-        this->trace_opcode_max[i] = this->trace_size(i);
+        /// Make the thread affinity
+        k = sinuca_engine.thread_affinity[i];
+
+        snprintf(dyn_file_name, sizeof(dyn_file_name), "%s.tid%d.dyn.bin", in_file, k);
+        snprintf(mem_file_name, sizeof(mem_file_name), "%s.tid%d.mem.bin", in_file, k);
+
+        struct stat st;
+        if (stat(dyn_file_name, &st) != 0) {
+            WARNING_PRINTF("FILE NOT FOUND %s => EMPTY TRACE.\n", dyn_file_name);
+            continue;
+        }
+
+        gzDynamicTraceFile[i] = gzopen(dyn_file_name, "rb");
+        ERROR_ASSERT_PRINTF(gzDynamicTraceFile[i] != NULL, "Could not open the file.\n%s\n", dyn_file_name);
+        snprintf(this->gz_dynamic_file_name[i], TRACE_FILE_NAME_SIZE, "%s", dyn_file_name);
+        this->read_binary_header(gzDynamicTraceFile[i], dyn_file_name, TRACE_BINARY_FILE_DYNAMIC, &header);
+        if (header.version == TRACE_BINARY_VERSION_CHUNKED) {
+            gzclose(gzDynamicTraceFile[i]);
+            gzDynamicTraceFile[i] = NULL;
+            chunkDynamicTraceFile[i] = this->open_trace_chunk(dyn_file_name, &header);
+        }
+        else {
+            this->mmapDynamicTraceFile[i] = this->open_trace_mmap(dyn_file_name);
+            if (this->mmapDynamicTraceFile[i] != NULL) {
+                this->mmapDynamicTraceFile[i]->set_position(sizeof(trace_binary_header_t));
+            }
+        }
+        TRACE_READER_DEBUG_PRINTF("Dynamic File = %s => READY !\n", dyn_file_name);
+
+        gzMemoryTraceFile[i] = gzopen(mem_file_name, "rb");
+        ERROR_ASSERT_PRINTF(gzMemoryTraceFile[i] != NULL, "Could not open the file.\n%s\n", mem_file_name);
+        snprintf(this->gz_memory_file_name[i], TRACE_FILE_NAME_SIZE, "%s", mem_file_name);
+        this->read_binary_header(gzMemoryTraceFile[i], mem_file_name, TRACE_BINARY_FILE_MEMORY, &header);
+        if (header.version == TRACE_BINARY_VERSION_CHUNKED) {
+            gzclose(gzMemoryTraceFile[i]);
+            gzMemoryTraceFile[i] = NULL;
+            chunkMemoryTraceFile[i] = this->open_trace_chunk(mem_file_name, &header);
+        }
+        else {
+            this->mmapMemoryTraceFile[i] = this->open_trace_mmap(mem_file_name);
+            if (this->mmapMemoryTraceFile[i] != NULL) {
+                this->mmapMemoryTraceFile[i]->set_position(sizeof(trace_binary_header_t));
+            }
+        }
+        TRACE_READER_DEBUG_PRINTF("Memory File = %s => READY !\n", mem_file_name);
     }
 
-    this->actual_bbl = utils_t::template_allocate_initialize_array<uint32_t>(this->total_cores, 0);
-    this->actual_bbl_opcode = utils_t::template_allocate_initialize_array<uint32_t>(this->total_cores, 0);
+    this->binary_dynamic = utils_t::template_allocate_matrix<uint32_t>(this->total_cores, TRACE_BINARY_BUFFER_SIZE);
+    this->binary_dynamic_position = utils_t::template_allocate_initialize_array<uint32_t>(this->total_cores, 0);
+    this->binary_dynamic_count = utils_t::template_allocate_initialize_array<uint32_t>(this->total_cores, 0);
+    this->binary_memory = utils_t::template_allocate_matrix<trace_binary_memory_t>(this->total_cores, TRACE_BINARY_BUFFER_SIZE);
+    this->binary_memory_position = utils_t::template_allocate_initialize_array<uint32_t>(this->total_cores, 0);
+    this->binary_memory_count = utils_t::template_allocate_initialize_array<uint32_t>(this->total_cores, 0);
+};
+
+// =============================================================================
+/// Read and validate the header, leaving the file at the first record
+void trace_reader_t::read_binary_header(gzFile file, const char *file_name, uint32_t file_type, trace_binary_header_t *header) {
+    uint32_t record_size = 0;
+    switch (file_type) {
+        case TRACE_BINARY_FILE_STATIC:  record_size = sizeof(trace_binary_opcode_t); break;
+        case TRACE_BINARY_FILE_DYNAMIC: record_size = sizeof(uint32_t); break;
+        case TRACE_BINARY_FILE_MEMORY:  record_size = sizeof(trace_binary_memory_t); break;
+    }
+
+    int bytes = gzread(file, header, sizeof(trace_binary_header_t));
+    ERROR_ASSERT_PRINTF(bytes == sizeof(trace_binary_header_t), "Binary trace header could not be read.\n%s\n", file_name);
+    ERROR_ASSERT_PRINTF(memcmp(header->magic, TRACE_BINARY_MAGIC, TRACE_BINARY_MAGIC_SIZE) == 0, "Not a binary trace file.\n%s\n", file_name);
+    /// Only the dynamic and memory files can be chunked
+    ERROR_ASSERT_PRINTF(header->version == TRACE_BINARY_VERSION ||
+                        (header->version == TRACE_BINARY_VERSION_CHUNKED && file_type != TRACE_BINARY_FILE_STATIC),
+                        "Binary trace version %u, expected %u.\n%s\n", header->version, TRACE_BINARY_VERSION, file_name);
+    ERROR_ASSERT_PRINTF(header->file_type == file_type, "Binary trace file type %u, expected %u.\n%s\n", header->file_type, file_type, file_name);
+    ERROR_ASSERT_PRINTF(header->record_size == record_size, "Binary trace record size %u, expected %u.\n%s\n", header->record_size, record_size, file_name);
+};
+
+// =============================================================================
+/// Map the file when -trace_mmap is set, NULL keeps reading it with zlib
+trace_mmap_t* trace_reader_t::open_trace_mmap(const char *file_name) {
+    if (!sinuca_engine.arg_trace_mmap) {
+        return NULL;
+    }
+
+    trace_mmap_t *mapping = new trace_mmap_t;
+    if (!mapping->open(file_name)) {
+        WARNING_PRINTF("Compressed trace %s => MMAP IGNORED.\n", file_name);
+        utils_t::template_delete_variable<trace_mmap_t>(mapping);
+        return NULL;
+    }
+    TRACE_READER_DEBUG_PRINTF("Mapped File = %s => READY !\n", file_name);
+    return mapping;
+};
+
+// =============================================================================
+/// The worker threads are started with the first chunked file
+trace_chunk_reader_t* trace_reader_t::open_trace_chunk(const char *file_name, const trace_binary_header_t *header) {
+    if (this->chunk_pool == NULL && sinuca_engine.arg_trace_read_ahead != 0) {
+        this->chunk_pool = new trace_chunk_pool_t;
+        this->chunk_pool->start();
+    }
+
+    trace_chunk_reader_t *reader = new trace_chunk_reader_t;
+    reader->open(file_name, header, this->chunk_pool, sinuca_engine.arg_trace_read_ahead);
+    return reader;
 };
 
 
@@ -212,6 +488,16 @@ void trace_reader_t::define_total_bbls() {
     uint32_t BBL = 0;
     this->total_bbls = 0;
 
+    if (this->trace_format == TRACE_FORMAT_BINARY) {
+        trace_binary_header_t header;
+        gzrewind(this->gzStaticTraceFile);
+        this->read_binary_header(this->gzStaticTraceFile, "Static File", TRACE_BINARY_FILE_STATIC, &header);
+        this->total_bbls = header.total_bbls;
+        ERROR_ASSERT_PRINTF(this->total_bbls > 1, "Static File has no BBLs.\n")
+        TRACE_READER_DEBUG_PRINTF("Total of BBLs %u", this->total_bbls);
+        return;
+    }
+
     gzclearerr(this->gzStaticTraceFile);
     gzseek(this->gzStaticTraceFile, 0, SEEK_SET);   /// Go to the Begin of the File
     file_eof = gzeof(this->gzStaticTraceFile);      /// Check is file not EOF
@@ -239,6 +525,14 @@ void trace_reader_t::define_total_bbl_size() {
     bool file_eof = false;
     uint32_t BBL = 0;
 
+    if (this->trace_format == TRACE_FORMAT_BINARY) {
+        /// The BBL sizes come right after the header
+        gzseek(this->gzStaticTraceFile, sizeof(trace_binary_header_t), SEEK_SET);
+        int bytes = gzread(this->gzStaticTraceFile, this->bbl_size, sizeof(uint32_t) * this->total_bbls);
+        ERROR_ASSERT_PRINTF(bytes == (int)(sizeof(uint32_t) * this->total_bbls), "Static File Unexpected EOF.\n")
+        return;
+    }
+
     gzclearerr(this->gzStaticTraceFile);
     gzseek(this->gzStaticTraceFile, 0, SEEK_SET);   /// Go to the Begin of the File
     file_eof = gzeof(this->gzStaticTraceFile);      /// Check is file not EOF
@@ -268,27 +562,382 @@ uint64_t trace_reader_t::trace_size(uint32_t cpuid) {
     uint32_t BBL = 0;
     uint64_t trace_size = 0;
 
+    if (this->trace_format == TRACE_FORMAT_BINARY) {
+        /// The converter already counted the opcodes
+        trace_binary_header_t header;
+        if (this->chunkDynamicTraceFile[cpuid] != NULL) {
+            return this->chunkDynamicTraceFile[cpuid]->get_header()->total_opcodes;
+        }
+        if (this->gzDynamicTraceFile[cpuid] == NULL) {
+            return 0;
+        }
+        gzrewind(this->gzDynamicTraceFile[cpuid]);
+        this->read_binary_header(this->gzDynamicTraceFile[cpuid], "Dynamic File", TRACE_BINARY_FILE_DYNAMIC, &header);
+        return header.total_opcodes;
+    }
+
+    /// A previous run already counted the opcodes
+    std::vector<trace_index_checkpoint_t> &checkpoints = this->index_checkpoints[cpuid];
+    trace_index_header_t index_header;
+    if (this->read_trace_index(cpuid, &index_header, &checkpoints)) {
+        return index_header.total_opcodes;
+    }
+
+    checkpoints.clear();
+    trace_index_checkpoint_t checkpoint;
+    uint64_t next_checkpoint = 0;
+    uint64_t total_bbls = 0;
+    uint64_t total_syncs = 0;
+    uint64_t total_memory = 0;
+
     gzclearerr(this->gzDynamicTraceFile[cpuid]);
     gzseek(this->gzDynamicTraceFile[cpuid], 0, SEEK_SET);   /// Go to the Begin of the File
     file_eof = gzeof(this->gzDynamicTraceFile[cpuid]);      /// Check is file not EOF
     ERROR_ASSERT_PRINTF(!file_eof, "Dynamic File Unexpected EOF.\n")
 
     while (!file_eof) {
+        uint64_t line_offset = gztell(this->gzDynamicTraceFile[cpuid]);
         gzgets(this->gzDynamicTraceFile[cpuid], this->line_dynamic[cpuid], TRACE_LINE_SIZE);
         file_eof = gzeof(this->gzDynamicTraceFile[cpuid]);
 
-        if (this->line_dynamic[cpuid][0] != '\0' && this->line_dynamic[cpuid][0] != '#' && this->line_dynamic[cpuid][0] != '$') {
+        if (this->line_dynamic[cpuid][0] == '$') {
+            total_syncs++;
+        }
+        else if (this->line_dynamic[cpuid][0] != '\0' && this->line_dynamic[cpuid][0] != '#') {
             BBL = (uint32_t)strtoul(this->line_dynamic[cpuid], NULL, 10);
+            if (BBL == 0) {
+                continue;
+            }
+            if (trace_size >= next_checkpoint) {
+                checkpoint.opcode = trace_size;
+                checkpoint.bbl = total_bbls;
+                checkpoint.memory = total_memory;
+                checkpoint.dynamic_offset = line_offset;
+                checkpoints.push_back(checkpoint);
+                next_checkpoint = trace_size + TRACE_INDEX_CHECKPOINT_INTERVAL;
+            }
             trace_size += this->bbl_size[BBL];
+            total_memory += this->bbl_memory_size[BBL];
+            total_bbls++;
         }
     }
 
     gzclearerr(this->gzDynamicTraceFile[cpuid]);            /// Go to the Begin of the File
     gzseek(this->gzDynamicTraceFile[cpuid], 0, SEEK_SET);
 
+    this->fill_trace_index_header(cpuid, &index_header);
+    index_header.total_opcodes = trace_size;
+    index_header.total_bbls = total_bbls;
+    index_header.total_syncs = total_syncs;
+    index_header.total_checkpoints = checkpoints.size();
+    this->write_trace_index(cpuid, &index_header, checkpoints);
+
     return(trace_size);
 };
 
+// =============================================================================
+/// Header identifying the current trace files, without the counters
+void trace_reader_t::fill_trace_index_header(uint32_t cpuid, trace_index_header_t *header) {
+    struct stat st;
+
+    memset(header, 0, sizeof(trace_index_header_t));
+    memcpy(header->magic, TRACE_INDEX_MAGIC, TRACE_INDEX_MAGIC_SIZE);
+    header->version = TRACE_INDEX_VERSION;
+    header->checkpoint_interval = TRACE_INDEX_CHECKPOINT_INTERVAL;
+
+    if (stat(this->dynamic_file_name[cpuid], &st) == 0) {
+        header->dynamic_file_size = st.st_size;
+        header->dynamic_file_mtime = st.st_mtime;
+    }
+    if (stat(this->static_file_name, &st) == 0) {
+        header->static_file_size = st.st_size;
+        header->static_file_mtime = st.st_mtime;
+    }
+};
+
+// =============================================================================
+/// Load the index of the dynamic trace and its checkpoints, if it is still valid
+bool trace_reader_t::read_trace_index(uint32_t cpuid, trace_index_header_t *header, std::vector<trace_index_checkpoint_t> *checkpoints) {
+    char index_file_name[TRACE_FILE_NAME_SIZE];
+    trace_index_header_t expected;
+
+    if (this->dynamic_file_name[cpuid][0] == '\0') {
+        return FAIL;
+    }
+    snprintf(index_file_name, sizeof(index_file_name), "%s.idx", this->dynamic_file_name[cpuid]);
+    FILE *index_file = fopen(index_file_name, "rb");
+    if (index_file == NULL) {
+        return FAIL;
+    }
+    size_t read = fread(header, sizeof(trace_index_header_t), 1, index_file);
+    if (read == 1) {
+        checkpoints->resize(header->total_checkpoints);
+        if (header->total_checkpoints != 0 &&
+        fread(checkpoints->data(), sizeof(trace_index_checkpoint_t), header->total_checkpoints, index_file) != header->total_checkpoints) {
+            read = 0;
+        }
+    }
+    fclose(index_file);
+
+    this->fill_trace_index_header(cpuid, &expected);
+    if (read != 1 ||
+    memcmp(header->magic, expected.magic, TRACE_INDEX_MAGIC_SIZE) != 0 ||
+    header->version != expected.version ||
+    header->checkpoint_interval != expected.checkpoint_interval ||
+    header->dynamic_file_size != expected.dynamic_file_size ||
+    header->dynamic_file_mtime != expected.dynamic_file_mtime ||
+    header->static_file_size != expected.static_file_size ||
+    header->static_file_mtime != expected.static_file_mtime) {
+        WARNING_PRINTF("Outdated trace index %s => IGNORED.\n", index_file_name);
+        checkpoints->clear();
+        return FAIL;
+    }
+
+    TRACE_READER_DEBUG_PRINTF("Index File = %s => %" PRIu64 " opcodes\n", index_file_name, header->total_opcodes);
+    return OK;
+};
+
+// =============================================================================
+/// Save the index next to the dynamic trace, the simulation goes on without it
+void trace_reader_t::write_trace_index(uint32_t cpuid, trace_index_header_t *header, const std::vector<trace_index_checkpoint_t> &checkpoints) {
+    char index_file_name[TRACE_FILE_NAME_SIZE];
+
+    if (this->dynamic_file_name[cpuid][0] == '\0') {
+        return;
+    }
+    snprintf(index_file_name, sizeof(index_file_name), "%s.idx", this->dynamic_file_name[cpuid]);
+    FILE *index_file = fopen(index_file_name, "wb");
+    if (index_file == NULL) {
+        WARNING_PRINTF("Could not create the trace index %s.\n", index_file_name);
+        return;
+    }
+
+    bool written = (fwrite(header, sizeof(trace_index_header_t), 1, index_file) == 1);
+    if (written && !checkpoints.empty()) {
+        written = (fwrite(checkpoints.data(), sizeof(trace_index_checkpoint_t), checkpoints.size(), index_file) == checkpoints.size());
+    }
+    fclose(index_file);
+
+    if (!written) {
+        WARNING_PRINTF("Could not write the trace index %s.\n", index_file_name);
+        remove(index_file_name);
+    }
+};
+
+// =============================================================================
+/// Position a chunked binary trace so the next trace_decode returns the given
+/// opcode (0 is the first one). Sync records before the opcode are skipped.
+/// Must be called while the prefetch threads are stopped.
+void trace_reader_t::trace_seek(uint32_t cpuid, uint64_t opcode) {
+    trace_chunk_reader_t *dynamic_file = this->chunkDynamicTraceFile != NULL ? this->chunkDynamicTraceFile[cpuid] : NULL;
+    trace_chunk_reader_t *memory_file = this->chunkMemoryTraceFile != NULL ? this->chunkMemoryTraceFile[cpuid] : NULL;
+
+    ERROR_ASSERT_PRINTF(this->trace_prefetch_thread == NULL, "Trace seek while the prefetch threads are running.\n");
+    ERROR_ASSERT_PRINTF(dynamic_file != NULL && memory_file != NULL, "Trace seek needs a chunked binary trace - cpu id %d\n", cpuid);
+    ERROR_ASSERT_PRINTF(opcode < dynamic_file->get_header()->total_opcodes,
+                        "Trace seek to opcode %" PRIu64 " beyond the trace - cpu id %d\n", opcode, cpuid);
+
+    /// Start from the chunk containing the opcode
+    const trace_binary_chunk_t *chunk = dynamic_file->get_chunk(dynamic_file->find_chunk_opcode(opcode));
+    uint64_t actual_opcode = chunk->first_opcode;
+    uint64_t actual_memory = chunk->first_memory;
+    dynamic_file->seek(chunk->first_record);
+    this->binary_dynamic_position[cpuid] = 0;
+    this->binary_dynamic_count[cpuid] = 0;
+
+    /// Walk the BBLs until the one containing the opcode
+    uint32_t BBL = 0;
+    while (true) {
+        sync_t sync_found = SYNC_FREE;
+        BBL = this->trace_next_dynamic_binary(cpuid, &sync_found);
+        if (BBL == FAIL) {
+            ERROR_ASSERT_PRINTF(sync_found != SYNC_FREE, "Dynamic File Unexpected EOF while seeking - cpu id %d\n", cpuid);
+            continue;
+        }
+        if (actual_opcode + this->bbl_size[BBL] > opcode) {
+            break;
+        }
+        actual_opcode += this->bbl_size[BBL];
+        actual_memory += this->bbl_memory_size[BBL];
+    }
+
+    this->actual_bbl[cpuid] = BBL;
+    this->actual_bbl_opcode[cpuid] = opcode - actual_opcode;
+    this->insideBBL[cpuid] = true;
+    for (uint32_t i = 0; i < this->actual_bbl_opcode[cpuid]; i++) {
+        actual_memory += this->static_dict->get_memory_operands(BBL, i);
+    }
+
+    memory_file->seek(actual_memory);
+    this->binary_memory_position[cpuid] = 0;
+    this->binary_memory_count[cpuid] = 0;
+
+    this->trace_opcode_counter[cpuid] = opcode + 1;
+    TRACE_READER_DEBUG_PRINTF("cpu[%d] Seek to opcode %" PRIu64 " => BBL %u + %u, memory %" PRIu64 "\n",
+                                cpuid, opcode, BBL, this->actual_bbl_opcode[cpuid], actual_memory);
+};
+
+// =============================================================================
+/// Position the dynamic and memory traces back at the first record.
+/// Must be called while the prefetch threads are stopped.
+void trace_reader_t::trace_rewind(uint32_t cpuid) {
+    ERROR_ASSERT_PRINTF(this->trace_prefetch_thread == NULL, "Trace rewind while the prefetch threads are running.\n");
+
+    if (this->trace_format == TRACE_FORMAT_BINARY) {
+        if (this->chunkDynamicTraceFile[cpuid] != NULL) {
+            this->chunkDynamicTraceFile[cpuid]->seek(0);
+        }
+        else if (this->mmapDynamicTraceFile[cpuid] != NULL) {
+            this->mmapDynamicTraceFile[cpuid]->set_position(sizeof(trace_binary_header_t));
+        }
+        else if (this->gzDynamicTraceFile[cpuid] != NULL) {
+            gzseek(this->gzDynamicTraceFile[cpuid], sizeof(trace_binary_header_t), SEEK_SET);
+        }
+
+        if (this->chunkMemoryTraceFile[cpuid] != NULL) {
+            this->chunkMemoryTraceFile[cpuid]->seek(0);
+        }
+        else if (this->mmapMemoryTraceFile[cpuid] != NULL) {
+            this->mmapMemoryTraceFile[cpuid]->set_position(sizeof(trace_binary_header_t));
+        }
+        else if (this->gzMemoryTraceFile[cpuid] != NULL) {
+            gzseek(this->gzMemoryTraceFile[cpuid], sizeof(trace_binary_header_t), SEEK_SET);
+        }
+
+        this->binary_dynamic_position[cpuid] = 0;
+        this->binary_dynamic_count[cpuid] = 0;
+        this->binary_memory_position[cpuid] = 0;
+        this->binary_memory_count[cpuid] = 0;
+    }
+    else {
+        if (this->mmapDynamicTraceFile[cpuid] != NULL) {
+            this->mmapDynamicTraceFile[cpuid]->set_position(0);
+        }
+        else {
+            gzrewind(this->gzDynamicTraceFile[cpuid]);
+        }
+
+        if (this->mmapMemoryTraceFile[cpuid] != NULL) {
+            this->mmapMemoryTraceFile[cpuid]->set_position(0);
+        }
+        else {
+            gzrewind(this->gzMemoryTraceFile[cpuid]);
+        }
+    }
+
+    this->insideBBL[cpuid] = false;
+    this->actual_bbl[cpuid] = 0;
+    this->actual_bbl_opcode[cpuid] = 0;
+    this->trace_opcode_counter[cpuid] = 1;
+    this->trace_sync_counter[cpuid] = 0;
+};
+
+// =============================================================================
+/// Consume the given opcodes (and the syncs among them) from the beginning of
+/// the trace, then the given syncs. Chunked traces seek, text traces start from
+/// the nearest index checkpoint, the rest is decoded.
+void trace_reader_t::trace_skip(uint32_t cpuid, uint64_t opcodes, uint32_t syncs) {
+    opcode_package_t skipped;
+    uint64_t actual_opcodes = 0;
+
+    this->trace_rewind(cpuid);
+    if (opcodes != 0 && this->chunkDynamicTraceFile != NULL && this->chunkDynamicTraceFile[cpuid] != NULL) {
+        /// Seek to the last opcode, the syncs after it are decoded below
+        this->trace_seek(cpuid, opcodes - 1);
+        actual_opcodes = opcodes - 1;
+    }
+    else if (opcodes != 0 && this->trace_format == TRACE_FORMAT_TEXT) {
+        actual_opcodes = this->trace_seek_index(cpuid, opcodes);
+    }
+
+    while (actual_opcodes < opcodes) {
+        skipped.package_clean();
+        ERROR_ASSERT_PRINTF(this->trace_decode(cpuid, &skipped) == OK,
+                            "Trace over after %" PRIu64 " of %" PRIu64 " opcodes while restoring - cpu id %d\n", actual_opcodes, opcodes, cpuid);
+        if (skipped.sync_type == SYNC_FREE) {
+            actual_opcodes++;
+        }
+    }
+
+    for (uint32_t i = 0; i < syncs; i++) {
+        skipped.package_clean();
+        ERROR_ASSERT_PRINTF(this->trace_decode(cpuid, &skipped) == OK && skipped.sync_type != SYNC_FREE,
+                            "Trace does not match the checkpoint syncs while restoring - cpu id %d\n", cpuid);
+    }
+
+    this->trace_opcode_counter[cpuid] = opcodes + 1;
+    this->trace_sync_counter[cpuid] = syncs;
+};
+
+// =============================================================================
+/// Position a rewound text trace at the last index checkpoint before the given
+/// opcodes: the dynamic trace is seeked to its BBL line and the memory lines of
+/// the previous BBLs are consumed. Returns the opcodes before the checkpoint.
+/// The checkpoint must be before the last opcode, the syncs between the last
+/// opcode and the checkpoint BBL are decoded by trace_skip.
+uint64_t trace_reader_t::trace_seek_index(uint32_t cpuid, uint64_t opcodes) {
+    const std::vector<trace_index_checkpoint_t> &checkpoints = this->index_checkpoints[cpuid];
+
+    /// First checkpoint with opcode >= opcodes, the previous one is used
+    uint32_t begin = 0;
+    uint32_t end = checkpoints.size();
+    while (begin < end) {
+        uint32_t middle = (begin + end) / 2;
+        if (checkpoints[middle].opcode < opcodes) {
+            begin = middle + 1;
+        }
+        else {
+            end = middle;
+        }
+    }
+    if (begin == 0 || checkpoints[begin - 1].opcode == 0) {
+        return 0;
+    }
+    const trace_index_checkpoint_t &checkpoint = checkpoints[begin - 1];
+
+    if (this->mmapDynamicTraceFile[cpuid] != NULL) {
+        this->mmapDynamicTraceFile[cpuid]->set_position(checkpoint.dynamic_offset);
+    }
+    else {
+        ERROR_ASSERT_PRINTF(gzseek(this->gzDynamicTraceFile[cpuid], checkpoint.dynamic_offset, SEEK_SET) == (z_off_t)checkpoint.dynamic_offset,
+                            "Could not seek the dynamic trace while restoring - cpu id %d\n", cpuid);
+    }
+
+    for (uint64_t i = 0; i < checkpoint.memory; i++) {
+        if (this->mmapMemoryTraceFile[cpuid] != NULL) {
+            this->trace_next_memory_mapped(cpuid);
+        }
+        else {
+            this->trace_next_memory(cpuid);
+        }
+    }
+
+    TRACE_READER_DEBUG_PRINTF("cpu[%d] Index checkpoint at opcode %" PRIu64 " => BBL %" PRIu64 ", memory %" PRIu64 "\n",
+                                cpuid, checkpoint.opcode, checkpoint.bbl, checkpoint.memory);
+    return checkpoint.opcode;
+};
+
+// =============================================================================
+/// Only the counters are saved, the trace is the same on restore
+void trace_reader_t::checkpoint(checkpoint_t *checkpoint) {
+    checkpoint->section(this->get_label());
+
+    checkpoint->value(this->trace_opcode_total);
+    checkpoint->check_size(this->total_cores);
+    checkpoint->array(this->trace_opcode_counter, this->total_cores);
+    checkpoint->array(this->trace_sync_counter, this->total_cores);
+
+    if (checkpoint->get_is_restore()) {
+        this->stop_trace_prefetch();
+        for (uint32_t i = 0; i < this->total_cores; i++) {
+            this->trace_skip(i, this->trace_opcode_counter[i] - 1, this->trace_sync_counter[i]);
+        }
+        if (this->trace_prefetch_size != 0) {
+            this->start_trace_prefetch();
+        }
+    }
+};
+
 // =============================================================================
 uint32_t trace_reader_t::trace_next_dynamic(uint32_t cpuid, sync_t *new_sync) {
     uint32_t BBL = 0;
@@ -299,9 +948,29 @@ uint32_t trace_reader_t::trace_next_dynamic(uint32_t cpuid, sync_t *new_sync) {
     bool valid_dynamic = false;
     sync_t &sync_found = *new_sync;
 
+    /// Parse the lines in place
+    if (this->mmapDynamicTraceFile[cpuid] != NULL) {
+        const char *line, *line_end;
+        while ((line = this->mmapDynamicTraceFile[cpuid]->next_line(&line_end)) != NULL) {
+            if (line == line_end || line[0] == '#') {
+                continue;
+            }
+            else if (line[0] == '$') {
+                line++;
+                sync_found = (sync_t)trace_mmap_t::parse_uint64(&line, line_end);
+                return FAIL;
+            }
+            /// BBL is always greater than 0
+            BBL = (uint32_t)trace_mmap_t::parse_uint64(&line, line_end);
+            if (BBL != 0) {
+                return BBL;
+            }
+        }
+        return FAIL;
+    }
+
     while (!valid_dynamic) {
         if (gzeof(this->gzDynamicTraceFile[cpuid])) {
-            sinuca_engine.set_is_processor_trace_eof(cpuid);
             return FAIL;
         }
         gzgets(this->gzDynamicTraceFile[cpuid], this->line_dynamic[cpuid], TRACE_LINE_SIZE);
@@ -327,6 +996,99 @@ uint32_t trace_reader_t::trace_next_dynamic(uint32_t cpuid, sync_t *new_sync) {
     return BBL;
 };
 
+// =============================================================================
+uint32_t trace_reader_t::trace_next_dynamic_binary(uint32_t cpuid, sync_t *new_sync) {
+    uint32_t record;
+
+    if (this->mmapDynamicTraceFile[cpuid] != NULL) {
+        /// Zero copy, the record is used from the mapped file
+        uint32_t total_records;
+        const uint32_t *mapped = (const uint32_t*)this->mmapDynamicTraceFile[cpuid]->next_records(sizeof(uint32_t), 1, &total_records);
+        if (total_records == 0) {
+            return FAIL;
+        }
+        record = *mapped;
+    }
+    else {
+        if (this->binary_dynamic_position[cpuid] == this->binary_dynamic_count[cpuid]) {
+            int bytes = 0;
+            if (this->chunkDynamicTraceFile[cpuid] != NULL) {
+                bytes = sizeof(uint32_t) * this->chunkDynamicTraceFile[cpuid]->read(this->binary_dynamic[cpuid], TRACE_BINARY_BUFFER_SIZE);
+            }
+            else if (this->gzDynamicTraceFile[cpuid] != NULL) {
+                bytes = gzread(this->gzDynamicTraceFile[cpuid], this->binary_dynamic[cpuid], sizeof(uint32_t) * TRACE_BINARY_BUFFER_SIZE);
+                ERROR_ASSERT_PRINTF(bytes >= 0 && bytes % sizeof(uint32_t) == 0, "DynamicTraceFile read error - cpu id %d\n", cpuid);
+            }
+            this->binary_dynamic_position[cpuid] = 0;
+            this->binary_dynamic_count[cpuid] = bytes / sizeof(uint32_t);
+
+            if (this->binary_dynamic_count[cpuid] == 0) {
+                return FAIL;
+            }
+        }
+        record = this->binary_dynamic[cpuid][this->binary_dynamic_position[cpuid]++];
+    }
+
+    if (record & TRACE_BINARY_SYNC_FLAG) {
+        *new_sync = (sync_t)(record & ~TRACE_BINARY_SYNC_FLAG);
+        return FAIL;
+    }
+
+    TRACE_READER_DEBUG_PRINTF("cpu[%d] BBL = %u\n", cpuid, record);
+    ERROR_ASSERT_PRINTF(record != 0, "BBL zero inside the binary dynamic trace - cpu id %d\n", cpuid);
+    return record;
+};
+
+// =============================================================================
+const trace_binary_memory_t* trace_reader_t::trace_next_memory_binary(uint32_t cpuid) {
+    if (this->mmapMemoryTraceFile[cpuid] != NULL) {
+        /// Zero copy, the record is used from the mapped file
+        uint32_t total_records;
+        const trace_binary_memory_t *mapped = (const trace_binary_memory_t*)this->mmapMemoryTraceFile[cpuid]->next_records(sizeof(trace_binary_memory_t), 1, &total_records);
+        ERROR_ASSERT_PRINTF(total_records == 1, "MemoryTraceFile EOF - cpu id %d\n", cpuid);
+        return mapped;
+    }
+
+    if (this->binary_memory_position[cpuid] == this->binary_memory_count[cpuid]) {
+        int bytes = 0;
+        if (this->chunkMemoryTraceFile[cpuid] != NULL) {
+            bytes = sizeof(trace_binary_memory_t) * this->chunkMemoryTraceFile[cpuid]->read(this->binary_memory[cpuid], TRACE_BINARY_BUFFER_SIZE);
+        }
+        else {
+            ERROR_ASSERT_PRINTF(this->gzMemoryTraceFile[cpuid] != NULL, "MemoryTraceFile EOF - cpu id %d\n", cpuid);
+            bytes = gzread(this->gzMemoryTraceFile[cpuid], this->binary_memory[cpuid], sizeof(trace_binary_memory_t) * TRACE_BINARY_BUFFER_SIZE);
+        }
+        ERROR_ASSERT_PRINTF(bytes > 0 && bytes % sizeof(trace_binary_memory_t) == 0, "MemoryTraceFile EOF - cpu id %d\n", cpuid);
+        this->binary_memory_position[cpuid] = 0;
+        this->binary_memory_count[cpuid] = bytes / sizeof(trace_binary_memory_t);
+    }
+    return &this->binary_memory[cpuid][this->binary_memory_position[cpuid]++];
+};
+
+// =============================================================================
+/// Parse the next text memory line in place, without copying it to line_memory
+const trace_binary_memory_t* trace_reader_t::trace_next_memory_mapped(uint32_t cpuid) {
+    trace_binary_memory_t *record = &this->mapped_memory[cpuid];
+    const char *line, *line_end;
+
+    while (true) {
+        line = this->mmapMemoryTraceFile[cpuid]->next_line(&line_end);
+        ERROR_ASSERT_PRINTF(line != NULL, "MemoryTraceFile EOF - cpu id %d\n", cpuid);
+        if (line != line_end && line[0] != '#') {
+            break;
+        }
+    }
+
+    ERROR_ASSERT_PRINTF(line_end - line > 1 && (line[0] == 'R' || line[0] == 'W') && line[1] == ' ',
+                        "MemoryTraceFile Type (R/W) expected - cpu id %d\n", cpuid);
+    record->is_write = (line[0] == 'W');
+    line++;
+    record->size = trace_mmap_t::parse_uint64(&line, line_end);
+    record->address = trace_mmap_t::parse_uint64(&line, line_end);
+    record->bbl = trace_mmap_t::parse_uint64(&line, line_end);
+    return record;
+};
+
 // =============================================================================
 void trace_reader_t::trace_next_memory(uint32_t cpuid) {
     bool valid_memory = false;
@@ -345,42 +1107,29 @@ void trace_reader_t::trace_next_memory(uint32_t cpuid) {
 };
 
 // =============================================================================
-bool trace_reader_t::trace_fetch(uint32_t cpuid, opcode_package_t *m) {
-    opcode_package_t NewOpcode;
+/// Decode the next opcode of the thread, without touching the simulation state.
+/// Called by the simulation thread or by the prefetch thread of the core.
+/// Returns FAIL when the trace is over, sync_type is set when a sync was found.
+bool trace_reader_t::trace_decode(uint32_t cpuid, opcode_package_t *m) {
     sync_t sync_found = SYNC_FREE;
 
-    /// Spawn Warmup
-    if (trace_opcode_total == sinuca_engine.arg_warmup_instructions) {
-        /// Next cycle all the statistics will be reset
-        sinuca_engine.set_is_warmup(true);
-    }
-
-    /// Spawn Stopat
-    if (sinuca_engine.arg_stopat_instructions != 0 && trace_opcode_total == sinuca_engine.arg_stopat_instructions) {
-        /// All the cores will achieve the EOF
-        sinuca_engine.set_is_processor_trace_eof(cpuid);
-        return FAIL;
-    }
-
-    this->trace_opcode_total++;
-
-
     // =========================================================================
     /// Fetch new BBL inside the dynamic file.
     // =========================================================================
     if (!this->insideBBL[cpuid]) {
-        uint32_t new_BBL = this->trace_next_dynamic(cpuid, &sync_found);
+        uint32_t new_BBL;
+        if (this->trace_format == TRACE_FORMAT_BINARY) {
+            new_BBL = this->trace_next_dynamic_binary(cpuid, &sync_found);
+        }
+        else {
+            new_BBL = this->trace_next_dynamic(cpuid, &sync_found);
+        }
         if (new_BBL == FAIL) {
             if (sync_found == SYNC_FREE) {      /// EOF
                 return FAIL;
             }
             else {                              /// SYNC
-                /// SINUCA control variables.
                 m->opcode_operation = INSTRUCTION_OPERATION_NOP;
-                m->state = PACKAGE_STATE_UNTREATED;
-                m->born_cycle = sinuca_engine.get_global_cycle();
-                m->ready_cycle = sinuca_engine.get_global_cycle();
-                m->opcode_number = trace_opcode_counter[cpuid];
                 m->sync_type = sync_found;
                 return OK;
             }
@@ -402,49 +1151,230 @@ bool trace_reader_t::trace_fetch(uint32_t cpuid, opcode_package_t *m) {
     /// Fetch new INSTRUCTION inside the static file.
     // =========================================================================
     ERROR_ASSERT_PRINTF(this->actual_bbl[cpuid] != 0, "First BBL from the dynamic trace file should be zero.\n");
-    NewOpcode = this->static_dict[this->actual_bbl[cpuid]][this->actual_bbl_opcode[cpuid]];
-    // ~ printf("CPU:%u  BBL:%u  OPCODE:%u = %s\n",cpuid, this->actual_bbl[cpuid], this->actual_bbl_opcode[cpuid], NewOpcode.content_to_string().c_str());
+    this->static_dict->fill_opcode(this->actual_bbl[cpuid], this->actual_bbl_opcode[cpuid], m);
+    // ~ printf("CPU:%u  BBL:%u  OPCODE:%u = %s\n",cpuid, this->actual_bbl[cpuid], this->actual_bbl_opcode[cpuid], m->content_to_string().c_str());
 
     this->actual_bbl_opcode[cpuid]++;
     if (this->actual_bbl_opcode[cpuid] >= this->bbl_size[this->actual_bbl[cpuid]]) {
         this->insideBBL[cpuid] = false;
         this->actual_bbl_opcode[cpuid] = 0;
     }
+    m->sync_type = sync_found;
+
+    // =========================================================================
+    /// If it is LOAD/STORE -> Fetch new MEMORY inside the memory file
+    // =========================================================================
+    if (this->trace_format == TRACE_FORMAT_BINARY) {
+        if (m->is_read) {
+            m->trace_binary_to_read(this->trace_next_memory_binary(cpuid), this->actual_bbl[cpuid]);
+        }
+
+        if (m->is_read2) {
+            m->trace_binary_to_read2(this->trace_next_memory_binary(cpuid), this->actual_bbl[cpuid]);
+        }
+
+        if (m->is_write) {
+            m->trace_binary_to_write(this->trace_next_memory_binary(cpuid), this->actual_bbl[cpuid]);
+        }
+    }
+    else if (this->mmapMemoryTraceFile[cpuid] != NULL) {
+        if (m->is_read) {
+            m->trace_binary_to_read(this->trace_next_memory_mapped(cpuid), this->actual_bbl[cpuid]);
+        }
+
+        if (m->is_read2) {
+            m->trace_binary_to_read2(this->trace_next_memory_mapped(cpuid), this->actual_bbl[cpuid]);
+        }
+
+        if (m->is_write) {
+            m->trace_binary_to_write(this->trace_next_memory_mapped(cpuid), this->actual_bbl[cpuid]);
+        }
+    }
+    else {
+        if (m->is_read) {
+            this->trace_next_memory(cpuid);
+            m->trace_string_to_read(this->line_memory[cpuid], this->actual_bbl[cpuid]);
+        }
+
+        if (m->is_read2) {
+            this->trace_next_memory(cpuid);
+            m->trace_string_to_read2(this->line_memory[cpuid], this->actual_bbl[cpuid]);
+        }
+
+        if (m->is_write) {
+            this->trace_next_memory(cpuid);
+            m->trace_string_to_write(this->line_memory[cpuid], this->actual_bbl[cpuid]);
+        }
+    }
+
+    TRACE_READER_DEBUG_PRINTF("CPU[%d] Found Operation [%s]. Found Memory [%s].\n", cpuid, m->content_to_string().c_str(), this->line_memory[cpuid]);
+    return OK;
+};
+
+// =============================================================================
+bool trace_reader_t::trace_fetch(uint32_t cpuid, opcode_package_t *m) {
+    /// Spawn Warmup
+    if (trace_opcode_total == sinuca_engine.arg_warmup_instructions) {
+        /// Next cycle all the statistics will be reset
+        sinuca_engine.set_is_warmup(true);
+    }
+
+    /// Spawn Stopat
+    if (sinuca_engine.arg_stopat_instructions != 0 && trace_opcode_total == sinuca_engine.arg_stopat_instructions) {
+        /// All the cores will achieve the EOF
+        sinuca_engine.set_is_processor_trace_eof(cpuid);
+        return FAIL;
+    }
+
+    this->trace_opcode_total++;
+
+    // =========================================================================
+    /// Obtain the decoded opcode
+    // =========================================================================
+    bool valid_opcode;
+    if (this->trace_prefetch_size != 0) {
+        trace_ring_entry_t *entry = this->trace_prefetch_ring[cpuid]->front();
+        while (entry == NULL) {
+            /// The prefetch thread is behind the simulation
+            std::this_thread::yield();
+            entry = this->trace_prefetch_ring[cpuid]->front();
+        }
+        valid_opcode = !entry->is_eof;
+        if (valid_opcode) {
+            *m = entry->opcode;
+            /// The EOF entry is kept, any later fetch also finds the EOF
+            this->trace_prefetch_ring[cpuid]->pop_front();
+        }
+    }
+    else {
+        valid_opcode = this->trace_decode(cpuid, m);
+    }
+
+    if (!valid_opcode) {
+        sinuca_engine.set_is_processor_trace_eof(cpuid);
+        return FAIL;
+    }
 
     // =========================================================================
     /// Add SiNUCA information
     // =========================================================================
-    *m = NewOpcode;
     /// SINUCA control variables.
     m->state = PACKAGE_STATE_UNTREATED;
     m->born_cycle = sinuca_engine.get_global_cycle();
     m->ready_cycle = sinuca_engine.get_global_cycle();
     m->opcode_number = trace_opcode_counter[cpuid];
-    m->sync_type = sync_found;
-    this->trace_opcode_counter[cpuid]++;
+    if (m->sync_type == SYNC_FREE) {
+        this->trace_opcode_counter[cpuid]++;
+        this->trace_sync_counter[cpuid] = 0;
+    }
+    else {
+        this->trace_sync_counter[cpuid]++;
+    }
+    return OK;
+};
 
-    // =========================================================================
-    /// If it is LOAD/STORE -> Fetch new MEMORY inside the memory file
-    // =========================================================================
-    if (m->is_read) {
-        this->trace_next_memory(cpuid);
-        m->trace_string_to_read(this->line_memory[cpuid], this->actual_bbl[cpuid]);
+// =============================================================================
+/// The threads do not exist in a forked process, the pool workers end after
+/// inflating the queued chunks and are started again by reopen_trace_files
+void trace_reader_t::prepare_fork() {
+    ERROR_ASSERT_PRINTF(this->trace_prefetch_thread == NULL, "Fork while the prefetch threads are running.\n");
+    if (this->chunk_pool != NULL) {
+        this->chunk_pool->stop();
     }
+};
 
-    if (m->is_read2) {
-        this->trace_next_memory(cpuid);
-        m->trace_string_to_read2(this->line_memory[cpuid], this->actual_bbl[cpuid]);
+// =============================================================================
+/// A forked process shares the file offsets with its parent and siblings, so
+/// each gzFile is opened again at the same uncompressed position. The mapped
+/// and chunked files are read without moving the offsets, the chunk pool
+/// workers are started again.
+void trace_reader_t::reopen_trace_files() {
+    for (uint32_t i = 0; i < this->total_cores; i++) {
+        gzFile *files[2] = { &this->gzDynamicTraceFile[i], &this->gzMemoryTraceFile[i] };
+        const char *names[2] = { this->gz_dynamic_file_name[i], this->gz_memory_file_name[i] };
+        for (uint32_t j = 0; j < 2; j++) {
+            if (*files[j] == NULL) {
+                continue;
+            }
+            z_off_t position = gztell(*files[j]);
+            gzclose(*files[j]);
+            *files[j] = gzopen(names[j], "rb");
+            ERROR_ASSERT_PRINTF(*files[j] != NULL, "Could not open the file.\n%s\n", names[j]);
+            ERROR_ASSERT_PRINTF(gzseek(*files[j], position, SEEK_SET) == position, "Could not seek the file.\n%s\n", names[j]);
+        }
     }
 
-    if (m->is_write) {
-        this->trace_next_memory(cpuid);
-        m->trace_string_to_write(this->line_memory[cpuid], this->actual_bbl[cpuid]);
+    if (this->chunk_pool != NULL) {
+        this->chunk_pool->start();
+    }
+};
+
+// =============================================================================
+/// Start one thread per core decoding the trace ahead of trace_fetch
+void trace_reader_t::start_trace_prefetch() {
+    this->trace_prefetch_stop.store(false);
+    this->trace_prefetch_ring = utils_t::template_allocate_initialize_array<trace_ring_t*>(this->total_cores, NULL);
+    for (uint32_t i = 0; i < this->total_cores; i++) {
+        this->trace_prefetch_ring[i] = new trace_ring_t;
+        this->trace_prefetch_ring[i]->allocate(this->trace_prefetch_size);
     }
 
+    this->trace_prefetch_thread = utils_t::template_allocate_array<std::thread>(this->total_cores);
+    for (uint32_t i = 0; i < this->total_cores; i++) {
+        this->trace_prefetch_thread[i] = std::thread(&trace_reader_t::trace_prefetch, this, i);
+    }
+    TRACE_READER_DEBUG_PRINTF("Trace Prefetch = %u threads with %u opcodes each.\n", this->total_cores, this->trace_prefetch_size);
+};
 
+// =============================================================================
+void trace_reader_t::stop_trace_prefetch() {
+    if (this->trace_prefetch_thread == NULL) {
+        return;
+    }
 
-    TRACE_READER_DEBUG_PRINTF("CPU[%d] Found Operation [%s]. Found Memory [%s].\n", cpuid, m->content_to_string().c_str(), this->line_memory[cpuid]);
-    return OK;
+    this->trace_prefetch_stop.store(true);
+    for (uint32_t i = 0; i < this->total_cores; i++) {
+        if (!this->trace_prefetch_thread[i].joinable()) {
+            continue;
+        }
+        /// exit() may be called by a prefetch thread itself (ERROR_PRINTF)
+        if (this->trace_prefetch_thread[i].get_id() == std::this_thread::get_id()) {
+            this->trace_prefetch_thread[i].detach();
+        }
+        else {
+            this->trace_prefetch_thread[i].join();
+        }
+    }
+    utils_t::template_delete_array<std::thread>(this->trace_prefetch_thread);
+    this->trace_prefetch_thread = NULL;
+
+    for (uint32_t i = 0; i < this->total_cores; i++) {
+        utils_t::template_delete_variable<trace_ring_t>(this->trace_prefetch_ring[i]);
+    }
+    utils_t::template_delete_array<trace_ring_t*>(this->trace_prefetch_ring);
+    this->trace_prefetch_ring = NULL;
+};
+
+// =============================================================================
+/// Body of the prefetch thread, it owns all the decoding state of the core
+void trace_reader_t::trace_prefetch(uint32_t cpuid) {
+    trace_ring_t *ring = this->trace_prefetch_ring[cpuid];
+
+    while (!this->trace_prefetch_stop.load(std::memory_order_relaxed)) {
+        trace_ring_entry_t *entry = ring->back();
+        if (entry == NULL) {
+            /// Ring is full, the simulation is behind
+            std::this_thread::sleep_for(std::chrono::microseconds(TRACE_PREFETCH_SLEEP_US));
+            continue;
+        }
+
+        entry->opcode.package_clean();
+        entry->is_eof = !this->trace_decode(cpuid, &entry->opcode);
+        ring->push_back();
+        if (entry->is_eof) {
+            return;
+        }
+    }
 };
 
 // =============================================================================
@@ -477,13 +1407,54 @@ void trace_reader_t::generate_static_dict() {
         else {                                                  /// If Inside BBL
             NewOpcode.trace_string_to_opcode(this->line_static);
             ERROR_ASSERT_PRINTF(NewOpcode.opcode_address != 0, "Static trace file generating opcode address equal to zero.\n")
-            this->static_dict[BBL][opcode++] = NewOpcode;                 /// Save the new opcode
+            this->static_dict->set_opcode(BBL, opcode++, &NewOpcode);     /// Save the new opcode
         }
     }
 
     this->check_static_dict();
 };
 
+// =============================================================================
+void trace_reader_t::generate_static_dict_binary() {
+    trace_binary_opcode_t *records;
+    opcode_package_t NewOpcode;
+    uint32_t BBL;
+
+    /// The instructions come after the header and the BBL sizes, in BBL order
+    gzseek(this->gzStaticTraceFile, sizeof(trace_binary_header_t) + sizeof(uint32_t) * this->total_bbls, SEEK_SET);
+
+    if (this->mmapStaticTraceFile != NULL) {
+        this->mmapStaticTraceFile->set_position(sizeof(trace_binary_header_t) + sizeof(uint32_t) * this->total_bbls);
+    }
+
+    for (BBL = 1; BBL < this->total_bbls; BBL++) {
+        ERROR_ASSERT_PRINTF(this->bbl_size[BBL] != 0, "BBL[%d] has no instruction inside.\n", BBL);
+
+        if (this->mmapStaticTraceFile != NULL) {
+            /// Zero copy, the records are converted from the mapped file
+            uint32_t total_records;
+            const trace_binary_opcode_t *mapped = (const trace_binary_opcode_t*)this->mmapStaticTraceFile->next_records(sizeof(trace_binary_opcode_t), this->bbl_size[BBL], &total_records);
+            ERROR_ASSERT_PRINTF(total_records == this->bbl_size[BBL], "Static File Smaller than StaticDict.\n")
+            for (uint32_t opcode = 0; opcode < this->bbl_size[BBL]; opcode++) {
+                NewOpcode.trace_binary_to_opcode(&mapped[opcode]);
+                ERROR_ASSERT_PRINTF(NewOpcode.opcode_address != 0, "Static trace file generating opcode address equal to zero.\n")
+                this->static_dict->set_opcode(BBL, opcode, &NewOpcode);
+            }
+            continue;
+        }
+
+        records = utils_t::template_allocate_array<trace_binary_opcode_t>(this->bbl_size[BBL]);
+        int bytes = gzread(this->gzStaticTraceFile, records, sizeof(trace_binary_opcode_t) * this->bbl_size[BBL]);
+        ERROR_ASSERT_PRINTF(bytes == (int)(sizeof(trace_binary_opcode_t) * this->bbl_size[BBL]), "Static File Smaller than StaticDict.\n")
+
+        for (uint32_t opcode = 0; opcode < this->bbl_size[BBL]; opcode++) {
+            NewOpcode.trace_binary_to_opcode(&records[opcode]);
+            ERROR_ASSERT_PRINTF(NewOpcode.opcode_address != 0, "Static trace file generating opcode address equal to zero.\n")
+            this->static_dict->set_opcode(BBL, opcode, &NewOpcode);
+        }
+        utils_t::template_delete_array<trace_binary_opcode_t>(records);
+    }
+};
 
 // =============================================================================
 /// Check if the map was successfully generated
@@ -500,7 +1471,9 @@ void trace_reader_t::check_static_dict() {
         ERROR_ASSERT_PRINTF(this->bbl_size[bbl], "BBL[%d] has no instruction inside.\n", bbl);
 
         for (uint32_t j = 0; j < this->bbl_size[bbl]; j++) {
-            dict_opcode = this->static_dict[bbl][j];
+            dict_opcode.package_clean();
+            this->static_dict->fill_opcode(bbl, j, &dict_opcode);
+            snprintf(dict_opcode.opcode_assembly, sizeof(dict_opcode.opcode_assembly), "%s", this->static_dict->get_assembly(dict_opcode.static_opcode));
 
             while (true) {
                 gzgets(this->gzStaticTraceFile, this->line_static, TRACE_LINE_SIZE);
@@ -21,35 +21,84 @@
 /// Trace Reader
 // ============================================================================
  /*! Read the instruction/memory trace files
-  * Open the static trace => Dictionary of instruction per Basic Block
+  * Open the static trace => Dictionary of instruction per Basic Block (trace_static_dict_t)
   * Open the dynamic trace(s) => Reads the threads Basic Block execution trace
   * Open the memory trace(s) => Match the memory addresses for R/W Instructions
+  * When <trace>.tid0.stat.bin exists the binary trace (trace_binary.hpp) is used instead.
+  * Chunked binary dynamic/memory files are read by one trace_chunk_reader_t each,
+  * inflated ahead by one shared trace_chunk_pool_t, and can be positioned at any
+  * opcode with trace_seek.
+  * With -trace_mmap the uncompressed files are also mapped (trace_mmap_t) and the
+  * dynamic/memory records are parsed in place, the gzFiles are used only at start-up.
+  * The opcode count of each text dynamic trace is cached in <trace>.tidN.dyn.out.gz.idx (trace_index.hpp),
+  * with the checkpoints used to seek the text traces (trace_seek_index).
+  * With -trace_prefetch each core has one thread decoding its dynamic and memory
+  * traces ahead into a trace_ring_t, and trace_fetch only pops decoded opcodes.
+  * The checkpoint keeps only the opcode/sync counters of each core, on restore the
+  * trace is positioned again with trace_seek (chunked), or from the nearest index
+  * checkpoint (text) or the beginning (binary) by decoding it up to there.
   */
 class trace_reader_t {
     private:
+        trace_format_t trace_format;
+
         gzFile gzStaticTraceFile;
         gzFile *gzDynamicTraceFile;
         gzFile *gzMemoryTraceFile;
+        trace_chunk_reader_t **chunkDynamicTraceFile;
+        trace_chunk_reader_t **chunkMemoryTraceFile;
+        trace_chunk_pool_t *chunk_pool;         /// Workers of the chunked files, started with the first one
+        trace_mmap_t *mmapStaticTraceFile;
+        trace_mmap_t **mmapDynamicTraceFile;
+        trace_mmap_t **mmapMemoryTraceFile;
 
         bool *insideBBL;
         uint64_t *trace_opcode_counter;
+        uint32_t *trace_sync_counter;       /// Syncs fetched after the last opcode, used by the checkpoint
         uint64_t *trace_opcode_max;
         uint64_t trace_opcode_total;
 
         uint32_t total_bbls;
         uint32_t *bbl_size;
+        uint32_t *bbl_memory_size;      /// Memory operands of each BBL
 
         uint32_t total_cores;
 
-        opcode_package_t **static_dict;
+        trace_static_dict_t *static_dict;
         uint32_t *actual_bbl;
         uint32_t *actual_bbl_opcode;
 
+        /// Used to handle the trace index
+        char *static_file_name;
+        char **dynamic_file_name;
+        std::vector<trace_index_checkpoint_t> *index_checkpoints;
+
+        /// Used to open the gzFiles again in a forked process
+        char **gz_dynamic_file_name;
+        char **gz_memory_file_name;
+
         /// Used to handle the trace reader
         char *line_static;
         char **line_dynamic;
         char **line_memory;
 
+        /// Used to handle the mapped text memory trace
+        trace_binary_memory_t *mapped_memory;
+
+        /// Used to handle the binary trace reader
+        uint32_t **binary_dynamic;
+        uint32_t *binary_dynamic_position;
+        uint32_t *binary_dynamic_count;
+        trace_binary_memory_t **binary_memory;
+        uint32_t *binary_memory_position;
+        uint32_t *binary_memory_count;
+
+        /// Used to handle the trace prefetch threads
+        uint32_t trace_prefetch_size;
+        trace_ring_t **trace_prefetch_ring;
+        std::thread *trace_prefetch_thread;
+        std::atomic<bool> trace_prefetch_stop;
+
     public:
         // ====================================================================
         /// Methods
@@ -64,18 +113,48 @@ class trace_reader_t {
             return "TRACE_READER";
         };
 
+        void open_text_trace(char *in_file);
+        void open_binary_trace(char *in_file);
+        void read_binary_header(gzFile file, const char *file_name, uint32_t file_type, trace_binary_header_t *header);
+        trace_mmap_t* open_trace_mmap(const char *file_name);
+        trace_chunk_reader_t* open_trace_chunk(const char *file_name, const trace_binary_header_t *header);
+
         void define_total_bbls();
         void define_total_bbl_size();
 
-
         uint64_t trace_size(uint32_t cpuid);
+        void trace_seek(uint32_t cpuid, uint64_t opcode);
+        void trace_rewind(uint32_t cpuid);
+        void trace_skip(uint32_t cpuid, uint64_t opcodes, uint32_t syncs);
+        uint64_t trace_seek_index(uint32_t cpuid, uint64_t opcodes);
+        bool read_trace_index(uint32_t cpuid, trace_index_header_t *header, std::vector<trace_index_checkpoint_t> *checkpoints);
+        void write_trace_index(uint32_t cpuid, trace_index_header_t *header, const std::vector<trace_index_checkpoint_t> &checkpoints);
+        void fill_trace_index_header(uint32_t cpuid, trace_index_header_t *header);
         uint32_t trace_next_dynamic(uint32_t cpuid, sync_t *sync_found);
         void trace_next_memory(uint32_t cpuid);
+        const trace_binary_memory_t* trace_next_memory_mapped(uint32_t cpuid);
+        uint32_t trace_next_dynamic_binary(uint32_t cpuid, sync_t *sync_found);
+        const trace_binary_memory_t* trace_next_memory_binary(uint32_t cpuid);
+        bool trace_decode(uint32_t cpuid, opcode_package_t *m);
         bool trace_fetch(uint32_t cpuid, opcode_package_t *m);
 
+        void prepare_fork();
+        void reopen_trace_files();
+
+        void start_trace_prefetch();
+        void stop_trace_prefetch();
+        void trace_prefetch(uint32_t cpuid);
+
+        void checkpoint(checkpoint_t *checkpoint);
+
         void generate_static_dict();
+        void generate_static_dict_binary();
         void check_static_dict();
 
+        INSTANTIATE_GET_SET(trace_format_t, trace_format);
+        INSTANTIATE_GET_SET(trace_static_dict_t*, static_dict);
+        INSTANTIATE_GET_SET(uint32_t, trace_prefetch_size);
+
         /// Progress
         uint64_t get_trace_opcode_counter(uint32_t cpuid) { return this->trace_opcode_counter[cpuid]; }
         uint64_t get_trace_opcode_max(uint32_t cpuid) { return this->trace_opcode_max[cpuid]; }
@@ -0,0 +1,106 @@
+/*
+ * Copyright (C) 2010~2014  Marco Antonio Zanata Alves
+ *                          (mazalves at inf.ufrgs.br)
+ *                          GPPD - Parallel and Distributed Processing Group
+ *                          Universidade Federal do Rio Grande do Sul
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/// Trace Ring
+// ============================================================================
+ /*! Bounded single-producer/single-consumer ring of decoded opcodes.
+  * The producer is the trace prefetch thread of one core and the consumer
+  * is trace_reader_t::trace_fetch() on the simulation thread.
+  * Only the producer writes the tail and only the consumer writes the head,
+  * so no lock is needed.
+  *
+  *            -----------------
+  *   FRONT <- |0|1|2|3|4|5|6|7| <- BACK
+  * (consumer) -----------------    (producer)
+  *          HEAD              TAIL
+  */
+#ifndef _SINUCA_TRACE_RING_HPP_
+#define _SINUCA_TRACE_RING_HPP_
+
+#define TRACE_RING_CACHE_LINE 64    /// Keep head and tail in different lines
+
+// ============================================================================
+struct trace_ring_entry_t {
+    opcode_package_t opcode;
+    bool is_eof;                    /// Trace is over, opcode is not valid
+};
+
+// ============================================================================
+class trace_ring_t {
+    private:
+        trace_ring_entry_t *data;
+        uint32_t capacity;
+
+        char padding_head[TRACE_RING_CACHE_LINE];
+        std::atomic<uint64_t> head;     /// Written by the consumer
+        char padding_tail[TRACE_RING_CACHE_LINE];
+        std::atomic<uint64_t> tail;     /// Written by the producer
+        char padding_end[TRACE_RING_CACHE_LINE];
+
+    public:
+        // ====================================================================
+        /// Methods
+        // ====================================================================
+        trace_ring_t() {
+            this->data = NULL;
+            this->capacity = 0;
+            this->head.store(0);
+            this->tail.store(0);
+        };
+
+        ~trace_ring_t() {
+            utils_t::template_delete_array<trace_ring_entry_t>(this->data);
+        };
+
+        void allocate(uint32_t elements) {
+            this->capacity = elements;
+            this->data = utils_t::template_allocate_array<trace_ring_entry_t>(this->capacity);
+        };
+
+        /// Consumer: oldest entry, or NULL when the producer is behind
+        inline trace_ring_entry_t* front() {
+            uint64_t position = this->head.load(std::memory_order_relaxed);
+            if (position == this->tail.load(std::memory_order_acquire)) {
+                return NULL;
+            }
+            return &this->data[position % this->capacity];
+        };
+
+        /// Consumer: release the front entry to the producer
+        inline void pop_front() {
+            this->head.store(this->head.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+        };
+
+        /// Producer: entry to be filled, or NULL when the ring is full
+        inline trace_ring_entry_t* back() {
+            uint64_t position = this->tail.load(std::memory_order_relaxed);
+            if (position - this->head.load(std::memory_order_acquire) == this->capacity) {
+                return NULL;
+            }
+            return &this->data[position % this->capacity];
+        };
+
+        /// Producer: publish the back entry to the consumer
+        inline void push_back() {
+            this->tail.store(this->tail.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+        };
+};
+
+#endif  // _SINUCA_TRACE_RING_HPP_
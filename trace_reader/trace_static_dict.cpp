@@ -0,0 +1,282 @@
+/*
+ * Copyright (C) 2010~2014  Marco Antonio Zanata Alves
+ *                          (mazalves at inf.ufrgs.br)
+ *                          GPPD - Parallel and Distributed Processing Group
+ *                          Universidade Federal do Rio Grande do Sul
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "../sinuca.hpp"
+
+#ifdef TRACE_READER_DEBUG
+    #define TRACE_READER_DEBUG_PRINTF(...) DEBUG_PRINTF(__VA_ARGS__);
+#else
+    #define TRACE_READER_DEBUG_PRINTF(...)
+#endif
+
+// =============================================================================
+trace_static_dict_t::trace_static_dict_t() {
+    this->total_bbls = 0;
+    this->total_opcodes = 0;
+    this->bbl_first = NULL;
+
+    this->opcode_address = NULL;
+    this->opcode_operation = NULL;
+    this->opcode_size = NULL;
+    this->flags = NULL;
+    this->base_reg = NULL;
+    this->index_reg = NULL;
+
+    this->registers_first = NULL;
+    this->read_regs_count = NULL;
+    this->write_regs_count = NULL;
+
+    this->assembly = NULL;
+
+    this->uops_first = NULL;
+    this->uops_count = NULL;
+};
+
+// =============================================================================
+trace_static_dict_t::~trace_static_dict_t() {
+    utils_t::template_delete_array<uint32_t>(bbl_first);
+
+    utils_t::template_delete_array<uint64_t>(opcode_address);
+    utils_t::template_delete_array<uint8_t>(opcode_operation);
+    utils_t::template_delete_array<uint8_t>(opcode_size);
+    utils_t::template_delete_array<uint8_t>(flags);
+    utils_t::template_delete_array<uint16_t>(base_reg);
+    utils_t::template_delete_array<uint16_t>(index_reg);
+
+    utils_t::template_delete_array<uint32_t>(registers_first);
+    utils_t::template_delete_array<uint8_t>(read_regs_count);
+    utils_t::template_delete_array<uint8_t>(write_regs_count);
+
+    utils_t::template_delete_array<uint32_t>(assembly);
+
+    utils_t::template_delete_array<uint32_t>(uops_first);
+    utils_t::template_delete_array<uint8_t>(uops_count);
+};
+
+// =============================================================================
+/// BBL 0 is never used, bbl_size[0] must be 0
+void trace_static_dict_t::allocate(uint32_t in_total_bbls, const uint32_t *bbl_size) {
+    this->total_bbls = in_total_bbls;
+    this->bbl_first = utils_t::template_allocate_array<uint32_t>(this->total_bbls + 1);
+
+    this->total_opcodes = 0;
+    for (uint32_t i = 0; i < this->total_bbls; i++) {
+        this->bbl_first[i] = this->total_opcodes;
+        this->total_opcodes += bbl_size[i];
+    }
+    this->bbl_first[this->total_bbls] = this->total_opcodes;
+    ERROR_ASSERT_PRINTF(this->total_opcodes > 0, "Static dictionary without instructions.\n")
+
+    this->opcode_address = utils_t::template_allocate_initialize_array<uint64_t>(this->total_opcodes, 0);
+    this->opcode_operation = utils_t::template_allocate_initialize_array<uint8_t>(this->total_opcodes, INSTRUCTION_OPERATION_NOP);
+    this->opcode_size = utils_t::template_allocate_initialize_array<uint8_t>(this->total_opcodes, 0);
+    this->flags = utils_t::template_allocate_initialize_array<uint8_t>(this->total_opcodes, 0);
+    this->base_reg = utils_t::template_allocate_initialize_array<uint16_t>(this->total_opcodes, 0);
+    this->index_reg = utils_t::template_allocate_initialize_array<uint16_t>(this->total_opcodes, 0);
+
+    this->registers_first = utils_t::template_allocate_initialize_array<uint32_t>(this->total_opcodes, 0);
+    this->read_regs_count = utils_t::template_allocate_initialize_array<uint8_t>(this->total_opcodes, 0);
+    this->write_regs_count = utils_t::template_allocate_initialize_array<uint8_t>(this->total_opcodes, 0);
+    this->registers.clear();
+    this->registers.reserve(this->total_opcodes * 4);
+
+    this->assembly = utils_t::template_allocate_initialize_array<uint32_t>(this->total_opcodes, 0);
+    this->assembly_pool.clear();
+    this->assembly_index.clear();
+};
+
+// =============================================================================
+/// Store one static instruction, the opcodes must be set only once
+void trace_static_dict_t::set_opcode(uint32_t bbl, uint32_t opcode, const opcode_package_t *package) {
+    ERROR_ASSERT_PRINTF(bbl < this->total_bbls && this->bbl_first[bbl] + opcode < this->bbl_first[bbl + 1],
+                        "Static dictionary position BBL[%u] opcode[%u] out of bounds.\n", bbl, opcode)
+    uint32_t i = this->bbl_first[bbl] + opcode;
+
+    /// Fields narrower than inside the opcode_package_t
+    ERROR_ASSERT_PRINTF(package->opcode_operation <= UINT8_MAX, "Opcode operation %u too big.\n", package->opcode_operation)
+    ERROR_ASSERT_PRINTF(package->opcode_size <= UINT8_MAX, "Opcode size %u too big.\n", package->opcode_size)
+    ERROR_ASSERT_PRINTF(package->base_reg <= UINT16_MAX && package->index_reg <= UINT16_MAX,
+                        "Base/Index register %u/%u too big.\n", package->base_reg, package->index_reg)
+
+    this->opcode_address[i] = package->opcode_address;
+    this->opcode_operation[i] = package->opcode_operation;
+    this->opcode_size[i] = package->opcode_size;
+    this->base_reg[i] = package->base_reg;
+    this->index_reg[i] = package->index_reg;
+
+    this->flags[i] = (package->is_read ? TRACE_BINARY_IS_READ : 0) |
+                    (package->is_read2 ? TRACE_BINARY_IS_READ2 : 0) |
+                    (package->is_write ? TRACE_BINARY_IS_WRITE : 0) |
+                    (package->is_conditional ? TRACE_BINARY_IS_CONDITIONAL : 0) |
+                    (package->is_predicated ? TRACE_BINARY_IS_PREDICATED : 0) |
+                    (package->is_prefetch ? TRACE_BINARY_IS_PREFETCH : 0);
+
+    /// Registers up to the last used position
+    uint32_t read_count = MAX_REGISTERS, write_count = MAX_REGISTERS;
+    while (read_count > 0 && package->read_regs[read_count - 1] == POSITION_FAIL) read_count--;
+    while (write_count > 0 && package->write_regs[write_count - 1] == POSITION_FAIL) write_count--;
+
+    this->registers_first[i] = this->registers.size();
+    this->read_regs_count[i] = read_count;
+    this->write_regs_count[i] = write_count;
+    for (uint32_t r = 0; r < read_count; r++) {
+        ERROR_ASSERT_PRINTF(package->read_regs[r] >= INT16_MIN && package->read_regs[r] <= INT16_MAX, "Read register %d too big.\n", package->read_regs[r])
+        this->registers.push_back(package->read_regs[r]);
+    }
+    for (uint32_t r = 0; r < write_count; r++) {
+        ERROR_ASSERT_PRINTF(package->write_regs[r] >= INT16_MIN && package->write_regs[r] <= INT16_MAX, "Write register %d too big.\n", package->write_regs[r])
+        this->registers.push_back(package->write_regs[r]);
+    }
+
+    /// Intern the assembly
+    char name[MAX_ASSEMBLY_SIZE];
+    memset(name, 0, sizeof(name));
+    snprintf(name, sizeof(name), "%s", package->opcode_assembly);
+    std::unordered_map<std::string, uint32_t>::iterator it = this->assembly_index.find(name);
+    if (it == this->assembly_index.end()) {
+        uint32_t position = this->assembly_pool.size();
+        this->assembly_pool.insert(this->assembly_pool.end(), name, name + MAX_ASSEMBLY_SIZE);
+        it = this->assembly_index.insert(std::make_pair(std::string(name), position)).first;
+    }
+    this->assembly[i] = it->second;
+};
+
+// =============================================================================
+/// Insert the aux register 258 in the first free position
+static void insert_register_258(int32_t *regs) {
+    for (uint32_t r = 0; r < MAX_REGISTERS; r++) {
+        if (regs[r] == POSITION_FAIL) {
+            regs[r] = 258;
+            return;
+        }
+    }
+    ERROR_PRINTF("Could not insert register_258, all MAX_REGISTERS(%d) used.", MAX_REGISTERS)
+};
+
+// =============================================================================
+/// Crack every static instruction into its uops, in the format described
+/// by processor_t::stage_decode (dependencies through the aux register 258)
+void trace_static_dict_t::decode_uops() {
+    this->uops_first = utils_t::template_allocate_initialize_array<uint32_t>(this->total_opcodes, 0);
+    this->uops_count = utils_t::template_allocate_initialize_array<uint8_t>(this->total_opcodes, 0);
+    this->uops.clear();
+    this->uops.reserve(this->total_opcodes * 2);
+
+    opcode_package_t opcode;
+    trace_static_uop_t uop;
+    for (uint32_t bbl = 0; bbl < this->total_bbls; bbl++) {
+        for (uint32_t j = 0; this->bbl_first[bbl] + j < this->bbl_first[bbl + 1]; j++) {
+            this->fill_opcode(bbl, j, &opcode);
+            uint32_t i = opcode.static_opcode;
+            this->uops_first[i] = this->uops.size();
+
+            /// HMC ============================================================
+            if (opcode.opcode_operation == INSTRUCTION_OPERATION_HMC_ALU ||
+            opcode.opcode_operation == INSTRUCTION_OPERATION_HMC_ALUR) {
+                uop.uop_operation = opcode.opcode_operation;
+                uop.memory_operand = TRACE_BINARY_IS_READ;
+                memcpy(uop.read_regs, opcode.read_regs, sizeof(uop.read_regs));
+                memcpy(uop.write_regs, opcode.write_regs, sizeof(uop.write_regs));
+                this->uops.push_back(uop);
+                this->uops_count[i] = 1;
+                continue;
+            }
+
+            /// READ and READ 2 ================================================
+            for (uint32_t k = 0; k < 2; k++) {
+                if (!(k == 0 ? opcode.is_read : opcode.is_read2)) {
+                    continue;
+                }
+                uop.uop_operation = INSTRUCTION_OPERATION_MEM_LOAD;
+                uop.memory_operand = (k == 0) ? TRACE_BINARY_IS_READ : TRACE_BINARY_IS_READ2;
+                memcpy(uop.read_regs, opcode.read_regs, sizeof(uop.read_regs));
+                memcpy(uop.write_regs, opcode.write_regs, sizeof(uop.write_regs));
+                if (opcode.opcode_operation != INSTRUCTION_OPERATION_MEM_LOAD) {
+                    memset(uop.read_regs, POSITION_FAIL, sizeof(uop.read_regs));
+                    memset(uop.write_regs, POSITION_FAIL, sizeof(uop.write_regs));
+                    uop.read_regs[0] = opcode.base_reg;
+                    uop.read_regs[1] = opcode.index_reg;
+                    uop.write_regs[0] = 258;
+                }
+                this->uops.push_back(uop);
+            }
+
+            /// ALU and BRANCH =================================================
+            if (opcode.opcode_operation != INSTRUCTION_OPERATION_MEM_LOAD &&
+            opcode.opcode_operation != INSTRUCTION_OPERATION_MEM_STORE) {
+                uop.uop_operation = opcode.opcode_operation;
+                uop.memory_operand = 0;
+                memcpy(uop.read_regs, opcode.read_regs, sizeof(uop.read_regs));
+                memcpy(uop.write_regs, opcode.write_regs, sizeof(uop.write_regs));
+                if (opcode.is_read || opcode.is_read2) {
+                    insert_register_258(uop.read_regs);
+                }
+                if (opcode.is_write) {
+                    insert_register_258(uop.write_regs);
+                }
+                this->uops.push_back(uop);
+            }
+
+            /// WRITE ==========================================================
+            if (opcode.is_write) {
+                uop.uop_operation = INSTRUCTION_OPERATION_MEM_STORE;
+                uop.memory_operand = TRACE_BINARY_IS_WRITE;
+                memcpy(uop.read_regs, opcode.read_regs, sizeof(uop.read_regs));
+                memcpy(uop.write_regs, opcode.write_regs, sizeof(uop.write_regs));
+                if (opcode.opcode_operation != INSTRUCTION_OPERATION_MEM_STORE) {
+                    insert_register_258(uop.read_regs);
+                    memset(uop.write_regs, POSITION_FAIL, sizeof(uop.write_regs));
+                }
+                this->uops.push_back(uop);
+            }
+
+            ERROR_ASSERT_PRINTF(this->uops.size() - this->uops_first[i] <= MAX_UOP_DECODED,
+                                "Decoding more uops than MAX_UOP_DECODED (%d)", MAX_UOP_DECODED)
+            this->uops_count[i] = this->uops.size() - this->uops_first[i];
+        }
+    }
+};
+
+// =============================================================================
+/// All the opcodes were set, release the building structures
+void trace_static_dict_t::finish() {
+    this->assembly_index.clear();
+    this->registers.shrink_to_fit();
+    this->assembly_pool.shrink_to_fit();
+
+    this->decode_uops();
+    this->uops.shrink_to_fit();
+
+    TRACE_READER_DEBUG_PRINTF("Static Dictionary = %u opcodes, %u assemblies, %" PRIu64 " bytes\n",
+                                this->total_opcodes, (uint32_t)(this->assembly_pool.size() / MAX_ASSEMBLY_SIZE), this->get_size_bytes());
+};
+
+// =============================================================================
+uint64_t trace_static_dict_t::get_size_bytes() {
+    uint64_t per_opcode = sizeof(uint64_t) + 3 * sizeof(uint8_t) + 2 * sizeof(uint16_t) +
+                            sizeof(uint32_t) + 2 * sizeof(uint8_t) + sizeof(uint32_t);
+    return (uint64_t)this->total_opcodes * per_opcode +
+            (uint64_t)(this->total_bbls + 1) * sizeof(uint32_t) +
+            this->registers.size() * sizeof(int16_t) +
+            this->assembly_pool.size() +
+            (uint64_t)this->total_opcodes * (sizeof(uint32_t) + sizeof(uint8_t)) +
+            this->uops.size() * sizeof(trace_static_uop_t);
+};
@@ -0,0 +1,153 @@
+/*
+ * Copyright (C) 2010~2014  Marco Antonio Zanata Alves
+ *                          (mazalves at inf.ufrgs.br)
+ *                          GPPD - Parallel and Distributed Processing Group
+ *                          Universidade Federal do Rio Grande do Sul
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+/// Trace Static Dictionary
+// ============================================================================
+ /*! Static instructions of all the BBLs, stored as one dense array per field.
+  * Instruction N of BBL B is at position bbl_first[B] + N of every array.
+  * The assembly strings are interned and the registers of each instruction
+  * are packed into one shared pool, without the unused positions.
+  * fill_opcode writes only the trace fields into the opcode_package_t.
+  * The uops of each instruction are cracked once by finish(), the decode
+  * stage copies them and only stamps the dynamic fields.
+  */
+#ifndef _SINUCA_TRACE_STATIC_DICT_HPP_
+#define _SINUCA_TRACE_STATIC_DICT_HPP_
+
+// ============================================================================
+/// Decoded uop of one static instruction
+class trace_static_uop_t {
+    public:
+        instruction_operation_t uop_operation;
+        uint8_t memory_operand;             /// TRACE_BINARY_IS_READ/READ2/WRITE, or 0 without memory
+        int32_t read_regs[MAX_REGISTERS];
+        int32_t write_regs[MAX_REGISTERS];
+};
+
+// ============================================================================
+class trace_static_dict_t {
+    private:
+        uint32_t total_bbls;
+        uint32_t total_opcodes;
+        uint32_t *bbl_first;                /// First instruction of each BBL
+
+        uint64_t *opcode_address;
+        uint8_t *opcode_operation;          /// instruction_operation_t
+        uint8_t *opcode_size;
+        uint8_t *flags;                     /// TRACE_BINARY_IS_* bits
+        uint16_t *base_reg;
+        uint16_t *index_reg;
+
+        uint32_t *registers_first;          /// First position inside the registers pool
+        uint8_t *read_regs_count;           /// Read registers, then the write registers
+        uint8_t *write_regs_count;
+        std::vector<int16_t> registers;
+
+        uint32_t *assembly;                 /// Position inside the assembly pool
+        std::vector<char> assembly_pool;    /// MAX_ASSEMBLY_SIZE chars per different string
+        std::unordered_map<std::string, uint32_t> assembly_index;   /// Only while building
+
+        uint32_t *uops_first;               /// First position inside the uops pool
+        uint8_t *uops_count;
+        std::vector<trace_static_uop_t> uops;
+
+        void decode_uops();
+
+    public:
+        // ====================================================================
+        /// Methods
+        // ====================================================================
+        trace_static_dict_t();
+        ~trace_static_dict_t();
+        inline const char* get_label() {
+            return "TRACE_STATIC_DICT";
+        };
+
+        void allocate(uint32_t in_total_bbls, const uint32_t *bbl_size);
+        void set_opcode(uint32_t bbl, uint32_t opcode, const opcode_package_t *package);
+        void finish();
+        uint64_t get_size_bytes();
+
+        /// Copy the trace fields of one static instruction, memory operands are cleared
+        /// The assembly stays in the dictionary, see get_assembly()
+        inline void fill_opcode(uint32_t bbl, uint32_t opcode, opcode_package_t *package) {
+            uint32_t i = this->bbl_first[bbl] + opcode;
+
+            package->static_opcode = i;
+            package->opcode_operation = instruction_operation_t(this->opcode_operation[i]);
+            package->opcode_address = this->opcode_address[i];
+            package->opcode_size = this->opcode_size[i];
+
+            const int16_t *pool = this->registers.data() + this->registers_first[i];
+            uint32_t r, count = this->read_regs_count[i];
+            for (r = 0; r < count; r++) package->read_regs[r] = pool[r];
+            for (; r < MAX_REGISTERS; r++) package->read_regs[r] = POSITION_FAIL;
+            pool += count;
+            count = this->write_regs_count[i];
+            for (r = 0; r < count; r++) package->write_regs[r] = pool[r];
+            for (; r < MAX_REGISTERS; r++) package->write_regs[r] = POSITION_FAIL;
+
+            package->base_reg = this->base_reg[i];
+            package->index_reg = this->index_reg[i];
+
+            uint8_t opcode_flags = this->flags[i];
+            package->is_read = (opcode_flags & TRACE_BINARY_IS_READ) != 0;
+            package->is_read2 = (opcode_flags & TRACE_BINARY_IS_READ2) != 0;
+            package->is_write = (opcode_flags & TRACE_BINARY_IS_WRITE) != 0;
+            package->is_conditional = (opcode_flags & TRACE_BINARY_IS_CONDITIONAL) != 0;
+            package->is_predicated = (opcode_flags & TRACE_BINARY_IS_PREDICATED) != 0;
+            package->is_prefetch = (opcode_flags & TRACE_BINARY_IS_PREFETCH) != 0;
+
+            package->read_address = 0;
+            package->read_size = 0;
+            package->read2_address = 0;
+            package->read2_size = 0;
+            package->write_address = 0;
+            package->write_size = 0;
+        };
+
+        /// Memory records used by one static instruction
+        inline uint32_t get_memory_operands(uint32_t bbl, uint32_t opcode) {
+            uint8_t opcode_flags = this->flags[this->bbl_first[bbl] + opcode];
+            return ((opcode_flags & TRACE_BINARY_IS_READ) != 0) +
+                    ((opcode_flags & TRACE_BINARY_IS_READ2) != 0) +
+                    ((opcode_flags & TRACE_BINARY_IS_WRITE) != 0);
+        };
+
+        /// Uops of one static instruction (opcode_package_t::static_opcode)
+        inline const trace_static_uop_t* get_uops(uint32_t static_opcode, uint32_t *count) {
+            *count = this->uops_count[static_opcode];
+            return this->uops.data() + this->uops_first[static_opcode];
+        };
+
+        /// Interned assembly of one static instruction (opcode_package_t::static_opcode)
+        inline const char* get_assembly(uint32_t static_opcode) {
+            return &this->assembly_pool[this->assembly[static_opcode]];
+        };
+
+        inline uint64_t get_opcode_address(uint32_t bbl, uint32_t opcode) {
+            return this->opcode_address[this->bbl_first[bbl] + opcode];
+        };
+
+        INSTANTIATE_GET_SET(uint32_t, total_opcodes);
+};
+
+#endif  // _SINUCA_TRACE_STATIC_DICT_HPP_